@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Benchmark runner regression thresholds
+ *
+ * Floors for the HPM6E00 FULL_PORT board with the default 172x320 panel. A cell fails when its
+ * measured FPS or throughput drops below the first matching entry. Zero fields match anything,
+ * so put specific entries before generic ones. Re-baseline after intentional changes by copying
+ * the CSV from a known-good run and keeping a ~15% margin.
+ */
+
+#ifndef BENCH_BASELINE_H
+#define BENCH_BASELINE_H
+
+#include <stdint.h>
+#include "bench_workloads.h"
+
+typedef struct {
+    int32_t mode;           /* bench_mode_t, or -1 for any */
+    uint16_t fb_lines;      /* 0 = any */
+    uint8_t buffers;        /* 1 or 2, 0 = any */
+    uint8_t spi_mhz;        /* 0 = any */
+    uint16_t min_fps;       /* frames_rendered per second */
+    uint16_t min_kbps;      /* flushed KB per second */
+} bench_baseline_t;
+
+static const bench_baseline_t bench_baseline[] = {
+    /* Full-screen redraw is bus bound: throughput tracks the SPI clock. */
+    { BENCH_MODE_FULL,    0,  2, 40, 20, 3200 },
+    { BENCH_MODE_FULL,    0,  1, 40, 14, 2200 },
+    { BENCH_MODE_FULL,    0,  2, 20, 11, 1700 },
+    { BENCH_MODE_FULL,    0,  1, 20,  8, 1200 },
+
+    /* Small dirty areas are render/overhead bound: the animation period caps the frame rate. */
+    { BENCH_MODE_SCATTER, 0,  0,  0, 45,    0 },
+    { BENCH_MODE_STRIPE,  0,  0, 40, 50,  300 },
+    { BENCH_MODE_STRIPE,  0,  0, 20, 45,  250 },
+};
+
+#endif /* BENCH_BASELINE_H */
@@ -0,0 +1,297 @@
+/*
+ * LVGL Benchmark Runner for HPM6E00 + ST7789/GC9307 (SPI + DMA)
+ *
+ * Headless counterpart of render_benchmark:
+ * - Runs every workload (scatter / stripe / full refresh) for a fixed duration
+ * - Sweeps draw buffer lines, single/double buffering and SPI clock at runtime
+ * - Prints one CSV row per configuration over the console UART
+ * - Checks each row against bench_baseline.h and ends with BENCH_RESULT PASS/FAIL
+ *
+ * The display backend is fixed at build time (default dma_mgr, or -DBENCH_BACKEND=legacy),
+ * or -DBENCH_BACKEND=ab builds both into one image and the matrix runs once per backend.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "board.h"
+#include "hpm_lvgl_spi.h"
+#include "bench_workloads.h"
+#include "bench_baseline.h"
+
+ATTR_WEAK void board_init_lcd(void) {}
+
+/*============================================================================
+ * Configuration matrix
+ *============================================================================*/
+
+#ifndef BENCH_WARMUP_MS
+#define BENCH_WARMUP_MS     500
+#endif
+
+#ifndef BENCH_DURATION_MS
+#define BENCH_DURATION_MS   3000
+#endif
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+static const uint16_t bench_fb_lines[] = { 20, 40, HPM_LVGL_FB_LINES };
+
+#if HPM_LVGL_USE_DOUBLE_BUFFER
+static const uint8_t bench_buffers[] = { 1, 2 };
+#else
+static const uint8_t bench_buffers[] = { 1 };
+#endif
+
+static const uint32_t bench_spi_hz[] = { 20000000UL, HPM_LVGL_SPI_FREQ };
+
+#if HPM_LVGL_BACKEND_AB
+static const hpm_lvgl_spi_backend_t bench_backends[] = { HPM_LVGL_SPI_BACKEND_DMA_MGR, HPM_LVGL_SPI_BACKEND_LEGACY };
+#elif HPM_LVGL_DUALCORE == 1
+static const hpm_lvgl_spi_backend_t bench_backends[] = { HPM_LVGL_SPI_BACKEND_DUALCORE };
+#else
+static const hpm_lvgl_spi_backend_t bench_backends[] = { HPM_LVGL_USE_LVGL_ST7789_DRIVER ? HPM_LVGL_SPI_BACKEND_DMA_MGR
+                                                                                       : HPM_LVGL_SPI_BACKEND_LEGACY };
+#endif
+
+typedef struct {
+    bench_mode_t mode;
+    uint32_t fb_lines;
+    uint32_t buffers;
+    uint32_t spi_hz;
+} bench_cell_t;
+
+typedef struct {
+    uint32_t duration_ms;
+    uint32_t frames;
+    uint32_t flushes;
+    uint64_t bytes;
+    uint64_t render_us;
+    uint64_t xfer_us;
+    uint64_t flush_cpu_us;
+    uint32_t isr_count;
+    uint64_t isr_us;
+    uint32_t isr_max_us;
+    uint64_t idle_us;
+    uint8_t overlap_pct;
+    uint64_t dma_saved_cycles;
+    uint64_t l8_expand_cycles;
+} bench_result_t;
+
+/*============================================================================
+ * Runner
+ *============================================================================*/
+
+static void bench_run_for(uint32_t ms)
+{
+    uint32_t start = lv_tick_get();
+
+    while (lv_tick_elaps(start) < ms) {
+        lv_timer_handler();
+    }
+}
+
+static void anim_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    bench_workloads_step();
+}
+
+static const bench_baseline_t *bench_find_baseline(const bench_cell_t *cell)
+{
+    uint32_t spi_mhz = cell->spi_hz / 1000000UL;
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(bench_baseline); i++) {
+        const bench_baseline_t *b = &bench_baseline[i];
+
+        if (((b->mode < 0) || (b->mode == (int32_t)cell->mode)) &&
+            ((b->fb_lines == 0U) || (b->fb_lines == cell->fb_lines)) &&
+            ((b->buffers == 0U) || (b->buffers == cell->buffers)) &&
+            ((b->spi_mhz == 0U) || (b->spi_mhz == spi_mhz))) {
+            return b;
+        }
+    }
+
+    return NULL;
+}
+
+static bool bench_run_cell(const bench_cell_t *cell, bench_result_t *res)
+{
+    hpm_lvgl_spi_stats_t s;
+    uint32_t start;
+
+    if ((hpm_lvgl_spi_set_buffer_config(cell->fb_lines, cell->buffers == 2U) != status_success) ||
+        (hpm_lvgl_spi_set_spi_freq(cell->spi_hz) != status_success)) {
+        return false;
+    }
+
+    bench_workloads_set_mode(cell->mode);
+    bench_run_for(BENCH_WARMUP_MS);
+
+    hpm_lvgl_spi_reset_stats();
+    hpm_lvgl_draw_dma_reset();
+    hpm_lvgl_l8_reset();
+    start = lv_tick_get();
+    bench_run_for(BENCH_DURATION_MS);
+    res->duration_ms = lv_tick_elaps(start);
+
+    hpm_lvgl_spi_get_stats(&s);
+    res->frames = s.frames_rendered;
+    res->flushes = s.flush_count;
+    res->bytes = s.flush_bytes;
+    res->render_us = s.render_us;
+    res->xfer_us = s.xfer_us;
+    res->flush_cpu_us = s.flush_cpu_us;
+    res->isr_count = s.isr_count;
+    res->isr_us = s.isr_us;
+    res->isr_max_us = s.isr_max_us;
+    res->idle_us = s.idle_us;
+    res->overlap_pct = s.overlap_pct;
+
+    hpm_lvgl_draw_dma_stats_t d = {0};
+    hpm_lvgl_draw_dma_get_stats(&d);
+    res->dma_saved_cycles = d.saved_min_cycles;
+
+    hpm_lvgl_l8_stats_t l8 = {0};
+    hpm_lvgl_l8_get_stats(&l8);
+    res->l8_expand_cycles = l8.expand_cycles;
+
+    return true;
+}
+
+static bool bench_report(const bench_cell_t *cell, const bench_result_t *res)
+{
+    uint32_t ms = (res->duration_ms != 0U) ? res->duration_ms : 1U;
+    uint32_t fps_x10 = (uint32_t)(((uint64_t)res->frames * 10000U) / ms);
+    uint32_t kbps = (uint32_t)((res->bytes * 1000U) / ((uint64_t)ms * 1024U));
+    const bench_baseline_t *b = bench_find_baseline(cell);
+    uint32_t flush_cpu_us = (res->flushes > 0U) ? (uint32_t)(res->flush_cpu_us / res->flushes) : 0U;
+    uint32_t isr_us = (res->isr_count > 0U) ? (uint32_t)(res->isr_us / res->isr_count) : 0U;
+    uint32_t idle_pct = (uint32_t)((res->idle_us * 100U) / ((uint64_t)ms * 1000U));
+    uint32_t dma_saved = (res->frames > 0U) ? (uint32_t)(res->dma_saved_cycles / res->frames) : 0U;
+    uint32_t l8_expand = (res->frames > 0U) ? (uint32_t)(res->l8_expand_cycles / res->frames) : 0U;
+    const char *verdict = "-";
+    bool pass = true;
+
+    if (b != NULL) {
+        pass = (fps_x10 >= ((uint32_t)b->min_fps * 10U)) && (kbps >= b->min_kbps);
+        verdict = pass ? "PASS" : "FAIL";
+    }
+
+    printf("%s,%s,%lu,%lu,%lu,%lu,%lu,%lu.%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%s\n",
+           hpm_lvgl_spi_get_backend_name(), bench_mode_name(cell->mode),
+           (unsigned long)cell->fb_lines, (unsigned long)cell->buffers, (unsigned long)cell->spi_hz,
+           (unsigned long)res->duration_ms, (unsigned long)res->frames,
+           (unsigned long)(fps_x10 / 10U), (unsigned long)(fps_x10 % 10U),
+           (unsigned long)res->flushes, (unsigned long)kbps,
+           (unsigned long)res->render_us, (unsigned long)res->xfer_us, (unsigned long)flush_cpu_us,
+           (unsigned long)isr_us, (unsigned long)res->isr_max_us, (unsigned long)idle_pct,
+           (unsigned long)res->overlap_pct, (unsigned long)dma_saved, (unsigned long)l8_expand, verdict);
+
+    if (!pass) {
+        printf("FAIL %s %s lines=%lu buffers=%lu spi=%lu: fps %lu.%lu < %u or kbps %lu < %u\n",
+               hpm_lvgl_spi_get_backend_name(), bench_mode_name(cell->mode), (unsigned long)cell->fb_lines, (unsigned long)cell->buffers,
+               (unsigned long)cell->spi_hz, (unsigned long)(fps_x10 / 10U), (unsigned long)(fps_x10 % 10U),
+               (unsigned int)b->min_fps, (unsigned long)kbps, (unsigned int)b->min_kbps);
+    }
+
+    return pass;
+}
+
+static void bench_run_matrix(uint32_t *runs, uint32_t *failures)
+{
+    for (uint32_t l = 0; l < ARRAY_SIZE(bench_fb_lines); l++) {
+        for (uint32_t b = 0; b < ARRAY_SIZE(bench_buffers); b++) {
+            for (uint32_t f = 0; f < ARRAY_SIZE(bench_spi_hz); f++) {
+                for (uint32_t m = 0; m < BENCH_MODE_COUNT; m++) {
+                    bench_cell_t cell = {
+                        .mode = (bench_mode_t)m,
+                        .fb_lines = bench_fb_lines[l],
+                        .buffers = bench_buffers[b],
+                        .spi_hz = bench_spi_hz[f],
+                    };
+                    bench_result_t res;
+
+                    memset(&res, 0, sizeof(res));
+                    (*runs)++;
+                    if (!bench_run_cell(&cell, &res)) {
+                        printf("FAIL %s lines=%lu buffers=%lu spi=%lu: configuration rejected\n",
+                               bench_mode_name(cell.mode), (unsigned long)cell.fb_lines,
+                               (unsigned long)cell.buffers, (unsigned long)cell.spi_hz);
+                        (*failures)++;
+                        continue;
+                    }
+                    if (!bench_report(&cell, &res)) {
+                        (*failures)++;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*============================================================================
+ * Main
+ *============================================================================*/
+
+int main(void)
+{
+    uint32_t runs = 0;
+    uint32_t failures = 0;
+
+    board_init();
+    board_init_lcd();
+
+    printf("LVGL Benchmark Runner\n");
+    printf("Screen: %dx%d, backend: %s, %lu ms per configuration\n", (int)HPM_LVGL_LCD_WIDTH,
+           (int)HPM_LVGL_LCD_HEIGHT, hpm_lvgl_spi_get_backend_name(), (unsigned long)BENCH_DURATION_MS);
+
+    if (hpm_lvgl_spi_init() == NULL) {
+        printf("Failed to initialize display!\n");
+        while (1) {
+        }
+    }
+
+    lv_obj_t *screen = lv_screen_active();
+    lv_obj_set_style_bg_color(screen, lv_color_hex(0x0b1020), 0);
+    lv_obj_set_style_bg_opa(screen, LV_OPA_COVER, 0);
+    lv_obj_clear_flag(screen, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t *content = lv_obj_create(screen);
+    lv_obj_remove_style_all(content);
+    lv_obj_set_pos(content, 0, 56);
+    lv_obj_set_size(content, HPM_LVGL_LCD_WIDTH, (HPM_LVGL_LCD_HEIGHT - 56 - 20));
+
+    bench_workloads_init(content);
+    (void)lv_timer_create(anim_timer_cb, BENCH_ANIM_PERIOD_MS, NULL);
+
+    printf("# bench_runner v1 ramfunc=%u draw_units=%u dsp=%u dsp_isa=%u l8=%u\n", (unsigned int)HPM_LVGL_RAMFUNC,
+           (unsigned int)LV_DRAW_SW_DRAW_UNIT_CNT, (unsigned int)HPM_LVGL_DSP, (unsigned int)HPM_LVGL_DSP_ISA,
+           (unsigned int)HPM_LVGL_L8);
+    hpm_lvgl_l8_dump();
+    printf("backend,mode,fb_lines,buffers,spi_hz,duration_ms,frames,fps,flushes,kbps,render_us,xfer_us,"
+           "flush_cpu_us,isr_us,isr_max_us,idle_pct,overlap_pct,dma_saved_cyc,l8_expand_cyc,verdict\n");
+
+    for (uint32_t k = 0; k < ARRAY_SIZE(bench_backends); k++) {
+        if (hpm_lvgl_spi_set_backend(bench_backends[k]) != status_success) {
+            printf("FAIL backend %u: switch rejected\n", (unsigned int)bench_backends[k]);
+            failures++;
+            continue;
+        }
+        bench_run_matrix(&runs, &failures);
+    }
+
+    /* Leave the panel at the build-time defaults. */
+    (void)hpm_lvgl_spi_set_backend(bench_backends[0]);
+    (void)hpm_lvgl_spi_set_buffer_config(HPM_LVGL_FB_LINES, (HPM_LVGL_USE_DOUBLE_BUFFER != 0));
+    (void)hpm_lvgl_spi_set_spi_freq(HPM_LVGL_SPI_FREQ);
+
+    printf("BENCH_RESULT %s runs=%lu failures=%lu\n", (failures == 0U) ? "PASS" : "FAIL",
+           (unsigned long)runs, (unsigned long)failures);
+
+    while (1) {
+        hpm_lvgl_spi_run_once(HPM_LVGL_RUN_MAX_SLEEP_MS);
+    }
+
+    return 0;
+}
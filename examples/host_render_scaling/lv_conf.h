@@ -0,0 +1,23 @@
+/**
+ * @file lv_conf.h
+ * Host configuration for the render scaling benchmark: the target's standalone configuration
+ * with pthreads as the OS layer (one thread per draw unit) and a larger heap.
+ */
+
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+#define LV_USE_OS LV_OS_PTHREAD
+
+#include "lv_conf_standalone.h"
+
+#undef LV_MEM_SIZE
+#define LV_MEM_SIZE (256 * 1024U)
+
+/* No panel on the host */
+#undef LV_USE_ST7789
+#define LV_USE_ST7789 0
+#undef LV_USE_GENERIC_MIPI
+#define LV_USE_GENERIC_MIPI 0
+
+#endif /* LV_CONF_H */
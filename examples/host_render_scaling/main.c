@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Host render scaling benchmark
+ *
+ * Renders every render_benchmark workload on LVGL's software renderer with the draw unit count
+ * this binary was built for (HPM_LVGL_DRAW_UNITS), into 80-line partial strips like the target.
+ * Time is virtual (one animation step per frame), so the pixels are identical for every unit
+ * count and for the HPM_LVGL_DSP kernels: the CRC column checks that, us_per_frame shows the scaling.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "lvgl.h"
+#include "hpm_lvgl_dsp.h"
+#include "bench_workloads.h"
+
+#ifndef HOST_LCD_WIDTH
+#define HOST_LCD_WIDTH      172
+#endif
+
+#ifndef HOST_LCD_HEIGHT
+#define HOST_LCD_HEIGHT     320
+#endif
+
+#ifndef HOST_FB_LINES
+#define HOST_FB_LINES       80
+#endif
+
+#ifndef HOST_WARMUP_FRAMES
+#define HOST_WARMUP_FRAMES  30
+#endif
+
+#ifndef HOST_FRAMES
+#define HOST_FRAMES         300
+#endif
+
+static uint8_t host_fb0[HOST_LCD_WIDTH * HOST_FB_LINES * 2] __attribute__((aligned(64)));
+static uint8_t host_fb1[HOST_LCD_WIDTH * HOST_FB_LINES * 2] __attribute__((aligned(64)));
+static uint32_t host_tick;
+static uint32_t host_crc;
+
+static uint32_t host_crc32(uint32_t crc, const uint8_t *p, uint32_t len)
+{
+    crc = ~crc;
+    while (len-- > 0U) {
+        crc ^= *p++;
+        for (uint32_t k = 0; k < 8U; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0U - (crc & 1U)));
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t host_tick_get(void)
+{
+    return host_tick;
+}
+
+static uint64_t host_now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000U) + ((uint64_t)ts.tv_nsec / 1000U);
+}
+
+static void host_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    /* Partial strips are packed: the stride is the area width */
+    host_crc = host_crc32(host_crc, px_map, lv_area_get_size(area) * 2U);
+    host_crc = host_crc32(host_crc, (const uint8_t *)area, sizeof(*area));
+    lv_display_flush_ready(disp);
+}
+
+/* One frame: advance the workload and virtual time, render all invalidated strips now. */
+static void host_frame(lv_display_t *disp)
+{
+    lv_lock();
+    bench_workloads_step();
+    host_tick += BENCH_ANIM_PERIOD_MS;
+    lv_refr_now(disp);
+    lv_unlock();
+}
+
+int main(void)
+{
+    lv_init();
+    lv_tick_set_cb(host_tick_get);
+
+    lv_display_t *disp = lv_display_create(HOST_LCD_WIDTH, HOST_LCD_HEIGHT);
+    lv_display_set_buffers(disp, host_fb0, host_fb1, sizeof(host_fb0), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, host_flush_cb);
+
+    lv_lock();
+    lv_obj_t *screen = lv_screen_active();
+    lv_obj_set_style_bg_color(screen, lv_color_hex(0x0b1220), 0);
+    lv_obj_t *content = lv_obj_create(screen);
+    lv_obj_remove_style_all(content);
+    lv_obj_set_size(content, HOST_LCD_WIDTH, HOST_LCD_HEIGHT);
+    bench_workloads_init(content);
+    lv_unlock();
+
+    printf("# host_render_scaling draw_units=%u dsp=%u %ux%u lines=%u frames=%u\n",
+           (unsigned int)LV_DRAW_SW_DRAW_UNIT_CNT, (unsigned int)HPM_LVGL_DSP, (unsigned int)HOST_LCD_WIDTH,
+           (unsigned int)HOST_LCD_HEIGHT, (unsigned int)HOST_FB_LINES, (unsigned int)HOST_FRAMES);
+    printf("draw_units,dsp,mode,frames,us_per_frame,crc\n");
+
+    uint64_t total_us = 0;
+    for (uint32_t m = 0; m < (uint32_t)BENCH_MODE_COUNT; m++) {
+        lv_lock();
+        bench_workloads_set_mode((bench_mode_t)m);
+        lv_unlock();
+        for (uint32_t i = 0; i < HOST_WARMUP_FRAMES; i++) {
+            host_frame(disp);
+        }
+
+        host_crc = 0;
+        uint64_t start = host_now_us();
+        for (uint32_t i = 0; i < HOST_FRAMES; i++) {
+            host_frame(disp);
+        }
+        uint64_t us = host_now_us() - start;
+        total_us += us;
+
+        printf("%u,%u,%s,%u,%lu,%08lx\n", (unsigned int)LV_DRAW_SW_DRAW_UNIT_CNT, (unsigned int)HPM_LVGL_DSP,
+               bench_mode_name((bench_mode_t)m), (unsigned int)HOST_FRAMES, (unsigned long)(us / HOST_FRAMES),
+               (unsigned long)host_crc);
+    }
+    printf("%u,%u,TOTAL,%u,%lu,-\n", (unsigned int)LV_DRAW_SW_DRAW_UNIT_CNT, (unsigned int)HPM_LVGL_DSP,
+           (unsigned int)(HOST_FRAMES * BENCH_MODE_COUNT), (unsigned long)(total_us / (HOST_FRAMES * BENCH_MODE_COUNT)));
+
+    return 0;
+}
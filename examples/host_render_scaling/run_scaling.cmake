@@ -0,0 +1,40 @@
+# Copyright (c) 2024 HPMicro
+# SPDX-License-Identifier: BSD-3-Clause
+
+# Runs the render_scaling builds in turn (SCALING_BINARIES, comma separated) and prints their rows.
+# Fails when a mode's crc differs between builds: neither the draw unit count nor the DSP kernels
+# may change a pixel.
+
+string(REPLACE "," ";" binaries "${SCALING_BINARIES}")
+set(mismatches)
+
+foreach(binary IN LISTS binaries)
+    execute_process(COMMAND ${binary} OUTPUT_VARIABLE out RESULT_VARIABLE result)
+    string(STRIP "${out}" out)
+    execute_process(COMMAND ${CMAKE_COMMAND} -E echo "${out}")
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${binary} failed (${result})")
+    endif()
+
+    string(REPLACE "\n" ";" lines "${out}")
+    foreach(line IN LISTS lines)
+        # draw_units,dsp,mode,frames,us_per_frame,crc
+        if(line MATCHES "^([0-9]+),([0-9]+),([A-Za-z0-9_]+),[0-9]+,[0-9]+,([0-9a-f]+)$")
+            set(build "draw_units=${CMAKE_MATCH_1} dsp=${CMAKE_MATCH_2}")
+            set(mode ${CMAKE_MATCH_3})
+            set(crc ${CMAKE_MATCH_4})
+            if(NOT DEFINED crc_${mode})
+                set(crc_${mode} ${crc})
+                set(build_${mode} ${build})
+            elseif(NOT crc STREQUAL crc_${mode})
+                list(APPEND mismatches "${mode}: ${crc} with ${build}, ${crc_${mode}} with ${build_${mode}}")
+            endif()
+        endif()
+    endforeach()
+endforeach()
+
+if(mismatches)
+    string(REPLACE ";" "\n  " mismatches "${mismatches}")
+    message(FATAL_ERROR "crc differs between builds:\n  ${mismatches}")
+endif()
+message(STATUS "crc matches across all builds")
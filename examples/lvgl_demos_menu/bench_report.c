@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * lv_demo_benchmark report implementation
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "hpm_lvgl_spi.h"
+#include "bench_report.h"
+
+#include <lvgl.h>
+#include <demos/lv_demos.h>
+
+#if LV_USE_DEMO_BENCHMARK
+
+/*============================================================================
+ * Private data
+ *============================================================================*/
+
+typedef struct {
+    uint32_t duration_ms;
+    hpm_lvgl_spi_stats_t stats;
+} bench_scene_t;
+
+static struct {
+    bool running;
+    lv_timer_t *poll_timer;
+    lv_obj_t *watch;            /* First child of the current scene; its deletion ends the scene */
+    bool just_cleaned;          /* Screen was cleaned since the last poll */
+    uint32_t scene_start;
+    uint32_t scene_count;
+    bench_scene_t scenes[BENCH_REPORT_MAX_SCENES];
+} report;
+
+/*============================================================================
+ * Scene tracking
+ *============================================================================*/
+
+static void report_scene_end(void)
+{
+    uint32_t elapsed = lv_tick_elaps(report.scene_start);
+
+    if (report.scene_count < BENCH_REPORT_MAX_SCENES) {
+        bench_scene_t *sc = &report.scenes[report.scene_count++];
+        sc->duration_ms = elapsed;
+        hpm_lvgl_spi_get_stats(&sc->stats);
+    }
+
+    hpm_lvgl_spi_reset_stats();
+    report.scene_start = lv_tick_get();
+}
+
+static void report_watch_delete_cb(lv_event_t *e)
+{
+    (void)e;
+
+    /* lv_demo_benchmark cleans the screen and builds the next scene in the same timer call. */
+    report.watch = NULL;
+    report.just_cleaned = true;
+    report_scene_end();
+}
+
+static void report_poll_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+
+    if (report.watch != NULL) {
+        return;
+    }
+
+    lv_obj_t *child = lv_obj_get_child(lv_screen_active(), 0);
+    if (child != NULL) {
+        /* Objects appearing on a screen that was not just cleaned: an empty scene ended. */
+        if (!report.just_cleaned) {
+            report_scene_end();
+        }
+        report.watch = child;
+        lv_obj_add_event_cb(child, report_watch_delete_cb, LV_EVENT_DELETE, NULL);
+    }
+    report.just_cleaned = false;
+}
+
+/*============================================================================
+ * Report
+ *============================================================================*/
+
+/* Limited by the SPI link when the bus is (nearly) always busy or rendering spends a
+ * significant share of the frame waiting for a draw buffer to come back from DMA. */
+static const char *report_limit(uint32_t bus_pct, uint64_t render_us, uint64_t wait_us)
+{
+    if ((bus_pct >= 80U) || ((wait_us * 2U) > render_us)) {
+        return "spi";
+    }
+    return "cpu";
+}
+
+static void report_print(void)
+{
+    uint32_t lines = 0;
+    bool double_buffer = false;
+
+    hpm_lvgl_spi_get_buffer_config(&lines, &double_buffer);
+
+    printf("# bench_report v1 scenes=%lu backend=%s fb_lines=%lu buffers=%u spi_hz=%lu\n",
+           (unsigned long)report.scene_count, hpm_lvgl_spi_get_backend_name(), (unsigned long)lines,
+           double_buffer ? 2U : 1U, (unsigned long)hpm_lvgl_spi_get_spi_freq());
+    printf("scene  time_ms  fps render_ms flushes flush/s KB/frame  bus%% wait_ms limit\n");
+
+    for (uint32_t i = 0; i < report.scene_count; i++) {
+        const bench_scene_t *sc = &report.scenes[i];
+        const hpm_lvgl_spi_stats_t *s = &sc->stats;
+        uint32_t ms = (sc->duration_ms != 0U) ? sc->duration_ms : 1U;
+        uint32_t frames = (s->frames_rendered != 0U) ? s->frames_rendered : 1U;
+        uint32_t fps_x10 = (s->frames_rendered * 10000U) / ms;
+        uint32_t render_us = (uint32_t)(s->render_us / frames);
+        uint32_t wait_us = (uint32_t)(s->wait_us / frames);
+        uint32_t flush_ps = (s->flush_count * 1000U) / ms;
+        uint32_t kb_frame_x10 = (uint32_t)((s->flush_bytes * 10U) / 1024U / frames);
+        uint32_t bus_pct = (uint32_t)((s->xfer_us * 100U) / ((uint64_t)ms * 1000U));
+
+        printf("%5lu %8lu %4lu.%lu %6lu.%02lu %7lu %7lu %6lu.%lu %5lu %4lu.%02lu %s\n", (unsigned long)i,
+               (unsigned long)sc->duration_ms, (unsigned long)(fps_x10 / 10U), (unsigned long)(fps_x10 % 10U),
+               (unsigned long)(render_us / 1000U), (unsigned long)((render_us % 1000U) / 10U),
+               (unsigned long)s->flush_count, (unsigned long)flush_ps, (unsigned long)(kb_frame_x10 / 10U),
+               (unsigned long)(kb_frame_x10 % 10U), (unsigned long)bus_pct, (unsigned long)(wait_us / 1000U),
+               (unsigned long)((wait_us % 1000U) / 10U), report_limit(bus_pct, s->render_us, s->wait_us));
+    }
+
+    printf("# bench_report end\n");
+}
+
+static void report_end_cb(const lv_demo_benchmark_summary_t *summary)
+{
+    lv_timer_delete(report.poll_timer);
+    report.poll_timer = NULL;
+    report.running = false;
+
+    /* Close the last scene unless its clean-up already did (the summary screen is not measured). */
+    if (report.watch != NULL) {
+        lv_obj_remove_event_cb(report.watch, report_watch_delete_cb);
+        report.watch = NULL;
+    }
+    if (lv_tick_elaps(report.scene_start) > BENCH_REPORT_POLL_MS) {
+        report_scene_end();
+    }
+
+    /* LVGL's per-scene table (names, CPU, FPS, render/flush time) in the same scene order */
+    lv_demo_benchmark_summary_display(summary);
+    report_print();
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+void bench_report_start(void)
+{
+    if (report.running) {
+        return;
+    }
+
+    memset(&report, 0, sizeof(report));
+    report.running = true;
+    report.just_cleaned = true;
+
+    hpm_lvgl_spi_reset_stats();
+    report.scene_start = lv_tick_get();
+    report.poll_timer = lv_timer_create(report_poll_timer_cb, BENCH_REPORT_POLL_MS, NULL);
+
+    lv_demo_benchmark_set_end_cb(report_end_cb);
+    lv_demo_benchmark();
+}
+
+bool bench_report_is_running(void)
+{
+    return report.running;
+}
+
+#endif /* LV_USE_DEMO_BENCHMARK */
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * lv_demo_benchmark report with SPI driver statistics
+ *
+ * Runs every lv_demo_benchmark scene and splits the adapter statistics at scene
+ * boundaries (the benchmark cleans the active screen before each scene). When the
+ * benchmark ends, LVGL's own summary is shown/logged as usual and a combined table
+ * (render time next to flush count, bytes, bus utilization and DMA wait) is printed
+ * over the console UART, with the resource each scene is limited by.
+ */
+
+#ifndef BENCH_REPORT_H
+#define BENCH_REPORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef BENCH_REPORT_MAX_SCENES
+#define BENCH_REPORT_MAX_SCENES     32
+#endif
+
+/* Scene boundary polling period (ms) */
+#ifndef BENCH_REPORT_POLL_MS
+#define BENCH_REPORT_POLL_MS        10
+#endif
+
+/**
+ * @brief Start lv_demo_benchmark in report mode (call on a clean active screen)
+ */
+void bench_report_start(void);
+
+/**
+ * @brief true while the benchmark is running
+ */
+bool bench_report_is_running(void);
+
+#endif /* BENCH_REPORT_H */
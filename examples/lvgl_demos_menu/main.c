@@ -3,6 +3,9 @@
  *
  * This example is inspired by HPM SDK `samples/lvgl/common/lvgl.c`,
  * but uses a responsive layout that works on narrow screens such as 172x320.
+ *
+ * "bench report" runs lv_demo_benchmark and prints a per-scene table that joins
+ * LVGL's render time with the SPI driver's flush/bus/DMA-wait statistics.
  */
 
 #include <stdbool.h>
@@ -10,6 +13,7 @@
 
 #include "board.h"
 #include "hpm_lvgl_spi.h"
+#include "bench_report.h"
 
 #include <lvgl.h>
 #include <demos/lv_demos.h>
@@ -28,6 +32,7 @@ static demo_info_t demo_infos[] = {
 #endif
 #if LV_USE_DEMO_BENCHMARK
     { "benchmark", lv_demo_benchmark },
+    { "bench report", bench_report_start },
 #endif
 #if LV_USE_DEMO_STRESS
     { "stress", lv_demo_stress },
@@ -132,6 +137,15 @@ static void create_menu(void)
     }
 }
 
+#if HPM_LVGL_HEATMAP_ENABLE
+static void heatmap_dump_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    hpm_lvgl_heatmap_dump();
+    hpm_lvgl_heatmap_reset();
+}
+#endif
+
 int main(void)
 {
     board_init();
@@ -147,9 +161,13 @@ int main(void)
 
     create_menu();
 
+#if HPM_LVGL_HEATMAP_ENABLE
+    /* No keys in this example: print the flush heatmap periodically. */
+    lv_timer_create(heatmap_dump_timer_cb, 10000, NULL);
+#endif
+
     while (1) {
-        lv_timer_handler();
-        board_delay_us(1000);
+        hpm_lvgl_spi_run_once(HPM_LVGL_RUN_MAX_SLEEP_MS);
     }
 }
 
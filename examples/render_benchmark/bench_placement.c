@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Draw buffer placement comparison implementation
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "hpm_lvgl_spi.h"
+#include "bench_workloads.h"
+#include "bench_placement.h"
+
+/* Two runs per workload: non-cacheable first, then cacheable */
+#define PLACEMENT_RUNS      ((uint32_t)BENCH_MODE_COUNT * 2U)
+
+typedef enum {
+    PLACEMENT_IDLE = 0,
+    PLACEMENT_WARMUP,
+    PLACEMENT_MEASURE,
+} placement_state_t;
+
+/*============================================================================
+ * Private data
+ *============================================================================*/
+
+static struct {
+    placement_state_t state;
+    lv_timer_t *anim_timer;
+    uint32_t index;
+    uint32_t phase_start;
+    bool saved_cacheable;
+
+    /* Non-cacheable run of the current workload */
+    uint32_t nc_render_us;
+    uint32_t nc_fps_x10;
+
+    /* Sums over all workloads */
+    uint64_t total_nc_us;
+    uint64_t total_c_us;
+} place;
+
+/*============================================================================
+ * Measurement
+ *============================================================================*/
+
+static void placement_begin_run(void)
+{
+    bench_mode_t mode = (bench_mode_t)(place.index / 2U);
+    bool cacheable = ((place.index % 2U) != 0U);
+
+    (void)hpm_lvgl_spi_set_fb_cacheable(cacheable);
+    if (!cacheable) {
+        bench_workloads_set_mode(mode);
+    }
+
+    place.state = PLACEMENT_WARMUP;
+    place.phase_start = lv_tick_get();
+}
+
+static void placement_report_run(uint32_t dt_ms)
+{
+    hpm_lvgl_spi_stats_t s;
+    bench_mode_t mode = (bench_mode_t)(place.index / 2U);
+
+    hpm_lvgl_spi_get_stats(&s);
+
+    if (dt_ms == 0U) {
+        dt_ms = 1U;
+    }
+    uint32_t frames = s.frames_rendered;
+    uint32_t render_us = (frames > 0U) ? (uint32_t)(s.render_us / frames) : 0U;
+    uint32_t fps_x10 = (frames * 10000U) / dt_ms;
+
+    if ((place.index % 2U) == 0U) {
+        place.nc_render_us = render_us;
+        place.nc_fps_x10 = fps_x10;
+        return;
+    }
+
+    /* Render time of the cacheable run relative to the non-cacheable one (percent) */
+    uint32_t ratio_pct = (place.nc_render_us > 0U) ? ((render_us * 100U) / place.nc_render_us) : 0U;
+
+    place.total_nc_us += place.nc_render_us;
+    place.total_c_us += render_us;
+
+    printf("%-8s | %4lu.%02lu %4lu.%lu | %4lu.%02lu %4lu.%lu | %4lu%%\n", bench_mode_name(mode),
+           (unsigned long)(place.nc_render_us / 1000U), (unsigned long)((place.nc_render_us % 1000U) / 10U),
+           (unsigned long)(place.nc_fps_x10 / 10U), (unsigned long)(place.nc_fps_x10 % 10U),
+           (unsigned long)(render_us / 1000U), (unsigned long)((render_us % 1000U) / 10U),
+           (unsigned long)(fps_x10 / 10U), (unsigned long)(fps_x10 % 10U), (unsigned long)ratio_pct);
+}
+
+static void placement_restore(void)
+{
+    (void)hpm_lvgl_spi_set_fb_cacheable(place.saved_cacheable);
+    place.state = PLACEMENT_IDLE;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+bool bench_placement_start(lv_timer_t *anim_timer)
+{
+    uint32_t lines = 0;
+    bool double_buffer = false;
+
+#if !HPM_LVGL_FB_PLACEMENT_AB
+    (void)anim_timer;
+    (void)lines;
+    (void)double_buffer;
+    printf("# bench_placement needs HPM_LVGL_FB_PLACEMENT_AB=1\n");
+    return false;
+#else
+
+    memset(&place, 0, sizeof(place));
+    place.anim_timer = anim_timer;
+    place.saved_cacheable = hpm_lvgl_spi_get_fb_cacheable();
+    lv_timer_set_period(anim_timer, BENCH_ANIM_PERIOD_MS);
+    hpm_lvgl_spi_get_buffer_config(&lines, &double_buffer);
+
+    printf("# bench_placement v1 modes=%u warmup_ms=%lu measure_ms=%lu fb_lines=%lu buffers=%u backend=%s\n",
+           (unsigned int)BENCH_MODE_COUNT, (unsigned long)BENCH_PLACEMENT_WARMUP_MS,
+           (unsigned long)BENCH_PLACEMENT_MEASURE_MS, (unsigned long)lines, double_buffer ? 2U : 1U,
+           hpm_lvgl_spi_get_backend_name());
+    printf("mode     | noncache render_ms  fps | cacheable render_ms  fps | render c/nc\n");
+
+    placement_begin_run();
+    return true;
+#endif
+}
+
+bool bench_placement_poll(void)
+{
+    uint32_t elapsed;
+
+    if (place.state == PLACEMENT_IDLE) {
+        return false;
+    }
+
+    elapsed = lv_tick_elaps(place.phase_start);
+
+    if (place.state == PLACEMENT_WARMUP) {
+        if (elapsed >= BENCH_PLACEMENT_WARMUP_MS) {
+            hpm_lvgl_spi_reset_stats();
+            place.state = PLACEMENT_MEASURE;
+            place.phase_start = lv_tick_get();
+        }
+        return true;
+    }
+
+    if (elapsed < BENCH_PLACEMENT_MEASURE_MS) {
+        return true;
+    }
+
+    placement_report_run(elapsed);
+
+    place.index++;
+    if (place.index >= PLACEMENT_RUNS) {
+        uint32_t total_pct = (place.total_nc_us > 0U) ? (uint32_t)((place.total_c_us * 100U) / place.total_nc_us) : 0U;
+        printf("# bench_placement total render c/nc %lu%%\n", (unsigned long)total_pct);
+        printf("# bench_placement end\n");
+        placement_restore();
+        return false;
+    }
+
+    placement_begin_run();
+    return true;
+}
+
+void bench_placement_abort(void)
+{
+    if (place.state == PLACEMENT_IDLE) {
+        return;
+    }
+
+    printf("# bench_placement aborted at run %lu\n", (unsigned long)place.index);
+    placement_restore();
+}
+
+uint32_t bench_placement_progress(uint32_t *total)
+{
+    if (total != NULL) {
+        *total = PLACEMENT_RUNS;
+    }
+    return place.index;
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Draw buffer placement comparison for the render benchmark
+ *
+ * Runs every workload on the non-cacheable and on the cacheable draw buffers
+ * (hpm_lvgl_spi_set_fb_cacheable(), needs HPM_LVGL_FB_PLACEMENT_AB=1), back to back,
+ * and prints the per-frame render time of both and their ratio over the console UART.
+ */
+
+#ifndef BENCH_PLACEMENT_H
+#define BENCH_PLACEMENT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl.h"
+
+#ifndef BENCH_PLACEMENT_WARMUP_MS
+#define BENCH_PLACEMENT_WARMUP_MS   300
+#endif
+
+#ifndef BENCH_PLACEMENT_MEASURE_MS
+#define BENCH_PLACEMENT_MEASURE_MS  1500
+#endif
+
+/**
+ * @brief Start the comparison (does nothing without HPM_LVGL_FB_PLACEMENT_AB)
+ * @param anim_timer Timer driving bench_workloads_step()
+ * @return true if started
+ */
+bool bench_placement_start(lv_timer_t *anim_timer);
+
+/**
+ * @brief Advance the comparison; call from the main loop next to lv_timer_handler()
+ * @return true while it is running
+ */
+bool bench_placement_poll(void);
+
+/**
+ * @brief Stop the comparison and restore the initial placement
+ */
+void bench_placement_abort(void);
+
+/**
+ * @brief Current run index (0-based)
+ * @param total Number of runs (may be NULL)
+ */
+uint32_t bench_placement_progress(uint32_t *total);
+
+#endif /* BENCH_PLACEMENT_H */
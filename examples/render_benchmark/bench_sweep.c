@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Parametric scaling sweep implementation
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "hpm_lvgl_spi.h"
+#include "bench_workloads.h"
+#include "bench_sweep.h"
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+/*============================================================================
+ * Sweep axes
+ *============================================================================*/
+
+static const uint16_t sweep_period_ms[] = { 16, 33, 66 };
+static const uint16_t sweep_dot_count[] = { 1, 2, 4, 8, 16, 32, 64 };
+static const uint16_t sweep_dot_size[] = { 8, 16, 32 };
+static const uint16_t sweep_stripe_w[] = { 8, 22, 48, 96, 160 };
+
+/* Per period: FULL reference first, then SCATTER count x size, then STRIPE widths */
+#define SWEEP_PER_PERIOD    (1U + ARRAY_SIZE(sweep_dot_count) * ARRAY_SIZE(sweep_dot_size) + ARRAY_SIZE(sweep_stripe_w))
+#define SWEEP_POINTS        (ARRAY_SIZE(sweep_period_ms) * SWEEP_PER_PERIOD)
+
+typedef enum {
+    SWEEP_IDLE = 0,
+    SWEEP_WARMUP,
+    SWEEP_MEASURE,
+} sweep_state_t;
+
+typedef struct {
+    bench_mode_t mode;
+    bench_params_t params;
+    uint32_t period_ms;
+} sweep_point_t;
+
+/*============================================================================
+ * Private data
+ *============================================================================*/
+
+static struct {
+    sweep_state_t state;
+    lv_timer_t *anim_timer;
+    uint32_t index;
+    uint32_t phase_start;
+    bench_params_t saved_params;
+
+    /* Reference and knees for the current period */
+    uint32_t full_frame_us;
+    uint16_t knee_count[ARRAY_SIZE(sweep_period_ms)][ARRAY_SIZE(sweep_dot_size)];
+    uint16_t knee_stripe_w[ARRAY_SIZE(sweep_period_ms)];
+} sweep;
+
+static void sweep_get_point(uint32_t index, sweep_point_t *p)
+{
+    uint32_t period_idx = index / SWEEP_PER_PERIOD;
+    uint32_t i = index % SWEEP_PER_PERIOD;
+    bench_params_t defaults = BENCH_PARAMS_DEFAULT;
+
+    p->params = defaults;
+    p->period_ms = sweep_period_ms[period_idx];
+
+    if (i == 0U) {
+        p->mode = BENCH_MODE_FULL;
+        return;
+    }
+    i--;
+
+    if (i < (ARRAY_SIZE(sweep_dot_count) * ARRAY_SIZE(sweep_dot_size))) {
+        p->mode = BENCH_MODE_SCATTER;
+        p->params.dot_size = sweep_dot_size[i / ARRAY_SIZE(sweep_dot_count)];
+        p->params.dot_count = sweep_dot_count[i % ARRAY_SIZE(sweep_dot_count)];
+        return;
+    }
+    i -= ARRAY_SIZE(sweep_dot_count) * ARRAY_SIZE(sweep_dot_size);
+
+    p->mode = BENCH_MODE_STRIPE;
+    p->params.stripe_w = sweep_stripe_w[i];
+}
+
+/*============================================================================
+ * Measurement
+ *============================================================================*/
+
+static void sweep_begin_point(void)
+{
+    sweep_point_t p;
+
+    sweep_get_point(sweep.index, &p);
+
+    bench_workloads_set_params(&p.params);
+    bench_workloads_set_mode(p.mode);
+    lv_timer_set_period(sweep.anim_timer, p.period_ms);
+
+    sweep.state = SWEEP_WARMUP;
+    sweep.phase_start = lv_tick_get();
+}
+
+static void sweep_report_point(uint32_t dt_ms)
+{
+    hpm_lvgl_spi_stats_t s;
+    sweep_point_t p;
+    uint32_t period_idx = sweep.index / SWEEP_PER_PERIOD;
+    const char *mark = "";
+
+    hpm_lvgl_spi_get_stats(&s);
+    sweep_get_point(sweep.index, &p);
+    bench_workloads_get_params(&p.params);  /* clamped values */
+
+    if (dt_ms == 0U) {
+        dt_ms = 1U;
+    }
+    uint32_t frames = s.frames_rendered;
+    uint32_t fps_x10 = (frames * 10000U) / dt_ms;
+    uint32_t flush_ps = (s.flush_count * 1000U) / dt_ms;
+    uint32_t kb_ps = (uint32_t)((s.flush_bytes * 1000ULL) / (uint64_t)dt_ms / 1024ULL);
+    uint32_t frame_us = (frames > 0U) ? (uint32_t)(s.frame_us / frames) : 0U;
+    uint32_t kb_frame_x10 = (frames > 0U) ? (uint32_t)((s.flush_bytes * 10ULL) / 1024ULL / frames) : 0U;
+    uint32_t vs_full_pct = 0;
+
+    if (p.mode == BENCH_MODE_FULL) {
+        sweep.full_frame_us = frame_us;
+        vs_full_pct = 100U;
+    } else if (sweep.full_frame_us > 0U) {
+        vs_full_pct = (frame_us * 100U) / sweep.full_frame_us;
+    }
+
+    /* Knee: first point of a series whose frame costs as much as a full redraw */
+    if ((p.mode != BENCH_MODE_FULL) && (vs_full_pct >= 100U)) {
+        if (p.mode == BENCH_MODE_SCATTER) {
+            for (uint32_t k = 0; k < ARRAY_SIZE(sweep_dot_size); k++) {
+                if ((sweep_dot_size[k] == p.params.dot_size) && (sweep.knee_count[period_idx][k] == 0U)) {
+                    sweep.knee_count[period_idx][k] = p.params.dot_count;
+                    mark = "  <- knee";
+                }
+            }
+        } else if (sweep.knee_stripe_w[period_idx] == 0U) {
+            sweep.knee_stripe_w[period_idx] = p.params.stripe_w;
+            mark = "  <- knee";
+        }
+    }
+
+    printf("%-8s %5u %4u %6lu | %4lu.%lu %7lu %6lu %5lu.%02lu %5lu.%lu %4lu.%02lu%s\n",
+           bench_mode_name(p.mode),
+           (unsigned int)((p.mode == BENCH_MODE_SCATTER) ? p.params.dot_count : 1U),
+           (unsigned int)((p.mode == BENCH_MODE_SCATTER) ? p.params.dot_size
+                          : ((p.mode == BENCH_MODE_STRIPE) ? p.params.stripe_w : 0U)),
+           (unsigned long)p.period_ms,
+           (unsigned long)(fps_x10 / 10U), (unsigned long)(fps_x10 % 10U),
+           (unsigned long)flush_ps, (unsigned long)kb_ps,
+           (unsigned long)(frame_us / 1000U), (unsigned long)((frame_us % 1000U) / 10U),
+           (unsigned long)(kb_frame_x10 / 10U), (unsigned long)(kb_frame_x10 % 10U),
+           (unsigned long)(vs_full_pct / 100U), (unsigned long)(vs_full_pct % 100U), mark);
+}
+
+static void sweep_print_summary(void)
+{
+    for (uint32_t r = 0; r < ARRAY_SIZE(sweep_period_ms); r++) {
+        for (uint32_t k = 0; k < ARRAY_SIZE(sweep_dot_size); k++) {
+            if (sweep.knee_count[r][k] != 0U) {
+                printf("# knee period_ms=%u SCATTER size=%u count>=%u\n", (unsigned int)sweep_period_ms[r],
+                       (unsigned int)sweep_dot_size[k], (unsigned int)sweep.knee_count[r][k]);
+            } else {
+                printf("# knee period_ms=%u SCATTER size=%u none (partial cheaper up to count=%u)\n",
+                       (unsigned int)sweep_period_ms[r], (unsigned int)sweep_dot_size[k],
+                       (unsigned int)sweep_dot_count[ARRAY_SIZE(sweep_dot_count) - 1U]);
+            }
+        }
+        if (sweep.knee_stripe_w[r] != 0U) {
+            printf("# knee period_ms=%u STRIPE width>=%u\n", (unsigned int)sweep_period_ms[r],
+                   (unsigned int)sweep.knee_stripe_w[r]);
+        } else {
+            printf("# knee period_ms=%u STRIPE none\n", (unsigned int)sweep_period_ms[r]);
+        }
+    }
+    printf("# bench_sweep end\n");
+}
+
+static void sweep_restore(void)
+{
+    bench_workloads_set_params(&sweep.saved_params);
+    if (sweep.anim_timer != NULL) {
+        lv_timer_set_period(sweep.anim_timer, BENCH_ANIM_PERIOD_MS);
+    }
+    sweep.state = SWEEP_IDLE;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+void bench_sweep_start(lv_timer_t *anim_timer)
+{
+    uint32_t lines = 0;
+    bool double_buffer = false;
+
+    memset(&sweep, 0, sizeof(sweep));
+    sweep.anim_timer = anim_timer;
+    bench_workloads_get_params(&sweep.saved_params);
+    hpm_lvgl_spi_get_buffer_config(&lines, &double_buffer);
+
+    printf("# bench_sweep v1 points=%lu warmup_ms=%lu measure_ms=%lu fb_lines=%lu buffers=%u spi_hz=%lu\n",
+           (unsigned long)SWEEP_POINTS, (unsigned long)BENCH_SWEEP_WARMUP_MS, (unsigned long)BENCH_SWEEP_MEASURE_MS,
+           (unsigned long)lines, double_buffer ? 2U : 1U, (unsigned long)hpm_lvgl_spi_get_spi_freq());
+    printf("mode     count size period |  fps flush/s   KB/s frame_ms KB/frame vs_full\n");
+
+    sweep_begin_point();
+}
+
+bool bench_sweep_poll(void)
+{
+    uint32_t elapsed;
+
+    if (sweep.state == SWEEP_IDLE) {
+        return false;
+    }
+
+    elapsed = lv_tick_elaps(sweep.phase_start);
+
+    if (sweep.state == SWEEP_WARMUP) {
+        if (elapsed >= BENCH_SWEEP_WARMUP_MS) {
+            hpm_lvgl_spi_reset_stats();
+            sweep.state = SWEEP_MEASURE;
+            sweep.phase_start = lv_tick_get();
+        }
+        return true;
+    }
+
+    if (elapsed < BENCH_SWEEP_MEASURE_MS) {
+        return true;
+    }
+
+    sweep_report_point(elapsed);
+
+    sweep.index++;
+    if (sweep.index >= SWEEP_POINTS) {
+        sweep_print_summary();
+        sweep_restore();
+        return false;
+    }
+
+    sweep_begin_point();
+    return true;
+}
+
+void bench_sweep_abort(void)
+{
+    if (sweep.state == SWEEP_IDLE) {
+        return;
+    }
+
+    printf("# bench_sweep aborted at point %lu\n", (unsigned long)sweep.index);
+    sweep_restore();
+}
+
+uint32_t bench_sweep_progress(uint32_t *total)
+{
+    if (total != NULL) {
+        *total = SWEEP_POINTS;
+    }
+    return sweep.index;
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Parametric scaling sweep for the render benchmark
+ *
+ * Steps SCATTER (object count x object size), STRIPE (object width) and the FULL
+ * reference through a table of points, each at several animation rates. Every point
+ * is measured for a fixed time and printed as one table row over the console UART;
+ * a summary names the knee where partial refresh costs as much as a full redraw.
+ */
+
+#ifndef BENCH_SWEEP_H
+#define BENCH_SWEEP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl.h"
+
+#ifndef BENCH_SWEEP_WARMUP_MS
+#define BENCH_SWEEP_WARMUP_MS   300
+#endif
+
+#ifndef BENCH_SWEEP_MEASURE_MS
+#define BENCH_SWEEP_MEASURE_MS  1000
+#endif
+
+/**
+ * @brief Start the sweep
+ * @param anim_timer Timer driving bench_workloads_step(); its period is the swept update rate
+ */
+void bench_sweep_start(lv_timer_t *anim_timer);
+
+/**
+ * @brief Advance the sweep; call from the main loop next to lv_timer_handler()
+ * @return true while the sweep is running
+ */
+bool bench_sweep_poll(void);
+
+/**
+ * @brief Stop the sweep and restore the default workload geometry and rate
+ */
+void bench_sweep_abort(void);
+
+/**
+ * @brief Current point index (0-based)
+ * @param total Number of points (may be NULL)
+ */
+uint32_t bench_sweep_progress(uint32_t *total);
+
+#endif /* BENCH_SWEEP_H */
@@ -0,0 +1,661 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Render benchmark workloads
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bench_workloads.h"
+
+#define TEXT_LINES  40
+#define IMG_COUNT   4           /* Even indices opaque RGB565, odd ARGB8888 */
+#define IMG_SIZE    48
+#define PANEL_COUNT 3
+#define ARC_COUNT   3
+#define CHART_POINTS 48
+
+/* Colors */
+#define COLOR_TEXT      lv_color_hex(0xeaeaea)
+#define COLOR_ACCENT    lv_color_hex(0x3b82f6)
+
+static struct {
+    bench_mode_t mode;
+    lv_obj_t *content;
+
+    /* Scatter */
+    lv_obj_t *dots[BENCH_DOT_MAX];
+    int16_t dot_x[BENCH_DOT_MAX];
+    int16_t dot_y[BENCH_DOT_MAX];
+    int8_t dot_vx[BENCH_DOT_MAX];
+    int8_t dot_vy[BENCH_DOT_MAX];
+
+    /* Stripe */
+    lv_obj_t *stripe;
+    int16_t stripe_x;
+    int8_t stripe_vx;
+
+    /* Full refresh */
+    lv_obj_t *full_bg;
+    uint32_t full_color_step;
+
+    /* Text scroll */
+    lv_obj_t *text_label;
+    int32_t text_y;
+    int32_t text_h;
+
+    /* Image blit */
+    lv_obj_t *images[IMG_COUNT];
+    int16_t img_x[IMG_COUNT];
+    int16_t img_y[IMG_COUNT];
+    int8_t img_vx[IMG_COUNT];
+    int8_t img_vy[IMG_COUNT];
+
+    /* Alpha panels */
+    lv_obj_t *panels[PANEL_COUNT];
+    uint32_t panel_phase;
+
+    /* Arcs */
+    lv_obj_t *arcs[ARC_COUNT];
+    uint32_t arc_step;
+
+    /* Gradient */
+    lv_obj_t *grad_bg;
+    uint32_t grad_step;
+
+    /* Chart */
+    lv_obj_t *chart;
+    lv_chart_series_t *chart_ser[2];
+    uint32_t chart_seed;
+} wl;
+
+/* Geometry of the parametric workloads; survives mode switches */
+static bench_params_t wl_params = BENCH_PARAMS_DEFAULT;
+
+/* Image sources, generated once (deterministic patterns) */
+static uint16_t img_rgb565_map[IMG_SIZE * IMG_SIZE];
+static uint32_t img_argb_map[IMG_SIZE * IMG_SIZE];
+static lv_image_dsc_t img_rgb565;
+static lv_image_dsc_t img_argb;
+
+const char *bench_mode_name(bench_mode_t mode)
+{
+    switch (mode) {
+    case BENCH_MODE_SCATTER:
+        return "SCATTER";
+    case BENCH_MODE_STRIPE:
+        return "STRIPE";
+    case BENCH_MODE_FULL:
+        return "FULL";
+    case BENCH_MODE_TEXT:
+        return "TEXT";
+    case BENCH_MODE_IMAGE:
+        return "IMAGE";
+    case BENCH_MODE_ALPHA:
+        return "ALPHA";
+    case BENCH_MODE_ARC:
+        return "ARC";
+    case BENCH_MODE_GRADIENT:
+        return "GRADIENT";
+    case BENCH_MODE_CHART:
+        return "CHART";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+/*============================================================================
+ * Workload builders
+ *============================================================================*/
+
+static void bench_build_scatter(void)
+{
+    int16_t w = (int16_t)lv_obj_get_width(wl.content);
+    int16_t h = (int16_t)lv_obj_get_height(wl.content);
+
+    int16_t size = (int16_t)wl_params.dot_size;
+
+    for (uint32_t i = 0; i < wl_params.dot_count; i++) {
+        lv_obj_t *dot = lv_obj_create(wl.content);
+        lv_obj_remove_style_all(dot);
+        lv_obj_set_size(dot, size, size);
+        lv_obj_set_style_radius(dot, LV_RADIUS_CIRCLE, 0);
+        lv_obj_set_style_bg_opa(dot, LV_OPA_COVER, 0);
+
+        /* Color cycle */
+        uint32_t c = 0x22ccff;
+        if ((i % 3) == 1) {
+            c = 0x22ff88;
+        } else if ((i % 3) == 2) {
+            c = 0xff4477;
+        }
+        lv_obj_set_style_bg_color(dot, lv_color_hex(c), 0);
+
+        /* Deterministic pseudo-random init */
+        int16_t x = (int16_t)((i * 37U) % (uint32_t)(w - size));
+        int16_t y = (int16_t)((i * 61U) % (uint32_t)(h - size));
+        int8_t vx = (int8_t)((i % 3) + 1);
+        int8_t vy = (int8_t)(((i + 1) % 3) + 1);
+        if (i & 0x1U) {
+            vx = -vx;
+        }
+        if (i & 0x2U) {
+            vy = -vy;
+        }
+
+        wl.dots[i] = dot;
+        wl.dot_x[i] = x;
+        wl.dot_y[i] = y;
+        wl.dot_vx[i] = vx;
+        wl.dot_vy[i] = vy;
+
+        lv_obj_set_pos(dot, x, y);
+    }
+}
+
+static void bench_build_stripe(void)
+{
+    int16_t w = (int16_t)lv_obj_get_width(wl.content);
+    int16_t h = (int16_t)lv_obj_get_height(wl.content);
+
+    wl.stripe = lv_obj_create(wl.content);
+    lv_obj_remove_style_all(wl.stripe);
+    lv_obj_set_size(wl.stripe, wl_params.stripe_w, h);
+    lv_obj_set_style_bg_opa(wl.stripe, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(wl.stripe, COLOR_ACCENT, 0);
+    lv_obj_set_style_radius(wl.stripe, 6, 0);
+
+    wl.stripe_x = 0;
+    wl.stripe_vx = 3;
+    lv_obj_set_pos(wl.stripe, wl.stripe_x, 0);
+
+    /* Add a few static widgets to mimic dashboard workload */
+    lv_obj_t *lbl = lv_label_create(wl.content);
+    lv_obj_set_style_text_color(lbl, COLOR_TEXT, 0);
+    lv_obj_set_style_text_font(lbl, &lv_font_montserrat_12, 0);
+    lv_obj_align(lbl, LV_ALIGN_TOP_LEFT, 6, 6);
+    lv_label_set_text(lbl, "Stripe moves (partial)");
+
+    lv_obj_t *bar = lv_bar_create(wl.content);
+    lv_obj_set_size(bar, w - 12, 10);
+    lv_obj_align(bar, LV_ALIGN_BOTTOM_MID, 0, -10);
+    lv_bar_set_range(bar, 0, 100);
+    lv_bar_set_value(bar, 75, LV_ANIM_OFF);
+}
+
+static void bench_build_full(void)
+{
+    int16_t w = (int16_t)lv_obj_get_width(wl.content);
+    int16_t h = (int16_t)lv_obj_get_height(wl.content);
+
+    wl.full_bg = lv_obj_create(wl.content);
+    lv_obj_remove_style_all(wl.full_bg);
+    lv_obj_set_size(wl.full_bg, w, h);
+    lv_obj_set_style_bg_opa(wl.full_bg, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(wl.full_bg, lv_color_hex(0x112233), 0);
+
+    wl.full_color_step = 0;
+
+    lv_obj_t *lbl = lv_label_create(wl.full_bg);
+    lv_obj_set_style_text_color(lbl, COLOR_TEXT, 0);
+    lv_obj_set_style_text_font(lbl, &lv_font_montserrat_12, 0);
+    lv_obj_center(lbl);
+    lv_label_set_text(lbl, "Full-area redraw");
+}
+
+static void bench_build_text(void)
+{
+    static char text[TEXT_LINES * 40];
+    uint32_t len = 0;
+    int16_t w = (int16_t)lv_obj_get_width(wl.content);
+
+    for (uint32_t i = 0; i < TEXT_LINES; i++) {
+        len += (uint32_t)snprintf(&text[len], sizeof(text) - len, "%02lu  Lorem ipsum %lu.%02lu dolor\n",
+                                  (unsigned long)i, (unsigned long)(i * 37U % 100U), (unsigned long)(i * 53U % 100U));
+    }
+
+    wl.text_label = lv_label_create(wl.content);
+    lv_obj_set_width(wl.text_label, w - 12);
+    lv_obj_set_style_text_color(wl.text_label, COLOR_TEXT, 0);
+    lv_obj_set_style_text_font(wl.text_label, &lv_font_montserrat_14, 0);
+    lv_label_set_text(wl.text_label, text);
+    lv_obj_set_pos(wl.text_label, 6, 0);
+
+    lv_obj_update_layout(wl.text_label);
+    wl.text_h = lv_obj_get_height(wl.text_label);
+    wl.text_y = 0;
+}
+
+static void bench_image_init(void)
+{
+    if (img_rgb565.data != NULL) {
+        return;
+    }
+
+    /* Opaque: diagonal color ramp with a checker pattern */
+    for (uint32_t y = 0; y < IMG_SIZE; y++) {
+        for (uint32_t x = 0; x < IMG_SIZE; x++) {
+            uint32_t r = (x * 31U) / (IMG_SIZE - 1U);
+            uint32_t g = ((x + y) * 63U) / (2U * (IMG_SIZE - 1U));
+            uint32_t b = (((x >> 3) ^ (y >> 3)) & 1U) ? 31U : 8U;
+            img_rgb565_map[y * IMG_SIZE + x] = (uint16_t)((r << 11) | (g << 5) | b);
+        }
+    }
+
+    /* ARGB8888: soft disc, alpha falling off towards the edge */
+    for (uint32_t y = 0; y < IMG_SIZE; y++) {
+        for (uint32_t x = 0; x < IMG_SIZE; x++) {
+            int32_t dx = (int32_t)(x * 2U) - (IMG_SIZE - 1);
+            int32_t dy = (int32_t)(y * 2U) - (IMG_SIZE - 1);
+            uint32_t d2 = (uint32_t)(dx * dx + dy * dy);
+            uint32_t r2 = (uint32_t)(IMG_SIZE * IMG_SIZE);
+            uint32_t a = (d2 >= r2) ? 0U : (255U - (d2 * 255U) / r2);
+            img_argb_map[y * IMG_SIZE + x] = (a << 24) | (0xffU << 16) | ((x * 255U / IMG_SIZE) << 8) | 0x40U;
+        }
+    }
+
+    img_rgb565.header.magic = LV_IMAGE_HEADER_MAGIC;
+    img_rgb565.header.cf = LV_COLOR_FORMAT_RGB565;
+    img_rgb565.header.w = IMG_SIZE;
+    img_rgb565.header.h = IMG_SIZE;
+    img_rgb565.header.stride = IMG_SIZE * 2U;
+    img_rgb565.data_size = sizeof(img_rgb565_map);
+    img_rgb565.data = (const uint8_t *)img_rgb565_map;
+
+    img_argb.header.magic = LV_IMAGE_HEADER_MAGIC;
+    img_argb.header.cf = LV_COLOR_FORMAT_ARGB8888;
+    img_argb.header.w = IMG_SIZE;
+    img_argb.header.h = IMG_SIZE;
+    img_argb.header.stride = IMG_SIZE * 4U;
+    img_argb.data_size = sizeof(img_argb_map);
+    img_argb.data = (const uint8_t *)img_argb_map;
+}
+
+static void bench_build_image(void)
+{
+    int16_t w = (int16_t)lv_obj_get_width(wl.content);
+    int16_t h = (int16_t)lv_obj_get_height(wl.content);
+
+    bench_image_init();
+
+    for (uint32_t i = 0; i < IMG_COUNT; i++) {
+        lv_obj_t *img = lv_image_create(wl.content);
+        lv_image_set_src(img, ((i & 1U) == 0U) ? &img_rgb565 : &img_argb);
+
+        wl.images[i] = img;
+        wl.img_x[i] = (int16_t)((i * 41U) % (uint32_t)(w - IMG_SIZE));
+        wl.img_y[i] = (int16_t)((i * 67U) % (uint32_t)(h - IMG_SIZE));
+        wl.img_vx[i] = (int8_t)((i & 1U) ? -2 : 3);
+        wl.img_vy[i] = (int8_t)((i & 2U) ? -3 : 2);
+        lv_obj_set_pos(img, wl.img_x[i], wl.img_y[i]);
+    }
+}
+
+static void bench_build_alpha(void)
+{
+    static const uint32_t colors[PANEL_COUNT] = { 0xff4477, 0x22ff88, 0x3b82f6 };
+    int16_t w = (int16_t)lv_obj_get_width(wl.content);
+    int16_t h = (int16_t)lv_obj_get_height(wl.content);
+
+    /* Static content below, so every panel blends against something */
+    lv_obj_t *lbl = lv_label_create(wl.content);
+    lv_obj_set_style_text_color(lbl, COLOR_TEXT, 0);
+    lv_obj_set_style_text_font(lbl, &lv_font_montserrat_12, 0);
+    lv_obj_center(lbl);
+    lv_label_set_text(lbl, "Alpha blended panels\nover static text");
+
+    for (uint32_t i = 0; i < PANEL_COUNT; i++) {
+        lv_obj_t *p = lv_obj_create(wl.content);
+        lv_obj_remove_style_all(p);
+        lv_obj_set_size(p, (w * 3) / 5, h / 3);
+        lv_obj_set_style_radius(p, 10, 0);
+        lv_obj_set_style_bg_opa(p, LV_OPA_50, 0);
+        lv_obj_set_style_bg_color(p, lv_color_hex(colors[i]), 0);
+        wl.panels[i] = p;
+    }
+    wl.panel_phase = 0;
+}
+
+static void bench_build_arc(void)
+{
+    int16_t w = (int16_t)lv_obj_get_width(wl.content);
+    int32_t size = (w * 3) / 4;
+
+    for (uint32_t i = 0; i < ARC_COUNT; i++) {
+        lv_obj_t *arc = lv_arc_create(wl.content);
+        int32_t s = size - (int32_t)i * 36;
+
+        lv_obj_set_size(arc, s, s);
+        lv_obj_center(arc);
+        lv_obj_remove_style(arc, NULL, LV_PART_KNOB);
+        lv_obj_remove_flag(arc, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_set_style_arc_width(arc, 10, LV_PART_MAIN);
+        lv_obj_set_style_arc_width(arc, 10, LV_PART_INDICATOR);
+        lv_obj_set_style_arc_color(arc, lv_color_hex((i == 0U) ? 0x3b82f6 : ((i == 1U) ? 0x22ff88 : 0xff4477)),
+                                   LV_PART_INDICATOR);
+        lv_arc_set_bg_angles(arc, 0, 360);
+        lv_arc_set_angles(arc, 0, 90);
+        wl.arcs[i] = arc;
+    }
+    wl.arc_step = 0;
+}
+
+static void bench_build_gradient(void)
+{
+    int16_t w = (int16_t)lv_obj_get_width(wl.content);
+    int16_t h = (int16_t)lv_obj_get_height(wl.content);
+
+    wl.grad_bg = lv_obj_create(wl.content);
+    lv_obj_remove_style_all(wl.grad_bg);
+    lv_obj_set_size(wl.grad_bg, w, h);
+    lv_obj_set_style_bg_opa(wl.grad_bg, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(wl.grad_bg, lv_color_hex(0x112233), 0);
+    lv_obj_set_style_bg_grad_color(wl.grad_bg, lv_color_hex(0x3b82f6), 0);
+    lv_obj_set_style_bg_grad_dir(wl.grad_bg, LV_GRAD_DIR_VER, 0);
+
+    wl.grad_step = 0;
+}
+
+static void bench_build_chart(void)
+{
+    int16_t w = (int16_t)lv_obj_get_width(wl.content);
+    int16_t h = (int16_t)lv_obj_get_height(wl.content);
+
+    wl.chart = lv_chart_create(wl.content);
+    lv_obj_set_size(wl.chart, w - 12, h - 12);
+    lv_obj_center(wl.chart);
+    lv_chart_set_type(wl.chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_point_count(wl.chart, CHART_POINTS);
+    lv_chart_set_update_mode(wl.chart, LV_CHART_UPDATE_MODE_SHIFT);
+    lv_chart_set_range(wl.chart, LV_CHART_AXIS_PRIMARY_Y, 0, 100);
+    lv_chart_set_div_line_count(wl.chart, 4, 6);
+    lv_obj_set_style_size(wl.chart, 0, 0, LV_PART_INDICATOR);
+
+    wl.chart_ser[0] = lv_chart_add_series(wl.chart, lv_color_hex(0x22ccff), LV_CHART_AXIS_PRIMARY_Y);
+    wl.chart_ser[1] = lv_chart_add_series(wl.chart, lv_color_hex(0xff4477), LV_CHART_AXIS_PRIMARY_Y);
+    wl.chart_seed = 0x1234567U;
+}
+
+/*============================================================================
+ * Animation steps
+ *============================================================================*/
+
+static void bench_step_text(int16_t h)
+{
+    wl.text_y--;
+    if (wl.text_y < -(wl.text_h - h)) {
+        wl.text_y = 0;
+    }
+
+    if (wl.text_label) {
+        lv_obj_set_y(wl.text_label, wl.text_y);
+    }
+}
+
+static void bench_step_image(int16_t w, int16_t h)
+{
+    for (uint32_t i = 0; i < IMG_COUNT; i++) {
+        int16_t x = (int16_t)(wl.img_x[i] + wl.img_vx[i]);
+        int16_t y = (int16_t)(wl.img_y[i] + wl.img_vy[i]);
+
+        if ((x < 0) || (x > (w - IMG_SIZE))) {
+            wl.img_vx[i] = (int8_t)-wl.img_vx[i];
+            x = (x < 0) ? 0 : (int16_t)(w - IMG_SIZE);
+        }
+        if ((y < 0) || (y > (h - IMG_SIZE))) {
+            wl.img_vy[i] = (int8_t)-wl.img_vy[i];
+            y = (y < 0) ? 0 : (int16_t)(h - IMG_SIZE);
+        }
+
+        wl.img_x[i] = x;
+        wl.img_y[i] = y;
+        if (wl.images[i]) {
+            lv_obj_set_pos(wl.images[i], x, y);
+        }
+    }
+}
+
+/* Triangle wave 0..range..0 with the given period */
+static int32_t bench_tri(uint32_t t, int32_t range)
+{
+    uint32_t period = (uint32_t)range * 2U;
+    uint32_t p = t % period;
+
+    return (int32_t)((p < (uint32_t)range) ? p : (period - p));
+}
+
+static void bench_step_alpha(int16_t w, int16_t h)
+{
+    wl.panel_phase += 2U;
+
+    for (uint32_t i = 0; i < PANEL_COUNT; i++) {
+        int32_t pw = (w * 3) / 5;
+        int32_t ph = h / 3;
+        int32_t x = bench_tri(wl.panel_phase + i * 40U, w - pw);
+        int32_t y = bench_tri((wl.panel_phase * 2U) / 3U + i * 70U, h - ph);
+
+        if (wl.panels[i]) {
+            lv_obj_set_pos(wl.panels[i], x, y);
+        }
+    }
+}
+
+static void bench_step_arc(void)
+{
+    wl.arc_step++;
+
+    for (uint32_t i = 0; i < ARC_COUNT; i++) {
+        uint32_t speed = 3U + i * 2U;
+        int32_t rot = (int32_t)(((i & 1U) ? (360U - (wl.arc_step * speed) % 360U) : (wl.arc_step * speed)) % 360U);
+        int32_t span = 30 + bench_tri(wl.arc_step * 2U + i * 60U, 240);
+
+        if (wl.arcs[i]) {
+            lv_arc_set_rotation(wl.arcs[i], rot);
+            lv_arc_set_angles(wl.arcs[i], 0, span);
+        }
+    }
+}
+
+static void bench_step_gradient(void)
+{
+    wl.grad_step++;
+    uint32_t t = wl.grad_step;
+    uint32_t top = ((bench_tri(t * 3U, 255) & 0xffU) << 16) | 0x2233U;
+    uint32_t bottom = ((bench_tri(t * 5U, 255) & 0xffU) << 8) | 0x1000f6U;
+
+    if (wl.grad_bg) {
+        lv_obj_set_style_bg_color(wl.grad_bg, lv_color_hex(top), 0);
+        lv_obj_set_style_bg_grad_color(wl.grad_bg, lv_color_hex(bottom), 0);
+    }
+}
+
+static void bench_step_chart(void)
+{
+    if (wl.chart == NULL) {
+        return;
+    }
+
+    for (uint32_t s = 0; s < 2U; s++) {
+        /* LCG: same sequence on every run */
+        wl.chart_seed = wl.chart_seed * 1103515245U + 12345U;
+        int32_t v = (s == 0U) ? (20 + (int32_t)((wl.chart_seed >> 16) % 30U))
+                              : (55 + (int32_t)((wl.chart_seed >> 16) % 40U));
+        lv_chart_set_next_value(wl.chart, wl.chart_ser[s], v);
+    }
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+void bench_workloads_init(lv_obj_t *content)
+{
+    memset(&wl, 0, sizeof(wl));
+    wl.content = content;
+}
+
+void bench_workloads_set_mode(bench_mode_t mode)
+{
+    lv_obj_t *content = wl.content;
+
+    lv_obj_clean(content);
+
+    /* Drop every per-mode object pointer and animation state */
+    memset(&wl, 0, sizeof(wl));
+    wl.content = content;
+    wl.mode = mode;
+
+    switch (wl.mode) {
+    case BENCH_MODE_SCATTER:
+        bench_build_scatter();
+        break;
+    case BENCH_MODE_STRIPE:
+        bench_build_stripe();
+        break;
+    case BENCH_MODE_FULL:
+        bench_build_full();
+        break;
+    case BENCH_MODE_TEXT:
+        bench_build_text();
+        break;
+    case BENCH_MODE_IMAGE:
+        bench_build_image();
+        break;
+    case BENCH_MODE_ALPHA:
+        bench_build_alpha();
+        break;
+    case BENCH_MODE_ARC:
+        bench_build_arc();
+        break;
+    case BENCH_MODE_GRADIENT:
+        bench_build_gradient();
+        break;
+    case BENCH_MODE_CHART:
+        bench_build_chart();
+        break;
+    default:
+        break;
+    }
+}
+
+bench_mode_t bench_workloads_get_mode(void)
+{
+    return wl.mode;
+}
+
+void bench_workloads_set_params(const bench_params_t *params)
+{
+    int32_t w = lv_obj_get_width(wl.content);
+    int32_t h = lv_obj_get_height(wl.content);
+    int32_t max_size = ((w < h) ? w : h) - 1;
+
+    wl_params = *params;
+    if (wl_params.dot_count > BENCH_DOT_MAX) {
+        wl_params.dot_count = BENCH_DOT_MAX;
+    }
+    if (wl_params.dot_size < 1U) {
+        wl_params.dot_size = 1;
+    } else if ((int32_t)wl_params.dot_size > max_size) {
+        wl_params.dot_size = (uint16_t)max_size;
+    }
+    if (wl_params.stripe_w < 1U) {
+        wl_params.stripe_w = 1;
+    } else if ((int32_t)wl_params.stripe_w > (w - 1)) {
+        wl_params.stripe_w = (uint16_t)(w - 1);
+    }
+}
+
+void bench_workloads_get_params(bench_params_t *out)
+{
+    *out = wl_params;
+}
+
+void bench_workloads_step(void)
+{
+    int16_t w = (int16_t)lv_obj_get_width(wl.content);
+    int16_t h = (int16_t)lv_obj_get_height(wl.content);
+
+    switch (wl.mode) {
+    case BENCH_MODE_SCATTER: {
+        int16_t size = (int16_t)wl_params.dot_size;
+
+        for (uint32_t i = 0; i < wl_params.dot_count; i++) {
+            int16_t x = (int16_t)(wl.dot_x[i] + wl.dot_vx[i]);
+            int16_t y = (int16_t)(wl.dot_y[i] + wl.dot_vy[i]);
+
+            if (x < 0) {
+                x = 0;
+                wl.dot_vx[i] = (int8_t)-wl.dot_vx[i];
+            } else if (x > (w - size)) {
+                x = (int16_t)(w - size);
+                wl.dot_vx[i] = (int8_t)-wl.dot_vx[i];
+            }
+
+            if (y < 0) {
+                y = 0;
+                wl.dot_vy[i] = (int8_t)-wl.dot_vy[i];
+            } else if (y > (h - size)) {
+                y = (int16_t)(h - size);
+                wl.dot_vy[i] = (int8_t)-wl.dot_vy[i];
+            }
+
+            wl.dot_x[i] = x;
+            wl.dot_y[i] = y;
+
+            if (wl.dots[i]) {
+                lv_obj_set_pos(wl.dots[i], x, y);
+            }
+        }
+        break;
+    }
+    case BENCH_MODE_STRIPE: {
+        wl.stripe_x = (int16_t)(wl.stripe_x + wl.stripe_vx);
+        if (wl.stripe_x < 0) {
+            wl.stripe_x = 0;
+            wl.stripe_vx = (int8_t)-wl.stripe_vx;
+        } else if (wl.stripe_x > (w - (int16_t)wl_params.stripe_w)) {
+            wl.stripe_x = (int16_t)(w - (int16_t)wl_params.stripe_w);
+            wl.stripe_vx = (int8_t)-wl.stripe_vx;
+        }
+
+        if (wl.stripe) {
+            lv_obj_set_x(wl.stripe, wl.stripe_x);
+        }
+        break;
+    }
+    case BENCH_MODE_FULL: {
+        wl.full_color_step++;
+        uint32_t r = (wl.full_color_step * 5U) & 0xFFU;
+        uint32_t g = (wl.full_color_step * 3U) & 0xFFU;
+        uint32_t b = (wl.full_color_step * 7U) & 0xFFU;
+        uint32_t rgb = (r << 16) | (g << 8) | b;
+
+        if (wl.full_bg) {
+            lv_obj_set_style_bg_color(wl.full_bg, lv_color_hex(rgb), 0);
+        }
+        break;
+    }
+    case BENCH_MODE_TEXT:
+        bench_step_text(h);
+        break;
+    case BENCH_MODE_IMAGE:
+        bench_step_image(w, h);
+        break;
+    case BENCH_MODE_ALPHA:
+        bench_step_alpha(w, h);
+        break;
+    case BENCH_MODE_ARC:
+        bench_step_arc();
+        break;
+    case BENCH_MODE_GRADIENT:
+        bench_step_gradient();
+        break;
+    case BENCH_MODE_CHART:
+        bench_step_chart();
+        break;
+    default:
+        break;
+    }
+}
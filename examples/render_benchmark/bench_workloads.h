@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Render benchmark workloads (shared by render_benchmark and bench_runner)
+ *
+ * Each mode builds its objects inside a caller-provided content container and
+ * animates them one step per bench_workloads_step() call.
+ */
+
+#ifndef BENCH_WORKLOADS_H
+#define BENCH_WORKLOADS_H
+
+#include "lvgl.h"
+
+typedef enum {
+    BENCH_MODE_SCATTER = 0,
+    BENCH_MODE_STRIPE,
+    BENCH_MODE_FULL,
+    BENCH_MODE_TEXT,        /* Multi-line label scrolling by one pixel per step */
+    BENCH_MODE_IMAGE,       /* Opaque RGB565 and ARGB8888 images bouncing */
+    BENCH_MODE_ALPHA,       /* Overlapping 50% opacity panels */
+    BENCH_MODE_ARC,         /* Rotating arcs with changing span */
+    BENCH_MODE_GRADIENT,    /* Full-area vertical gradient changing colors */
+    BENCH_MODE_CHART,       /* Two-series line chart in shift mode */
+    BENCH_MODE_COUNT,
+} bench_mode_t;
+
+/* Animation step period used by both examples */
+#define BENCH_ANIM_PERIOD_MS    16
+
+/* Upper bound for bench_params_t.dot_count */
+#define BENCH_DOT_MAX           64
+
+/* Geometry of the SCATTER and STRIPE workloads */
+typedef struct {
+    uint16_t dot_count;         /* SCATTER: number of moving dots */
+    uint16_t dot_size;          /* SCATTER: dot edge length (px) */
+    uint16_t stripe_w;          /* STRIPE: stripe width (px) */
+} bench_params_t;
+
+#define BENCH_PARAMS_DEFAULT    { 24, 8, 22 }
+
+/**
+ * @brief Bind the workloads to a content container (cleared on every mode switch)
+ */
+void bench_workloads_init(lv_obj_t *content);
+
+/**
+ * @brief Rebuild the content container for a mode
+ */
+void bench_workloads_set_mode(bench_mode_t mode);
+
+/**
+ * @brief Current mode
+ */
+bench_mode_t bench_workloads_get_mode(void);
+
+/**
+ * @brief Set the SCATTER/STRIPE geometry (clamped to the content area); applies at the next mode switch
+ */
+void bench_workloads_set_params(const bench_params_t *params);
+
+/**
+ * @brief Get the SCATTER/STRIPE geometry
+ */
+void bench_workloads_get_params(bench_params_t *out);
+
+/**
+ * @brief Advance the current animation by one step
+ */
+void bench_workloads_step(void);
+
+/**
+ * @brief Printable mode name ("SCATTER", ...)
+ */
+const char *bench_mode_name(bench_mode_t mode);
+
+#endif /* BENCH_WORKLOADS_H */
@@ -3,13 +3,15 @@
  *
  * Goal:
  * - Generate different invalidation patterns (scatter / stripe / full refresh)
- * - Display live flush stats (flush/s, KB/s, last area)
+ *   and LVGL feature workloads (text scroll, image blit, alpha, arcs, gradient, chart)
+ * - Display live flush stats (flush/s, KB/s) and per-frame render vs. transfer time
  *
  * Keys (HPM6E00 FULL_PORT):
  * - KEY A: previous mode
- * - KEY B: next mode
- * - KEY C: pause/resume animation
- * - KEY D: reset statistics
+ * - KEY B: next mode (after the last mode: SWEEP, a parametric scaling sweep printed over UART,
+ *          then with HPM_LVGL_FB_PLACEMENT_AB=1: PLACEMENT, cacheable vs non-cacheable draw buffers)
+ * - KEY C: pause/resume animation (aborts a running sweep or placement run)
+ * - KEY D: reset statistics (and dump the event trace when HPM_LVGL_TRACE_ENABLE=1)
  */
 
 #include <stdio.h>
@@ -18,6 +20,9 @@
 #include "board.h"
 #include "hpm_gpio_drv.h"
 #include "hpm_lvgl_spi.h"
+#include "bench_workloads.h"
+#include "bench_sweep.h"
+#include "bench_placement.h"
 
 /* Some boards (e.g. hpm6e00evk in hpm_sdk) may not provide these helpers.
  * Provide weak defaults so the demo can still build. */
@@ -90,6 +95,7 @@ static bool key_just_pressed(uint8_t key_idx)
         if (now - key_debounce[key_idx] > DEBOUNCE_MS) {
             key_pressed[key_idx] = true;
             key_debounce[key_idx] = now;
+            hpm_lvgl_trace_input(key_idx, true);
             return true;
         }
     } else if (!pressed) {
@@ -103,29 +109,19 @@ static bool key_just_pressed(uint8_t key_idx)
  * Benchmark UI
  *============================================================================*/
 
-typedef enum {
-    BENCH_MODE_SCATTER = 0,
-    BENCH_MODE_STRIPE,
-    BENCH_MODE_FULL,
-    BENCH_MODE_COUNT,
-} bench_mode_t;
-
-#define ANIM_PERIOD_MS  16
 #define STATS_PERIOD_MS 250
 
-#define DOT_COUNT  24
-#define DOT_SIZE   8
-
 /* Colors */
 #define COLOR_BG        lv_color_hex(0x0b1020)
 #define COLOR_TEXT      lv_color_hex(0xeaeaea)
 #define COLOR_DIM       lv_color_hex(0x9aa3b2)
-#define COLOR_ACCENT    lv_color_hex(0x3b82f6)
 #define COLOR_WARN      lv_color_hex(0xf59e0b)
 
 static struct {
     bench_mode_t mode;
     bool paused;
+    bool sweeping;
+    bool placing;
 
     lv_obj_t *screen;
     lv_obj_t *title_label;
@@ -133,46 +129,27 @@ static struct {
     lv_obj_t *help_label;
     lv_obj_t *content;
 
-    /* Scatter */
-    lv_obj_t *dots[DOT_COUNT];
-    int16_t dot_x[DOT_COUNT];
-    int16_t dot_y[DOT_COUNT];
-    int8_t dot_vx[DOT_COUNT];
-    int8_t dot_vy[DOT_COUNT];
-
-    /* Stripe */
-    lv_obj_t *stripe;
-    int16_t stripe_x;
-    int8_t stripe_vx;
-
-    /* Full refresh */
-    lv_obj_t *full_bg;
-    uint32_t full_color_step;
-
     /* Stats baseline */
     uint32_t last_stats_ms;
     uint32_t last_flush_count;
     uint64_t last_flush_bytes;
+    uint32_t last_frames;
+    uint64_t last_render_us;
+    uint64_t last_xfer_us;
 
     lv_timer_t *anim_timer;
 } bench;
 
-static const char *bench_mode_name(bench_mode_t mode)
-{
-    switch (mode) {
-    case BENCH_MODE_SCATTER:
-        return "SCATTER";
-    case BENCH_MODE_STRIPE:
-        return "STRIPE";
-    case BENCH_MODE_FULL:
-        return "FULL";
-    default:
-        return "UNKNOWN";
-    }
-}
-
 static void ui_update_title(void)
 {
+    if (bench.sweeping) {
+        lv_label_set_text(bench.title_label, "LVGL BENCH  SWEEP");
+        return;
+    }
+    if (bench.placing) {
+        lv_label_set_text(bench.title_label, "LVGL BENCH  PLACEMENT");
+        return;
+    }
     lv_label_set_text_fmt(bench.title_label, "LVGL BENCH  %s%s",
                           bench_mode_name(bench.mode),
                           bench.paused ? "  (PAUSE)" : "");
@@ -188,127 +165,81 @@ static void bench_reset_stats(void)
     bench.last_stats_ms = hpm_lvgl_spi_tick_get();
     bench.last_flush_count = s.flush_count;
     bench.last_flush_bytes = s.flush_bytes;
+    bench.last_frames = s.frames_rendered;
+    bench.last_render_us = s.render_us;
+    bench.last_xfer_us = s.xfer_us;
 }
 
-static void bench_build_scatter(void)
+static void bench_set_mode(bench_mode_t mode)
 {
-    int16_t w = (int16_t)lv_obj_get_width(bench.content);
-    int16_t h = (int16_t)lv_obj_get_height(bench.content);
-
-    for (uint32_t i = 0; i < DOT_COUNT; i++) {
-        lv_obj_t *dot = lv_obj_create(bench.content);
-        lv_obj_remove_style_all(dot);
-        lv_obj_set_size(dot, DOT_SIZE, DOT_SIZE);
-        lv_obj_set_style_radius(dot, LV_RADIUS_CIRCLE, 0);
-        lv_obj_set_style_bg_opa(dot, LV_OPA_COVER, 0);
-
-        /* Color cycle */
-        uint32_t c = 0x22ccff;
-        if ((i % 3) == 1) {
-            c = 0x22ff88;
-        } else if ((i % 3) == 2) {
-            c = 0xff4477;
-        }
-        lv_obj_set_style_bg_color(dot, lv_color_hex(c), 0);
-
-        /* Deterministic pseudo-random init */
-        int16_t x = (int16_t)((i * 37U) % (uint32_t)(w - DOT_SIZE));
-        int16_t y = (int16_t)((i * 61U) % (uint32_t)(h - DOT_SIZE));
-        int8_t vx = (int8_t)((i % 3) + 1);
-        int8_t vy = (int8_t)(((i + 1) % 3) + 1);
-        if (i & 0x1U) {
-            vx = -vx;
-        }
-        if (i & 0x2U) {
-            vy = -vy;
-        }
+    bench.mode = mode;
+    bench.paused = false;
 
-        bench.dots[i] = dot;
-        bench.dot_x[i] = x;
-        bench.dot_y[i] = y;
-        bench.dot_vx[i] = vx;
-        bench.dot_vy[i] = vy;
+    /* Mode switches show up as markers on the trace timeline. */
+    hpm_lvgl_trace_marker(1, (uint32_t)mode);
 
-        lv_obj_set_pos(dot, x, y);
-    }
+    bench_workloads_set_mode(mode);
+
+    ui_update_title();
+    bench_reset_stats();
 }
 
-static void bench_build_stripe(void)
+static void bench_start_sweep(void)
 {
-    int16_t w = (int16_t)lv_obj_get_width(bench.content);
-    int16_t h = (int16_t)lv_obj_get_height(bench.content);
-
-    bench.stripe = lv_obj_create(bench.content);
-    lv_obj_remove_style_all(bench.stripe);
-    lv_obj_set_size(bench.stripe, 22, h);
-    lv_obj_set_style_bg_opa(bench.stripe, LV_OPA_COVER, 0);
-    lv_obj_set_style_bg_color(bench.stripe, COLOR_ACCENT, 0);
-    lv_obj_set_style_radius(bench.stripe, 6, 0);
-
-    bench.stripe_x = 0;
-    bench.stripe_vx = 3;
-    lv_obj_set_pos(bench.stripe, bench.stripe_x, 0);
-
-    /* Add a few static widgets to mimic dashboard workload */
-    lv_obj_t *lbl = lv_label_create(bench.content);
-    lv_obj_set_style_text_color(lbl, COLOR_TEXT, 0);
-    lv_obj_set_style_text_font(lbl, &lv_font_montserrat_12, 0);
-    lv_obj_align(lbl, LV_ALIGN_TOP_LEFT, 6, 6);
-    lv_label_set_text(lbl, "Stripe moves (partial)");
-
-    lv_obj_t *bar = lv_bar_create(bench.content);
-    lv_obj_set_size(bar, w - 12, 10);
-    lv_obj_align(bar, LV_ALIGN_BOTTOM_MID, 0, -10);
-    lv_bar_set_range(bar, 0, 100);
-    lv_bar_set_value(bar, 75, LV_ANIM_OFF);
+    bench.sweeping = true;
+    bench.paused = false;
+    ui_update_title();
+    lv_label_set_text(bench.stats_label, "Sweep running\nresults on UART");
+    bench_sweep_start(bench.anim_timer);
 }
 
-static void bench_build_full(void)
+static void bench_stop_sweep(void)
 {
-    int16_t w = (int16_t)lv_obj_get_width(bench.content);
-    int16_t h = (int16_t)lv_obj_get_height(bench.content);
-
-    bench.full_bg = lv_obj_create(bench.content);
-    lv_obj_remove_style_all(bench.full_bg);
-    lv_obj_set_size(bench.full_bg, w, h);
-    lv_obj_set_style_bg_opa(bench.full_bg, LV_OPA_COVER, 0);
-    lv_obj_set_style_bg_color(bench.full_bg, lv_color_hex(0x112233), 0);
-
-    bench.full_color_step = 0;
-
-    lv_obj_t *lbl = lv_label_create(bench.full_bg);
-    lv_obj_set_style_text_color(lbl, COLOR_TEXT, 0);
-    lv_obj_set_style_text_font(lbl, &lv_font_montserrat_12, 0);
-    lv_obj_center(lbl);
-    lv_label_set_text(lbl, "Full-area redraw");
+    bench_sweep_abort();
+    bench.sweeping = false;
+    bench_set_mode(bench.mode);
 }
 
-static void bench_set_mode(bench_mode_t mode)
+static void bench_start_placement(void)
 {
-    bench.mode = mode;
     bench.paused = false;
+    if (!bench_placement_start(bench.anim_timer)) {
+        return;
+    }
+    bench.placing = true;
+    ui_update_title();
+    lv_label_set_text(bench.stats_label, "Placement running\nresults on UART");
+}
 
-    lv_obj_clean(bench.content);
-    memset(bench.dots, 0, sizeof(bench.dots));
-    bench.stripe = NULL;
-    bench.full_bg = NULL;
+static void bench_stop_placement(void)
+{
+    bench_placement_abort();
+    bench.placing = false;
+    bench_set_mode(bench.mode);
+}
 
-    switch (bench.mode) {
-    case BENCH_MODE_SCATTER:
-        bench_build_scatter();
-        break;
-    case BENCH_MODE_STRIPE:
-        bench_build_stripe();
-        break;
-    case BENCH_MODE_FULL:
-        bench_build_full();
-        break;
-    default:
-        break;
-    }
+/* Mode selection index: 0..BENCH_MODE_COUNT-1 are workloads, then SWEEP, then PLACEMENT */
+#define SEL_SWEEP       ((uint32_t)BENCH_MODE_COUNT)
+#define SEL_PLACEMENT   (SEL_SWEEP + 1U)
+#define SEL_COUNT       (SEL_SWEEP + 1U + (HPM_LVGL_FB_PLACEMENT_AB ? 1U : 0U))
 
-    ui_update_title();
-    bench_reset_stats();
+static void bench_select(uint32_t sel)
+{
+    if (bench.sweeping) {
+        bench_sweep_abort();
+        bench.sweeping = false;
+    }
+    if (bench.placing) {
+        bench_placement_abort();
+        bench.placing = false;
+    }
+    if (sel == SEL_SWEEP) {
+        bench_start_sweep();
+    } else if (sel == SEL_PLACEMENT) {
+        bench_start_placement();
+    } else {
+        bench_set_mode((bench_mode_t)sel);
+    }
 }
 
 static void ui_update_stats(void)
@@ -318,6 +249,24 @@ static void ui_update_stats(void)
         return;
     }
 
+    if (bench.sweeping) {
+        /* The sweep resets the adapter stats per point; show progress only. */
+        uint32_t total = 0;
+        uint32_t done = bench_sweep_progress(&total);
+        lv_label_set_text_fmt(bench.stats_label, "Sweep %lu/%lu\nresults on UART", (unsigned long)(done + 1U),
+                              (unsigned long)total);
+        bench.last_stats_ms = now;
+        return;
+    }
+    if (bench.placing) {
+        uint32_t total = 0;
+        uint32_t done = bench_placement_progress(&total);
+        lv_label_set_text_fmt(bench.stats_label, "Placement %lu/%lu\nresults on UART", (unsigned long)(done + 1U),
+                              (unsigned long)total);
+        bench.last_stats_ms = now;
+        return;
+    }
+
     hpm_lvgl_spi_stats_t s;
     hpm_lvgl_spi_get_stats(&s);
 
@@ -328,24 +277,33 @@ static void ui_update_stats(void)
     uint32_t flush_ps = (dt_ms > 0) ? (df * 1000U) / dt_ms : 0;
     uint32_t kb_ps = (dt_ms > 0) ? (uint32_t)((db * 1000ULL) / (uint64_t)dt_ms / 1024ULL) : 0;
 
-    int32_t last_w = (int32_t)s.last_flush_area.x2 - (int32_t)s.last_flush_area.x1 + 1;
-    int32_t last_h = (int32_t)s.last_flush_area.y2 - (int32_t)s.last_flush_area.y1 + 1;
-    if (s.flush_count == 0 || last_w < 0 || last_h < 0) {
-        last_w = 0;
-        last_h = 0;
-    }
-
+    /* Per-frame CPU render time vs. bus transfer time (0.1 ms units): tells whether a
+     * workload is limited by LVGL drawing or by the SPI link. */
+    uint32_t dfr = s.frames_rendered - bench.last_frames;
+    uint32_t render_x10 = (dfr > 0) ? (uint32_t)((s.render_us - bench.last_render_us) / 100U / dfr) : 0;
+    uint32_t xfer_x10 = (dfr > 0) ? (uint32_t)((s.xfer_us - bench.last_xfer_us) / 100U / dfr) : 0;
+
+#if HPM_LVGL_HUD_ACTIVE
+    /* The overlay HUD reports FPS/bus use; keep the label static so it does not add flushes. */
+    (void)flush_ps;
+    (void)kb_ps;
+    (void)render_x10;
+    (void)xfer_x10;
+#else
     lv_label_set_text_fmt(bench.stats_label,
-                          "Flush %lu/s  %lu KB/s\nLast %ldx%ld  Buf %d",
+                          "Flush %lu/s  %lu KB/s\nRndr %lu.%lu  Xfer %lu.%lu ms/f",
                           (unsigned long)flush_ps,
                           (unsigned long)kb_ps,
-                          (long)last_w,
-                          (long)last_h,
-                          (int)HPM_LVGL_FB_LINES);
+                          (unsigned long)(render_x10 / 10U), (unsigned long)(render_x10 % 10U),
+                          (unsigned long)(xfer_x10 / 10U), (unsigned long)(xfer_x10 % 10U));
+#endif
 
     bench.last_stats_ms = now;
     bench.last_flush_count = s.flush_count;
     bench.last_flush_bytes = s.flush_bytes;
+    bench.last_frames = s.frames_rendered;
+    bench.last_render_us = s.render_us;
+    bench.last_xfer_us = s.xfer_us;
 }
 
 static void anim_timer_cb(lv_timer_t *timer)
@@ -356,69 +314,7 @@ static void anim_timer_cb(lv_timer_t *timer)
         return;
     }
 
-    int16_t w = (int16_t)lv_obj_get_width(bench.content);
-    int16_t h = (int16_t)lv_obj_get_height(bench.content);
-
-    switch (bench.mode) {
-    case BENCH_MODE_SCATTER:
-        for (uint32_t i = 0; i < DOT_COUNT; i++) {
-            int16_t x = (int16_t)(bench.dot_x[i] + bench.dot_vx[i]);
-            int16_t y = (int16_t)(bench.dot_y[i] + bench.dot_vy[i]);
-
-            if (x < 0) {
-                x = 0;
-                bench.dot_vx[i] = (int8_t)-bench.dot_vx[i];
-            } else if (x > (w - DOT_SIZE)) {
-                x = (int16_t)(w - DOT_SIZE);
-                bench.dot_vx[i] = (int8_t)-bench.dot_vx[i];
-            }
-
-            if (y < 0) {
-                y = 0;
-                bench.dot_vy[i] = (int8_t)-bench.dot_vy[i];
-            } else if (y > (h - DOT_SIZE)) {
-                y = (int16_t)(h - DOT_SIZE);
-                bench.dot_vy[i] = (int8_t)-bench.dot_vy[i];
-            }
-
-            bench.dot_x[i] = x;
-            bench.dot_y[i] = y;
-
-            if (bench.dots[i]) {
-                lv_obj_set_pos(bench.dots[i], x, y);
-            }
-        }
-        break;
-    case BENCH_MODE_STRIPE: {
-        bench.stripe_x = (int16_t)(bench.stripe_x + bench.stripe_vx);
-        if (bench.stripe_x < 0) {
-            bench.stripe_x = 0;
-            bench.stripe_vx = (int8_t)-bench.stripe_vx;
-        } else if (bench.stripe_x > (w - 22)) {
-            bench.stripe_x = (int16_t)(w - 22);
-            bench.stripe_vx = (int8_t)-bench.stripe_vx;
-        }
-
-        if (bench.stripe) {
-            lv_obj_set_x(bench.stripe, bench.stripe_x);
-        }
-        break;
-    }
-    case BENCH_MODE_FULL: {
-        bench.full_color_step++;
-        uint32_t r = (bench.full_color_step * 5U) & 0xFFU;
-        uint32_t g = (bench.full_color_step * 3U) & 0xFFU;
-        uint32_t b = (bench.full_color_step * 7U) & 0xFFU;
-        uint32_t rgb = (r << 16) | (g << 8) | b;
-
-        if (bench.full_bg) {
-            lv_obj_set_style_bg_color(bench.full_bg, lv_color_hex(rgb), 0);
-        }
-        break;
-    }
-    default:
-        break;
-    }
+    bench_workloads_step();
 }
 
 static void ui_create(void)
@@ -435,7 +331,7 @@ static void ui_create(void)
     lv_obj_set_style_text_color(bench.stats_label, COLOR_DIM, 0);
     lv_obj_set_style_text_font(bench.stats_label, &lv_font_montserrat_12, 0);
     lv_obj_align(bench.stats_label, LV_ALIGN_TOP_LEFT, 6, 26);
-    lv_label_set_text(bench.stats_label, "Flush --/s  -- KB/s\nLast --x--  Buf --");
+    lv_label_set_text(bench.stats_label, "Flush --/s  -- KB/s\nRndr --  Xfer -- ms/f");
 
     bench.help_label = lv_label_create(bench.screen);
     lv_obj_set_style_text_color(bench.help_label, COLOR_WARN, 0);
@@ -447,6 +343,8 @@ static void ui_create(void)
     lv_obj_remove_style_all(bench.content);
     lv_obj_set_pos(bench.content, 0, 56);
     lv_obj_set_size(bench.content, HPM_LVGL_LCD_WIDTH, (HPM_LVGL_LCD_HEIGHT - 56 - 20));
+
+    bench_workloads_init(bench.content);
 }
 
 /*============================================================================
@@ -473,31 +371,51 @@ int main(void)
 
     ui_create();
 
-    bench.anim_timer = lv_timer_create(anim_timer_cb, ANIM_PERIOD_MS, NULL);
+    bench.anim_timer = lv_timer_create(anim_timer_cb, BENCH_ANIM_PERIOD_MS, NULL);
     (void)bench.anim_timer;
 
     bench_set_mode(BENCH_MODE_SCATTER);
 
     while (1) {
+        uint32_t sel = bench.sweeping ? SEL_SWEEP : (bench.placing ? SEL_PLACEMENT : (uint32_t)bench.mode);
+
         if (key_just_pressed(0)) { /* KEY A */
-            bench_set_mode((bench_mode_t)((bench.mode + BENCH_MODE_COUNT - 1) % BENCH_MODE_COUNT));
+            bench_select((sel + SEL_COUNT - 1U) % SEL_COUNT);
         }
         if (key_just_pressed(1)) { /* KEY B */
-            bench_set_mode((bench_mode_t)((bench.mode + 1) % BENCH_MODE_COUNT));
+            bench_select((sel + 1U) % SEL_COUNT);
         }
         if (key_just_pressed(2)) { /* KEY C */
-            bench.paused = !bench.paused;
-            ui_update_title();
-            bench_reset_stats();
+            if (bench.sweeping) {
+                bench_stop_sweep();
+            } else if (bench.placing) {
+                bench_stop_placement();
+            } else {
+                bench.paused = !bench.paused;
+                ui_update_title();
+                bench_reset_stats();
+            }
         }
         if (key_just_pressed(3)) { /* KEY D */
+            hpm_lvgl_trace_dump();
+            hpm_lvgl_spi_capture_dump(HPM_LVGL_SPI_FREQ);
+            hpm_lvgl_jank_dump();
             bench_reset_stats();
         }
 
+        if (bench.sweeping && !bench_sweep_poll()) {
+            /* Finished: back to the interactive mode that was selected before */
+            bench.sweeping = false;
+            bench_set_mode(bench.mode);
+        }
+        if (bench.placing && !bench_placement_poll()) {
+            bench.placing = false;
+            bench_set_mode(bench.mode);
+        }
+
         ui_update_stats();
 
-        lv_timer_handler();
-        board_delay_us(1000);
+        hpm_lvgl_spi_run_once(HPM_LVGL_RUN_MAX_SLEEP_MS);
     }
 
     return 0;
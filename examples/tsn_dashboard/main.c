@@ -9,6 +9,9 @@
  * - Smooth menu navigation with button control
  * - Real-time FPS display
  * - Animation demo
+ * - With HPM_LVGL_REPLAY_ENABLE=1: replays a page-switch journey at virtual time on boot
+ *   (twice, printing frame CRC and wall-clock time), then records the keys pressed;
+ *   KEY C prints the recording for tools/hpm_lvgl_replay_to_c.py
  */
 
 #include <stdio.h>
@@ -85,6 +88,7 @@ static bool key_pressed[4] = {false};
 static uint32_t key_debounce[4] = {0};
 
 #define DEBOUNCE_MS 50
+#define TSN_KEY_POLL_MS 10     /* Keys are polled: longest sleep of the main loop */
 
 #if defined(BOARD_KEYA_GPIO_CTRL) && defined(BOARD_KEYA_GPIO_INDEX) && defined(BOARD_KEYA_GPIO_PIN) && \
     defined(BOARD_KEYB_GPIO_CTRL) && defined(BOARD_KEYB_GPIO_INDEX) && defined(BOARD_KEYB_GPIO_PIN) && \
@@ -145,6 +149,7 @@ static bool key_just_pressed(uint8_t key_idx)
         if (now - key_debounce[key_idx] > DEBOUNCE_MS) {
             key_pressed[key_idx] = true;
             key_debounce[key_idx] = now;
+            hpm_lvgl_trace_input(key_idx, true);
             return true;
         }
     } else if (!pressed) {
@@ -528,6 +533,71 @@ static void update_port_data(void)
     }
 }
 
+/*============================================================================
+ * Input
+ *============================================================================*/
+
+static void handle_key(uint8_t key_idx)
+{
+    switch (key_idx) {
+    case 0: /* KEY A - Previous */
+        prev_page();
+        break;
+    case 1: /* KEY B - Next */
+        next_page();
+        break;
+    case 2: /* KEY C - Select/Action */
+        /* With HPM_LVGL_HEATMAP_ENABLE / HPM_LVGL_JANK_ENABLE: print the flush heatmap and
+         * slow frames of this page and start over. */
+        hpm_lvgl_heatmap_dump();
+        hpm_lvgl_heatmap_reset();
+        hpm_lvgl_jank_dump();
+        hpm_lvgl_jank_reset();
+        hpm_lvgl_replay_dump();
+        hpm_lvgl_mem_dump();
+        break;
+    case 3: /* KEY D - Back to overview */
+        if (ui.current_page != PAGE_OVERVIEW) {
+            switch_to_page(PAGE_OVERVIEW);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void replay_input_cb(uint16_t code, uint16_t arg)
+{
+    (void)arg;
+    handle_key((uint8_t)code);
+}
+
+/*============================================================================
+ * Replay journey
+ *============================================================================*/
+
+/* Page-switch journey replayed on boot (paste a recording here, see tools/hpm_lvgl_replay_to_c.py) */
+static const hpm_lvgl_replay_event_t tsn_journey[] = {
+    { 800, 1, 0 },  /* B: PORT1 */
+    { 600, 1, 0 },  /* B: PORT2 */
+    { 600, 1, 0 },  /* B: PORT3 */
+    { 600, 1, 0 },  /* B: SETTINGS */
+    { 600, 0, 0 },  /* A: PORT3 */
+    { 600, 0, 0 },  /* A: PORT2 */
+    { 600, 3, 0 },  /* D: OVERVIEW */
+};
+
+#define TSN_JOURNEY_RUNS    2
+#define TSN_JOURNEY_TAIL_MS 1000
+
+/* Bring the dashboard to the state every journey starts from */
+static void dashboard_reset(void)
+{
+    ui.anim_counter = 0;
+    init_port_data();
+    switch_to_page(PAGE_OVERVIEW);
+}
+
 /*============================================================================
  * Main
  *============================================================================*/
@@ -550,6 +620,15 @@ int main(void)
         }
     }
     printf("Display initialized\n");
+
+    /* L8 draw buffers: map each luminance back to the dashboard colors (no-op otherwise) */
+    const lv_color_t palette[] = {
+        lv_color_black(), COLOR_BG, COLOR_PANEL, COLOR_ACCENT, COLOR_GREEN,
+        COLOR_RED, COLOR_YELLOW, COLOR_TEXT, COLOR_DIM, lv_color_white(),
+    };
+    if (hpm_lvgl_l8_set_palette(palette, sizeof(palette) / sizeof(palette[0])) != status_success) {
+        printf("L8 palette: colors share a luminance\n");
+    }
     
     /* Get screen */
     ui.screen = lv_screen_active();
@@ -570,24 +649,33 @@ int main(void)
     
     uint32_t last_update = 0;
     uint32_t last_fps_update = 0;
+    uint32_t journey_runs = HPM_LVGL_REPLAY_ENABLE ? TSN_JOURNEY_RUNS : 0;
+    bool boot_reported = false;
     
     /* Main loop */
     while (1) {
-        uint32_t now = hpm_lvgl_spi_tick_get();
-        
-        /* Handle button input */
-        if (key_just_pressed(0)) {  /* KEY A - Previous */
-            prev_page();
-        }
-        if (key_just_pressed(1)) {  /* KEY B - Next */
-            next_page();
+        /* Deterministic journey replay: starts from a reset dashboard, runs at virtual time */
+        if ((journey_runs > 0) && !hpm_lvgl_replay_is_playing()) {
+            journey_runs--;
+            dashboard_reset();
+            last_update = hpm_lvgl_spi_tick_get();
+            hpm_lvgl_replay_play(tsn_journey, sizeof(tsn_journey) / sizeof(tsn_journey[0]),
+                                 TSN_JOURNEY_TAIL_MS, replay_input_cb);
         }
-        if (key_just_pressed(2)) {  /* KEY C - Select/Action */
-            /* Could add action here */
+        if (hpm_lvgl_replay_is_playing() && !hpm_lvgl_replay_poll()) {
+            hpm_lvgl_replay_dump_result();
+            if (journey_runs == 0) {
+                hpm_lvgl_replay_record_start();
+            }
         }
-        if (key_just_pressed(3)) {  /* KEY D - Back to overview */
-            if (ui.current_page != PAGE_OVERVIEW) {
-                switch_to_page(PAGE_OVERVIEW);
+
+        uint32_t now = hpm_lvgl_spi_tick_get();
+        
+        /* Handle button input (ignored while a journey is replayed) */
+        for (uint8_t k = 0; (k < 4) && !hpm_lvgl_replay_is_playing(); k++) {
+            if (key_just_pressed(k)) {
+                hpm_lvgl_replay_input(k, 0);
+                handle_key(k);
             }
         }
         
@@ -597,8 +685,8 @@ int main(void)
             last_update = now;
         }
         
-        /* Update FPS display */
-        if (now - last_fps_update > 500) {
+        /* Update FPS display (the overlay HUD shows it without invalidating anything) */
+        if (!HPM_LVGL_HUD_ACTIVE && !hpm_lvgl_replay_is_playing() && (now - last_fps_update > 500)) {
             uint32_t fps = hpm_lvgl_spi_get_fps();
             if (ui.fps_label) {
                 lv_label_set_text_fmt(ui.fps_label, "%lu FPS", fps);
@@ -606,11 +694,21 @@ int main(void)
             last_fps_update = now;
         }
         
-        /* Run LVGL tasks */
-        lv_timer_handler();
-        
-        /* Small delay to prevent busy loop */
-        board_delay_us(1000);  /* 1ms */
+        /* Run LVGL timers and sleep until the next one; wake at least every 10 ms to poll the keys */
+        hpm_lvgl_spi_run_once(TSN_KEY_POLL_MS);
+
+        /* Boot timeline, once the first frame reached the panel */
+        if (!boot_reported) {
+            hpm_lvgl_spi_boot_stats_t boot;
+            hpm_lvgl_spi_get_boot_stats(&boot);
+            if (boot.first_pixel_us != 0U) {
+                printf("Boot%s: init returned %lu us, splash %lu us, panel on %lu us, first pixel %lu us\n",
+                       boot.warm_start ? " (warm)" : "", (unsigned long)boot.init_return_us,
+                       (unsigned long)boot.splash_us, (unsigned long)boot.panel_ready_us,
+                       (unsigned long)boot.first_pixel_us);
+                boot_reported = true;
+            }
+        }
     }
     
     return 0;
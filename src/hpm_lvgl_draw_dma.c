@@ -0,0 +1,544 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * DMA draw unit implementation
+ */
+
+#include "hpm_lvgl_draw_dma.h"
+
+#if HPM_LVGL_DRAW_DMA
+
+#include "hpm_lvgl_spi.h"
+#include "board.h"
+#include "hpm_csr_drv.h"
+#include "hpm_l1c_drv.h"
+#include "hpm_soc.h"
+#include "hpm_dmav2_drv.h"
+#include "src/display/lv_display_private.h"
+#include "src/draw/lv_draw_private.h"
+#if LV_USE_OS
+#include "src/core/lv_global.h"
+#endif
+#include <stdio.h>
+#include <string.h>
+
+#if USE_DMA_MGR
+#include "hpm_dma_mgr.h"
+#endif
+
+#if HPM_LVGL_DUALCORE == 1
+#error "HPM_LVGL_DRAW_DMA needs a DMA interrupt on the LVGL core; core 0 takes none with HPM_LVGL_DUALCORE=1."
+#endif
+
+/* Legacy path (no DMA manager): a second channel on the display DMA controller. Its completion
+ * arrives through the display DMA ISR (hpm_lvgl_spi_dma_irq_handler()). */
+#ifndef BOARD_LCD_DMA
+#define BOARD_LCD_DMA               HPM_HDMA
+#endif
+
+#ifndef BOARD_LCD_DMA_CH
+#define BOARD_LCD_DMA_CH            0
+#endif
+
+#ifndef HPM_LVGL_DRAW_DMA_CH
+#define HPM_LVGL_DRAW_DMA_CH        (BOARD_LCD_DMA_CH + 1)
+#endif
+
+#ifndef BOARD_RUNNING_CORE
+#define BOARD_RUNNING_CORE          HPM_CORE0
+#endif
+
+#ifndef ARRAY_SIZE
+#define ARRAY_SIZE(a)               (sizeof(a) / sizeof((a)[0]))
+#endif
+
+/* LVGL draw unit ID (the software renderer is 1, LVGL's GPU units use 2..9). */
+#define DRAW_DMA_UNIT_ID            32
+
+/* LVGL's software renderer (DRAW_UNIT_ID_SW) and its preference score; lower wins. */
+#define DRAW_DMA_SW_UNIT_ID         1
+#define DRAW_DMA_SW_SCORE           100
+
+/* Preference score of this unit. */
+#define DRAW_DMA_SCORE              40
+
+/* Rows used to calibrate the CPU estimate. */
+#define DRAW_DMA_CAL_ROWS           8U
+
+/*============================================================================
+ * Private data
+ *============================================================================*/
+
+typedef struct {
+    uint8_t *dst;
+    uint32_t dst_stride;
+    const uint8_t *src;         /* NULL: fill with color */
+    uint32_t src_stride;
+    uint32_t row_bytes;
+    uint32_t rows;
+    uint16_t color;
+} draw_dma_job_t;
+
+typedef struct {
+    lv_draw_unit_t base;
+    lv_draw_task_t *volatile task_act;
+} draw_dma_unit_t;
+
+static struct {
+    draw_dma_unit_t *unit;
+    DMA_Type *dma;
+    uint8_t ch;
+    draw_dma_job_t job;         /* Transfer on the channel (redone on the CPU after an error) */
+    uint64_t start_cycle;
+    hpm_lvgl_draw_dma_stats_t stats;
+} draw_dma;
+
+#if USE_DMA_MGR
+static dma_resource_t draw_dma_resource;
+#endif
+
+/* Rows 2..n of a transfer; row 1 is programmed into the channel. */
+HPM_LVGL_DRAW_DMA_ATTR static dma_linked_descriptor_t draw_dma_desc[HPM_LVGL_DRAW_DMA_MAX_ROWS];
+
+/* Fill source: four copies of the color, read at a fixed address */
+HPM_LVGL_DRAW_DMA_ATTR static uint16_t draw_dma_pattern[4];
+
+/* Cached source row for the copy calibration (like an image in RAM) */
+static uint16_t draw_dma_cal_row[HPM_LVGL_LCD_WIDTH];
+
+/*============================================================================
+ * CPU path (fallback and calibration)
+ *============================================================================*/
+
+/* Same work as LVGL's opaque RGB565 fill: 32-bit stores, a halfword at either end. */
+static void draw_dma_fill_row(uint16_t *p, uint32_t n, uint16_t color)
+{
+    if ((((uintptr_t)p & 2U) != 0U) && (n > 0U)) {
+        *p++ = color;
+        n--;
+    }
+    uint32_t c2 = (uint32_t)color * 0x00010001UL;
+    uint32_t *w = (uint32_t *)p;
+    for (; n >= 2U; n -= 2U) {
+        *w++ = c2;
+    }
+    if (n > 0U) {
+        *(uint16_t *)w = color;
+    }
+}
+
+static void draw_dma_run_cpu(const draw_dma_job_t *job)
+{
+    uint8_t *dst = job->dst;
+    const uint8_t *src = job->src;
+
+    for (uint32_t y = 0; y < job->rows; y++) {
+        if (src != NULL) {
+            lv_memcpy(dst, src, job->row_bytes);
+            src += job->src_stride;
+        } else {
+            draw_dma_fill_row((uint16_t *)dst, job->row_bytes / 2U, job->color);
+        }
+        dst += job->dst_stride;
+    }
+}
+
+/* CPU cycles per 1024 pixels for a fill or a copy into the draw buffer (second run, warm I-cache). */
+static uint32_t draw_dma_calibrate(lv_draw_buf_t *buf, const uint8_t *src)
+{
+    draw_dma_job_t job = {0};
+    uint64_t cycles = 0;
+
+    job.dst = buf->data;
+    job.row_bytes = HPM_LVGL_LCD_WIDTH * 2U;
+    job.dst_stride = job.row_bytes;
+    job.rows = buf->data_size / job.row_bytes;
+    if (job.rows > DRAW_DMA_CAL_ROWS) {
+        job.rows = DRAW_DMA_CAL_ROWS;
+    }
+    if (job.rows == 0U) {
+        return 0;
+    }
+    job.src = src;
+    job.color = 0x1234U;
+
+    for (uint32_t i = 0; i < 2U; i++) {
+        uint64_t start = hpm_csr_get_core_cycle();
+        draw_dma_run_cpu(&job);
+        cycles = hpm_csr_get_core_cycle() - start;
+    }
+
+    return (uint32_t)((cycles * 1024U) / ((uint64_t)job.rows * HPM_LVGL_LCD_WIDTH));
+}
+
+/*============================================================================
+ * Task selection
+ *============================================================================*/
+
+/* Destination (and source) of task `t` in the layer's draw buffer. False if there is nothing
+ * to draw or the task is not one the DMA can do. */
+static bool draw_dma_prepare(const lv_draw_task_t *t, draw_dma_job_t *job)
+{
+    const lv_draw_dsc_base_t *base = (const lv_draw_dsc_base_t *)t->draw_dsc;
+    lv_layer_t *layer = base->layer;
+    lv_display_t *disp = hpm_lvgl_spi_get_display();
+    lv_area_t a;
+
+    /* Only the adapter's draw buffers, and only while they are non-cacheable: the CPU then never
+     * holds a line that mixes DMA-written pixels with its own. */
+    if ((layer == NULL) || (layer->draw_buf == NULL) || (disp == NULL) ||
+        (layer->color_format != LV_COLOR_FORMAT_RGB565) || hpm_lvgl_spi_get_fb_cacheable() ||
+        ((layer->draw_buf != disp->buf_1) && (layer->draw_buf != disp->buf_2))) {
+        return false;
+    }
+    if (!lv_area_intersect(&a, &t->area, &t->clip_area)) {
+        return false;
+    }
+
+    uint32_t w = (uint32_t)lv_area_get_width(&a);
+    uint32_t h = (uint32_t)lv_area_get_height(&a);
+    if (((w * h) < HPM_LVGL_DRAW_DMA_MIN_PX) || (h > HPM_LVGL_DRAW_DMA_MAX_ROWS)) {
+        return false;
+    }
+
+    job->dst_stride = layer->draw_buf->header.stride;
+    job->dst = layer->draw_buf->data + ((uint32_t)(a.y1 - layer->buf_area.y1) * job->dst_stride) +
+               ((uint32_t)(a.x1 - layer->buf_area.x1) * 2U);
+    job->row_bytes = w * 2U;
+    job->rows = h;
+    job->src = NULL;
+    job->src_stride = 0;
+
+    if (t->type == LV_DRAW_TASK_TYPE_FILL) {
+        const lv_draw_fill_dsc_t *dsc = (const lv_draw_fill_dsc_t *)t->draw_dsc;
+
+        if ((dsc->radius != 0) || (dsc->opa < LV_OPA_MAX) || (dsc->grad.dir != LV_GRAD_DIR_NONE)) {
+            return false;
+        }
+        job->color = lv_color_to_u16(dsc->color);
+        return true;
+    }
+
+#if HPM_LVGL_DRAW_DMA_IMAGES
+    if (t->type == LV_DRAW_TASK_TYPE_IMAGE) {
+        const lv_draw_image_dsc_t *dsc = (const lv_draw_image_dsc_t *)t->draw_dsc;
+
+        if ((lv_image_src_get_type(dsc->src) != LV_IMAGE_SRC_VARIABLE) || (dsc->rotation != 0) ||
+            (dsc->scale_x != LV_SCALE_NONE) || (dsc->scale_y != LV_SCALE_NONE) || (dsc->skew_x != 0) ||
+            (dsc->skew_y != 0) || (dsc->recolor_opa > LV_OPA_MIN) || (dsc->opa < LV_OPA_MAX) ||
+            (dsc->blend_mode != LV_BLEND_MODE_NORMAL) || (dsc->clip_radius != 0) ||
+            (dsc->bitmap_mask_src != NULL) || dsc->tile) {
+            return false;
+        }
+
+        const lv_image_dsc_t *img = (const lv_image_dsc_t *)dsc->src;
+        if ((img->data == NULL) || (img->header.cf != LV_COLOR_FORMAT_RGB565) ||
+            ((img->header.flags & LV_IMAGE_FLAGS_COMPRESSED) != 0U) ||
+            (lv_area_get_width(&t->area) != (int32_t)img->header.w) ||
+            (lv_area_get_height(&t->area) != (int32_t)img->header.h)) {
+            return false;
+        }
+
+        job->src_stride = (img->header.stride != 0U) ? img->header.stride : (uint32_t)img->header.w * 2U;
+        job->src = img->data + ((uint32_t)(a.y1 - t->area.y1) * job->src_stride) +
+                   ((uint32_t)(a.x1 - t->area.x1) * 2U);
+        return true;
+    }
+#endif
+
+    return false;
+}
+
+static int32_t draw_dma_evaluate_cb(lv_draw_unit_t *draw_unit, lv_draw_task_t *task)
+{
+    draw_dma_job_t job;
+
+    (void)draw_unit;
+    if (((task->type == LV_DRAW_TASK_TYPE_FILL) || (task->type == LV_DRAW_TASK_TYPE_IMAGE)) &&
+        (task->preference_score > DRAW_DMA_SCORE) && draw_dma_prepare(task, &job)) {
+        task->preference_score = DRAW_DMA_SCORE;
+        task->preferred_draw_unit_id = DRAW_DMA_UNIT_ID;
+    }
+
+    return 0;
+}
+
+/*============================================================================
+ * Transfer
+ *============================================================================*/
+
+/* Widest transfer unit (8, 4 or 2 bytes) every row start, length and stride is aligned to. */
+static uint8_t draw_dma_width(const draw_dma_job_t *job, uint32_t rows)
+{
+    uint32_t bits = (uint32_t)(uintptr_t)job->dst | job->row_bytes;
+
+    if (rows > 1U) {
+        bits |= job->dst_stride;
+    }
+    if (job->src != NULL) {
+        bits |= (uint32_t)(uintptr_t)job->src;
+        if (rows > 1U) {
+            bits |= job->src_stride;
+        }
+    }
+
+    if ((bits & 7U) == 0U) {
+        return DMA_TRANSFER_WIDTH_DOUBLE_WORD;
+    }
+    return ((bits & 3U) == 0U) ? DMA_TRANSFER_WIDTH_WORD : DMA_TRANSFER_WIDTH_HALF_WORD;
+}
+
+static hpm_stat_t draw_dma_start(const draw_dma_job_t *job)
+{
+    dma_channel_config_t cfg;
+    /* Full-width fills and copies from an image as wide as the strip are one contiguous run. */
+    bool packed = (job->dst_stride == job->row_bytes) && ((job->src == NULL) || (job->src_stride == job->row_bytes));
+    uint32_t rows = packed ? 1U : job->rows;
+    uint32_t row_bytes = packed ? (job->row_bytes * job->rows) : job->row_bytes;
+    uint32_t src_stride = (job->src != NULL) ? job->src_stride : 0U;
+    uint32_t src;
+
+    if (job->src != NULL) {
+        /* The image may still have dirty lines in the D-cache (RAM sources) */
+        if (l1c_dc_is_enabled()) {
+            uint32_t start = HPM_L1C_CACHELINE_ALIGN_DOWN((uint32_t)(uintptr_t)job->src);
+            uint32_t end = HPM_L1C_CACHELINE_ALIGN_UP((uint32_t)(uintptr_t)job->src + ((rows - 1U) * src_stride) + row_bytes);
+            l1c_dc_writeback(start, end - start);
+        }
+        src = core_local_mem_to_sys_address(BOARD_RUNNING_CORE, (uint32_t)(uintptr_t)job->src);
+    } else {
+        for (uint32_t i = 0; i < ARRAY_SIZE(draw_dma_pattern); i++) {
+            draw_dma_pattern[i] = job->color;
+        }
+        src = core_local_mem_to_sys_address(BOARD_RUNNING_CORE, (uint32_t)(uintptr_t)draw_dma_pattern);
+    }
+    uint32_t dst = core_local_mem_to_sys_address(BOARD_RUNNING_CORE, (uint32_t)(uintptr_t)job->dst);
+
+    dma_default_channel_config(draw_dma.dma, &cfg);
+    cfg.src_width = draw_dma_width(job, rows);
+    cfg.dst_width = cfg.src_width;
+    cfg.src_addr_ctrl = (job->src != NULL) ? DMA_ADDRESS_CONTROL_INCREMENT : DMA_ADDRESS_CONTROL_FIXED;
+    cfg.dst_addr_ctrl = DMA_ADDRESS_CONTROL_INCREMENT;
+    cfg.src_mode = DMA_HANDSHAKE_MODE_NORMAL;
+    cfg.dst_mode = DMA_HANDSHAKE_MODE_NORMAL;
+    cfg.src_burst_size = DMA_NUM_TRANSFER_PER_BURST_8T;
+    cfg.size_in_byte = row_bytes;
+
+    /* Only the last row raises the completion interrupt. */
+    for (uint32_t i = 1; i < rows; i++) {
+        bool last = (i + 1U) == rows;
+
+        cfg.src_addr = src + (i * src_stride);
+        cfg.dst_addr = dst + (i * job->dst_stride);
+        cfg.linked_ptr = last ? 0U : core_local_mem_to_sys_address(BOARD_RUNNING_CORE, (uint32_t)(uintptr_t)&draw_dma_desc[i]);
+        cfg.interrupt_mask = last ? DMA_INTERRUPT_MASK_HALF_TC : (DMA_INTERRUPT_MASK_TERMINAL_COUNT | DMA_INTERRUPT_MASK_HALF_TC);
+        if (dma_config_linked_descriptor(draw_dma.dma, &draw_dma_desc[i - 1U], draw_dma.ch, &cfg) != status_success) {
+            return status_fail;
+        }
+    }
+
+    cfg.src_addr = src;
+    cfg.dst_addr = dst;
+    cfg.linked_ptr = (rows > 1U) ? core_local_mem_to_sys_address(BOARD_RUNNING_CORE, (uint32_t)(uintptr_t)&draw_dma_desc[0]) : 0U;
+    cfg.interrupt_mask = (rows > 1U) ? (DMA_INTERRUPT_MASK_TERMINAL_COUNT | DMA_INTERRUPT_MASK_HALF_TC) : DMA_INTERRUPT_MASK_HALF_TC;
+
+    return dma_setup_channel(draw_dma.dma, draw_dma.ch, &cfg, true);
+}
+
+/* Wake LVGL's dispatcher (ISR context). */
+HPM_LVGL_HOT_ATTR static inline void draw_dma_wake(void)
+{
+#if LV_USE_OS
+    lv_thread_sync_signal_isr(&LV_GLOBAL_DEFAULT()->draw_info.sync);
+#else
+    lv_draw_dispatch_request();
+#endif
+}
+
+HPM_LVGL_HOT_ATTR static void draw_dma_complete(bool ok)
+{
+    lv_draw_task_t *t = draw_dma.unit->task_act;
+
+    if (t == NULL) {
+        return;
+    }
+
+    draw_dma.stats.dma_cycles += hpm_csr_get_core_cycle() - draw_dma.start_cycle;
+    if (!ok) {
+        draw_dma.stats.errors++;
+        draw_dma_run_cpu(&draw_dma.job);
+    }
+
+    /* The dispatcher frees the task once it sees READY: drop the reference first. */
+    draw_dma.unit->task_act = NULL;
+    __asm volatile("" ::: "memory");
+    t->state = LV_DRAW_TASK_STATE_READY;
+    draw_dma_wake();
+}
+
+#if USE_DMA_MGR
+HPM_LVGL_HOT_ATTR static void draw_dma_tc_cb(DMA_Type *base, uint32_t channel, void *cb_data_ptr)
+{
+    (void)base;
+    (void)channel;
+    (void)cb_data_ptr;
+
+    draw_dma_complete(true);
+}
+
+/* Bus error or abort: the CPU redoes the task, as the legacy IRQ handler does */
+static void draw_dma_error_cb(DMA_Type *base, uint32_t channel, void *cb_data_ptr)
+{
+    (void)base;
+    (void)channel;
+    (void)cb_data_ptr;
+
+    draw_dma_complete(false);
+}
+#endif
+
+static int32_t draw_dma_dispatch_cb(lv_draw_unit_t *draw_unit, lv_layer_t *layer)
+{
+    draw_dma_unit_t *u = (draw_dma_unit_t *)draw_unit;
+
+    if (u->task_act != NULL) {
+        return 0;
+    }
+
+    lv_draw_task_t *t = lv_draw_get_next_available_task(layer, NULL, DRAW_DMA_UNIT_ID);
+    if ((t == NULL) || (t->preferred_draw_unit_id != DRAW_DMA_UNIT_ID)) {
+        return LV_DRAW_UNIT_IDLE;
+    }
+
+    uint64_t start = hpm_csr_get_core_cycle();
+    draw_dma_job_t *job = &draw_dma.job;
+
+    t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+    if (!draw_dma_prepare(t, job)) {
+        /* Claimed at creation, but the buffer placement changed since: hand it to the CPU */
+        t->preferred_draw_unit_id = DRAW_DMA_SW_UNIT_ID;
+        t->preference_score = DRAW_DMA_SW_SCORE;
+        t->state = LV_DRAW_TASK_STATE_QUEUED;
+        draw_dma.stats.cpu_tasks++;
+        return 0;
+    }
+
+    u->base.target_layer = layer;
+    u->base.clip_area = &t->clip_area;
+    u->task_act = t;
+    draw_dma.start_cycle = start;
+    if (draw_dma_start(job) != status_success) {
+        u->task_act = NULL;
+        draw_dma_run_cpu(job);
+        draw_dma.stats.cpu_tasks++;
+        t->state = LV_DRAW_TASK_STATE_READY;
+        lv_draw_dispatch_request();
+        return 1;
+    }
+
+    uint32_t px = (job->row_bytes / 2U) * job->rows;
+    uint32_t per_kpx;
+    if (job->src != NULL) {
+        draw_dma.stats.copies++;
+        per_kpx = draw_dma.stats.copy_cycles_per_kpx;
+    } else {
+        draw_dma.stats.fills++;
+        per_kpx = draw_dma.stats.fill_cycles_per_kpx;
+    }
+    draw_dma.stats.pixels += px;
+    draw_dma.stats.cpu_est_cycles += ((uint64_t)px * per_kpx) / 1024U;
+    draw_dma.stats.setup_cycles += hpm_csr_get_core_cycle() - start;
+
+    return 1;
+}
+
+/*============================================================================
+ * API Functions
+ *============================================================================*/
+
+hpm_stat_t hpm_lvgl_draw_dma_init(lv_display_t *disp)
+{
+    memset(&draw_dma, 0, sizeof(draw_dma));
+
+#if USE_DMA_MGR
+    if (dma_mgr_request_resource(&draw_dma_resource) != status_success) {
+        return status_fail;
+    }
+    dma_mgr_install_chn_tc_callback(&draw_dma_resource, draw_dma_tc_cb, NULL);
+    dma_mgr_install_chn_error_callback(&draw_dma_resource, draw_dma_error_cb, NULL);
+    dma_mgr_install_chn_abort_callback(&draw_dma_resource, draw_dma_error_cb, NULL);
+    dma_mgr_enable_dma_irq_with_priority(&draw_dma_resource, 5);
+    draw_dma.dma = draw_dma_resource.base;
+    draw_dma.ch = (uint8_t)draw_dma_resource.channel;
+#else
+    draw_dma.dma = BOARD_LCD_DMA;
+    draw_dma.ch = HPM_LVGL_DRAW_DMA_CH;
+#endif
+
+    /* The draw buffer is not on screen yet (the splash and the first frame overwrite it). */
+    if ((disp != NULL) && (disp->buf_1 != NULL)) {
+        draw_dma.stats.fill_cycles_per_kpx = draw_dma_calibrate(disp->buf_1, NULL);
+        draw_dma.stats.copy_cycles_per_kpx = draw_dma_calibrate(disp->buf_1, (const uint8_t *)draw_dma_cal_row);
+    }
+
+    draw_dma.unit = lv_draw_create_unit(sizeof(draw_dma_unit_t));
+    draw_dma.unit->base.evaluate_cb = draw_dma_evaluate_cb;
+    draw_dma.unit->base.dispatch_cb = draw_dma_dispatch_cb;
+
+    return status_success;
+}
+
+HPM_LVGL_HOT_ATTR void hpm_lvgl_draw_dma_irq_handler(void)
+{
+#if !USE_DMA_MGR
+    if (draw_dma.unit == NULL) {
+        return;
+    }
+
+    uint32_t stat = dma_check_transfer_status(draw_dma.dma, draw_dma.ch);
+    if ((stat & (DMA_CHANNEL_STATUS_TC | DMA_CHANNEL_STATUS_ERROR | DMA_CHANNEL_STATUS_ABORT)) != 0U) {
+        draw_dma_complete((stat & DMA_CHANNEL_STATUS_TC) != 0U);
+    }
+#endif
+}
+
+void hpm_lvgl_draw_dma_reset(void)
+{
+    uint32_t fill = draw_dma.stats.fill_cycles_per_kpx;
+    uint32_t copy = draw_dma.stats.copy_cycles_per_kpx;
+
+    memset(&draw_dma.stats, 0, sizeof(draw_dma.stats));
+    draw_dma.stats.fill_cycles_per_kpx = fill;
+    draw_dma.stats.copy_cycles_per_kpx = copy;
+}
+
+void hpm_lvgl_draw_dma_get_stats(hpm_lvgl_draw_dma_stats_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    *out = draw_dma.stats;
+    uint64_t spent = out->setup_cycles + out->dma_cycles;
+    out->saved_min_cycles = (out->cpu_est_cycles > spent) ? (out->cpu_est_cycles - spent) : 0U;
+    out->saved_max_cycles = (out->cpu_est_cycles > out->setup_cycles) ? (out->cpu_est_cycles - out->setup_cycles) : 0U;
+}
+
+void hpm_lvgl_draw_dma_dump(void)
+{
+    hpm_lvgl_draw_dma_stats_t s;
+
+    hpm_lvgl_draw_dma_get_stats(&s);
+
+    printf("# hpm_lvgl_draw_dma fills=%lu copies=%lu cpu_tasks=%lu errors=%lu pixels=%lu\n",
+           (unsigned long)s.fills, (unsigned long)s.copies, (unsigned long)s.cpu_tasks,
+           (unsigned long)s.errors, (unsigned long)s.pixels);
+    printf("C fill_cyc_per_kpx=%lu copy_cyc_per_kpx=%lu cpu_est=%lu setup=%lu dma=%lu\n",
+           (unsigned long)s.fill_cycles_per_kpx, (unsigned long)s.copy_cycles_per_kpx,
+           (unsigned long)s.cpu_est_cycles, (unsigned long)s.setup_cycles, (unsigned long)s.dma_cycles);
+    printf("S saved_min=%lu saved_max=%lu\n", (unsigned long)s.saved_min_cycles, (unsigned long)s.saved_max_cycles);
+    printf("# hpm_lvgl_draw_dma end\n");
+}
+
+#endif /* HPM_LVGL_DRAW_DMA */
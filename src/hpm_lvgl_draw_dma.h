@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * DMA draw unit for opaque fills and image copies
+ *
+ * An LVGL draw unit that takes opaque rectangle fills (no radius, no gradient) and unscaled,
+ * opaque RGB565 image copies into the display draw buffer, and runs them on a spare DMA channel
+ * as memory-to-memory transfers (one linked descriptor per row). LVGL's dispatcher keeps
+ * rendering the independent tasks of the strip on the CPU in the meantime; the DMA completion
+ * interrupt hands the task back as finished.
+ */
+
+#ifndef HPM_LVGL_DRAW_DMA_H
+#define HPM_LVGL_DRAW_DMA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hpm_common.h"
+#include "lvgl.h"
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+/* Disabled by default: every task stays on LVGL's software renderer. */
+#ifndef HPM_LVGL_DRAW_DMA
+#define HPM_LVGL_DRAW_DMA           0
+#endif
+
+/* Smaller areas stay on the CPU: descriptor setup costs about as much as filling them. */
+#ifndef HPM_LVGL_DRAW_DMA_MIN_PX
+#define HPM_LVGL_DRAW_DMA_MIN_PX    512U
+#endif
+
+/* Also copy opaque RGB565 images (variable sources in memory, no transform or recolor). */
+#ifndef HPM_LVGL_DRAW_DMA_IMAGES
+#define HPM_LVGL_DRAW_DMA_IMAGES    1
+#endif
+
+/* Rows one transfer can cover (one descriptor each); taller areas stay on the CPU. */
+#ifndef HPM_LVGL_DRAW_DMA_MAX_ROWS
+#define HPM_LVGL_DRAW_DMA_MAX_ROWS  HPM_LVGL_FB_LINES
+#endif
+
+/* Descriptors and the fill pattern are read by the DMA: keep them out of the D-cache */
+#ifndef HPM_LVGL_DRAW_DMA_ATTR
+#if defined(ATTR_PLACE_AT_NONCACHEABLE_WITH_ALIGNMENT)
+#define HPM_LVGL_DRAW_DMA_ATTR      ATTR_PLACE_AT_NONCACHEABLE_WITH_ALIGNMENT(8)
+#else
+#define HPM_LVGL_DRAW_DMA_ATTR      __attribute__((aligned(8), section(".noncacheable")))
+#endif
+#endif
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+typedef struct {
+    uint32_t fills;             /* Fills run by the DMA */
+    uint32_t copies;            /* Image copies run by the DMA */
+    uint32_t cpu_tasks;         /* Claimed tasks the unit had to run on the CPU after all */
+    uint32_t errors;            /* Transfers that ended in a DMA error (redone on the CPU) */
+    uint64_t pixels;            /* Pixels written by the DMA */
+    uint64_t cpu_est_cycles;    /* What the CPU would have spent on those pixels (calibrated at init) */
+    uint64_t setup_cycles;      /* CPU time spent building descriptors and starting the channel */
+    uint64_t dma_cycles;        /* Time the channel was busy */
+    uint64_t saved_min_cycles;  /* cpu_est - setup - dma: the renderer waited for every transfer */
+    uint64_t saved_max_cycles;  /* cpu_est - setup: every transfer overlapped other rendering */
+    uint32_t fill_cycles_per_kpx;   /* Calibration: CPU cycles per 1024 filled pixels */
+    uint32_t copy_cycles_per_kpx;   /* Calibration: CPU cycles per 1024 copied pixels */
+} hpm_lvgl_draw_dma_stats_t;
+
+/*============================================================================
+ * API Functions
+ *============================================================================*/
+
+#if HPM_LVGL_DRAW_DMA
+
+/**
+ * @brief Get a DMA channel, calibrate the CPU estimate and register the draw unit
+ * @note Called by `hpm_lvgl_spi_init()` once the draw buffers are set; tasks stay on the CPU
+ *       when it fails.
+ * @return status_success, or status_fail if no DMA channel is free
+ */
+hpm_stat_t hpm_lvgl_draw_dma_init(lv_display_t *disp);
+
+/**
+ * @brief Completion handler, called from the display DMA ISR (legacy path, `USE_DMA_MGR == 0`)
+ */
+void hpm_lvgl_draw_dma_irq_handler(void);
+
+/**
+ * @brief Clear the counters (the calibration is kept)
+ */
+void hpm_lvgl_draw_dma_reset(void);
+
+/**
+ * @brief Get offload statistics
+ * @param out Output stats (must not be NULL)
+ */
+void hpm_lvgl_draw_dma_get_stats(hpm_lvgl_draw_dma_stats_t *out);
+
+/**
+ * @brief Print offload statistics over the console UART
+ */
+void hpm_lvgl_draw_dma_dump(void);
+
+#else
+
+static inline hpm_stat_t hpm_lvgl_draw_dma_init(lv_display_t *disp) { (void)disp; return status_success; }
+static inline void hpm_lvgl_draw_dma_irq_handler(void) {}
+static inline void hpm_lvgl_draw_dma_reset(void) {}
+static inline void hpm_lvgl_draw_dma_get_stats(hpm_lvgl_draw_dma_stats_t *out) { (void)out; }
+static inline void hpm_lvgl_draw_dma_dump(void) {}
+
+#endif /* HPM_LVGL_DRAW_DMA */
+
+#endif /* HPM_LVGL_DRAW_DMA_H */
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Packed-SIMD RGB565 kernels implementation
+ *
+ * Each kernel reproduces the per-pixel arithmetic of LVGL's generic loop (lv_color_16_16_mix() and
+ * lv_color_24_16_mix() in lv_draw_sw_blend_to_rgb565.c). The packed helpers below have one
+ * definition per instruction set; the portable ones compute exactly what the instructions do, so
+ * the host build checks the target arithmetic.
+ */
+
+#include "hpm_lvgl_dsp.h"
+
+#if HPM_LVGL_DSP
+
+#include "lvgl.h"
+#include <stdint.h>
+
+#if HPM_LVGL_DSP_ISA == 1
+#include <nds_intrinsic.h>
+#elif HPM_LVGL_DSP_ISA == 2
+#include <rvp_intrinsic.h>
+#endif
+
+/* RGB565 spread over a word as ...GGGGGG.....RRRRR......BBBBB: 5 spare bits above each field */
+#define DSP_565_SPREAD_MASK         0x07E0F81FUL
+
+/*============================================================================
+ * Packed helpers
+ *============================================================================*/
+
+#if HPM_LVGL_DSP_ISA == 1
+
+/* {a.lo, b.lo} */
+static inline uint32_t dsp_pkbb16(uint32_t a, uint32_t b) { return (uint32_t)__nds__pkbb16(a, b); }
+/* {a.hi, b.hi} */
+static inline uint32_t dsp_pktt16(uint32_t a, uint32_t b) { return (uint32_t)__nds__pktt16(a, b); }
+/* Byte swap in each halfword */
+static inline uint32_t dsp_swap8(uint32_t a) { return (uint32_t)__nds__swap8(a); }
+/* Logical right shift of each halfword by 8 */
+static inline uint32_t dsp_srl16_8(uint32_t a) { return (uint32_t)__nds__srl16(a, 8); }
+
+#elif HPM_LVGL_DSP_ISA == 2
+
+static inline uint32_t dsp_pkbb16(uint32_t a, uint32_t b) { return (uint32_t)__rv_pkbb16(a, b); }
+static inline uint32_t dsp_pktt16(uint32_t a, uint32_t b) { return (uint32_t)__rv_pktt16(a, b); }
+static inline uint32_t dsp_swap8(uint32_t a) { return (uint32_t)__rv_swap8(a); }
+static inline uint32_t dsp_srl16_8(uint32_t a) { return (uint32_t)__rv_srl16(a, 8); }
+
+#else
+
+static inline uint32_t dsp_pkbb16(uint32_t a, uint32_t b) { return (a << 16) | (b & 0xFFFFU); }
+static inline uint32_t dsp_pktt16(uint32_t a, uint32_t b) { return (a & 0xFFFF0000UL) | (b >> 16); }
+static inline uint32_t dsp_swap8(uint32_t a) { return ((a & 0x00FF00FFUL) << 8) | ((a >> 8) & 0x00FF00FFUL); }
+static inline uint32_t dsp_srl16_8(uint32_t a) { return (a >> 8) & 0x00FF00FFUL; }
+
+#endif
+
+static inline void *dsp_next_row(void *p, int32_t stride)
+{
+    return (uint8_t *)p + stride;
+}
+
+static inline const void *dsp_next_row_const(const void *p, int32_t stride)
+{
+    return (const uint8_t *)p + stride;
+}
+
+/*============================================================================
+ * Per-pixel arithmetic
+ *============================================================================*/
+
+/*
+ * RGB565 mix of a spread foreground, premultiplied by mix (0..32), into one background pixel.
+ * Per field: (bg * (32 - mix) + fg * mix) >> 5. The largest field sum (63 * 32) still fits below the
+ * next field, so this is exactly lv_color_16_16_mix() with mix = (opa + 4) >> 3.
+ * The result is valid in the low halfword.
+ */
+static inline uint32_t dsp_mix565_premul(uint32_t bg_px, uint32_t fg_premul, uint32_t inv)
+{
+    uint32_t bg = dsp_pkbb16(bg_px, bg_px) & DSP_565_SPREAD_MASK;
+    uint32_t r = ((bg * inv + fg_premul) >> 5) & DSP_565_SPREAD_MASK;
+
+    return r | (r >> 16);
+}
+
+/* Same mix with two spread operands, as LVGL writes it: bg + (fg - bg) * mix >> 5. */
+static inline uint32_t dsp_mix565(uint32_t fg, uint32_t bg, uint32_t mix)
+{
+    uint32_t r = (((((fg - bg) * mix) >> 5) + bg) & DSP_565_SPREAD_MASK);
+
+    return r | (r >> 16);
+}
+
+/* lv_color_24_16_mix(): ARGB8888 over RGB565 with mix 0..255. R and B are blended as a halfword pair. */
+static inline uint32_t dsp_mix8888(uint32_t s, uint32_t d, uint32_t mix)
+{
+    if (mix == 0U) {
+        return d;
+    }
+    if (mix == 255U) {
+        return ((s >> 8) & 0xF800U) | ((s >> 5) & 0x07E0U) | ((s >> 3) & 0x001FU);
+    }
+
+    uint32_t inv = 255U - mix;
+    uint32_t rb = ((s >> 3) & 0x001F001FUL) * mix + (dsp_pkbb16(d >> 11, d) & 0x001F001FUL) * inv;
+    uint32_t g = ((s >> 10) & 0x3FU) * mix + ((d >> 5) & 0x3FU) * inv;
+
+    rb = dsp_srl16_8(rb);
+    return ((rb >> 16) << 11) | ((g >> 8) << 5) | (rb & 0xFFFFU);
+}
+
+/* Per-pixel alpha scaled by the global opacity; 255 means "opaque layer" (LVGL's no-opa path). */
+static inline uint32_t dsp_alpha(uint32_t s, uint32_t opa)
+{
+    return (opa == 255U) ? (s >> 24) : (((s >> 24) * opa) >> 8);
+}
+
+/*============================================================================
+ * Kernels
+ *============================================================================*/
+
+LV_ATTRIBUTE_FAST_MEM void hpm_lvgl_dsp_fill(uint16_t *dst, int32_t w, int32_t h, int32_t dst_stride, uint16_t color)
+{
+    const uint32_t c2 = dsp_pkbb16(color, color);
+
+    for (int32_t y = 0; y < h; y++) {
+        uint16_t *p = dst;
+        int32_t n = w;
+
+        if ((((uintptr_t)p & 2U) != 0U) && (n > 0)) {
+            *p++ = color;
+            n--;
+        }
+        uint32_t *p32 = (uint32_t *)p;
+        for (; n >= 16; n -= 16) {
+            p32[0] = c2;
+            p32[1] = c2;
+            p32[2] = c2;
+            p32[3] = c2;
+            p32[4] = c2;
+            p32[5] = c2;
+            p32[6] = c2;
+            p32[7] = c2;
+            p32 += 8;
+        }
+        for (; n >= 2; n -= 2) {
+            *p32++ = c2;
+        }
+        if (n > 0) {
+            *(uint16_t *)p32 = color;
+        }
+        dst = dsp_next_row(dst, dst_stride);
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM void hpm_lvgl_dsp_fill_opa(uint16_t *dst, int32_t w, int32_t h, int32_t dst_stride, uint16_t color,
+                                                 uint8_t opa)
+{
+    const uint32_t mix = ((uint32_t)opa + 4U) >> 3;
+    const uint32_t inv = 32U - mix;
+    const uint32_t fg = (dsp_pkbb16(color, color) & DSP_565_SPREAD_MASK) * mix;
+
+    /* Backgrounds are mostly flat: reuse the result while the destination pair repeats */
+    uint32_t last_in = 0;
+    uint32_t last_out = dsp_mix565_premul(0, fg, inv);
+
+    last_out = dsp_pkbb16(last_out, last_out);
+
+    for (int32_t y = 0; y < h; y++) {
+        uint16_t *p = dst;
+        int32_t n = w;
+
+        if ((((uintptr_t)p & 2U) != 0U) && (n > 0)) {
+            *p = (uint16_t)dsp_mix565_premul(*p, fg, inv);
+            p++;
+            n--;
+        }
+        uint32_t *p32 = (uint32_t *)p;
+        for (; n >= 2; n -= 2) {
+            uint32_t in = *p32;
+            if (in != last_in) {
+                uint32_t lo = dsp_mix565_premul(in, fg, inv);
+                uint32_t hi = dsp_mix565_premul(in >> 16, fg, inv);
+                last_in = in;
+                last_out = dsp_pkbb16(hi, lo);
+            }
+            *p32++ = last_out;
+        }
+        if (n > 0) {
+            p = (uint16_t *)p32;
+            *p = (uint16_t)dsp_mix565_premul(*p, fg, inv);
+        }
+        dst = dsp_next_row(dst, dst_stride);
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM void hpm_lvgl_dsp_rgb565_blend_opa(uint16_t *dst, int32_t w, int32_t h, int32_t dst_stride,
+                                                         const uint16_t *src, int32_t src_stride, uint8_t opa)
+{
+    const uint32_t mix = ((uint32_t)opa + 4U) >> 3;
+
+    for (int32_t y = 0; y < h; y++) {
+        uint16_t *d = dst;
+        const uint16_t *s = src;
+        int32_t n = w;
+
+        /* Pairs need both rows word aligned at the same pixel */
+        if ((((uintptr_t)d ^ (uintptr_t)s) & 2U) == 0U) {
+            if ((((uintptr_t)d & 2U) != 0U) && (n > 0)) {
+                *d = (uint16_t)dsp_mix565(dsp_pkbb16(*s, *s) & DSP_565_SPREAD_MASK,
+                                          dsp_pkbb16(*d, *d) & DSP_565_SPREAD_MASK, mix);
+                d++;
+                s++;
+                n--;
+            }
+            uint32_t *d32 = (uint32_t *)d;
+            const uint32_t *s32 = (const uint32_t *)s;
+            for (; n >= 2; n -= 2) {
+                uint32_t sp = *s32++;
+                uint32_t dp = *d32;
+                uint32_t lo = dsp_mix565(dsp_pkbb16(sp, sp) & DSP_565_SPREAD_MASK,
+                                         dsp_pkbb16(dp, dp) & DSP_565_SPREAD_MASK, mix);
+                uint32_t hi = dsp_mix565(dsp_pktt16(sp, sp) & DSP_565_SPREAD_MASK,
+                                         dsp_pktt16(dp, dp) & DSP_565_SPREAD_MASK, mix);
+                *d32++ = dsp_pkbb16(hi, lo);
+            }
+            d = (uint16_t *)d32;
+            s = (const uint16_t *)s32;
+        }
+        for (; n > 0; n--) {
+            *d = (uint16_t)dsp_mix565(dsp_pkbb16(*s, *s) & DSP_565_SPREAD_MASK,
+                                      dsp_pkbb16(*d, *d) & DSP_565_SPREAD_MASK, mix);
+            d++;
+            s++;
+        }
+        dst = dsp_next_row(dst, dst_stride);
+        src = dsp_next_row_const(src, src_stride);
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM void hpm_lvgl_dsp_argb8888_blend(uint16_t *dst, int32_t w, int32_t h, int32_t dst_stride,
+                                                       const uint32_t *src, int32_t src_stride, uint8_t opa)
+{
+    for (int32_t y = 0; y < h; y++) {
+        uint16_t *d = dst;
+        const uint32_t *s = src;
+        int32_t n = w;
+
+        if ((((uintptr_t)d & 2U) != 0U) && (n > 0)) {
+            *d = (uint16_t)dsp_mix8888(s[0], *d, dsp_alpha(s[0], opa));
+            d++;
+            s++;
+            n--;
+        }
+        uint32_t *d32 = (uint32_t *)d;
+        for (; n >= 2; n -= 2) {
+            uint32_t dp = *d32;
+            uint32_t lo = dsp_mix8888(s[0], dp & 0xFFFFU, dsp_alpha(s[0], opa));
+            uint32_t hi = dsp_mix8888(s[1], dp >> 16, dsp_alpha(s[1], opa));
+            *d32++ = dsp_pkbb16(hi, lo);
+            s += 2;
+        }
+        if (n > 0) {
+            d = (uint16_t *)d32;
+            *d = (uint16_t)dsp_mix8888(s[0], *d, dsp_alpha(s[0], opa));
+        }
+        dst = dsp_next_row(dst, dst_stride);
+        src = dsp_next_row_const(src, src_stride);
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM void hpm_lvgl_dsp_rgb565_swap(void *buf, uint32_t px)
+{
+    uint16_t *p = buf;
+
+    if ((((uintptr_t)p & 2U) != 0U) && (px > 0U)) {
+        *p = (uint16_t)dsp_swap8(*p);
+        p++;
+        px--;
+    }
+    uint32_t *p32 = (uint32_t *)p;
+    for (; px >= 8U; px -= 8U) {
+        p32[0] = dsp_swap8(p32[0]);
+        p32[1] = dsp_swap8(p32[1]);
+        p32[2] = dsp_swap8(p32[2]);
+        p32[3] = dsp_swap8(p32[3]);
+        p32 += 4;
+    }
+    for (; px >= 2U; px -= 2U) {
+        *p32 = dsp_swap8(*p32);
+        p32++;
+    }
+    if (px > 0U) {
+        p = (uint16_t *)p32;
+        *p = (uint16_t)dsp_swap8(*p);
+    }
+}
+
+#endif /* HPM_LVGL_DSP */
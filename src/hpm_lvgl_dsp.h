@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Packed-SIMD RGB565 kernels for LVGL's software renderer
+ *
+ * Solid fill, fill with opacity, RGB565 blend with opacity, ARGB8888 -> RGB565 blend and the
+ * in-place RGB565 byte swap, plugged into LVGL through its custom draw-sw "asm" hooks
+ * (`LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM`, set by lv_conf_ext.h / lv_conf_standalone.h).
+ * With the RISC-V P extension (Andes DSP on the D45) the kernels use packed 16-bit instructions;
+ * otherwise the same code runs on portable C helpers. Results are bit-exact with LVGL's C loops.
+ *
+ * LVGL includes this file from its blend sources (`LV_DRAW_SW_ASM_CUSTOM_INCLUDE`), so it only
+ * depends on the C library.
+ */
+
+#ifndef HPM_LVGL_DSP_H
+#define HPM_LVGL_DSP_H
+
+#include <stdint.h>
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+/* Disabled by default: LVGL's generic C loops run. */
+#ifndef HPM_LVGL_DSP
+#define HPM_LVGL_DSP                0
+#endif
+
+/* Instruction set the kernels are built for: 0 portable C, 1 Andes DSP intrinsics (nds_intrinsic.h),
+ * 2 RISC-V P draft intrinsics (rvp_intrinsic.h). Follows the compiler's -march by default. */
+#ifndef HPM_LVGL_DSP_ISA
+#if defined(__riscv_dsp)
+#define HPM_LVGL_DSP_ISA            1
+#elif defined(__riscv_zpn) || defined(__riscv_p)
+#define HPM_LVGL_DSP_ISA            2
+#else
+#define HPM_LVGL_DSP_ISA            0
+#endif
+#endif
+
+/*============================================================================
+ * API Functions
+ *============================================================================*/
+
+#if HPM_LVGL_DSP
+
+/* Strides are in bytes, as in LVGL's blend descriptors. */
+
+/**
+ * @brief Fill a w x h RGB565 area with one color
+ */
+void hpm_lvgl_dsp_fill(uint16_t *dst, int32_t w, int32_t h, int32_t dst_stride, uint16_t color);
+
+/**
+ * @brief Mix one color into a w x h RGB565 area (`lv_color_16_16_mix()` per pixel)
+ */
+void hpm_lvgl_dsp_fill_opa(uint16_t *dst, int32_t w, int32_t h, int32_t dst_stride, uint16_t color, uint8_t opa);
+
+/**
+ * @brief Blend an RGB565 image into a w x h RGB565 area with a global opacity
+ */
+void hpm_lvgl_dsp_rgb565_blend_opa(uint16_t *dst, int32_t w, int32_t h, int32_t dst_stride,
+                                   const uint16_t *src, int32_t src_stride, uint8_t opa);
+
+/**
+ * @brief Blend an ARGB8888 image into a w x h RGB565 area (per-pixel alpha, scaled by opa)
+ */
+void hpm_lvgl_dsp_argb8888_blend(uint16_t *dst, int32_t w, int32_t h, int32_t dst_stride,
+                                 const uint32_t *src, int32_t src_stride, uint8_t opa);
+
+/**
+ * @brief Swap the bytes of px RGB565 pixels in place (little-endian render -> MSB-first wire order)
+ */
+void hpm_lvgl_dsp_rgb565_swap(void *buf, uint32_t px);
+
+/*
+ * LVGL hooks. Each evaluates to LV_RESULT_OK, so LVGL skips its own loop. LVGL only calls them for
+ * normal blending without a mask; the "no opa" variants also imply opa >= LV_OPA_MAX.
+ */
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565(dsc) \
+    (hpm_lvgl_dsp_fill((uint16_t *)(dsc)->dest_buf, (dsc)->dest_w, (dsc)->dest_h, (dsc)->dest_stride, \
+                       lv_color_to_u16((dsc)->color)), LV_RESULT_OK)
+
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA(dsc) \
+    (hpm_lvgl_dsp_fill_opa((uint16_t *)(dsc)->dest_buf, (dsc)->dest_w, (dsc)->dest_h, (dsc)->dest_stride, \
+                           lv_color_to_u16((dsc)->color), (dsc)->opa), LV_RESULT_OK)
+
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc) \
+    (hpm_lvgl_dsp_rgb565_blend_opa((uint16_t *)(dsc)->dest_buf, (dsc)->dest_w, (dsc)->dest_h, (dsc)->dest_stride, \
+                                   (const uint16_t *)(dsc)->src_buf, (dsc)->src_stride, (dsc)->opa), LV_RESULT_OK)
+
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565(dsc) \
+    (hpm_lvgl_dsp_argb8888_blend((uint16_t *)(dsc)->dest_buf, (dsc)->dest_w, (dsc)->dest_h, (dsc)->dest_stride, \
+                                 (const uint32_t *)(dsc)->src_buf, (dsc)->src_stride, 255U), LV_RESULT_OK)
+
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc) \
+    (hpm_lvgl_dsp_argb8888_blend((uint16_t *)(dsc)->dest_buf, (dsc)->dest_w, (dsc)->dest_h, (dsc)->dest_stride, \
+                                 (const uint32_t *)(dsc)->src_buf, (dsc)->src_stride, (dsc)->opa), LV_RESULT_OK)
+
+#define LV_DRAW_SW_RGB565_SWAP(buf, buf_size_px) \
+    (hpm_lvgl_dsp_rgb565_swap((buf), (buf_size_px)), LV_RESULT_OK)
+
+#endif /* HPM_LVGL_DSP */
+
+#endif /* HPM_LVGL_DSP_H */
@@ -0,0 +1,399 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Dual-core render/transfer split implementation
+ */
+
+#include "hpm_lvgl_dualcore.h"
+
+#if HPM_LVGL_DUALCORE
+
+#include "board.h"
+#include "hpm_csr_drv.h"
+#include "hpm_clock_drv.h"
+#include <stdio.h>
+#include <string.h>
+
+/*============================================================================
+ * Shared block (non-cacheable, same address in both images)
+ *============================================================================*/
+
+#define DUALCORE_MAGIC          0x4C564443UL    /* "LVDC" */
+#define DUALCORE_RING_MASK      (HPM_LVGL_DUALCORE_RING_LEN - 1U)
+
+typedef struct {
+    volatile uint32_t magic;            /* Core 1: ring initialized */
+    volatile uint32_t panel_ready;      /* Core 1: init sequence sent, panel on */
+    volatile uint32_t head;             /* Core 0 only: messages queued */
+    volatile uint32_t tail;             /* Core 1 only: messages taken */
+    volatile uint32_t done_seq;         /* Core 1: last finished message */
+    volatile uint32_t done_count;
+    volatile uint32_t last_xfer_us;
+    volatile uint32_t max_depth;
+    volatile uint64_t busy_us;
+    hpm_lvgl_dualcore_msg_t ring[HPM_LVGL_DUALCORE_RING_LEN];
+} dualcore_shared_t;
+
+#define DUALCORE_SHARED         ((dualcore_shared_t *)HPM_LVGL_DUALCORE_SHARED_ADDR)
+
+/* Order the slot contents against the index that publishes them. The block is non-cacheable,
+ * so this only has to keep the stores (and loads) in program order on the bus (`fence rw, rw`
+ * on RISC-V; the host ring test gets its own architecture's barrier). */
+static inline void dualcore_fence(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+#if HPM_LVGL_DUALCORE == 1
+
+/*============================================================================
+ * Core 0: producer
+ *============================================================================*/
+
+static struct {
+    uint32_t cpu_mhz;
+    uint32_t sent;
+    uint32_t pixel_msgs;
+    uint32_t ring_full;
+    uint32_t send_timeouts;
+} dualcore_tx;
+
+hpm_stat_t hpm_lvgl_dualcore_attach(void)
+{
+    dualcore_shared_t *sh = DUALCORE_SHARED;
+
+    for (uint32_t ms = 0; sh->magic != DUALCORE_MAGIC; ms++) {
+        if (ms >= HPM_LVGL_DUALCORE_ATTACH_TIMEOUT_MS) {
+            printf("hpm_lvgl_dualcore: core 1 transport not running\n");
+            return status_timeout;
+        }
+        board_delay_ms(1);
+    }
+    dualcore_fence();
+    memset(&dualcore_tx, 0, sizeof(dualcore_tx));
+    dualcore_tx.cpu_mhz = clock_get_frequency(clock_cpu0) / 1000000UL;
+    if (dualcore_tx.cpu_mhz == 0U) {
+        dualcore_tx.cpu_mhz = 1U;
+    }
+
+    return status_success;
+}
+
+bool hpm_lvgl_dualcore_panel_ready(void)
+{
+    return DUALCORE_SHARED->panel_ready != 0U;
+}
+
+HPM_LVGL_DUALCORE_HOT_ATTR hpm_stat_t hpm_lvgl_dualcore_send(hpm_lvgl_dualcore_msg_t *msg)
+{
+    dualcore_shared_t *sh = DUALCORE_SHARED;
+    uint32_t head = sh->head;
+
+    if ((head - sh->tail) >= HPM_LVGL_DUALCORE_RING_LEN) {
+        uint64_t start = hpm_csr_get_core_cycle();
+        uint64_t limit = (uint64_t)HPM_LVGL_DUALCORE_SEND_TIMEOUT_MS * 1000U * dualcore_tx.cpu_mhz;
+
+        dualcore_tx.ring_full++;
+        while ((head - sh->tail) >= HPM_LVGL_DUALCORE_RING_LEN) {
+            /* Core 1 stalled or never booted: drop the message rather than hang the renderer */
+            if ((hpm_csr_get_core_cycle() - start) > limit) {
+                dualcore_tx.send_timeouts++;
+                return status_timeout;
+            }
+        }
+        /* The slot core 1 just released must not be overwritten before it read it. */
+        dualcore_fence();
+    }
+
+    msg->seq = head + 1U;
+    sh->ring[head & DUALCORE_RING_MASK] = *msg;
+    dualcore_fence();
+    sh->head = head + 1U;
+
+    dualcore_tx.sent++;
+    if (msg->type == HPM_LVGL_DUALCORE_MSG_PIXELS) {
+        dualcore_tx.pixel_msgs++;
+    }
+    return status_success;
+}
+
+HPM_LVGL_DUALCORE_HOT_ATTR bool hpm_lvgl_dualcore_done(uint32_t seq, uint32_t *xfer_us)
+{
+    dualcore_shared_t *sh = DUALCORE_SHARED;
+
+    if ((int32_t)(sh->done_seq - seq) < 0) {
+        return false;
+    }
+    dualcore_fence();
+    if (xfer_us != NULL) {
+        *xfer_us = sh->last_xfer_us;
+    }
+    return true;
+}
+
+void hpm_lvgl_dualcore_get_stats(hpm_lvgl_dualcore_stats_t *out)
+{
+    dualcore_shared_t *sh = DUALCORE_SHARED;
+    uint64_t busy;
+
+    if (out == NULL) {
+        return;
+    }
+
+    /* 64-bit value written by the other core: re-read until both halves belong together. */
+    do {
+        busy = sh->busy_us;
+    } while (busy != sh->busy_us);
+
+    out->sent = dualcore_tx.sent;
+    out->pixel_msgs = dualcore_tx.pixel_msgs;
+    out->ring_full = dualcore_tx.ring_full;
+    out->send_timeouts = dualcore_tx.send_timeouts;
+    out->max_depth = sh->max_depth;
+    out->done = sh->done_count;
+    out->core1_busy_us = busy;
+    out->last_xfer_us = sh->last_xfer_us;
+}
+
+void hpm_lvgl_dualcore_dump(void)
+{
+    hpm_lvgl_dualcore_stats_t s;
+
+    hpm_lvgl_dualcore_get_stats(&s);
+    printf("# hpm_lvgl_dualcore sent=%lu pixels=%lu done=%lu ring_full=%lu timeouts=%lu max_depth=%lu/%u "
+           "core1_busy_us=%llu last_xfer_us=%lu\n",
+           (unsigned long)s.sent, (unsigned long)s.pixel_msgs, (unsigned long)s.done,
+           (unsigned long)s.ring_full, (unsigned long)s.send_timeouts, (unsigned long)s.max_depth,
+           (unsigned int)HPM_LVGL_DUALCORE_RING_LEN,
+           (unsigned long long)s.core1_busy_us, (unsigned long)s.last_xfer_us);
+}
+
+#else /* HPM_LVGL_DUALCORE == 2 */
+
+/*============================================================================
+ * Core 1: consumer, owns SPI/DMA through st7789.c
+ *============================================================================*/
+
+#include "st7789.h"
+#include "hpm_interrupt.h"
+
+/* Core 1 does not include hpm_lvgl_spi.h (no LVGL in its image): same panel defaults. */
+#ifndef HPM_LVGL_LCD_WIDTH
+#define HPM_LVGL_LCD_WIDTH      172
+#endif
+
+#ifndef HPM_LVGL_LCD_HEIGHT
+#define HPM_LVGL_LCD_HEIGHT     320
+#endif
+
+#ifndef HPM_LVGL_SPI_FREQ
+#ifdef BOARD_LCD_SPI_CLK_FREQ
+#define HPM_LVGL_SPI_FREQ       BOARD_LCD_SPI_CLK_FREQ
+#else
+#define HPM_LVGL_SPI_FREQ       (40000000UL)
+#endif
+#endif
+
+/* Board defaults, as in hpm_lvgl_spi.c */
+#ifndef BOARD_LCD_SPI
+#define BOARD_LCD_SPI           HPM_SPI7
+#endif
+
+#ifndef BOARD_LCD_SPI_CLK_NAME
+#define BOARD_LCD_SPI_CLK_NAME  clock_spi7
+#endif
+
+#ifndef BOARD_LCD_DMA
+#define BOARD_LCD_DMA           HPM_HDMA
+#endif
+
+#ifndef BOARD_LCD_DMAMUX
+#define BOARD_LCD_DMAMUX        HPM_DMAMUX
+#endif
+
+#ifndef BOARD_LCD_DMA_CH
+#define BOARD_LCD_DMA_CH        0
+#endif
+
+#ifndef BOARD_LCD_DMA_MUX_CH
+#define BOARD_LCD_DMA_MUX_CH    DMAMUX_MUXCFG_HDMA_MUX0
+#endif
+
+#ifndef BOARD_LCD_DMA_SRC
+#define BOARD_LCD_DMA_SRC       HPM_DMA_SRC_SPI7_TX
+#endif
+
+#ifndef BOARD_LCD_DMA_IRQ
+#define BOARD_LCD_DMA_IRQ       IRQn_HDMA
+#endif
+
+#ifndef BOARD_LCD_GPIO
+#define BOARD_LCD_GPIO          HPM_GPIO0
+#endif
+
+#ifndef BOARD_LCD_X_OFFSET
+#define BOARD_LCD_X_OFFSET      34
+#endif
+
+#ifndef BOARD_LCD_Y_OFFSET
+#define BOARD_LCD_Y_OFFSET      0
+#endif
+
+static struct {
+    uint32_t cpu_mhz;
+    volatile bool xfer_busy;
+    uint32_t xfer_seq;
+    uint64_t xfer_start_cycle;
+} dualcore_rx;
+
+/* Publish a finished message to core 0 (task or ISR context). */
+HPM_LVGL_DUALCORE_HOT_ATTR static void dualcore_complete(dualcore_shared_t *sh, uint32_t seq)
+{
+    sh->done_count++;
+    dualcore_fence();
+    sh->done_seq = seq;
+}
+
+HPM_LVGL_DUALCORE_HOT_ATTR static void dualcore_xfer_done(void *user_data)
+{
+    dualcore_shared_t *sh = DUALCORE_SHARED;
+    uint32_t us = (uint32_t)((hpm_csr_get_core_cycle() - dualcore_rx.xfer_start_cycle) / dualcore_rx.cpu_mhz);
+
+    (void)user_data;
+    sh->last_xfer_us = us;
+    sh->busy_us += us;
+    dualcore_rx.xfer_busy = false;
+    dualcore_complete(sh, dualcore_rx.xfer_seq);
+}
+
+SDK_DECLARE_EXT_ISR_M(BOARD_LCD_DMA_IRQ, hpm_lvgl_dualcore_dma_isr)
+HPM_LVGL_DUALCORE_HOT_ATTR void hpm_lvgl_dualcore_dma_isr(void)
+{
+    st7789_dma_irq_handler();
+}
+
+hpm_stat_t hpm_lvgl_dualcore_transport_init(void)
+{
+    dualcore_shared_t *sh = DUALCORE_SHARED;
+    st7789_config_t cfg = {0};
+
+    memset(sh, 0, sizeof(*sh));
+    memset(&dualcore_rx, 0, sizeof(dualcore_rx));
+    dualcore_rx.cpu_mhz = clock_get_frequency(clock_cpu1) / 1000000UL;
+    if (dualcore_rx.cpu_mhz == 0U) {
+        dualcore_rx.cpu_mhz = 1U;
+    }
+
+    /* Core 0 may start queueing (the splash, its first frame) while the panel comes up. */
+    dualcore_fence();
+    sh->magic = DUALCORE_MAGIC;
+
+    cfg.spi_base = BOARD_LCD_SPI;
+    cfg.spi_clk_name = BOARD_LCD_SPI_CLK_NAME;
+    cfg.spi_freq_hz = HPM_LVGL_SPI_FREQ;
+    cfg.dma_base = BOARD_LCD_DMA;
+    cfg.dmamux_base = BOARD_LCD_DMAMUX;
+    cfg.dma_channel = BOARD_LCD_DMA_CH;
+    cfg.dma_mux_channel = BOARD_LCD_DMA_MUX_CH;
+    cfg.dma_src_request = BOARD_LCD_DMA_SRC;
+    cfg.dma_irq_num = BOARD_LCD_DMA_IRQ;
+    cfg.gpio_base = BOARD_LCD_GPIO;
+    cfg.dc_gpio_index = BOARD_LCD_D_C_INDEX;
+    cfg.dc_gpio_pin = BOARD_LCD_D_C_PIN;
+    cfg.rst_gpio_index = BOARD_LCD_RESET_INDEX;
+    cfg.rst_gpio_pin = BOARD_LCD_RESET_PIN;
+    cfg.bl_gpio_index = BOARD_LCD_BL_INDEX;
+    cfg.bl_gpio_pin = BOARD_LCD_BL_PIN;
+    cfg.width = HPM_LVGL_LCD_WIDTH;
+    cfg.height = HPM_LVGL_LCD_HEIGHT;
+    cfg.x_offset = BOARD_LCD_X_OFFSET;
+    cfg.y_offset = BOARD_LCD_Y_OFFSET;
+    cfg.driver_ic = LCD_DRIVER_ST7789;
+    cfg.invert_colors = true;
+    cfg.defer_backlight = true;         /* Core 0 switches it on once its first frame is ready */
+    cfg.noncacheable_buffers = true;    /* Core 0 writes its draw buffers back before queueing them */
+
+    if (st7789_init(&cfg) != status_success) {
+        return status_fail;
+    }
+    intc_m_enable_irq_with_priority(BOARD_LCD_DMA_IRQ, 5);
+
+    dualcore_fence();
+    sh->panel_ready = 1U;
+    return status_success;
+}
+
+HPM_LVGL_DUALCORE_HOT_ATTR bool hpm_lvgl_dualcore_transport_poll(void)
+{
+    dualcore_shared_t *sh = DUALCORE_SHARED;
+    hpm_lvgl_dualcore_msg_t msg;
+
+    /* Messages run in order: nothing starts while a transfer is on the bus. */
+    if (dualcore_rx.xfer_busy) {
+        return false;
+    }
+
+    uint32_t tail = sh->tail;
+    uint32_t depth = sh->head - tail;
+    if (depth == 0U) {
+        return false;
+    }
+    if (depth > sh->max_depth) {
+        sh->max_depth = depth;
+    }
+
+    dualcore_fence();
+    msg = sh->ring[tail & DUALCORE_RING_MASK];
+    dualcore_fence();
+    sh->tail = tail + 1U;
+
+    switch (msg.type) {
+    case HPM_LVGL_DUALCORE_MSG_PIXELS:
+        st7789_set_window(msg.x1, msg.y1, msg.x2, msg.y2);
+        dualcore_rx.xfer_seq = msg.seq;
+        dualcore_rx.xfer_start_cycle = hpm_csr_get_core_cycle();
+        dualcore_rx.xfer_busy = true;
+        if (st7789_write_pixels_dma((const void *)(uintptr_t)msg.addr, msg.len, dualcore_xfer_done, NULL) !=
+            status_success) {
+            st7789_write_pixels((const uint16_t *)(uintptr_t)msg.addr, msg.len / 2U);
+            dualcore_xfer_done(NULL);
+        }
+        return true;
+    case HPM_LVGL_DUALCORE_MSG_BACKLIGHT:
+        st7789_backlight(msg.arg != 0U);
+        break;
+    case HPM_LVGL_DUALCORE_MSG_ROTATION:
+        st7789_set_rotation((uint16_t)msg.arg);
+        break;
+    case HPM_LVGL_DUALCORE_MSG_SPI_FREQ:
+        (void)st7789_set_spi_freq(msg.arg);
+        break;
+    default:
+        break;
+    }
+    dualcore_complete(sh, msg.seq);
+    return true;
+}
+
+void hpm_lvgl_dualcore_transport_run(void)
+{
+    for (;;) {
+        if (hpm_lvgl_dualcore_transport_poll()) {
+            continue;
+        }
+        /* Core 0 raises no interrupt for new messages, so the ring is polled; while a transfer is
+         * on the bus nothing can start anyway, so sleep until its completion interrupt. */
+        uint32_t level = disable_global_irq(CSR_MSTATUS_MIE_MASK);
+        if (dualcore_rx.xfer_busy) {
+#if defined(__riscv)
+            __asm volatile("wfi");
+#endif
+        }
+        restore_global_irq(level);
+    }
+}
+
+#endif /* HPM_LVGL_DUALCORE == 1 */
+
+#endif /* HPM_LVGL_DUALCORE */
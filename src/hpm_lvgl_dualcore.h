@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Dual-core render/transfer split (HPM6E8x)
+ *
+ * Core 0 runs LVGL and renders; core 1 owns the display transport (SPI, DMA, window commands,
+ * backlight) through the legacy st7789.c driver. Finished draw buffers and panel commands go
+ * from core 0 to core 1 through a single-producer/single-consumer ring in non-cacheable shared
+ * RAM; core 1 reports each completed message back with a sequence number. Core 0 therefore
+ * never takes a DMA interrupt and never touches the SPI block.
+ *
+ * The same file is built into both images: `HPM_LVGL_DUALCORE=1` for core 0 (with the adapter),
+ * `HPM_LVGL_DUALCORE=2` for core 1 (with st7789.c only, no LVGL).
+ */
+
+#ifndef HPM_LVGL_DUALCORE_H
+#define HPM_LVGL_DUALCORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hpm_common.h"
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+/* 0: single core (default), 1: core 0 image (LVGL), 2: core 1 image (display transport) */
+#ifndef HPM_LVGL_DUALCORE
+#define HPM_LVGL_DUALCORE           0
+#endif
+
+/* Ring slots (power of two). LVGL has at most two draw buffers in flight; the rest absorbs
+ * backlight/rotation/clock commands queued behind them. */
+#ifndef HPM_LVGL_DUALCORE_RING_LEN
+#define HPM_LVGL_DUALCORE_RING_LEN  8U
+#endif
+
+/* Shared block, at the same address in both images. Must be non-cacheable on both cores (the
+ * SDK's SHARE_RAM region is); the default is its start, so move it when RPMsg or another user
+ * owns that region. */
+#ifndef HPM_LVGL_DUALCORE_SHARED_ADDR
+#define HPM_LVGL_DUALCORE_SHARED_ADDR   ((uintptr_t)__share_mem_start__)
+extern uint8_t __share_mem_start__[];
+#endif
+
+/* How long core 0 waits in hpm_lvgl_spi_init() for core 1 to publish the ring */
+#ifndef HPM_LVGL_DUALCORE_ATTACH_TIMEOUT_MS
+#define HPM_LVGL_DUALCORE_ATTACH_TIMEOUT_MS 1000U
+#endif
+
+/* How long a send waits for core 1 to free a ring slot before the message is dropped */
+#ifndef HPM_LVGL_DUALCORE_SEND_TIMEOUT_MS
+#define HPM_LVGL_DUALCORE_SEND_TIMEOUT_MS   100U
+#endif
+
+/* Ring and completion code in ILM with HPM_LVGL_RAMFUNC (core 1 does not see hpm_lvgl_spi.h) */
+#ifndef HPM_LVGL_DUALCORE_HOT_ATTR
+#if defined(HPM_LVGL_RAMFUNC) && (HPM_LVGL_RAMFUNC >= 1) && defined(ATTR_RAMFUNC)
+#define HPM_LVGL_DUALCORE_HOT_ATTR  ATTR_RAMFUNC
+#else
+#define HPM_LVGL_DUALCORE_HOT_ATTR
+#endif
+#endif
+
+#if (HPM_LVGL_DUALCORE_RING_LEN &(HPM_LVGL_DUALCORE_RING_LEN - 1U)) != 0U
+#error "HPM_LVGL_DUALCORE_RING_LEN must be a power of two"
+#endif
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+typedef enum {
+    HPM_LVGL_DUALCORE_MSG_PIXELS = 1,   /* addr/len: RGB565 (wire order) for window x1..y2 */
+    HPM_LVGL_DUALCORE_MSG_BACKLIGHT,    /* arg: 0 off, 1 on */
+    HPM_LVGL_DUALCORE_MSG_ROTATION,     /* arg: 0, 90, 180, 270 */
+    HPM_LVGL_DUALCORE_MSG_SPI_FREQ,     /* arg: SCLK in Hz */
+} hpm_lvgl_dualcore_msg_type_t;
+
+typedef struct {
+    uint32_t type;
+    uint32_t seq;               /* Written back to done_seq once the message is finished */
+    uint16_t x1, y1, x2, y2;
+    uint32_t addr;              /* System (bus) address, reachable by core 1's DMA */
+    uint32_t len;               /* Bytes (PIXELS) */
+    uint32_t arg;
+} hpm_lvgl_dualcore_msg_t;
+
+typedef struct {
+    uint32_t sent;              /* Messages queued by core 0 */
+    uint32_t pixel_msgs;        /* Of which draw buffers */
+    uint32_t ring_full;         /* Sends that had to wait for a free slot */
+    uint32_t send_timeouts;     /* Messages dropped: the ring stayed full (core 1 stalled) */
+    uint32_t max_depth;         /* Most messages queued at once (seen by core 1) */
+    uint32_t done;              /* Messages core 1 has finished */
+    uint64_t core1_busy_us;     /* Time core 1 had a pixel transfer on the bus */
+    uint32_t last_xfer_us;      /* Duration of the last pixel transfer on core 1 */
+} hpm_lvgl_dualcore_stats_t;
+
+/*============================================================================
+ * API Functions
+ *============================================================================*/
+
+#if HPM_LVGL_DUALCORE == 1
+
+/* Core 0 (used by hpm_lvgl_spi.c) */
+
+/**
+ * @brief Wait for core 1 to publish the ring (HPM_LVGL_DUALCORE_ATTACH_TIMEOUT_MS)
+ * @return status_success, or status_timeout if core 1 is not running the transport
+ */
+hpm_stat_t hpm_lvgl_dualcore_attach(void);
+
+/**
+ * @brief Has core 1 finished the panel init sequence?
+ */
+bool hpm_lvgl_dualcore_panel_ready(void);
+
+/**
+ * @brief Queue a message for core 1 (spins while the ring is full, up to HPM_LVGL_DUALCORE_SEND_TIMEOUT_MS)
+ * @param msg Message; type and payload filled in, seq is assigned here (pass it to hpm_lvgl_dualcore_done())
+ * @return status_success, or status_timeout if the ring stayed full (the message is dropped)
+ */
+hpm_stat_t hpm_lvgl_dualcore_send(hpm_lvgl_dualcore_msg_t *msg);
+
+/**
+ * @brief Has core 1 finished message `seq` (and everything queued before it)?
+ * @param xfer_us Duration of the last pixel transfer on core 1 (may be NULL)
+ */
+bool hpm_lvgl_dualcore_done(uint32_t seq, uint32_t *xfer_us);
+
+/**
+ * @brief Get ring and core 1 statistics
+ * @param out Output stats (must not be NULL)
+ */
+void hpm_lvgl_dualcore_get_stats(hpm_lvgl_dualcore_stats_t *out);
+
+/**
+ * @brief Print ring and core 1 statistics over the console UART
+ */
+void hpm_lvgl_dualcore_dump(void);
+
+#elif HPM_LVGL_DUALCORE == 2
+
+/* Core 1 */
+
+/**
+ * @brief Bring up SPI, DMA and the panel (blocking) and publish the ring to core 0
+ * @note Call after board_init_lcd() on core 1; core 0's hpm_lvgl_spi_init() waits for it.
+ * @return status_success on success
+ */
+hpm_stat_t hpm_lvgl_dualcore_transport_init(void);
+
+/**
+ * @brief Start the next queued message if the bus is free; never waits
+ * @return true if a message was taken from the ring
+ */
+bool hpm_lvgl_dualcore_transport_poll(void);
+
+/**
+ * @brief Core 1 main loop: poll the ring, WFI while a transfer is on the bus (does not return)
+ */
+void hpm_lvgl_dualcore_transport_run(void);
+
+#else
+
+static inline void hpm_lvgl_dualcore_get_stats(hpm_lvgl_dualcore_stats_t *out) { (void)out; }
+static inline void hpm_lvgl_dualcore_dump(void) {}
+
+#endif /* HPM_LVGL_DUALCORE */
+
+#endif /* HPM_LVGL_DUALCORE_H */
@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Flush heatmap and update-region overlay implementation
+ */
+
+#include "hpm_lvgl_heatmap.h"
+
+#if HPM_LVGL_HEATMAP_ENABLE
+
+#include "hpm_lvgl_spi.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Grid covers the panel in either orientation. */
+#define HEATMAP_MAX_DIM     ((HPM_LVGL_LCD_WIDTH > HPM_LVGL_LCD_HEIGHT) ? HPM_LVGL_LCD_WIDTH : HPM_LVGL_LCD_HEIGHT)
+#define HEATMAP_MAX_TILES   ((HEATMAP_MAX_DIM + HPM_LVGL_HEATMAP_TILE - 1) / HPM_LVGL_HEATMAP_TILE)
+
+/* Overlay tint at full strength (alpha / 256) and tint color (RGB565 channel maxima). */
+#define OVERLAY_ALPHA_MAX   128U
+
+/*============================================================================
+ * Private data
+ *============================================================================*/
+
+#if HPM_LVGL_HEATMAP_OVERLAY
+typedef struct {
+    lv_area_t area;
+    uint8_t level;      /* remaining fade steps, 0 = not tinted */
+    bool repaint;       /* invalidated by the fade timer; flushes inside are repaints, not updates */
+} overlay_rect_t;
+#endif
+
+static struct {
+    lv_display_t *disp;
+    uint16_t tiles[HEATMAP_MAX_TILES * HEATMAP_MAX_TILES];
+    hpm_lvgl_heatmap_stats_t stats;
+#if HPM_LVGL_HEATMAP_OVERLAY
+    overlay_rect_t rects[HPM_LVGL_HEATMAP_OVERLAY_RECTS];
+    lv_timer_t *timer;
+    bool overlay_on;
+#endif
+} heatmap_ctx;
+
+#if HPM_LVGL_HEATMAP_SHADOW
+/* Last value sent for every pixel (wire byte order), row stride = current horizontal resolution. */
+static uint16_t heatmap_shadow[HPM_LVGL_LCD_WIDTH * HPM_LVGL_LCD_HEIGHT];
+#endif
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+static void heatmap_update_grid_size(void)
+{
+    int32_t hor = lv_display_get_horizontal_resolution(heatmap_ctx.disp);
+    int32_t ver = lv_display_get_vertical_resolution(heatmap_ctx.disp);
+
+    heatmap_ctx.stats.tiles_x = (uint16_t)((hor + HPM_LVGL_HEATMAP_TILE - 1) >> HPM_LVGL_HEATMAP_TILE_SHIFT);
+    heatmap_ctx.stats.tiles_y = (uint16_t)((ver + HPM_LVGL_HEATMAP_TILE - 1) >> HPM_LVGL_HEATMAP_TILE_SHIFT);
+}
+
+static bool heatmap_clip(const lv_area_t *area, lv_area_t *out)
+{
+    lv_area_t screen;
+
+    lv_area_set(&screen, 0, 0, lv_display_get_horizontal_resolution(heatmap_ctx.disp) - 1,
+                lv_display_get_vertical_resolution(heatmap_ctx.disp) - 1);
+    return lv_area_intersect(out, area, &screen);
+}
+
+static void heatmap_count_tiles(const lv_area_t *a)
+{
+    uint16_t tx1 = (uint16_t)(a->x1 >> HPM_LVGL_HEATMAP_TILE_SHIFT);
+    uint16_t tx2 = (uint16_t)(a->x2 >> HPM_LVGL_HEATMAP_TILE_SHIFT);
+    uint16_t ty1 = (uint16_t)(a->y1 >> HPM_LVGL_HEATMAP_TILE_SHIFT);
+    uint16_t ty2 = (uint16_t)(a->y2 >> HPM_LVGL_HEATMAP_TILE_SHIFT);
+
+    for (uint16_t ty = ty1; ty <= ty2; ty++) {
+        uint16_t *row = &heatmap_ctx.tiles[ty * HEATMAP_MAX_TILES];
+        for (uint16_t tx = tx1; tx <= tx2; tx++) {
+            if (row[tx] != UINT16_MAX) {
+                row[tx]++;
+            }
+            if (row[tx] > heatmap_ctx.stats.max_tile_count) {
+                heatmap_ctx.stats.max_tile_count = row[tx];
+            }
+        }
+    }
+}
+
+#if HPM_LVGL_HEATMAP_SHADOW
+/* Compare the flushed pixels of `clip` against the shadow and update it; returns changed pixel count. */
+static uint32_t heatmap_shadow_update(const lv_area_t *area, const lv_area_t *clip, const uint8_t *px_map)
+{
+    int32_t stride = lv_display_get_horizontal_resolution(heatmap_ctx.disp);
+    int32_t src_w = lv_area_get_width(area);
+    uint32_t changed = 0;
+
+    for (int32_t y = clip->y1; y <= clip->y2; y++) {
+        const uint16_t *src = (const uint16_t *)px_map + (y - area->y1) * src_w + (clip->x1 - area->x1);
+        uint16_t *dst = &heatmap_shadow[y * stride + clip->x1];
+        for (int32_t x = clip->x1; x <= clip->x2; x++) {
+            if (*dst != *src) {
+                *dst = *src;
+                changed++;
+            }
+            dst++;
+            src++;
+        }
+    }
+
+    return changed;
+}
+#endif
+
+#if HPM_LVGL_HEATMAP_OVERLAY
+/* Blend the intersection of `rect` and `area` towards red. Pixels are RGB565, MSB first. */
+static void overlay_tint(const lv_area_t *area, uint8_t *px_map, const lv_area_t *rect, uint32_t alpha)
+{
+    lv_area_t clip;
+    int32_t src_w = lv_area_get_width(area);
+
+    if (!lv_area_intersect(&clip, area, rect)) {
+        return;
+    }
+
+    for (int32_t y = clip.y1; y <= clip.y2; y++) {
+        uint8_t *p = px_map + (((y - area->y1) * src_w + (clip.x1 - area->x1)) * 2);
+        for (int32_t x = clip.x1; x <= clip.x2; x++) {
+            uint32_t v = ((uint32_t)p[0] << 8) | p[1];
+            uint32_t r = (v >> 11) & 0x1FU;
+            uint32_t g = (v >> 5) & 0x3FU;
+            uint32_t b = v & 0x1FU;
+
+            r += ((0x1FU - r) * alpha) >> 8;
+            g -= (g * alpha) >> 8;
+            b -= (b * alpha) >> 8;
+
+            v = (r << 11) | (g << 5) | b;
+            p[0] = (uint8_t)(v >> 8);
+            p[1] = (uint8_t)v;
+            p += 2;
+        }
+    }
+}
+
+static bool overlay_is_repaint(const lv_area_t *area)
+{
+    for (uint32_t i = 0; i < HPM_LVGL_HEATMAP_OVERLAY_RECTS; i++) {
+        const overlay_rect_t *r = &heatmap_ctx.rects[i];
+        if (r->repaint && lv_area_is_in(area, &r->area, 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void overlay_record(const lv_area_t *area)
+{
+    overlay_rect_t *slot = NULL;
+
+    for (uint32_t i = 0; i < HPM_LVGL_HEATMAP_OVERLAY_RECTS; i++) {
+        overlay_rect_t *r = &heatmap_ctx.rects[i];
+        if (((r->level != 0U) || r->repaint) && (memcmp(&r->area, area, sizeof(*area)) == 0)) {
+            slot = r;
+            break;
+        }
+        if ((slot == NULL) && (r->level == 0U) && !r->repaint) {
+            slot = r;
+        }
+    }
+
+    /* Ring full: leave this flush untinted rather than evicting a rect whose tint would then stick. */
+    if (slot == NULL) {
+        return;
+    }
+
+    lv_area_copy(&slot->area, area);
+    slot->level = HPM_LVGL_HEATMAP_FADE_STEPS;
+}
+
+static void overlay_timer_cb(lv_timer_t *timer)
+{
+    lv_obj_t *scr = lv_display_get_screen_active(heatmap_ctx.disp);
+
+    (void)timer;
+
+    for (uint32_t i = 0; i < HPM_LVGL_HEATMAP_OVERLAY_RECTS; i++) {
+        overlay_rect_t *r = &heatmap_ctx.rects[i];
+
+        /* The repaint requested on the previous tick has been flushed by now: the slot is free
+         * once its tint reached zero (kept one extra tick so the repaint is not recorded as an update). */
+        r->repaint = false;
+        if (r->level == 0U) {
+            continue;
+        }
+
+        r->level--;
+        r->repaint = true;
+        if (scr != NULL) {
+            lv_obj_invalidate_area(scr, &r->area);
+        }
+    }
+}
+#endif /* HPM_LVGL_HEATMAP_OVERLAY */
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+void hpm_lvgl_heatmap_init(lv_display_t *disp)
+{
+    memset(&heatmap_ctx, 0, sizeof(heatmap_ctx));
+    heatmap_ctx.disp = disp;
+    hpm_lvgl_heatmap_reset();
+
+#if HPM_LVGL_HEATMAP_OVERLAY
+    heatmap_ctx.overlay_on = true;
+    heatmap_ctx.timer = lv_timer_create(overlay_timer_cb, HPM_LVGL_HEATMAP_FADE_MS, NULL);
+#endif
+}
+
+void hpm_lvgl_heatmap_flush(const lv_area_t *area, uint8_t *px_map)
+{
+    lv_area_t clip;
+
+    if ((heatmap_ctx.disp == NULL) || (area == NULL) || (px_map == NULL)) {
+        return;
+    }
+    if (!heatmap_clip(area, &clip)) {
+        return;
+    }
+
+#if HPM_LVGL_HEATMAP_OVERLAY
+    bool repaint = heatmap_ctx.overlay_on && overlay_is_repaint(area);
+#else
+    bool repaint = false;
+#endif
+
+    /* Account on the untinted pixels so the shadow always holds real UI content. */
+    if (!repaint) {
+        heatmap_ctx.stats.flushes++;
+        heatmap_ctx.stats.flushed_pixels += (uint64_t)lv_area_get_size(area);
+        heatmap_count_tiles(&clip);
+#if HPM_LVGL_HEATMAP_SHADOW
+        heatmap_ctx.stats.changed_pixels += heatmap_shadow_update(area, &clip, px_map);
+#endif
+    }
+
+#if HPM_LVGL_HEATMAP_OVERLAY
+    if (!heatmap_ctx.overlay_on) {
+        return;
+    }
+    if (!repaint) {
+        overlay_record(area);
+    }
+    for (uint32_t i = 0; i < HPM_LVGL_HEATMAP_OVERLAY_RECTS; i++) {
+        const overlay_rect_t *r = &heatmap_ctx.rects[i];
+        if (r->level != 0U) {
+            overlay_tint(area, px_map, &r->area, (OVERLAY_ALPHA_MAX * r->level) / HPM_LVGL_HEATMAP_FADE_STEPS);
+        }
+    }
+#endif
+}
+
+void hpm_lvgl_heatmap_reset(void)
+{
+    memset(heatmap_ctx.tiles, 0, sizeof(heatmap_ctx.tiles));
+    memset(&heatmap_ctx.stats, 0, sizeof(heatmap_ctx.stats));
+#if HPM_LVGL_HEATMAP_SHADOW
+    memset(heatmap_shadow, 0, sizeof(heatmap_shadow));
+#endif
+    if (heatmap_ctx.disp != NULL) {
+        heatmap_update_grid_size();
+    }
+}
+
+void hpm_lvgl_heatmap_set_overlay(bool enable)
+{
+#if HPM_LVGL_HEATMAP_OVERLAY
+    if (heatmap_ctx.overlay_on == enable) {
+        return;
+    }
+
+    heatmap_ctx.overlay_on = enable;
+    if (!enable) {
+        /* Repaint whatever is still tinted. */
+        lv_obj_t *scr = lv_display_get_screen_active(heatmap_ctx.disp);
+        for (uint32_t i = 0; i < HPM_LVGL_HEATMAP_OVERLAY_RECTS; i++) {
+            if ((heatmap_ctx.rects[i].level != 0U) && (scr != NULL)) {
+                lv_obj_invalidate_area(scr, &heatmap_ctx.rects[i].area);
+            }
+        }
+        memset(heatmap_ctx.rects, 0, sizeof(heatmap_ctx.rects));
+    }
+#else
+    (void)enable;
+#endif
+}
+
+void hpm_lvgl_heatmap_get_stats(hpm_lvgl_heatmap_stats_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    *out = heatmap_ctx.stats;
+}
+
+uint16_t hpm_lvgl_heatmap_get_tile(uint16_t tx, uint16_t ty)
+{
+    if ((tx >= heatmap_ctx.stats.tiles_x) || (ty >= heatmap_ctx.stats.tiles_y)) {
+        return 0;
+    }
+
+    return heatmap_ctx.tiles[ty * HEATMAP_MAX_TILES + tx];
+}
+
+void hpm_lvgl_heatmap_dump(void)
+{
+    static const char shades[] = " .:-=+*#%@";
+    const hpm_lvgl_heatmap_stats_t *s = &heatmap_ctx.stats;
+    uint32_t max = (s->max_tile_count != 0U) ? s->max_tile_count : 1U;
+    /* Overdraw = flushed / changed pixels, printed with two decimals (no float printf). */
+    uint32_t overdraw_x100 = (s->changed_pixels != 0U) ? (uint32_t)((s->flushed_pixels * 100U) / s->changed_pixels) : 0U;
+
+    printf("# hpm_lvgl_heatmap tiles=%ux%u tile=%u flushes=%lu flushed_px=%lu changed_px=%lu overdraw=%lu.%02lu max_tile=%u\n",
+           (unsigned int)s->tiles_x, (unsigned int)s->tiles_y, (unsigned int)HPM_LVGL_HEATMAP_TILE,
+           (unsigned long)s->flushes, (unsigned long)s->flushed_pixels, (unsigned long)s->changed_pixels,
+           (unsigned long)(overdraw_x100 / 100U), (unsigned long)(overdraw_x100 % 100U),
+           (unsigned int)s->max_tile_count);
+
+    /* One character per tile, scaled to the hottest tile. */
+    for (uint16_t ty = 0; ty < s->tiles_y; ty++) {
+        char line[HEATMAP_MAX_TILES + 1];
+        for (uint16_t tx = 0; tx < s->tiles_x; tx++) {
+            uint32_t c = heatmap_ctx.tiles[ty * HEATMAP_MAX_TILES + tx];
+            uint32_t idx = (c == 0U) ? 0U : 1U + ((c * (sizeof(shades) - 3U)) / max);
+            line[tx] = shades[idx];
+        }
+        line[s->tiles_x] = '\0';
+        printf("|%s|\n", line);
+    }
+
+    printf("# hpm_lvgl_heatmap end\n");
+}
+
+#endif /* HPM_LVGL_HEATMAP_ENABLE */
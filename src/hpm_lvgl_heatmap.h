@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Flush heatmap and update-region overlay ("show surface updates")
+ *
+ * Counts how often every 8x8 tile of the panel is flushed, compares flushed pixels
+ * against a shadow copy of the panel to compute an overdraw ratio, and can tint
+ * recently flushed rectangles on the panel with a fading overlay.
+ */
+
+#ifndef HPM_LVGL_HEATMAP_H
+#define HPM_LVGL_HEATMAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl.h"
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+/* Disabled by default: every hook below compiles to nothing. */
+#ifndef HPM_LVGL_HEATMAP_ENABLE
+#define HPM_LVGL_HEATMAP_ENABLE     0
+#endif
+
+/* Tile size is fixed at 8x8 pixels. */
+#define HPM_LVGL_HEATMAP_TILE_SHIFT 3
+#define HPM_LVGL_HEATMAP_TILE       (1 << HPM_LVGL_HEATMAP_TILE_SHIFT)
+
+/* Shadow copy of the panel (WIDTH x HEIGHT x 2 bytes) used for the overdraw ratio.
+ * Set to 0 to save the RAM; only flush counts are collected then. */
+#ifndef HPM_LVGL_HEATMAP_SHADOW
+#define HPM_LVGL_HEATMAP_SHADOW     1
+#endif
+
+/* Fading overlay of recently flushed rectangles. */
+#ifndef HPM_LVGL_HEATMAP_OVERLAY
+#define HPM_LVGL_HEATMAP_OVERLAY    1
+#endif
+
+/* Rectangles tracked by the overlay at once; newer flushes are not tinted while the ring is full. */
+#ifndef HPM_LVGL_HEATMAP_OVERLAY_RECTS
+#define HPM_LVGL_HEATMAP_OVERLAY_RECTS  16
+#endif
+
+/* Fade step period (ms) and number of steps until a rectangle disappears. */
+#ifndef HPM_LVGL_HEATMAP_FADE_MS
+#define HPM_LVGL_HEATMAP_FADE_MS    100
+#endif
+
+#ifndef HPM_LVGL_HEATMAP_FADE_STEPS
+#define HPM_LVGL_HEATMAP_FADE_STEPS 4
+#endif
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+typedef struct {
+    uint32_t flushes;           /* Flushes counted (overlay repaints excluded) */
+    uint64_t flushed_pixels;    /* Pixels sent to the panel */
+    uint64_t changed_pixels;    /* Pixels whose value differed from the shadow (0 without shadow) */
+    uint16_t tiles_x;           /* Heatmap grid size */
+    uint16_t tiles_y;
+    uint16_t max_tile_count;    /* Hottest tile */
+} hpm_lvgl_heatmap_stats_t;
+
+/*============================================================================
+ * API Functions
+ *============================================================================*/
+
+#if HPM_LVGL_HEATMAP_ENABLE
+
+/**
+ * @brief Attach to a display (called by `hpm_lvgl_spi_init()`)
+ */
+void hpm_lvgl_heatmap_init(lv_display_t *disp);
+
+/**
+ * @brief Flush hook: account and optionally tint an area before it is sent
+ * @param area Flushed area (LVGL coordinates, inclusive)
+ * @param px_map RGB565 pixels in wire byte order (MSB first), modified in place by the overlay
+ */
+void hpm_lvgl_heatmap_flush(const lv_area_t *area, uint8_t *px_map);
+
+/**
+ * @brief Clear tile counters, statistics and the shadow copy
+ */
+void hpm_lvgl_heatmap_reset(void);
+
+/**
+ * @brief Enable/disable the fading update overlay at runtime
+ */
+void hpm_lvgl_heatmap_set_overlay(bool enable);
+
+/**
+ * @brief Get aggregated statistics
+ * @param out Output stats (must not be NULL)
+ */
+void hpm_lvgl_heatmap_get_stats(hpm_lvgl_heatmap_stats_t *out);
+
+/**
+ * @brief Flush count of one tile (0 when out of range)
+ */
+uint16_t hpm_lvgl_heatmap_get_tile(uint16_t tx, uint16_t ty);
+
+/**
+ * @brief Print statistics and an ASCII heatmap over the console UART (printf)
+ */
+void hpm_lvgl_heatmap_dump(void);
+
+#else
+
+static inline void hpm_lvgl_heatmap_init(lv_display_t *disp) { (void)disp; }
+static inline void hpm_lvgl_heatmap_flush(const lv_area_t *area, uint8_t *px_map)
+{
+    (void)area;
+    (void)px_map;
+}
+static inline void hpm_lvgl_heatmap_reset(void) {}
+static inline void hpm_lvgl_heatmap_set_overlay(bool enable) { (void)enable; }
+static inline void hpm_lvgl_heatmap_get_stats(hpm_lvgl_heatmap_stats_t *out) { (void)out; }
+static inline uint16_t hpm_lvgl_heatmap_get_tile(uint16_t tx, uint16_t ty)
+{
+    (void)tx;
+    (void)ty;
+    return 0;
+}
+static inline void hpm_lvgl_heatmap_dump(void) {}
+
+#endif /* HPM_LVGL_HEATMAP_ENABLE */
+
+#endif /* HPM_LVGL_HEATMAP_H */
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Jank attribution implementation
+ */
+
+#include "hpm_lvgl_jank.h"
+
+#if HPM_LVGL_JANK_ENABLE
+
+#include <stdio.h>
+#include <string.h>
+
+/* Object tree depth searched during attribution */
+#define JANK_MAX_DEPTH  16
+
+/*============================================================================
+ * Private data
+ *============================================================================*/
+
+typedef struct {
+    lv_area_t areas[HPM_LVGL_JANK_MAX_AREAS];
+    uint16_t count;
+    uint16_t dropped;
+} jank_area_set_t;
+
+static struct {
+    lv_display_t *disp;
+    uint32_t budget_us;
+    uint32_t seq;
+    jank_area_set_t pending;    /* invalidated since the last REFR_START */
+    jank_area_set_t frame;      /* areas refreshed by the current frame */
+    hpm_lvgl_jank_frame_t ring[HPM_LVGL_JANK_RING];
+    uint32_t head;              /* total frames recorded */
+} jank_ctx;
+
+/*============================================================================
+ * Attribution
+ *============================================================================*/
+
+static void jank_add_obj(hpm_lvgl_jank_frame_t *f, const lv_obj_t *obj)
+{
+    for (uint32_t i = 0; i < f->obj_count; i++) {
+        if (f->objs[i].obj == obj) {
+            return;
+        }
+    }
+    if (f->obj_count >= HPM_LVGL_JANK_MAX_OBJS) {
+        return;
+    }
+
+    hpm_lvgl_jank_obj_t *o = &f->objs[f->obj_count++];
+    const lv_obj_class_t *cls = lv_obj_get_class(obj);
+    o->obj = obj;
+    o->class_name = ((cls != NULL) && (cls->name != NULL)) ? cls->name : "?";
+    o->user_data = lv_obj_get_user_data((lv_obj_t *)obj);
+    lv_obj_get_coords(obj, &o->coords);
+}
+
+/* An invalidated area usually is the (extended) coordinates of the object that changed:
+ * report the outermost objects lying inside the area. If the area is smaller than any
+ * object (partial invalidation, e.g. a chart series), report the deepest object covering it. */
+static uint32_t jank_walk(hpm_lvgl_jank_frame_t *f, lv_obj_t *obj, const lv_area_t *area, uint32_t depth,
+                          lv_obj_t **cover)
+{
+    uint32_t found = 0;
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+
+    for (uint32_t i = 0; i < child_cnt; i++) {
+        lv_obj_t *child = lv_obj_get_child(obj, (int32_t)i);
+        lv_area_t coords;
+
+        if (lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) {
+            continue;
+        }
+        lv_obj_get_coords(child, &coords);
+        if (!lv_area_is_on(&coords, area)) {
+            continue;
+        }
+
+        if (lv_area_is_in(&coords, area, 0)) {
+            jank_add_obj(f, child);
+            found++;
+            continue;
+        }
+
+        if (lv_area_is_in(area, &coords, 0)) {
+            *cover = child;
+        }
+        if (depth < JANK_MAX_DEPTH) {
+            found += jank_walk(f, child, area, depth + 1U, cover);
+        }
+    }
+
+    return found;
+}
+
+static void jank_attribute(hpm_lvgl_jank_frame_t *f)
+{
+    lv_obj_t *roots[3];
+
+    roots[0] = lv_display_get_screen_active(jank_ctx.disp);
+    roots[1] = lv_display_get_layer_top(jank_ctx.disp);
+    roots[2] = lv_display_get_layer_sys(jank_ctx.disp);
+
+    for (uint32_t a = 0; a < f->area_count; a++) {
+        uint32_t found = 0;
+        lv_obj_t *cover = NULL;
+
+        for (uint32_t r = 0; r < 3U; r++) {
+            if (roots[r] != NULL) {
+                found += jank_walk(f, roots[r], &f->areas[a], 0, &cover);
+            }
+        }
+        if (found == 0U) {
+            jank_add_obj(f, (cover != NULL) ? cover : roots[0]);
+        }
+    }
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+void hpm_lvgl_jank_init(lv_display_t *disp)
+{
+    memset(&jank_ctx, 0, sizeof(jank_ctx));
+    jank_ctx.disp = disp;
+    jank_ctx.budget_us = HPM_LVGL_JANK_BUDGET_US;
+}
+
+void hpm_lvgl_jank_invalidate(const lv_area_t *area)
+{
+    jank_area_set_t *set = &jank_ctx.pending;
+
+    if (area == NULL) {
+        return;
+    }
+    if (set->count >= HPM_LVGL_JANK_MAX_AREAS) {
+        set->dropped++;
+        return;
+    }
+    lv_area_copy(&set->areas[set->count++], area);
+}
+
+void hpm_lvgl_jank_frame_start(void)
+{
+    jank_ctx.frame = jank_ctx.pending;
+    jank_ctx.pending.count = 0;
+    jank_ctx.pending.dropped = 0;
+}
+
+void hpm_lvgl_jank_frame_end(uint32_t frame_us, uint32_t render_us, uint32_t flush_us, uint32_t flushes)
+{
+    jank_ctx.seq++;
+    if (frame_us <= jank_ctx.budget_us) {
+        return;
+    }
+
+    hpm_lvgl_jank_frame_t *f = &jank_ctx.ring[jank_ctx.head % HPM_LVGL_JANK_RING];
+    memset(f, 0, sizeof(*f));
+    f->seq = jank_ctx.seq;
+    f->tick = lv_tick_get();
+    f->frame_us = frame_us;
+    f->render_us = render_us;
+    f->flush_us = flush_us;
+    f->flushes = (uint16_t)flushes;
+    f->area_count = jank_ctx.frame.count;
+    f->areas_dropped = jank_ctx.frame.dropped;
+    memcpy(f->areas, jank_ctx.frame.areas, sizeof(lv_area_t) * f->area_count);
+
+    /* Runs from LV_EVENT_REFR_READY: the object tree is the one just rendered. */
+    jank_attribute(f);
+    jank_ctx.head++;
+}
+
+void hpm_lvgl_jank_set_budget_us(uint32_t budget_us)
+{
+    jank_ctx.budget_us = budget_us;
+}
+
+uint32_t hpm_lvgl_jank_get_count(void)
+{
+    return (jank_ctx.head < HPM_LVGL_JANK_RING) ? jank_ctx.head : HPM_LVGL_JANK_RING;
+}
+
+bool hpm_lvgl_jank_get(uint32_t index, hpm_lvgl_jank_frame_t *out)
+{
+    uint32_t count = hpm_lvgl_jank_get_count();
+
+    if ((out == NULL) || (index >= count)) {
+        return false;
+    }
+
+    *out = jank_ctx.ring[(jank_ctx.head - count + index) % HPM_LVGL_JANK_RING];
+    return true;
+}
+
+void hpm_lvgl_jank_reset(void)
+{
+    jank_ctx.head = 0;
+}
+
+void hpm_lvgl_jank_dump(void)
+{
+    uint32_t count = hpm_lvgl_jank_get_count();
+
+    printf("# hpm_lvgl_jank budget_us=%lu frames=%lu total=%lu\n",
+           (unsigned long)jank_ctx.budget_us, (unsigned long)count, (unsigned long)jank_ctx.head);
+
+    for (uint32_t i = 0; i < count; i++) {
+        const hpm_lvgl_jank_frame_t *f = &jank_ctx.ring[(jank_ctx.head - count + i) % HPM_LVGL_JANK_RING];
+
+        printf("F seq=%lu tick=%lu frame_us=%lu render_us=%lu flush_us=%lu flushes=%u areas=%u dropped=%u\n",
+               (unsigned long)f->seq, (unsigned long)f->tick, (unsigned long)f->frame_us,
+               (unsigned long)f->render_us, (unsigned long)f->flush_us, (unsigned int)f->flushes,
+               (unsigned int)f->area_count, (unsigned int)f->areas_dropped);
+        for (uint32_t a = 0; a < f->area_count; a++) {
+            const lv_area_t *ar = &f->areas[a];
+            printf("  A (%ld,%ld)-(%ld,%ld) %lux%lu\n", (long)ar->x1, (long)ar->y1, (long)ar->x2, (long)ar->y2,
+                   (unsigned long)lv_area_get_width(ar), (unsigned long)lv_area_get_height(ar));
+        }
+        for (uint32_t o = 0; o < f->obj_count; o++) {
+            const hpm_lvgl_jank_obj_t *ob = &f->objs[o];
+            printf("  O %p %s tag=%p (%ld,%ld)-(%ld,%ld)\n", (const void *)ob->obj, ob->class_name, ob->user_data,
+                   (long)ob->coords.x1, (long)ob->coords.y1, (long)ob->coords.x2, (long)ob->coords.y2);
+        }
+    }
+
+    printf("# hpm_lvgl_jank end\n");
+}
+
+#endif /* HPM_LVGL_JANK_ENABLE */
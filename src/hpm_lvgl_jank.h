@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Jank attribution for the LVGL SPI display adapter
+ *
+ * When a refresh cycle exceeds the frame budget, the invalidated areas of that frame,
+ * the LVGL objects they map to (class, pointer, user data), render time and flush time
+ * are kept in a small ring. `hpm_lvgl_jank_dump()` prints the ring over the console UART.
+ */
+
+#ifndef HPM_LVGL_JANK_H
+#define HPM_LVGL_JANK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl.h"
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+/* Disabled by default: every hook below compiles to nothing. */
+#ifndef HPM_LVGL_JANK_ENABLE
+#define HPM_LVGL_JANK_ENABLE        0
+#endif
+
+/* Default frame budget (us); change at runtime with hpm_lvgl_jank_set_budget_us(). */
+#ifndef HPM_LVGL_JANK_BUDGET_US
+#define HPM_LVGL_JANK_BUDGET_US     16667
+#endif
+
+/* Slow frames kept (oldest overwritten) */
+#ifndef HPM_LVGL_JANK_RING
+#define HPM_LVGL_JANK_RING          8
+#endif
+
+/* Invalidated areas and attributed objects kept per frame */
+#ifndef HPM_LVGL_JANK_MAX_AREAS
+#define HPM_LVGL_JANK_MAX_AREAS     8
+#endif
+
+#ifndef HPM_LVGL_JANK_MAX_OBJS
+#define HPM_LVGL_JANK_MAX_OBJS      8
+#endif
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+typedef struct {
+    const lv_obj_t *obj;        /* Object pointer (may be deleted by the time it is read) */
+    const char *class_name;     /* lv_obj_class_t name, e.g. "lv_label" */
+    const void *user_data;      /* lv_obj_get_user_data(), used as a tag */
+    lv_area_t coords;           /* Object coordinates when the frame finished */
+} hpm_lvgl_jank_obj_t;
+
+typedef struct {
+    uint32_t seq;               /* Refresh cycle number */
+    uint32_t tick;              /* LVGL tick (ms) at the end of the frame */
+    uint32_t frame_us;          /* REFR_START -> REFR_READY */
+    uint32_t render_us;         /* frame_us minus waits for a free draw buffer */
+    uint32_t flush_us;          /* Bus time of the flushes completed during the frame */
+    uint16_t flushes;           /* Flush calls in the frame */
+    uint16_t area_count;
+    uint16_t areas_dropped;     /* Areas beyond HPM_LVGL_JANK_MAX_AREAS */
+    uint16_t obj_count;
+    lv_area_t areas[HPM_LVGL_JANK_MAX_AREAS];
+    hpm_lvgl_jank_obj_t objs[HPM_LVGL_JANK_MAX_OBJS];
+} hpm_lvgl_jank_frame_t;
+
+/*============================================================================
+ * API Functions
+ *============================================================================*/
+
+#if HPM_LVGL_JANK_ENABLE
+
+/**
+ * @brief Attach to a display (called by `hpm_lvgl_spi_init()`)
+ */
+void hpm_lvgl_jank_init(lv_display_t *disp);
+
+/**
+ * @brief Adapter hooks (display events); not for application use
+ */
+void hpm_lvgl_jank_invalidate(const lv_area_t *area);
+void hpm_lvgl_jank_frame_start(void);
+void hpm_lvgl_jank_frame_end(uint32_t frame_us, uint32_t render_us, uint32_t flush_us, uint32_t flushes);
+
+/**
+ * @brief Set the frame budget; frames taking longer are recorded
+ */
+void hpm_lvgl_jank_set_budget_us(uint32_t budget_us);
+
+/**
+ * @brief Number of slow frames currently in the ring
+ */
+uint32_t hpm_lvgl_jank_get_count(void);
+
+/**
+ * @brief Copy a recorded frame (0 = oldest)
+ * @return true if `index` is valid
+ */
+bool hpm_lvgl_jank_get(uint32_t index, hpm_lvgl_jank_frame_t *out);
+
+/**
+ * @brief Forget all recorded frames
+ */
+void hpm_lvgl_jank_reset(void);
+
+/**
+ * @brief Print the recorded frames over the console UART (printf)
+ */
+void hpm_lvgl_jank_dump(void);
+
+#else
+
+static inline void hpm_lvgl_jank_init(lv_display_t *disp) { (void)disp; }
+static inline void hpm_lvgl_jank_invalidate(const lv_area_t *area) { (void)area; }
+static inline void hpm_lvgl_jank_frame_start(void) {}
+static inline void hpm_lvgl_jank_frame_end(uint32_t frame_us, uint32_t render_us, uint32_t flush_us, uint32_t flushes)
+{
+    (void)frame_us;
+    (void)render_us;
+    (void)flush_us;
+    (void)flushes;
+}
+static inline void hpm_lvgl_jank_set_budget_us(uint32_t budget_us) { (void)budget_us; }
+static inline uint32_t hpm_lvgl_jank_get_count(void) { return 0; }
+static inline bool hpm_lvgl_jank_get(uint32_t index, hpm_lvgl_jank_frame_t *out)
+{
+    (void)index;
+    (void)out;
+    return false;
+}
+static inline void hpm_lvgl_jank_reset(void) {}
+static inline void hpm_lvgl_jank_dump(void) {}
+
+#endif /* HPM_LVGL_JANK_ENABLE */
+
+#endif /* HPM_LVGL_JANK_H */
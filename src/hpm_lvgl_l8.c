@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * L8 draw buffers with LUT expansion implementation
+ */
+
+#include "hpm_lvgl_l8.h"
+
+#if HPM_LVGL_L8
+
+#include "hpm_lvgl_spi.h"
+#include "hpm_csr_drv.h"
+#include <stdio.h>
+#include <string.h>
+
+/* These read or compose RGB565 in the draw buffer, which holds L8 pixels in this mode. */
+#if HPM_LVGL_DUALCORE == 1
+#error "HPM_LVGL_L8 is not supported with HPM_LVGL_DUALCORE=1 (core 1 sends the draw buffers as they are)."
+#endif
+#if HPM_LVGL_DRAW_DMA
+#error "HPM_LVGL_L8 is not supported with HPM_LVGL_DRAW_DMA (the DMA draw unit writes RGB565)."
+#endif
+#if HPM_LVGL_WARM_RESTART || HPM_LVGL_HEATMAP_ENABLE || HPM_LVGL_OVERLAY_ENABLE
+#error "HPM_LVGL_L8 is not supported with the warm restart, heatmap or overlay modules (they need RGB565 draw buffers)."
+#endif
+
+#if (HPM_LVGL_L8_CHUNK_PX % 4U) != 0U
+#error "HPM_LVGL_L8_CHUNK_PX must be a multiple of 4"
+#endif
+
+#if HPM_LVGL_L8_STAGE_SLOTS < 2U
+#error "HPM_LVGL_L8_STAGE_SLOTS must be at least 2"
+#endif
+
+/* Pixels timed for the calibration (the LUT itself is the source). */
+#define L8_CAL_PX                   LV_MIN(HPM_LVGL_L8_CHUNK_PX, 512U)
+
+/*============================================================================
+ * Private data
+ *============================================================================*/
+
+/* Big-endian RGB565 (wire order) for each L8 value */
+static uint16_t l8_lut[256];
+
+/* Staging ring, read by the SPI TX DMA */
+static uint16_t HPM_LVGL_FB_NONCACHEABLE_ATTR l8_stage[HPM_LVGL_L8_STAGE_SLOTS][HPM_LVGL_L8_CHUNK_PX];
+
+static struct {
+    lv_display_t *disp;
+
+    /* Current strip: pixels not expanded yet, and the staged chunks waiting for the bus */
+    const uint8_t *src;
+    uint32_t left;
+    uint32_t staged;
+    uint32_t fill;              /* Slot the next chunk is expanded into */
+    uint32_t send;              /* Slot sent next */
+    uint32_t len[HPM_LVGL_L8_STAGE_SLOTS];
+
+    hpm_lvgl_l8_stats_t stats;
+} l8_ctx;
+
+/*============================================================================
+ * LUT
+ *============================================================================*/
+
+static inline uint16_t l8_wire(uint16_t c)
+{
+    return (uint16_t)((c >> 8) | (c << 8));
+}
+
+static void l8_lut_grey(void)
+{
+    for (uint32_t i = 0; i < 256U; i++) {
+        l8_lut[i] = l8_wire(lv_color_to_u16(lv_color_make((uint8_t)i, (uint8_t)i, (uint8_t)i)));
+    }
+}
+
+static inline uint8_t l8_lerp(uint8_t a, uint8_t b, uint32_t num, uint32_t den)
+{
+    return (uint8_t)((int32_t)a + ((((int32_t)b - (int32_t)a) * (int32_t)num) / (int32_t)den));
+}
+
+static void l8_redraw(void)
+{
+    if (l8_ctx.disp != NULL) {
+        lv_obj_invalidate(lv_display_get_screen_active(l8_ctx.disp));
+    }
+}
+
+/*============================================================================
+ * Expansion
+ *============================================================================*/
+
+HPM_LVGL_HOT_ATTR void hpm_lvgl_l8_expand(uint16_t *dst, const uint8_t *src, uint32_t px)
+{
+    const uint16_t *lut = l8_lut;
+
+    /* Four pixels per word read, two per word written */
+    if (((((uintptr_t)src) & 3U) == 0U) && ((((uintptr_t)dst) & 3U) == 0U)) {
+        const uint32_t *s32 = (const uint32_t *)src;
+        uint32_t *d32 = (uint32_t *)dst;
+
+        for (; px >= 4U; px -= 4U) {
+            uint32_t s = *s32++;
+            d32[0] = (uint32_t)lut[s & 0xFFU] | ((uint32_t)lut[(s >> 8) & 0xFFU] << 16);
+            d32[1] = (uint32_t)lut[(s >> 16) & 0xFFU] | ((uint32_t)lut[s >> 24] << 16);
+            d32 += 2;
+        }
+        src = (const uint8_t *)s32;
+        dst = (uint16_t *)d32;
+    }
+    for (; px > 0U; px--) {
+        *dst++ = lut[*src++];
+    }
+}
+
+/* Expand the next chunk of the strip into the fill slot. */
+HPM_LVGL_HOT_ATTR static void l8_stage_one(void)
+{
+    uint32_t n = LV_MIN(l8_ctx.left, HPM_LVGL_L8_CHUNK_PX);
+    uint32_t slot = l8_ctx.fill;
+    uint64_t start = hpm_csr_get_core_cycle();
+
+    hpm_lvgl_l8_expand(l8_stage[slot], l8_ctx.src, n);
+
+    uint32_t cycles = (uint32_t)(hpm_csr_get_core_cycle() - start);
+    l8_ctx.stats.expand_cycles += cycles;
+    if (cycles > l8_ctx.stats.expand_max_cycles) {
+        l8_ctx.stats.expand_max_cycles = cycles;
+    }
+    l8_ctx.stats.pixels += n;
+
+    l8_ctx.len[slot] = n * 2U;
+    l8_ctx.src += n;
+    l8_ctx.left -= n;
+    l8_ctx.fill = (slot + 1U) % HPM_LVGL_L8_STAGE_SLOTS;
+    l8_ctx.staged++;
+}
+
+HPM_LVGL_HOT_ATTR void hpm_lvgl_l8_stream_begin(const uint8_t *px_map, uint32_t px)
+{
+    l8_ctx.src = px_map;
+    l8_ctx.left = px;
+    l8_ctx.staged = 0;
+    l8_ctx.fill = 0;
+    l8_ctx.send = 0;
+    l8_ctx.stats.strips++;
+
+    /* Nothing is on the bus yet: fill every slot. The DMA completion handler then finds the next
+     * chunk staged however early it runs, and is the only one refilling the ring from here on. */
+    while ((l8_ctx.left > 0U) && (l8_ctx.staged < HPM_LVGL_L8_STAGE_SLOTS)) {
+        l8_stage_one();
+    }
+}
+
+HPM_LVGL_HOT_ATTR const uint8_t *hpm_lvgl_l8_stream_next(uint32_t *len)
+{
+    if (l8_ctx.staged == 0U) {
+        return NULL;
+    }
+
+    uint32_t slot = l8_ctx.send;
+    l8_ctx.send = (slot + 1U) % HPM_LVGL_L8_STAGE_SLOTS;
+    l8_ctx.staged--;
+    l8_ctx.stats.chunks++;
+    *len = l8_ctx.len[slot];
+    return (const uint8_t *)l8_stage[slot];
+}
+
+HPM_LVGL_HOT_ATTR void hpm_lvgl_l8_stream_prefetch(void)
+{
+    /* One slot is on the bus; fill the others */
+    while ((l8_ctx.left > 0U) && (l8_ctx.staged < (HPM_LVGL_L8_STAGE_SLOTS - 1U))) {
+        l8_stage_one();
+    }
+}
+
+HPM_LVGL_HOT_ATTR void hpm_lvgl_l8_stream_abort(void)
+{
+    l8_ctx.left = 0;
+    l8_ctx.staged = 0;
+    l8_ctx.stats.errors++;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+hpm_stat_t hpm_lvgl_l8_init(lv_display_t *disp)
+{
+    memset(&l8_ctx, 0, sizeof(l8_ctx));
+    l8_ctx.disp = disp;
+    l8_lut_grey();
+
+    /* Calibration: time a warm expansion into the first slot */
+    hpm_lvgl_l8_expand(l8_stage[0], (const uint8_t *)l8_lut, L8_CAL_PX);
+    uint64_t start = hpm_csr_get_core_cycle();
+    hpm_lvgl_l8_expand(l8_stage[0], (const uint8_t *)l8_lut, L8_CAL_PX);
+    uint64_t cycles = hpm_csr_get_core_cycle() - start;
+    l8_ctx.stats.cycles_per_kpx = (uint32_t)((cycles * 1024U) / L8_CAL_PX);
+
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_L8);
+    return status_success;
+}
+
+hpm_stat_t hpm_lvgl_l8_set_palette(const lv_color_t *colors, uint32_t count)
+{
+    /* Color per luminance, or -1 */
+    int16_t owner[256];
+    uint32_t collisions = 0;
+
+    if (count > 256U) {
+        return status_invalid_argument;
+    }
+    if ((colors == NULL) || (count == 0U)) {
+        l8_lut_grey();
+        l8_redraw();
+        return status_success;
+    }
+
+    memset(owner, 0xFF, sizeof(owner));
+    for (uint32_t i = 0; i < count; i++) {
+        uint8_t l = lv_color_luminance(colors[i]);
+        if (owner[l] < 0) {
+            owner[l] = (int16_t)i;
+        } else if (!lv_color_eq(colors[owner[l]], colors[i])) {
+            collisions++;
+        }
+    }
+
+    /* Between two palette luminances interpolate; outside them hold the nearest color */
+    int32_t lo = -1;
+    for (uint32_t l = 0; l < 256U; l++) {
+        if (owner[l] >= 0) {
+            lo = (int32_t)l;
+            l8_lut[l] = l8_wire(lv_color_to_u16(colors[owner[l]]));
+            continue;
+        }
+
+        int32_t hi = -1;
+        for (uint32_t k = l + 1U; k < 256U; k++) {
+            if (owner[k] >= 0) {
+                hi = (int32_t)k;
+                break;
+            }
+        }
+
+        lv_color_t c;
+        if ((lo >= 0) && (hi >= 0)) {
+            lv_color_t a = colors[owner[lo]];
+            lv_color_t b = colors[owner[hi]];
+            uint32_t num = l - (uint32_t)lo;
+            uint32_t den = (uint32_t)(hi - lo);
+            c = lv_color_make(l8_lerp(a.red, b.red, num, den), l8_lerp(a.green, b.green, num, den),
+                              l8_lerp(a.blue, b.blue, num, den));
+        } else {
+            c = colors[owner[(lo >= 0) ? lo : hi]];
+        }
+        l8_lut[l] = l8_wire(lv_color_to_u16(c));
+    }
+
+    l8_ctx.stats.collisions = collisions;
+    l8_redraw();
+    return (collisions == 0U) ? status_success : status_fail;
+}
+
+void hpm_lvgl_l8_set_lut(const uint16_t *rgb565)
+{
+    if (rgb565 == NULL) {
+        return;
+    }
+    for (uint32_t i = 0; i < 256U; i++) {
+        l8_lut[i] = l8_wire(rgb565[i]);
+    }
+    l8_redraw();
+}
+
+void hpm_lvgl_l8_reset(void)
+{
+    uint32_t cal = l8_ctx.stats.cycles_per_kpx;
+    uint32_t collisions = l8_ctx.stats.collisions;
+
+    memset(&l8_ctx.stats, 0, sizeof(l8_ctx.stats));
+    l8_ctx.stats.cycles_per_kpx = cal;
+    l8_ctx.stats.collisions = collisions;
+}
+
+void hpm_lvgl_l8_get_stats(hpm_lvgl_l8_stats_t *out)
+{
+    if (out != NULL) {
+        *out = l8_ctx.stats;
+    }
+}
+
+void hpm_lvgl_l8_dump(void)
+{
+    hpm_lvgl_l8_stats_t s;
+
+    hpm_lvgl_l8_get_stats(&s);
+    printf("# hpm_lvgl_l8 chunk_px=%u slots=%u cyc_per_kpx=%lu collisions=%lu\n", (unsigned int)HPM_LVGL_L8_CHUNK_PX,
+           (unsigned int)HPM_LVGL_L8_STAGE_SLOTS, (unsigned long)s.cycles_per_kpx, (unsigned long)s.collisions);
+    printf("S strips=%lu chunks=%lu errors=%lu pixels=%lu expand=%lu expand_max=%lu\n", (unsigned long)s.strips,
+           (unsigned long)s.chunks, (unsigned long)s.errors, (unsigned long)s.pixels, (unsigned long)s.expand_cycles,
+           (unsigned long)s.expand_max_cycles);
+    printf("# hpm_lvgl_l8 end\n");
+}
+
+#endif /* HPM_LVGL_L8 */
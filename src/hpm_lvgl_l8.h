@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * L8 (8-bit) draw buffers with LUT expansion in the flush path
+ *
+ * LVGL renders into one byte per pixel (LV_COLOR_FORMAT_L8, the luminance of each color). The
+ * flush expands each strip through a 256-entry LUT into big-endian RGB565, a chunk at a time, in
+ * a small ring of non-cacheable staging buffers: the next chunk is expanded while the previous
+ * one is on the bus, and the DMA completion starts the following one. A palette of the UI's
+ * colors maps every luminance back to its color, so draw buffers take half the RAM.
+ */
+
+#ifndef HPM_LVGL_L8_H
+#define HPM_LVGL_L8_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hpm_common.h"
+#include "lvgl.h"
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+/* Disabled by default: LVGL renders RGB565 and the draw buffers are sent as they are. */
+#ifndef HPM_LVGL_L8
+#define HPM_LVGL_L8                 0
+#endif
+
+/* Pixels expanded per chunk (one DMA transfer each); a multiple of 4. */
+#ifndef HPM_LVGL_L8_CHUNK_PX
+#define HPM_LVGL_L8_CHUNK_PX        1024U
+#endif
+
+/* Staging buffers in the ring (>= 2): one on the bus, the others expanded ahead. */
+#ifndef HPM_LVGL_L8_STAGE_SLOTS
+#define HPM_LVGL_L8_STAGE_SLOTS     2U
+#endif
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+typedef struct {
+    uint32_t strips;            /* Flushed areas */
+    uint32_t chunks;            /* Staged chunks sent */
+    uint32_t errors;            /* Strips cut short because a chunk transfer did not start */
+    uint32_t collisions;        /* Palette colors dropped: same luminance as another one */
+    uint64_t pixels;            /* Pixels expanded */
+    uint64_t expand_cycles;     /* CPU time spent expanding (flush callback and DMA ISR) */
+    uint32_t expand_max_cycles; /* Longest single chunk */
+    uint32_t cycles_per_kpx;    /* Calibration at init: cycles per 1024 expanded pixels */
+} hpm_lvgl_l8_stats_t;
+
+/*============================================================================
+ * API Functions
+ *============================================================================*/
+
+#if HPM_LVGL_L8
+
+/**
+ * @brief Switch the display to L8, load a grey ramp LUT and calibrate the expansion
+ * @note Called by `hpm_lvgl_spi_init()` before the draw buffers are set.
+ */
+hpm_stat_t hpm_lvgl_l8_init(lv_display_t *disp);
+
+/**
+ * @brief Build the LUT from the UI's colors
+ *
+ * Each color lands on its luminance; the entries between two colors are interpolated, so
+ * anti-aliased edges between colors of neighbouring luminance keep their shade. Redraws the
+ * active screen. Call from LVGL context.
+ *
+ * @param colors Palette (NULL or count 0: grey ramp)
+ * @param count Number of colors (at most 256)
+ * @return status_success, status_invalid_argument for count > 256, or status_fail if two colors
+ *         share a luminance (the first one is kept; pick a slightly different shade)
+ */
+hpm_stat_t hpm_lvgl_l8_set_palette(const lv_color_t *colors, uint32_t count);
+
+/**
+ * @brief Load all 256 entries directly (native RGB565); redraws the active screen
+ */
+void hpm_lvgl_l8_set_lut(const uint16_t *rgb565);
+
+/**
+ * @brief Expand px L8 pixels to big-endian RGB565 through the current LUT
+ */
+void hpm_lvgl_l8_expand(uint16_t *dst, const uint8_t *src, uint32_t px);
+
+/**
+ * @brief Start sending an L8 strip: expands into every staging slot
+ * @note Call before the first chunk transfer starts. The ring is not locked: once it is on the
+ *       bus, only the DMA completion handler may call the stream functions.
+ */
+void hpm_lvgl_l8_stream_begin(const uint8_t *px_map, uint32_t px);
+
+/**
+ * @brief Next staged chunk of the current strip
+ * @param len Output: chunk length in bytes
+ * @return The chunk, or NULL when the strip is done
+ */
+const uint8_t *hpm_lvgl_l8_stream_next(uint32_t *len);
+
+/**
+ * @brief Expand ahead into the free staging slots
+ * @note Call from the DMA completion handler once the chunk from `hpm_lvgl_l8_stream_next()` is on
+ *       the bus (or between blocking transfers).
+ */
+void hpm_lvgl_l8_stream_prefetch(void);
+
+/**
+ * @brief Drop the rest of the current strip (a chunk transfer failed)
+ */
+void hpm_lvgl_l8_stream_abort(void);
+
+/**
+ * @brief Clear the counters (the calibration is kept)
+ */
+void hpm_lvgl_l8_reset(void);
+
+/**
+ * @brief Get expansion statistics
+ * @param out Output stats (must not be NULL)
+ */
+void hpm_lvgl_l8_get_stats(hpm_lvgl_l8_stats_t *out);
+
+/**
+ * @brief Print expansion statistics over the console UART
+ */
+void hpm_lvgl_l8_dump(void);
+
+#else
+
+static inline hpm_stat_t hpm_lvgl_l8_init(lv_display_t *disp) { (void)disp; return status_success; }
+static inline hpm_stat_t hpm_lvgl_l8_set_palette(const lv_color_t *colors, uint32_t count)
+{
+    (void)colors;
+    (void)count;
+    return status_success;
+}
+static inline void hpm_lvgl_l8_set_lut(const uint16_t *rgb565) { (void)rgb565; }
+static inline void hpm_lvgl_l8_reset(void) {}
+static inline void hpm_lvgl_l8_get_stats(hpm_lvgl_l8_stats_t *out) { (void)out; }
+static inline void hpm_lvgl_l8_dump(void) {}
+
+#endif /* HPM_LVGL_L8 */
+
+#endif /* HPM_LVGL_L8_H */
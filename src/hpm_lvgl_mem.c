@@ -0,0 +1,538 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * LVGL heap with size-class pools implementation
+ */
+
+#include "hpm_lvgl_mem.h"
+
+#if HPM_LVGL_MEM_POOLS
+
+#include <stdio.h>
+#include <string.h>
+#include "hpm_common.h"
+#include "lvgl.h"
+
+#if LV_USE_STDLIB_MALLOC != LV_STDLIB_CUSTOM
+#error "HPM_LVGL_MEM_POOLS needs LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM (set by lv_conf_ext.h)"
+#endif
+
+#define ARRAY_SIZE(a)       (sizeof(a) / sizeof((a)[0]))
+#define MEM_ALIGN(x)        (((x) + 7U) & ~7U)
+
+/* Arena block: an 8-byte header in front of the payload; free blocks chain through the payload. */
+#define MEM_HDR_SIZE        8U
+#define MEM_MIN_BLOCK       16U
+#define MEM_TAG_USED        0x55534544UL    /* "USED" */
+#define MEM_TAG_FREE        0x46524545UL    /* "FREE" */
+
+typedef struct mem_block {
+    uint32_t size;              /* Bytes including the header */
+    uint32_t tag;
+    struct mem_block *next;     /* Next free block by address (free blocks only) */
+} mem_block_t;
+
+typedef struct {
+    uint8_t *base;
+    uint8_t *end;
+    void *free;                 /* Free blocks, linked through their first word */
+    uint16_t size;
+    uint16_t blocks;
+    uint16_t used;
+    uint16_t peak;
+    uint32_t overflows;
+} mem_pool_t;
+
+static const uint16_t mem_class_size[] = HPM_LVGL_MEM_CLASS_SIZES;
+static const uint16_t mem_class_blocks[] = HPM_LVGL_MEM_CLASS_BLOCKS;
+
+#define MEM_CLASSES         ARRAY_SIZE(mem_class_size)
+
+/*============================================================================
+ * Private data
+ *============================================================================*/
+
+static uint8_t HPM_LVGL_MEM_ATTR mem_region[HPM_LVGL_MEM_SIZE];
+
+static struct {
+    mem_pool_t pools[MEM_CLASSES];
+    uint8_t *arena;
+    uint32_t arena_size;
+    mem_block_t *free_list;     /* Sorted by address */
+    uint32_t used;
+    uint32_t peak;
+    uint32_t alloc_count;
+    uint32_t fail_count;
+#if LV_USE_OS
+    lv_mutex_t lock;
+#endif
+} mem_ctx;
+
+static inline void mem_lock(void)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&mem_ctx.lock);
+#endif
+}
+
+static inline void mem_unlock(void)
+{
+#if LV_USE_OS
+    lv_mutex_unlock(&mem_ctx.lock);
+#endif
+}
+
+static inline void mem_account_alloc(uint32_t bytes)
+{
+    mem_ctx.used += bytes;
+    if (mem_ctx.used > mem_ctx.peak) {
+        mem_ctx.peak = mem_ctx.used;
+    }
+}
+
+/*============================================================================
+ * Size-class pools
+ *============================================================================*/
+
+static void mem_pools_init(void)
+{
+    uint8_t *p = mem_region;
+    uint32_t left = HPM_LVGL_MEM_SIZE;
+
+    for (uint32_t i = 0; i < MEM_CLASSES; i++) {
+        mem_pool_t *pool = &mem_ctx.pools[i];
+        uint32_t size = MEM_ALIGN(mem_class_size[i]);
+        uint32_t blocks = mem_class_blocks[i];
+
+        /* Leave at least half of the region to the arena */
+        uint32_t budget = (left > (HPM_LVGL_MEM_SIZE / 2U)) ? (left - (HPM_LVGL_MEM_SIZE / 2U)) : 0U;
+        if ((blocks * size) > budget) {
+            blocks = budget / size;
+        }
+
+        pool->base = p;
+        pool->size = (uint16_t)size;
+        pool->blocks = (uint16_t)blocks;
+        pool->free = NULL;
+        for (uint32_t b = blocks; b > 0U; b--) {
+            void **blk = (void **)(p + ((b - 1U) * size));
+            *blk = pool->free;
+            pool->free = blk;
+        }
+        p += blocks * size;
+        left -= blocks * size;
+        pool->end = p;
+    }
+
+    mem_ctx.arena = p;
+    mem_ctx.arena_size = left & ~7U;
+}
+
+static mem_pool_t *mem_pool_of(const void *ptr)
+{
+    const uint8_t *p = (const uint8_t *)ptr;
+
+    for (uint32_t i = 0; i < MEM_CLASSES; i++) {
+        if ((p >= mem_ctx.pools[i].base) && (p < mem_ctx.pools[i].end)) {
+            return &mem_ctx.pools[i];
+        }
+    }
+    return NULL;
+}
+
+/* Pop a block of the smallest class that fits; NULL if the size is not pooled or the pool is empty. */
+static void *mem_pool_alloc(size_t size)
+{
+    for (uint32_t i = 0; i < MEM_CLASSES; i++) {
+        mem_pool_t *pool = &mem_ctx.pools[i];
+
+        if (size > pool->size) {
+            continue;
+        }
+        if (pool->free == NULL) {
+            pool->overflows++;
+            return NULL;
+        }
+
+        void **blk = (void **)pool->free;
+        pool->free = *blk;
+        pool->used++;
+        if (pool->used > pool->peak) {
+            pool->peak = pool->used;
+        }
+        mem_account_alloc(pool->size);
+        return blk;
+    }
+    return NULL;
+}
+
+static void mem_pool_free(mem_pool_t *pool, void *ptr)
+{
+    void **blk = (void **)ptr;
+
+    *blk = pool->free;
+    pool->free = blk;
+    pool->used--;
+    mem_ctx.used -= pool->size;
+}
+
+/*============================================================================
+ * Arena (best fit, coalescing)
+ *============================================================================*/
+
+static void mem_arena_init(void)
+{
+    mem_block_t *b = (mem_block_t *)mem_ctx.arena;
+
+    b->size = mem_ctx.arena_size;
+    b->tag = MEM_TAG_FREE;
+    b->next = NULL;
+    mem_ctx.free_list = b;
+}
+
+static inline uint32_t mem_block_need(size_t size)
+{
+    uint32_t need = MEM_ALIGN((uint32_t)size + MEM_HDR_SIZE);
+
+    return (need < MEM_MIN_BLOCK) ? MEM_MIN_BLOCK : need;
+}
+
+/* Allocate the first `need` bytes of free block b (linked after prev); a large enough rest stays free. */
+static void mem_arena_take(mem_block_t *prev, mem_block_t *b, uint32_t need)
+{
+    mem_block_t *next = b->next;
+
+    if ((b->size - need) >= MEM_MIN_BLOCK) {
+        mem_block_t *rest = (mem_block_t *)((uint8_t *)b + need);
+        rest->size = b->size - need;
+        rest->tag = MEM_TAG_FREE;
+        rest->next = next;
+        next = rest;
+        b->size = need;
+    }
+
+    if (prev != NULL) {
+        prev->next = next;
+    } else {
+        mem_ctx.free_list = next;
+    }
+    b->tag = MEM_TAG_USED;
+    mem_account_alloc(b->size);
+}
+
+static void *mem_arena_alloc(size_t size)
+{
+    uint32_t need = mem_block_need(size);
+    mem_block_t *best = NULL;
+    mem_block_t *best_prev = NULL;
+    mem_block_t *prev = NULL;
+
+    if (size > (HPM_LVGL_MEM_SIZE - MEM_HDR_SIZE)) {
+        return NULL;
+    }
+
+    for (mem_block_t *b = mem_ctx.free_list; b != NULL; prev = b, b = b->next) {
+        if ((b->size >= need) && ((best == NULL) || (b->size < best->size))) {
+            best = b;
+            best_prev = prev;
+            if (b->size == need) {
+                break;
+            }
+        }
+    }
+    if (best == NULL) {
+        return NULL;
+    }
+
+    mem_arena_take(best_prev, best, need);
+    return (uint8_t *)best + MEM_HDR_SIZE;
+}
+
+static void mem_arena_free(mem_block_t *b)
+{
+    mem_block_t *prev = NULL;
+    mem_block_t *next = mem_ctx.free_list;
+
+    mem_ctx.used -= b->size;
+    b->tag = MEM_TAG_FREE;
+
+    while ((next != NULL) && (next < b)) {
+        prev = next;
+        next = next->next;
+    }
+
+    /* Merge with the following free block */
+    if ((next != NULL) && (((uint8_t *)b + b->size) == (uint8_t *)next)) {
+        b->size += next->size;
+        b->next = next->next;
+    } else {
+        b->next = next;
+    }
+
+    /* Merge with the preceding free block */
+    if ((prev != NULL) && (((uint8_t *)prev + prev->size) == (uint8_t *)b)) {
+        prev->size += b->size;
+        prev->next = b->next;
+    } else if (prev != NULL) {
+        prev->next = b;
+    } else {
+        mem_ctx.free_list = b;
+    }
+}
+
+/* Grow b in place into the free block right behind it; false if there is none or it is too small. */
+static bool mem_arena_grow(mem_block_t *b, uint32_t need)
+{
+    mem_block_t *prev = NULL;
+    mem_block_t *f = mem_ctx.free_list;
+    uint8_t *end = (uint8_t *)b + b->size;
+
+    while ((f != NULL) && ((uint8_t *)f < end)) {
+        prev = f;
+        f = f->next;
+    }
+    if ((f == NULL) || ((uint8_t *)f != end) || ((b->size + f->size) < need)) {
+        return false;
+    }
+
+    uint32_t extra = need - b->size;
+    mem_arena_take(prev, f, (extra < MEM_MIN_BLOCK) ? MEM_MIN_BLOCK : MEM_ALIGN(extra));
+    b->size += f->size;
+    return true;
+}
+
+static inline mem_block_t *mem_arena_block_of(void *ptr)
+{
+    return (mem_block_t *)((uint8_t *)ptr - MEM_HDR_SIZE);
+}
+
+static void mem_arena_scan(uint32_t *free_bytes, uint32_t *largest, uint32_t *blocks)
+{
+    *free_bytes = 0;
+    *largest = 0;
+    *blocks = 0;
+    for (mem_block_t *b = mem_ctx.free_list; b != NULL; b = b->next) {
+        *free_bytes += b->size;
+        if (b->size > *largest) {
+            *largest = b->size;
+        }
+        (*blocks)++;
+    }
+}
+
+/*============================================================================
+ * LVGL custom stdlib (LV_STDLIB_CUSTOM)
+ *============================================================================*/
+
+void lv_mem_init(void)
+{
+    memset(&mem_ctx, 0, sizeof(mem_ctx));
+    mem_pools_init();
+    mem_arena_init();
+#if LV_USE_OS
+    lv_mutex_init(&mem_ctx.lock);
+#endif
+}
+
+void lv_mem_deinit(void)
+{
+#if LV_USE_OS
+    lv_mutex_delete(&mem_ctx.lock);
+#endif
+}
+
+lv_mem_pool_t lv_mem_add_pool(void *mem, size_t bytes)
+{
+    /* The region is fixed at build time (HPM_LVGL_MEM_SIZE). */
+    LV_UNUSED(mem);
+    LV_UNUSED(bytes);
+    return NULL;
+}
+
+void lv_mem_remove_pool(lv_mem_pool_t pool)
+{
+    LV_UNUSED(pool);
+}
+
+void *lv_malloc_core(size_t size)
+{
+    mem_lock();
+    void *p = mem_pool_alloc(size);
+    if (p == NULL) {
+        p = mem_arena_alloc(size);
+    }
+    if (p != NULL) {
+        mem_ctx.alloc_count++;
+    } else {
+        mem_ctx.fail_count++;
+    }
+    mem_unlock();
+    return p;
+}
+
+void lv_free_core(void *p)
+{
+    if (p == NULL) {
+        return;
+    }
+
+    mem_lock();
+    mem_pool_t *pool = mem_pool_of(p);
+    if (pool != NULL) {
+        mem_pool_free(pool, p);
+        mem_ctx.alloc_count--;
+    } else {
+        mem_block_t *b = mem_arena_block_of(p);
+        if (b->tag == MEM_TAG_USED) {
+            mem_arena_free(b);
+            mem_ctx.alloc_count--;
+        }
+    }
+    mem_unlock();
+}
+
+void *lv_realloc_core(void *p, size_t new_size)
+{
+    size_t old_size;
+
+    if (p == NULL) {
+        return lv_malloc_core(new_size);
+    }
+
+    mem_lock();
+    mem_pool_t *pool = mem_pool_of(p);
+    if (pool != NULL) {
+        old_size = pool->size;
+        if (new_size <= old_size) {
+            mem_unlock();
+            return p;
+        }
+    } else {
+        mem_block_t *b = mem_arena_block_of(p);
+        uint32_t need = mem_block_need(new_size);
+        old_size = b->size - MEM_HDR_SIZE;
+        if ((need <= b->size) || mem_arena_grow(b, need)) {
+            mem_unlock();
+            return p;
+        }
+    }
+    mem_unlock();
+
+    void *np = lv_malloc_core(new_size);
+    if (np == NULL) {
+        return NULL;
+    }
+    memcpy(np, p, (old_size < new_size) ? old_size : new_size);
+    lv_free_core(p);
+    return np;
+}
+
+void lv_mem_monitor_core(lv_mem_monitor_t *mon_p)
+{
+    uint32_t arena_free;
+    uint32_t largest;
+    uint32_t free_blocks;
+
+    mem_lock();
+    mem_arena_scan(&arena_free, &largest, &free_blocks);
+    for (uint32_t i = 0; i < MEM_CLASSES; i++) {
+        free_blocks += (uint32_t)(mem_ctx.pools[i].blocks - mem_ctx.pools[i].used);
+    }
+
+    mon_p->total_size = HPM_LVGL_MEM_SIZE;
+    mon_p->free_cnt = free_blocks;
+    mon_p->free_size = HPM_LVGL_MEM_SIZE - mem_ctx.used;
+    mon_p->free_biggest_size = (largest > MEM_HDR_SIZE) ? (largest - MEM_HDR_SIZE) : 0U;
+    mon_p->used_cnt = mem_ctx.alloc_count;
+    mon_p->max_used = mem_ctx.peak;
+    mon_p->used_pct = (uint8_t)(((uint64_t)mem_ctx.used * 100U) / HPM_LVGL_MEM_SIZE);
+    /* Pool blocks have a fixed size and cannot fragment: rate the arena only. */
+    mon_p->frag_pct = (arena_free > 0U) ? (uint8_t)(100U - (((uint64_t)largest * 100U) / arena_free)) : 0U;
+    mem_unlock();
+}
+
+lv_result_t lv_mem_test_core(void)
+{
+    uint8_t *p = mem_ctx.arena;
+    uint8_t *end = mem_ctx.arena + mem_ctx.arena_size;
+    lv_result_t res = LV_RESULT_OK;
+
+    mem_lock();
+    while (p < end) {
+        mem_block_t *b = (mem_block_t *)p;
+        if ((b->size < MEM_MIN_BLOCK) || ((b->size & 7U) != 0U) ||
+            ((b->tag != MEM_TAG_USED) && (b->tag != MEM_TAG_FREE))) {
+            res = LV_RESULT_INVALID;
+            break;
+        }
+        p += b->size;
+    }
+    if (p != end) {
+        res = LV_RESULT_INVALID;
+    }
+    mem_unlock();
+    return res;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+void hpm_lvgl_mem_get_stats(hpm_lvgl_mem_stats_t *out)
+{
+    uint32_t arena_free;
+    uint32_t largest;
+    uint32_t free_blocks;
+
+    if (out == NULL) {
+        return;
+    }
+
+    memset(out, 0, sizeof(*out));
+    mem_lock();
+    mem_arena_scan(&arena_free, &largest, &free_blocks);
+
+    out->total = HPM_LVGL_MEM_SIZE;
+    out->used = mem_ctx.used;
+    out->peak = mem_ctx.peak;
+    out->arena_total = mem_ctx.arena_size;
+    out->arena_free = arena_free;
+    out->arena_largest_free = (largest > MEM_HDR_SIZE) ? (largest - MEM_HDR_SIZE) : 0U;
+    out->arena_free_blocks = free_blocks;
+    out->arena_frag_pct = (arena_free > 0U) ? (uint8_t)(100U - (((uint64_t)largest * 100U) / arena_free)) : 0U;
+    out->alloc_count = mem_ctx.alloc_count;
+    out->fail_count = mem_ctx.fail_count;
+    out->class_count = (MEM_CLASSES < HPM_LVGL_MEM_MAX_CLASSES) ? MEM_CLASSES : HPM_LVGL_MEM_MAX_CLASSES;
+    for (uint32_t i = 0; i < out->class_count; i++) {
+        const mem_pool_t *pool = &mem_ctx.pools[i];
+        out->classes[i].block_size = pool->size;
+        out->classes[i].blocks = pool->blocks;
+        out->classes[i].used = pool->used;
+        out->classes[i].peak = pool->peak;
+        out->classes[i].overflows = pool->overflows;
+    }
+    mem_unlock();
+}
+
+void hpm_lvgl_mem_dump(void)
+{
+    hpm_lvgl_mem_stats_t s;
+
+    hpm_lvgl_mem_get_stats(&s);
+
+    printf("# hpm_lvgl_mem total=%lu used=%lu peak=%lu allocs=%lu fails=%lu\n",
+           (unsigned long)s.total, (unsigned long)s.used, (unsigned long)s.peak,
+           (unsigned long)s.alloc_count, (unsigned long)s.fail_count);
+    for (uint32_t i = 0; i < s.class_count; i++) {
+        const hpm_lvgl_mem_class_stats_t *c = &s.classes[i];
+        printf("P size=%u blocks=%u used=%u peak=%u overflows=%lu\n", (unsigned int)c->block_size,
+               (unsigned int)c->blocks, (unsigned int)c->used, (unsigned int)c->peak, (unsigned long)c->overflows);
+    }
+    printf("A size=%lu free=%lu largest=%lu free_blocks=%lu frag=%u%%\n", (unsigned long)s.arena_total,
+           (unsigned long)s.arena_free, (unsigned long)s.arena_largest_free, (unsigned long)s.arena_free_blocks,
+           (unsigned int)s.arena_frag_pct);
+    printf("# hpm_lvgl_mem end\n");
+}
+
+#endif /* HPM_LVGL_MEM_POOLS */
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * LVGL heap with size-class pools
+ *
+ * Replaces LVGL's TLSF heap (`LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM`) with fixed-size
+ * block pools for the small allocations LVGL makes per object (objects, style arrays,
+ * event lists, label text) and a best-fit, coalescing arena for everything larger. Page
+ * rebuilds then recycle pool blocks instead of cutting up the arena, so the arena keeps
+ * large free blocks after hours of uptime. Both live in one region placed in DLM.
+ */
+
+#ifndef HPM_LVGL_MEM_H
+#define HPM_LVGL_MEM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+/* Disabled by default: LVGL keeps its built-in heap. Must be visible to the LVGL sources as
+ * well (lv_conf_ext.h switches LV_USE_STDLIB_MALLOC), so set it from CMake:
+ * `cmake -DHPM_LVGL_MEM_POOLS=1 ...`. */
+#ifndef HPM_LVGL_MEM_POOLS
+#define HPM_LVGL_MEM_POOLS          0
+#endif
+
+/* Region shared by the pools (carved first) and the arena (the rest) */
+#ifndef HPM_LVGL_MEM_SIZE
+#define HPM_LVGL_MEM_SIZE           (64 * 1024U)
+#endif
+
+/* Pool block sizes (ascending, multiples of 8) and block counts per size */
+#ifndef HPM_LVGL_MEM_CLASS_SIZES
+#define HPM_LVGL_MEM_CLASS_SIZES    { 16, 32, 64, 128, 256 }
+#endif
+
+#ifndef HPM_LVGL_MEM_CLASS_BLOCKS
+#define HPM_LVGL_MEM_CLASS_BLOCKS   { 128, 192, 160, 48, 12 }
+#endif
+
+/* Upper bound for the number of size classes (stats array size) */
+#define HPM_LVGL_MEM_MAX_CLASSES    8
+
+/* Placement of the region: DLM (`.fast_ram.bss`) when the SDK provides it */
+#ifndef HPM_LVGL_MEM_ATTR
+#if defined(ATTR_PLACE_AT_FAST_RAM_BSS_WITH_ALIGNMENT)
+#define HPM_LVGL_MEM_ATTR ATTR_PLACE_AT_FAST_RAM_BSS_WITH_ALIGNMENT(8)
+#else
+#define HPM_LVGL_MEM_ATTR __attribute__((aligned(8)))
+#endif
+#endif
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+typedef struct {
+    uint16_t block_size;        /* Bytes per block */
+    uint16_t blocks;            /* Blocks in the pool */
+    uint16_t used;              /* Blocks allocated now */
+    uint16_t peak;              /* Most blocks allocated at once */
+    uint32_t overflows;         /* Requests of this class served by the arena (pool empty) */
+} hpm_lvgl_mem_class_stats_t;
+
+typedef struct {
+    uint32_t total;             /* Region size (pools + arena) */
+    uint32_t used;              /* Bytes allocated now (pool blocks + arena blocks with headers) */
+    uint32_t peak;              /* High-water mark of used */
+    uint32_t arena_total;
+    uint32_t arena_free;
+    uint32_t arena_largest_free; /* Largest request the arena can serve now */
+    uint32_t arena_free_blocks;
+    uint8_t arena_frag_pct;     /* 100 - largest free * 100 / free */
+    uint32_t alloc_count;       /* Live allocations */
+    uint32_t fail_count;        /* Requests that returned NULL */
+    uint32_t class_count;
+    hpm_lvgl_mem_class_stats_t classes[HPM_LVGL_MEM_MAX_CLASSES];
+} hpm_lvgl_mem_stats_t;
+
+/*============================================================================
+ * API Functions
+ *============================================================================*/
+
+#if HPM_LVGL_MEM_POOLS
+
+/**
+ * @brief Get heap statistics (walks the arena free list)
+ * @param out Output stats (must not be NULL)
+ */
+void hpm_lvgl_mem_get_stats(hpm_lvgl_mem_stats_t *out);
+
+/**
+ * @brief Print pool and arena statistics over the console UART
+ */
+void hpm_lvgl_mem_dump(void);
+
+#else
+
+static inline void hpm_lvgl_mem_get_stats(hpm_lvgl_mem_stats_t *out) { (void)out; }
+static inline void hpm_lvgl_mem_dump(void) {}
+
+#endif /* HPM_LVGL_MEM_POOLS */
+
+#endif /* HPM_LVGL_MEM_H */
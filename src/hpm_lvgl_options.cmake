@@ -0,0 +1,70 @@
+# Copyright (c) 2024 HPMicro
+# SPDX-License-Identifier: BSD-3-Clause
+
+# Module options shared by src/CMakeLists.txt and the examples: each one is forwarded to every
+# source (LVGL's too, for lv_conf_ext.h). Set them on the cmake command line, e.g.
+# cmake -DHPM_LVGL_L8=1 -DHPM_LVGL_FB_LINES=160 ... (see docs/PORTING.md)
+
+# L8 draw buffers expanded to RGB565 through a palette LUT in the flush path (src/hpm_lvgl_l8.c);
+# HPM_LVGL_FB_LINES (default 80) can then be doubled for the same RAM
+if(NOT DEFINED HPM_LVGL_L8)
+    set(HPM_LVGL_L8 0)
+endif()
+sdk_compile_definitions(-DHPM_LVGL_L8=${HPM_LVGL_L8})
+foreach(opt HPM_LVGL_FB_LINES HPM_LVGL_L8_CHUNK_PX HPM_LVGL_L8_STAGE_SLOTS)
+    if(DEFINED ${opt})
+        sdk_compile_definitions(-D${opt}=${${opt}})
+    endif()
+endforeach()
+
+# Opaque fills and RGB565 image copies into the draw buffer on a spare DMA channel (src/hpm_lvgl_draw_dma.c)
+if(NOT DEFINED HPM_LVGL_DRAW_DMA)
+    set(HPM_LVGL_DRAW_DMA 0)
+endif()
+sdk_compile_definitions(-DHPM_LVGL_DRAW_DMA=${HPM_LVGL_DRAW_DMA})
+foreach(opt HPM_LVGL_DRAW_DMA_MIN_PX HPM_LVGL_DRAW_DMA_IMAGES HPM_LVGL_DRAW_DMA_MAX_ROWS HPM_LVGL_DRAW_DMA_CH)
+    if(DEFINED ${opt})
+        sdk_compile_definitions(-D${opt}=${${opt}})
+    endif()
+endforeach()
+
+# Packed-SIMD RGB565 fill/blend/swap kernels in LVGL's software renderer (src/hpm_lvgl_dsp.c); they use the
+# P-extension intrinsics when -march enables them, portable C otherwise
+if(NOT DEFINED HPM_LVGL_DSP)
+    set(HPM_LVGL_DSP 0)
+endif()
+sdk_compile_definitions(-DHPM_LVGL_DSP=${HPM_LVGL_DSP})
+foreach(opt HPM_LVGL_DSP_ISA)
+    if(DEFINED ${opt})
+        sdk_compile_definitions(-D${opt}=${${opt}})
+    endif()
+endforeach()
+
+# HPM6E8x render/transfer split (src/hpm_lvgl_dualcore.c): 0 off, 1 this image is core 0 (LVGL);
+# core 1 builds st7789.c + hpm_lvgl_dualcore.c with HPM_LVGL_DUALCORE=2 (see docs/PORTING.md)
+if(NOT DEFINED HPM_LVGL_DUALCORE)
+    set(HPM_LVGL_DUALCORE 0)
+endif()
+sdk_compile_definitions(-DHPM_LVGL_DUALCORE=${HPM_LVGL_DUALCORE})
+foreach(opt HPM_LVGL_DUALCORE_RING_LEN HPM_LVGL_DUALCORE_ATTACH_TIMEOUT_MS HPM_LVGL_DUALCORE_SEND_TIMEOUT_MS)
+    if(DEFINED ${opt})
+        sdk_compile_definitions(-D${opt}=${${opt}})
+    endif()
+endforeach()
+
+# LVGL in a FreeRTOS task (src/hpm_lvgl_rtos.c); the application also sets CONFIG_FREERTOS
+if(NOT DEFINED HPM_LVGL_RTOS)
+    set(HPM_LVGL_RTOS 0)
+endif()
+sdk_compile_definitions(-DHPM_LVGL_RTOS=${HPM_LVGL_RTOS})
+foreach(opt HPM_LVGL_RTOS_PRIORITY HPM_LVGL_RTOS_STACK_WORDS HPM_LVGL_RTOS_QUEUE_LEN)
+    if(DEFINED ${opt})
+        sdk_compile_definitions(-D${opt}=${${opt}})
+    endif()
+endforeach()
+
+# LVGL software draw units (threads) rendering one strip in parallel; > 1 needs HPM_LVGL_RTOS=1
+if(NOT DEFINED HPM_LVGL_DRAW_UNITS)
+    set(HPM_LVGL_DRAW_UNITS 1)
+endif()
+sdk_compile_definitions(-DHPM_LVGL_DRAW_UNITS=${HPM_LVGL_DRAW_UNITS})
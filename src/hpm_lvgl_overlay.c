@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Post-render overlay plane and perf HUD implementation
+ */
+
+#include "hpm_lvgl_overlay.h"
+
+#if HPM_LVGL_OVERLAY_ENABLE
+
+#include "hpm_lvgl_spi.h"
+#include <stdio.h>
+#include <string.h>
+
+/*============================================================================
+ * Built-in 5x7 font (column-major, LSB = top row)
+ *============================================================================*/
+
+static const char overlay_glyph_chars[] = " %-./0123456789:ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+static const uint8_t overlay_glyphs[][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, /* ' ' */
+    {0x23, 0x13, 0x08, 0x64, 0x62}, /* '%' */
+    {0x08, 0x08, 0x08, 0x08, 0x08}, /* '-' */
+    {0x00, 0x60, 0x60, 0x00, 0x00}, /* '.' */
+    {0x20, 0x10, 0x08, 0x04, 0x02}, /* '/' */
+    {0x3E, 0x51, 0x49, 0x45, 0x3E}, /* '0' */
+    {0x00, 0x42, 0x7F, 0x40, 0x00}, /* '1' */
+    {0x42, 0x61, 0x51, 0x49, 0x46}, /* '2' */
+    {0x21, 0x41, 0x45, 0x4B, 0x31}, /* '3' */
+    {0x18, 0x14, 0x12, 0x7F, 0x10}, /* '4' */
+    {0x27, 0x45, 0x45, 0x45, 0x39}, /* '5' */
+    {0x3C, 0x4A, 0x49, 0x49, 0x30}, /* '6' */
+    {0x01, 0x71, 0x09, 0x05, 0x03}, /* '7' */
+    {0x36, 0x49, 0x49, 0x49, 0x36}, /* '8' */
+    {0x06, 0x49, 0x49, 0x29, 0x1E}, /* '9' */
+    {0x00, 0x36, 0x36, 0x00, 0x00}, /* ':' */
+    {0x7E, 0x11, 0x11, 0x11, 0x7E}, /* 'A' */
+    {0x7F, 0x49, 0x49, 0x49, 0x36}, /* 'B' */
+    {0x3E, 0x41, 0x41, 0x41, 0x22}, /* 'C' */
+    {0x7F, 0x41, 0x41, 0x22, 0x1C}, /* 'D' */
+    {0x7F, 0x49, 0x49, 0x49, 0x41}, /* 'E' */
+    {0x7F, 0x09, 0x09, 0x09, 0x01}, /* 'F' */
+    {0x3E, 0x41, 0x49, 0x49, 0x7A}, /* 'G' */
+    {0x7F, 0x08, 0x08, 0x08, 0x7F}, /* 'H' */
+    {0x00, 0x41, 0x7F, 0x41, 0x00}, /* 'I' */
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, /* 'J' */
+    {0x7F, 0x08, 0x14, 0x22, 0x41}, /* 'K' */
+    {0x7F, 0x40, 0x40, 0x40, 0x40}, /* 'L' */
+    {0x7F, 0x02, 0x0C, 0x02, 0x7F}, /* 'M' */
+    {0x7F, 0x04, 0x08, 0x10, 0x7F}, /* 'N' */
+    {0x3E, 0x41, 0x41, 0x41, 0x3E}, /* 'O' */
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, /* 'P' */
+    {0x3E, 0x41, 0x51, 0x21, 0x5E}, /* 'Q' */
+    {0x7F, 0x09, 0x19, 0x29, 0x46}, /* 'R' */
+    {0x46, 0x49, 0x49, 0x49, 0x31}, /* 'S' */
+    {0x01, 0x01, 0x7F, 0x01, 0x01}, /* 'T' */
+    {0x3F, 0x40, 0x40, 0x40, 0x3F}, /* 'U' */
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, /* 'V' */
+    {0x3F, 0x40, 0x38, 0x40, 0x3F}, /* 'W' */
+    {0x63, 0x14, 0x08, 0x14, 0x63}, /* 'X' */
+    {0x07, 0x08, 0x70, 0x08, 0x07}, /* 'Y' */
+    {0x61, 0x51, 0x49, 0x45, 0x43}, /* 'Z' */
+};
+
+/*============================================================================
+ * Private data
+ *============================================================================*/
+
+static struct {
+    lv_display_t *disp;
+    hpm_lvgl_overlay_push_cb_t push_cb;
+    lv_area_t area;             /* plane position on screen */
+    bool visible;
+    volatile bool dirty;        /* plane changed since it was last pushed */
+#if HPM_LVGL_OVERLAY_HUD
+    lv_timer_t *hud_timer;
+    uint32_t hud_last_tick;
+    uint64_t hud_last_xfer_us;
+#endif
+} overlay_ctx;
+
+/* Plane pixels, RGB565 MSB first, row stride = plane width */
+static uint8_t overlay_buf[HPM_LVGL_OVERLAY_MAX_W * HPM_LVGL_OVERLAY_MAX_H * 2];
+
+/*============================================================================
+ * Helpers
+ *============================================================================*/
+
+static inline uint16_t overlay_wire_color(lv_color_t color)
+{
+    uint16_t c = lv_color_to_u16(color);
+    return (uint16_t)((c >> 8) | (c << 8));
+}
+
+static void overlay_fill_rect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t wire_color)
+{
+    int32_t pw = lv_area_get_width(&overlay_ctx.area);
+    int32_t ph = lv_area_get_height(&overlay_ctx.area);
+    uint16_t *px = (uint16_t *)overlay_buf;
+
+    for (int32_t yy = (y < 0) ? 0 : y; (yy < y + h) && (yy < ph); yy++) {
+        for (int32_t xx = (x < 0) ? 0 : x; (xx < x + w) && (xx < pw); xx++) {
+            px[yy * pw + xx] = wire_color;
+        }
+    }
+}
+
+static void overlay_try_push(void)
+{
+    if (!overlay_ctx.dirty || !overlay_ctx.visible || (overlay_ctx.push_cb == NULL)) {
+        return;
+    }
+
+    /* Clear first: a commit racing with the push is then pushed again. */
+    overlay_ctx.dirty = false;
+    if (!overlay_ctx.push_cb(&overlay_ctx.area, overlay_buf)) {
+        overlay_ctx.dirty = true;
+    }
+}
+
+#if HPM_LVGL_OVERLAY_HUD
+static void overlay_hud_timer_cb(lv_timer_t *timer)
+{
+    lv_color_t bg = lv_color_black();
+    lv_color_t fg = lv_color_make(0x00, 0xFF, 0x40);
+    hpm_lvgl_spi_stats_t s;
+    lv_mem_monitor_t mon;
+    char line[48];
+
+    (void)timer;
+
+    uint32_t now = lv_tick_get();
+    uint32_t dt_ms = now - overlay_ctx.hud_last_tick;
+    hpm_lvgl_spi_get_stats(&s);
+    lv_mem_monitor(&mon);
+
+    /* Bus utilization = time a draw buffer was on the SPI side / wall time */
+    uint64_t dxfer_us = s.xfer_us - overlay_ctx.hud_last_xfer_us;
+    uint32_t bus_pct = (dt_ms != 0U) ? (uint32_t)((dxfer_us / 10U) / dt_ms) : 0U;
+    if (bus_pct > 100U) {
+        bus_pct = 100U;
+    }
+    overlay_ctx.hud_last_tick = now;
+    overlay_ctx.hud_last_xfer_us = s.xfer_us;
+
+    snprintf(line, sizeof(line), "%luFPS BUS%lu%% HEAP%luK %u%%",
+             (unsigned long)hpm_lvgl_spi_get_fps(), (unsigned long)bus_pct,
+             (unsigned long)((mon.total_size - mon.free_size) / 1024U), (unsigned int)mon.used_pct);
+
+    hpm_lvgl_overlay_fill(bg);
+    hpm_lvgl_overlay_draw_text(1, 1, line, fg, bg);
+    hpm_lvgl_overlay_commit();
+    overlay_try_push();
+}
+#endif
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+void hpm_lvgl_overlay_init(lv_display_t *disp, hpm_lvgl_overlay_push_cb_t push_cb)
+{
+    memset(&overlay_ctx, 0, sizeof(overlay_ctx));
+    overlay_ctx.disp = disp;
+    overlay_ctx.push_cb = push_cb;
+
+    /* Default: one text line at the bottom of the screen. */
+    int32_t hor = lv_display_get_horizontal_resolution(disp);
+    int32_t ver = lv_display_get_vertical_resolution(disp);
+    hpm_lvgl_overlay_set_rect(0, ver - HPM_LVGL_OVERLAY_MAX_H, hor, HPM_LVGL_OVERLAY_MAX_H);
+
+#if HPM_LVGL_OVERLAY_HUD
+    hpm_lvgl_overlay_hud_enable(true);
+#endif
+}
+
+void hpm_lvgl_overlay_flush(const lv_area_t *area, uint8_t *px_map)
+{
+    lv_area_t clip;
+
+    if (!overlay_ctx.visible || (area == NULL) || (px_map == NULL)) {
+        return;
+    }
+    if (!lv_area_intersect(&clip, area, &overlay_ctx.area)) {
+        return;
+    }
+
+    int32_t dst_w = lv_area_get_width(area);
+    int32_t src_w = lv_area_get_width(&overlay_ctx.area);
+    size_t row_bytes = (size_t)lv_area_get_width(&clip) * 2U;
+
+    for (int32_t y = clip.y1; y <= clip.y2; y++) {
+        uint8_t *dst = px_map + (((y - area->y1) * dst_w + (clip.x1 - area->x1)) * 2);
+        const uint8_t *src = overlay_buf + (((y - overlay_ctx.area.y1) * src_w + (clip.x1 - overlay_ctx.area.x1)) * 2);
+        memcpy(dst, src, row_bytes);
+    }
+}
+
+void hpm_lvgl_overlay_refr_ready(void)
+{
+    overlay_try_push();
+}
+
+void hpm_lvgl_overlay_set_rect(int32_t x, int32_t y, int32_t w, int32_t h)
+{
+    bool was_visible = overlay_ctx.visible;
+
+    if (w > HPM_LVGL_OVERLAY_MAX_W) {
+        w = HPM_LVGL_OVERLAY_MAX_W;
+    }
+    if (h > HPM_LVGL_OVERLAY_MAX_H) {
+        h = HPM_LVGL_OVERLAY_MAX_H;
+    }
+    if ((w <= 0) || (h <= 0)) {
+        hpm_lvgl_overlay_show(false);
+        return;
+    }
+
+    if (was_visible) {
+        hpm_lvgl_overlay_show(false);
+    }
+    lv_area_set(&overlay_ctx.area, x, y, x + w - 1, y + h - 1);
+    memset(overlay_buf, 0, sizeof(overlay_buf));
+    if (was_visible) {
+        hpm_lvgl_overlay_show(true);
+    }
+}
+
+void hpm_lvgl_overlay_show(bool show)
+{
+    if (overlay_ctx.visible == show) {
+        return;
+    }
+
+    overlay_ctx.visible = show;
+    if (show) {
+        hpm_lvgl_overlay_commit();
+    } else if (overlay_ctx.disp != NULL) {
+        /* The only invalidation this module ever does: give the area back to LVGL. */
+        lv_obj_t *scr = lv_display_get_screen_active(overlay_ctx.disp);
+        if (scr != NULL) {
+            lv_obj_invalidate_area(scr, &overlay_ctx.area);
+        }
+    }
+}
+
+void hpm_lvgl_overlay_fill(lv_color_t color)
+{
+    overlay_fill_rect(0, 0, HPM_LVGL_OVERLAY_MAX_W, HPM_LVGL_OVERLAY_MAX_H, overlay_wire_color(color));
+}
+
+int32_t hpm_lvgl_overlay_draw_text(int32_t x, int32_t y, const char *text, lv_color_t fg, lv_color_t bg)
+{
+    uint16_t fg_px = overlay_wire_color(fg);
+    uint16_t bg_px = overlay_wire_color(bg);
+
+    if (text == NULL) {
+        return x;
+    }
+
+    for (; *text != '\0'; text++) {
+        char c = *text;
+        if ((c >= 'a') && (c <= 'z')) {
+            c = (char)(c - 'a' + 'A');
+        }
+        const char *pos = strchr(overlay_glyph_chars, c);
+        const uint8_t *glyph = overlay_glyphs[(pos != NULL) ? (pos - overlay_glyph_chars) : 0];
+
+        overlay_fill_rect(x, y, HPM_LVGL_OVERLAY_FONT_W, HPM_LVGL_OVERLAY_FONT_H, bg_px);
+        for (int32_t col = 0; col < 5; col++) {
+            for (int32_t row = 0; row < 7; row++) {
+                if ((glyph[col] & (1U << row)) != 0U) {
+                    overlay_fill_rect(x + col, y + row, 1, 1, fg_px);
+                }
+            }
+        }
+        x += HPM_LVGL_OVERLAY_FONT_W;
+    }
+
+    return x;
+}
+
+void hpm_lvgl_overlay_commit(void)
+{
+    overlay_ctx.dirty = true;
+}
+
+void hpm_lvgl_overlay_hud_enable(bool enable)
+{
+#if HPM_LVGL_OVERLAY_HUD
+    if (enable && (overlay_ctx.hud_timer == NULL)) {
+        overlay_ctx.hud_last_tick = lv_tick_get();
+        overlay_ctx.hud_timer = lv_timer_create(overlay_hud_timer_cb, HPM_LVGL_OVERLAY_HUD_PERIOD_MS, NULL);
+        hpm_lvgl_overlay_show(true);
+    } else if (!enable && (overlay_ctx.hud_timer != NULL)) {
+        lv_timer_delete(overlay_ctx.hud_timer);
+        overlay_ctx.hud_timer = NULL;
+        hpm_lvgl_overlay_show(false);
+    }
+#else
+    (void)enable;
+#endif
+}
+
+#endif /* HPM_LVGL_OVERLAY_ENABLE */
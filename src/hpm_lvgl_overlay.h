@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Post-render overlay plane for the LVGL SPI display adapter
+ *
+ * A fixed opaque rectangle with its own small pixel buffer. It is composited into
+ * every outgoing flush on top of what LVGL rendered, and pushed to the panel directly
+ * (between LVGL refreshes, when the bus is idle) after it changes. Updating it never
+ * invalidates LVGL objects, so it can show perf data without perturbing the measurement.
+ * The built-in HUD uses it to show FPS, bus utilization and LVGL heap use.
+ */
+
+#ifndef HPM_LVGL_OVERLAY_H
+#define HPM_LVGL_OVERLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl.h"
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+/* Disabled by default: every hook below compiles to nothing. */
+#ifndef HPM_LVGL_OVERLAY_ENABLE
+#define HPM_LVGL_OVERLAY_ENABLE     0
+#endif
+
+/* Largest plane (pixels); the buffer is MAX_W x MAX_H x 2 bytes. */
+#ifndef HPM_LVGL_OVERLAY_MAX_W
+#define HPM_LVGL_OVERLAY_MAX_W      HPM_LVGL_LCD_WIDTH
+#endif
+
+#ifndef HPM_LVGL_OVERLAY_MAX_H
+#define HPM_LVGL_OVERLAY_MAX_H      9
+#endif
+
+/* Built-in perf HUD (one text line at the bottom of the screen) */
+#ifndef HPM_LVGL_OVERLAY_HUD
+#define HPM_LVGL_OVERLAY_HUD        1
+#endif
+
+#ifndef HPM_LVGL_OVERLAY_HUD_PERIOD_MS
+#define HPM_LVGL_OVERLAY_HUD_PERIOD_MS  500
+#endif
+
+/* Convenience for applications that draw their own perf labels. */
+#define HPM_LVGL_HUD_ACTIVE         (HPM_LVGL_OVERLAY_ENABLE && HPM_LVGL_OVERLAY_HUD)
+
+/* Built-in font cell (5x7 glyphs) */
+#define HPM_LVGL_OVERLAY_FONT_W     6
+#define HPM_LVGL_OVERLAY_FONT_H     8
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+/**
+ * @brief Backend hook used to push the plane to the panel
+ * @param area Screen area (LVGL coordinates)
+ * @param px_map RGB565 pixels, MSB first, `lv_area_get_width(area)` per row
+ * @return false if the bus is busy (the push is retried later)
+ */
+typedef bool (*hpm_lvgl_overlay_push_cb_t)(const lv_area_t *area, const uint8_t *px_map);
+
+/*============================================================================
+ * API Functions
+ *============================================================================*/
+
+#if HPM_LVGL_OVERLAY_ENABLE
+
+/**
+ * @brief Attach to a display (called by `hpm_lvgl_spi_init()`)
+ */
+void hpm_lvgl_overlay_init(lv_display_t *disp, hpm_lvgl_overlay_push_cb_t push_cb);
+
+/**
+ * @brief Flush hook: copy the plane over the intersecting part of an outgoing area
+ * @param px_map RGB565 pixels in wire byte order (MSB first), modified in place
+ */
+void hpm_lvgl_overlay_flush(const lv_area_t *area, uint8_t *px_map);
+
+/**
+ * @brief Adapter hook at the end of an LVGL refresh: push the plane if it changed
+ */
+void hpm_lvgl_overlay_refr_ready(void);
+
+/**
+ * @brief Move/resize the plane (clipped to HPM_LVGL_OVERLAY_MAX_W/H)
+ */
+void hpm_lvgl_overlay_set_rect(int32_t x, int32_t y, int32_t w, int32_t h);
+
+/**
+ * @brief Show or hide the plane; hiding lets LVGL repaint the area below
+ */
+void hpm_lvgl_overlay_show(bool show);
+
+/**
+ * @brief Fill the whole plane with a color
+ */
+void hpm_lvgl_overlay_fill(lv_color_t color);
+
+/**
+ * @brief Draw text with the built-in 5x7 font (digits, A-Z, space and `%-./:`; lowercase is drawn uppercase)
+ * @param x,y Position inside the plane
+ * @return X position after the last glyph
+ */
+int32_t hpm_lvgl_overlay_draw_text(int32_t x, int32_t y, const char *text, lv_color_t fg, lv_color_t bg);
+
+/**
+ * @brief Mark the plane as changed; it is pushed at the next opportunity
+ */
+void hpm_lvgl_overlay_commit(void);
+
+/**
+ * @brief Enable/disable the built-in HUD (takes over the plane content)
+ */
+void hpm_lvgl_overlay_hud_enable(bool enable);
+
+#else
+
+static inline void hpm_lvgl_overlay_init(lv_display_t *disp, hpm_lvgl_overlay_push_cb_t push_cb)
+{
+    (void)disp;
+    (void)push_cb;
+}
+static inline void hpm_lvgl_overlay_flush(const lv_area_t *area, uint8_t *px_map)
+{
+    (void)area;
+    (void)px_map;
+}
+static inline void hpm_lvgl_overlay_refr_ready(void) {}
+static inline void hpm_lvgl_overlay_set_rect(int32_t x, int32_t y, int32_t w, int32_t h)
+{
+    (void)x;
+    (void)y;
+    (void)w;
+    (void)h;
+}
+static inline void hpm_lvgl_overlay_show(bool show) { (void)show; }
+static inline void hpm_lvgl_overlay_fill(lv_color_t color) { (void)color; }
+static inline int32_t hpm_lvgl_overlay_draw_text(int32_t x, int32_t y, const char *text, lv_color_t fg, lv_color_t bg)
+{
+    (void)y;
+    (void)text;
+    (void)fg;
+    (void)bg;
+    return x;
+}
+static inline void hpm_lvgl_overlay_commit(void) {}
+static inline void hpm_lvgl_overlay_hud_enable(bool enable) { (void)enable; }
+
+#endif /* HPM_LVGL_OVERLAY_ENABLE */
+
+#endif /* HPM_LVGL_OVERLAY_H */
@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Deterministic record/replay implementation
+ */
+
+#include "hpm_lvgl_replay.h"
+
+#if HPM_LVGL_REPLAY_ENABLE
+
+#include "hpm_lvgl_spi.h"
+#include "hpm_clock_drv.h"
+#include "hpm_csr_drv.h"
+#include <stdio.h>
+#include <string.h>
+
+/*============================================================================
+ * Private data
+ *============================================================================*/
+
+static struct {
+    lv_display_t *disp;
+
+    /* Time base: LVGL sees real + offset, or the virtual tick while replaying */
+    uint32_t offset_ms;
+    uint32_t last_real_ms;
+    uint32_t virt_ms;
+    uint32_t virt_start_ms;
+
+    /* Recording */
+    bool recording;
+    uint32_t rec_last_ms;
+    uint32_t rec_count;
+    hpm_lvgl_replay_event_t rec[HPM_LVGL_REPLAY_MAX_EVENTS];
+
+    /* Replay */
+    bool playing;
+    const hpm_lvgl_replay_event_t *events;
+    uint32_t event_count;
+    uint32_t next_event;
+    uint32_t next_due_ms;       /* Virtual time (since start) of the next event */
+    uint32_t end_ms;            /* Virtual time (since start) the replay ends */
+    hpm_lvgl_replay_input_cb_t cb;
+    uint64_t start_cycle;
+
+    /* Frame checksums */
+    bool frame_flushed;
+    uint32_t frame_crc;
+    hpm_lvgl_replay_result_t result;
+    uint32_t frame_crcs[HPM_LVGL_REPLAY_FRAME_CRCS];
+    uint32_t prev_frames;
+    uint32_t prev_crcs[HPM_LVGL_REPLAY_FRAME_CRCS];
+} replay_ctx;
+
+/*============================================================================
+ * CRC32 (IEEE 802.3, nibble table)
+ *============================================================================*/
+
+static const uint32_t replay_crc_table[16] = {
+    0x00000000U, 0x1db71064U, 0x3b6e20c8U, 0x26d930acU, 0x76dc4190U, 0x6b6b51f4U, 0x4db26158U, 0x5005713cU,
+    0xedb88320U, 0xf00f9344U, 0xd6d6a3e8U, 0xcb61b38cU, 0x9b64c2b0U, 0x86d3d2d4U, 0xa00ae278U, 0xbdbdf21cU,
+};
+
+static uint32_t replay_crc32(uint32_t crc, const uint8_t *data, uint32_t len)
+{
+    crc = ~crc;
+    for (uint32_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ replay_crc_table[crc & 0x0fU];
+        crc = (crc >> 4) ^ replay_crc_table[crc & 0x0fU];
+    }
+    return ~crc;
+}
+
+/*============================================================================
+ * Replay control
+ *============================================================================*/
+
+static void replay_schedule_next(void)
+{
+    if (replay_ctx.next_event < replay_ctx.event_count) {
+        replay_ctx.next_due_ms += replay_ctx.events[replay_ctx.next_event].delta_ms;
+    }
+}
+
+static void replay_finish(void)
+{
+    hpm_lvgl_replay_result_t *r = &replay_ctx.result;
+    uint32_t cpu_mhz = clock_get_frequency(clock_cpu0) / 1000000U;
+    uint32_t kept = (r->frames < HPM_LVGL_REPLAY_FRAME_CRCS) ? r->frames : HPM_LVGL_REPLAY_FRAME_CRCS;
+    uint32_t prev_kept = (replay_ctx.prev_frames < HPM_LVGL_REPLAY_FRAME_CRCS) ? replay_ctx.prev_frames
+                                                                               : HPM_LVGL_REPLAY_FRAME_CRCS;
+
+    r->virtual_ms = replay_ctx.virt_ms - replay_ctx.virt_start_ms;
+    r->real_us = (uint32_t)((hpm_csr_get_core_cycle() - replay_ctx.start_cycle) / ((cpu_mhz != 0U) ? cpu_mhz : 1U));
+
+    /* Compare with the previous replay */
+    r->compared = (replay_ctx.prev_frames != 0U);
+    r->mismatch_frame = UINT32_MAX;
+    if (r->compared) {
+        uint32_t n = (kept < prev_kept) ? kept : prev_kept;
+        for (uint32_t i = 0; i < n; i++) {
+            if (replay_ctx.frame_crcs[i] != replay_ctx.prev_crcs[i]) {
+                r->mismatch_frame = i;
+                break;
+            }
+        }
+        if ((r->mismatch_frame == UINT32_MAX) && (r->frames != replay_ctx.prev_frames)) {
+            r->mismatch_frame = n;
+        }
+    }
+    memcpy(replay_ctx.prev_crcs, replay_ctx.frame_crcs, sizeof(uint32_t) * kept);
+    replay_ctx.prev_frames = r->frames;
+
+    /* Keep the tick seen by LVGL monotonic: resume from wherever virtual time got to. */
+    uint32_t now = replay_ctx.last_real_ms + replay_ctx.offset_ms;
+    if ((int32_t)(replay_ctx.virt_ms - now) > 0) {
+        replay_ctx.offset_ms += replay_ctx.virt_ms - now;
+    }
+
+    replay_ctx.playing = false;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+void hpm_lvgl_replay_init(lv_display_t *disp)
+{
+    memset(&replay_ctx, 0, sizeof(replay_ctx));
+    replay_ctx.disp = disp;
+    replay_ctx.result.mismatch_frame = UINT32_MAX;
+}
+
+uint32_t hpm_lvgl_replay_tick(uint32_t real_ms)
+{
+    replay_ctx.last_real_ms = real_ms;
+    return replay_ctx.playing ? replay_ctx.virt_ms : (real_ms + replay_ctx.offset_ms);
+}
+
+void hpm_lvgl_replay_flush(const lv_area_t *area, const uint8_t *px_map)
+{
+    int32_t coords[4];
+
+    if (!replay_ctx.playing || (area == NULL) || (px_map == NULL)) {
+        return;
+    }
+
+    coords[0] = area->x1;
+    coords[1] = area->y1;
+    coords[2] = area->x2;
+    coords[3] = area->y2;
+    replay_ctx.frame_crc = replay_crc32(replay_ctx.frame_crc, (const uint8_t *)coords, sizeof(coords));
+    replay_ctx.frame_crc = replay_crc32(replay_ctx.frame_crc, px_map,
+                                        lv_area_get_size(area) * HPM_LVGL_FB_PIXEL_SIZE);
+    replay_ctx.frame_flushed = true;
+}
+
+void hpm_lvgl_replay_frame_end(void)
+{
+    hpm_lvgl_replay_result_t *r = &replay_ctx.result;
+
+    if (!replay_ctx.playing || !replay_ctx.frame_flushed) {
+        return;
+    }
+
+    if (r->frames < HPM_LVGL_REPLAY_FRAME_CRCS) {
+        replay_ctx.frame_crcs[r->frames] = replay_ctx.frame_crc;
+    }
+    r->crc = replay_crc32(r->crc, (const uint8_t *)&replay_ctx.frame_crc, sizeof(replay_ctx.frame_crc));
+    r->frames++;
+
+    replay_ctx.frame_crc = 0;
+    replay_ctx.frame_flushed = false;
+}
+
+void hpm_lvgl_replay_record_start(void)
+{
+    replay_ctx.rec_count = 0;
+    replay_ctx.rec_last_ms = lv_tick_get();
+    replay_ctx.recording = true;
+}
+
+void hpm_lvgl_replay_record_stop(void)
+{
+    replay_ctx.recording = false;
+}
+
+void hpm_lvgl_replay_input(uint16_t code, uint16_t arg)
+{
+    if (!replay_ctx.recording || replay_ctx.playing) {
+        return;
+    }
+    if (replay_ctx.rec_count >= HPM_LVGL_REPLAY_MAX_EVENTS) {
+        replay_ctx.recording = false;
+        return;
+    }
+
+    uint32_t now = lv_tick_get();
+    hpm_lvgl_replay_event_t *ev = &replay_ctx.rec[replay_ctx.rec_count++];
+    ev->delta_ms = now - replay_ctx.rec_last_ms;
+    ev->code = code;
+    ev->arg = arg;
+    replay_ctx.rec_last_ms = now;
+}
+
+const hpm_lvgl_replay_event_t *hpm_lvgl_replay_get_recording(uint32_t *count)
+{
+    if (count != NULL) {
+        *count = replay_ctx.rec_count;
+    }
+    return replay_ctx.rec;
+}
+
+void hpm_lvgl_replay_play(const hpm_lvgl_replay_event_t *events, uint32_t count, uint32_t tail_ms,
+                          hpm_lvgl_replay_input_cb_t cb)
+{
+    uint32_t total = 0;
+
+    if ((replay_ctx.disp == NULL) || replay_ctx.playing) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        total += events[i].delta_ms;
+    }
+
+    replay_ctx.events = events;
+    replay_ctx.event_count = count;
+    replay_ctx.next_event = 0;
+    replay_ctx.next_due_ms = 0;
+    replay_ctx.end_ms = total + tail_ms;
+    replay_ctx.cb = cb;
+    replay_schedule_next();
+
+    memset(&replay_ctx.result, 0, sizeof(replay_ctx.result));
+    replay_ctx.result.mismatch_frame = UINT32_MAX;
+    replay_ctx.frame_crc = 0;
+    replay_ctx.frame_flushed = false;
+
+    /* Virtual time continues from the current LVGL tick. */
+    replay_ctx.virt_ms = replay_ctx.last_real_ms + replay_ctx.offset_ms;
+    replay_ctx.virt_start_ms = replay_ctx.virt_ms;
+    replay_ctx.playing = true;
+    replay_ctx.start_cycle = hpm_csr_get_core_cycle();
+
+    /* Same starting frame and the same timer phase on every run */
+    lv_obj_invalidate(lv_display_get_screen_active(replay_ctx.disp));
+    lv_timer_reset(lv_display_get_refr_timer(replay_ctx.disp));
+    lv_timer_reset(lv_anim_get_timer());
+}
+
+bool hpm_lvgl_replay_poll(void)
+{
+    if (!replay_ctx.playing) {
+        return false;
+    }
+
+    replay_ctx.virt_ms += HPM_LVGL_REPLAY_STEP_MS;
+    uint32_t t = replay_ctx.virt_ms - replay_ctx.virt_start_ms;
+
+    while ((replay_ctx.next_event < replay_ctx.event_count) && (t >= replay_ctx.next_due_ms)) {
+        const hpm_lvgl_replay_event_t *ev = &replay_ctx.events[replay_ctx.next_event++];
+        if (replay_ctx.cb != NULL) {
+            replay_ctx.cb(ev->code, ev->arg);
+        }
+        replay_schedule_next();
+    }
+
+    if ((replay_ctx.next_event >= replay_ctx.event_count) && (t >= replay_ctx.end_ms)) {
+        replay_finish();
+        return false;
+    }
+
+    return true;
+}
+
+bool hpm_lvgl_replay_is_playing(void)
+{
+    return replay_ctx.playing;
+}
+
+void hpm_lvgl_replay_get_result(hpm_lvgl_replay_result_t *out)
+{
+    if (out != NULL) {
+        *out = replay_ctx.result;
+    }
+}
+
+void hpm_lvgl_replay_dump(void)
+{
+    printf("# hpm_lvgl_replay v1 events=%lu\n", (unsigned long)replay_ctx.rec_count);
+    for (uint32_t i = 0; i < replay_ctx.rec_count; i++) {
+        const hpm_lvgl_replay_event_t *ev = &replay_ctx.rec[i];
+        printf("E %lu %u %u\n", (unsigned long)ev->delta_ms, (unsigned int)ev->code, (unsigned int)ev->arg);
+    }
+    printf("# hpm_lvgl_replay end\n");
+}
+
+void hpm_lvgl_replay_dump_result(void)
+{
+    const hpm_lvgl_replay_result_t *r = &replay_ctx.result;
+
+    printf("# hpm_lvgl_replay result frames=%lu crc=0x%08lx virtual_ms=%lu real_us=%lu",
+           (unsigned long)r->frames, (unsigned long)r->crc, (unsigned long)r->virtual_ms,
+           (unsigned long)r->real_us);
+    if (!r->compared) {
+        printf(" compare=none\n");
+    } else if (r->mismatch_frame == UINT32_MAX) {
+        printf(" compare=match\n");
+    } else {
+        printf(" compare=mismatch frame=%lu\n", (unsigned long)r->mismatch_frame);
+    }
+}
+
+#endif /* HPM_LVGL_REPLAY_ENABLE */
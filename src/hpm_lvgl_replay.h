@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Deterministic input/time record and replay for the LVGL SPI display adapter
+ *
+ * Recording keeps the application's input events with the tick delta since the previous
+ * event. Replay feeds them back through a callback while the LVGL tick is virtual: it
+ * advances by a fixed step per `hpm_lvgl_replay_poll()` call instead of following the
+ * wall clock, so the same journey renders the same frames no matter how long each frame
+ * takes. A CRC over every flushed area makes that checkable (bit-identical runs), and
+ * the wall-clock duration of the replay is the benchmark number.
+ */
+
+#ifndef HPM_LVGL_REPLAY_H
+#define HPM_LVGL_REPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl.h"
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+/* Disabled by default: every hook below compiles to nothing. */
+#ifndef HPM_LVGL_REPLAY_ENABLE
+#define HPM_LVGL_REPLAY_ENABLE      0
+#endif
+
+/* Recorded input events (recording stops when full) */
+#ifndef HPM_LVGL_REPLAY_MAX_EVENTS
+#define HPM_LVGL_REPLAY_MAX_EVENTS  128
+#endif
+
+/* Virtual time advanced per hpm_lvgl_replay_poll() call during replay (ms) */
+#ifndef HPM_LVGL_REPLAY_STEP_MS
+#define HPM_LVGL_REPLAY_STEP_MS     5
+#endif
+
+/* Per-frame CRCs kept to locate the first diverging frame between two replays */
+#ifndef HPM_LVGL_REPLAY_FRAME_CRCS
+#define HPM_LVGL_REPLAY_FRAME_CRCS  128
+#endif
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+typedef struct {
+    uint32_t delta_ms;          /* Ticks since the previous event (or the start) */
+    uint16_t code;              /* Application-defined, e.g. key index */
+    uint16_t arg;
+} hpm_lvgl_replay_event_t;
+
+/**
+ * @brief Delivers a replayed input event to the application
+ */
+typedef void (*hpm_lvgl_replay_input_cb_t)(uint16_t code, uint16_t arg);
+
+typedef struct {
+    uint32_t frames;            /* Refresh cycles that flushed */
+    uint32_t crc;               /* CRC32 over every flushed area (coordinates + pixels) */
+    uint32_t virtual_ms;        /* Replayed time */
+    uint32_t real_us;           /* Wall-clock duration of the replay */
+    uint32_t mismatch_frame;    /* First frame differing from the previous replay, or UINT32_MAX */
+    bool compared;              /* A previous replay existed to compare with */
+} hpm_lvgl_replay_result_t;
+
+/*============================================================================
+ * API Functions
+ *============================================================================*/
+
+#if HPM_LVGL_REPLAY_ENABLE
+
+/**
+ * @brief Attach to a display (called by `hpm_lvgl_spi_init()`)
+ */
+void hpm_lvgl_replay_init(lv_display_t *disp);
+
+/**
+ * @brief Adapter hooks; not for application use
+ * @param real_ms Hardware tick
+ * @return Tick seen by LVGL (virtual while replaying, monotonic across replays)
+ */
+uint32_t hpm_lvgl_replay_tick(uint32_t real_ms);
+void hpm_lvgl_replay_flush(const lv_area_t *area, const uint8_t *px_map);
+void hpm_lvgl_replay_frame_end(void);
+
+/**
+ * @brief Start/stop recording; a new start discards the previous recording
+ */
+void hpm_lvgl_replay_record_start(void);
+void hpm_lvgl_replay_record_stop(void);
+
+/**
+ * @brief Report an application input event (recorded while recording, ignored otherwise)
+ */
+void hpm_lvgl_replay_input(uint16_t code, uint16_t arg);
+
+/**
+ * @brief Recorded events (valid until the next record_start)
+ */
+const hpm_lvgl_replay_event_t *hpm_lvgl_replay_get_recording(uint32_t *count);
+
+/**
+ * @brief Replay a journey
+ *
+ * Bring the UI to the state the recording started from before calling this; the screen is
+ * invalidated and the refresh/animation timers restarted so frame boundaries line up.
+ *
+ * @param events Journey (e.g. from hpm_lvgl_replay_get_recording() or a const table)
+ * @param count Number of events
+ * @param tail_ms Virtual time to keep running after the last event
+ * @param cb Receives each event when its virtual time is reached
+ */
+void hpm_lvgl_replay_play(const hpm_lvgl_replay_event_t *events, uint32_t count, uint32_t tail_ms,
+                          hpm_lvgl_replay_input_cb_t cb);
+
+/**
+ * @brief Advance virtual time and deliver due events; call once per main loop iteration,
+ *        before `lv_timer_handler()`
+ * @return true while a replay is running
+ */
+bool hpm_lvgl_replay_poll(void);
+
+/**
+ * @brief true while a replay is running (the application should ignore real input)
+ */
+bool hpm_lvgl_replay_is_playing(void);
+
+/**
+ * @brief Result of the last finished replay
+ */
+void hpm_lvgl_replay_get_result(hpm_lvgl_replay_result_t *out);
+
+/**
+ * @brief Print the recording (text, see tools/hpm_lvgl_replay_to_c.py) over the console UART
+ */
+void hpm_lvgl_replay_dump(void);
+
+/**
+ * @brief Print the last replay result over the console UART
+ */
+void hpm_lvgl_replay_dump_result(void);
+
+#else
+
+static inline void hpm_lvgl_replay_init(lv_display_t *disp) { (void)disp; }
+static inline uint32_t hpm_lvgl_replay_tick(uint32_t real_ms) { return real_ms; }
+static inline void hpm_lvgl_replay_flush(const lv_area_t *area, const uint8_t *px_map)
+{
+    (void)area;
+    (void)px_map;
+}
+static inline void hpm_lvgl_replay_frame_end(void) {}
+static inline void hpm_lvgl_replay_record_start(void) {}
+static inline void hpm_lvgl_replay_record_stop(void) {}
+static inline void hpm_lvgl_replay_input(uint16_t code, uint16_t arg)
+{
+    (void)code;
+    (void)arg;
+}
+static inline const hpm_lvgl_replay_event_t *hpm_lvgl_replay_get_recording(uint32_t *count)
+{
+    if (count != NULL) {
+        *count = 0;
+    }
+    return NULL;
+}
+static inline void hpm_lvgl_replay_play(const hpm_lvgl_replay_event_t *events, uint32_t count, uint32_t tail_ms,
+                                        hpm_lvgl_replay_input_cb_t cb)
+{
+    (void)events;
+    (void)count;
+    (void)tail_ms;
+    (void)cb;
+}
+static inline bool hpm_lvgl_replay_poll(void) { return false; }
+static inline bool hpm_lvgl_replay_is_playing(void) { return false; }
+static inline void hpm_lvgl_replay_get_result(hpm_lvgl_replay_result_t *out) { (void)out; }
+static inline void hpm_lvgl_replay_dump(void) {}
+static inline void hpm_lvgl_replay_dump_result(void) {}
+
+#endif /* HPM_LVGL_REPLAY_ENABLE */
+
+#endif /* HPM_LVGL_REPLAY_H */
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * FreeRTOS integration implementation
+ */
+
+#include "hpm_lvgl_rtos.h"
+
+#if HPM_LVGL_RTOS
+
+#if !defined(LV_USE_OS) || (LV_USE_OS != LV_OS_FREERTOS)
+#error "HPM_LVGL_RTOS needs LV_USE_OS == LV_OS_FREERTOS (set HPM_LVGL_RTOS from CMake so lv_conf_ext.h sees it)"
+#endif
+
+#include "hpm_lvgl_spi.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include <stdio.h>
+
+/*============================================================================
+ * Private data
+ *============================================================================*/
+
+typedef struct {
+    hpm_lvgl_rtos_cb_t cb;
+    void *user_data;
+} rtos_msg_t;
+
+static struct {
+    TaskHandle_t task;
+    QueueHandle_t queue;
+    hpm_lvgl_rtos_cb_t ui_create;
+    void *ui_user_data;
+
+    /* Flush finished in the DMA ISR, handed to lv_display_flush_ready() by the task */
+    lv_display_t *volatile flush_disp;
+} rtos_ctx;
+
+static inline TickType_t rtos_ms_to_ticks(uint32_t ms)
+{
+    return (ms == HPM_LVGL_RTOS_WAIT_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(ms);
+}
+
+/*============================================================================
+ * LVGL task
+ *============================================================================*/
+
+static void rtos_run_queued(void)
+{
+    rtos_msg_t msg;
+
+    while (xQueueReceive(rtos_ctx.queue, &msg, 0) == pdTRUE) {
+        msg.cb(msg.user_data);
+    }
+}
+
+static void rtos_lvgl_task(void *arg)
+{
+    (void)arg;
+
+    if (hpm_lvgl_spi_init() == NULL) {
+        printf("hpm_lvgl_rtos: display init failed\n");
+        rtos_ctx.task = NULL;
+        vTaskDelete(NULL);
+        return;
+    }
+
+    if (rtos_ctx.ui_create != NULL) {
+        lv_lock();
+        rtos_ctx.ui_create(rtos_ctx.ui_user_data);
+        lv_unlock();
+    }
+
+    for (;;) {
+        (void)hpm_lvgl_rtos_flush_ready();
+
+        lv_lock();
+        rtos_run_queued();
+        uint32_t next = lv_timer_handler();
+        lv_unlock();
+
+        if (next > HPM_LVGL_RUN_MAX_SLEEP_MS) {
+            next = HPM_LVGL_RUN_MAX_SLEEP_MS;
+        }
+
+        /* A notification consumed by a flush wait inside lv_timer_handler() may belong to a
+         * post; do not sleep on a non-empty queue. Posts after this check leave the
+         * notification pending, so the take below returns at once. */
+        if ((uxQueueMessagesWaiting(rtos_ctx.queue) == 0U) && (rtos_ctx.flush_disp == NULL)) {
+            (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(next));
+        }
+    }
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+hpm_stat_t hpm_lvgl_rtos_start(hpm_lvgl_rtos_cb_t ui_create, void *user_data)
+{
+    if (rtos_ctx.task != NULL) {
+        return status_fail;
+    }
+
+    rtos_ctx.ui_create = ui_create;
+    rtos_ctx.ui_user_data = user_data;
+    rtos_ctx.flush_disp = NULL;
+    if (rtos_ctx.queue == NULL) {
+        rtos_ctx.queue = xQueueCreate(HPM_LVGL_RTOS_QUEUE_LEN, sizeof(rtos_msg_t));
+    }
+    if (rtos_ctx.queue == NULL) {
+        return status_fail;
+    }
+
+    if (xTaskCreate(rtos_lvgl_task, "lvgl", HPM_LVGL_RTOS_STACK_WORDS, NULL, HPM_LVGL_RTOS_PRIORITY,
+                    &rtos_ctx.task) != pdPASS) {
+        rtos_ctx.task = NULL;
+        return status_fail;
+    }
+
+    return status_success;
+}
+
+hpm_stat_t hpm_lvgl_rtos_post(hpm_lvgl_rtos_cb_t cb, void *user_data, uint32_t timeout_ms)
+{
+    rtos_msg_t msg = { cb, user_data };
+
+    if ((cb == NULL) || (rtos_ctx.queue == NULL)) {
+        return status_invalid_argument;
+    }
+
+    /* Only the LVGL task drains the queue: from the task itself (an event callback, a posted
+     * call) waiting for a slot would never end */
+    if (hpm_lvgl_rtos_in_lvgl_task()) {
+        if (xQueueSend(rtos_ctx.queue, &msg, 0) != pdTRUE) {
+            return status_fail;
+        }
+        return status_success;
+    }
+
+    if (xQueueSend(rtos_ctx.queue, &msg, rtos_ms_to_ticks(timeout_ms)) != pdTRUE) {
+        return status_timeout;
+    }
+    xTaskNotifyGive(rtos_ctx.task);
+
+    return status_success;
+}
+
+hpm_stat_t hpm_lvgl_rtos_post_from_isr(hpm_lvgl_rtos_cb_t cb, void *user_data)
+{
+    rtos_msg_t msg = { cb, user_data };
+    BaseType_t woken = pdFALSE;
+
+    if ((cb == NULL) || (rtos_ctx.queue == NULL)) {
+        return status_invalid_argument;
+    }
+
+    if (xQueueSendFromISR(rtos_ctx.queue, &msg, &woken) != pdTRUE) {
+        return status_fail;
+    }
+    vTaskNotifyGiveFromISR(rtos_ctx.task, &woken);
+    portYIELD_FROM_ISR(woken);
+
+    return status_success;
+}
+
+void hpm_lvgl_rtos_wake_from_isr(void)
+{
+    BaseType_t woken = pdFALSE;
+
+    if (rtos_ctx.task == NULL) {
+        return;
+    }
+    vTaskNotifyGiveFromISR(rtos_ctx.task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+bool hpm_lvgl_rtos_in_lvgl_task(void)
+{
+    return (rtos_ctx.task != NULL) && (xTaskGetCurrentTaskHandle() == rtos_ctx.task);
+}
+
+/*============================================================================
+ * Adapter hooks
+ *============================================================================*/
+
+/* DMA completion (ISR context): LVGL only ever has one flush in flight, so one slot is enough. */
+HPM_LVGL_HOT_ATTR void hpm_lvgl_rtos_flush_done_isr(lv_display_t *disp)
+{
+    BaseType_t woken = pdFALSE;
+
+    if (rtos_ctx.task == NULL) {
+        lv_display_flush_ready(disp);
+        return;
+    }
+    rtos_ctx.flush_disp = disp;
+    vTaskNotifyGiveFromISR(rtos_ctx.task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/* LVGL task: hand a finished draw buffer back to LVGL */
+bool hpm_lvgl_rtos_flush_ready(void)
+{
+    lv_display_t *disp = rtos_ctx.flush_disp;
+
+    if (disp == NULL) {
+        return false;
+    }
+    rtos_ctx.flush_disp = NULL;
+    lv_display_flush_ready(disp);
+
+    return true;
+}
+
+void hpm_lvgl_rtos_wait(uint32_t timeout_ms)
+{
+    (void)ulTaskNotifyTake(pdTRUE, rtos_ms_to_ticks(timeout_ms));
+}
+
+/* Any task: sleep at least one tick */
+void hpm_lvgl_rtos_delay(uint32_t ms)
+{
+    TickType_t ticks = pdMS_TO_TICKS(ms);
+
+    vTaskDelay((ticks > 0U) ? ticks : 1U);
+}
+
+#endif /* HPM_LVGL_RTOS */
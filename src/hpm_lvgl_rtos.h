@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * FreeRTOS integration for the LVGL SPI display adapter
+ *
+ * One task owns LVGL: it brings the display up, builds the UI and runs the LVGL timers,
+ * sleeping on its task notification until the next timer is due. The DMA completion
+ * handler only records the finished flush and notifies the task, which calls
+ * `lv_display_flush_ready()` in task context. Other tasks change the UI by posting a call
+ * that the LVGL task runs under `lv_lock()`, or by taking `lv_lock()` themselves.
+ */
+
+#ifndef HPM_LVGL_RTOS_H
+#define HPM_LVGL_RTOS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hpm_common.h"
+#include "lvgl.h"
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+/* Disabled by default (bare-metal super loop). Must be visible to the LVGL sources as well
+ * (lv_conf_ext.h selects LV_OS_FREERTOS for lv_lock()), so set it from CMake together with
+ * CONFIG_FREERTOS: `cmake -DHPM_LVGL_RTOS=1 ...`. */
+#ifndef HPM_LVGL_RTOS
+#define HPM_LVGL_RTOS               0
+#endif
+
+/* LVGL task priority (FreeRTOS priority, above the application's worker tasks) */
+#ifndef HPM_LVGL_RTOS_PRIORITY
+#define HPM_LVGL_RTOS_PRIORITY      3
+#endif
+
+/* LVGL task stack, in words (the software renderer needs a few KB) */
+#ifndef HPM_LVGL_RTOS_STACK_WORDS
+#define HPM_LVGL_RTOS_STACK_WORDS   2048
+#endif
+
+/* Calls that can be queued for the LVGL task */
+#ifndef HPM_LVGL_RTOS_QUEUE_LEN
+#define HPM_LVGL_RTOS_QUEUE_LEN     16
+#endif
+
+/* Timeout value for hpm_lvgl_rtos_post() / hpm_lvgl_rtos_wait(): block until it succeeds */
+#define HPM_LVGL_RTOS_WAIT_FOREVER  UINT32_MAX
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+/* Runs in the LVGL task with lv_lock() held */
+typedef void (*hpm_lvgl_rtos_cb_t)(void *user_data);
+
+/*============================================================================
+ * API Functions
+ *============================================================================*/
+
+#if HPM_LVGL_RTOS
+
+/**
+ * @brief Create the LVGL task
+ * @param ui_create Called once in the LVGL task after hpm_lvgl_spi_init() (may be NULL)
+ * @param user_data Passed to ui_create
+ * @return status_success, or status_fail if the task or queue could not be created
+ * @note Call before vTaskStartScheduler() or from any task. Everything LVGL-related then happens
+ *       in the LVGL task; do not call lv_timer_handler() or hpm_lvgl_spi_run_once() elsewhere.
+ */
+hpm_stat_t hpm_lvgl_rtos_start(hpm_lvgl_rtos_cb_t ui_create, void *user_data);
+
+/**
+ * @brief Queue a call for the LVGL task (task context)
+ * @param cb Function to run with lv_lock() held
+ * @param user_data Passed to cb (must stay valid until cb runs)
+ * @param timeout_ms Time to wait for a free queue slot (0: none, HPM_LVGL_RTOS_WAIT_FOREVER)
+ * @return status_success, status_timeout if the queue stayed full, or status_fail if it is full
+ *         and the caller is the LVGL task (which never waits: only it drains the queue)
+ */
+hpm_stat_t hpm_lvgl_rtos_post(hpm_lvgl_rtos_cb_t cb, void *user_data, uint32_t timeout_ms);
+
+/**
+ * @brief Queue a call for the LVGL task (ISR context)
+ * @return status_success, or status_fail if the queue is full
+ */
+hpm_stat_t hpm_lvgl_rtos_post_from_isr(hpm_lvgl_rtos_cb_t cb, void *user_data);
+
+/**
+ * @brief Wake the LVGL task early, e.g. from an input interrupt (ISR context)
+ */
+void hpm_lvgl_rtos_wake_from_isr(void);
+
+/**
+ * @brief Check whether the caller is the LVGL task
+ */
+bool hpm_lvgl_rtos_in_lvgl_task(void);
+
+/* Adapter hooks (hpm_lvgl_spi.c) */
+void hpm_lvgl_rtos_flush_done_isr(lv_display_t *disp);
+bool hpm_lvgl_rtos_flush_ready(void);
+void hpm_lvgl_rtos_wait(uint32_t timeout_ms);
+void hpm_lvgl_rtos_delay(uint32_t ms);
+
+#else
+
+static inline hpm_stat_t hpm_lvgl_rtos_start(hpm_lvgl_rtos_cb_t ui_create, void *user_data)
+{
+    (void)ui_create;
+    (void)user_data;
+    return status_fail;
+}
+static inline hpm_stat_t hpm_lvgl_rtos_post(hpm_lvgl_rtos_cb_t cb, void *user_data, uint32_t timeout_ms)
+{
+    (void)cb;
+    (void)user_data;
+    (void)timeout_ms;
+    return status_fail;
+}
+static inline hpm_stat_t hpm_lvgl_rtos_post_from_isr(hpm_lvgl_rtos_cb_t cb, void *user_data)
+{
+    (void)cb;
+    (void)user_data;
+    return status_fail;
+}
+static inline void hpm_lvgl_rtos_wake_from_isr(void) {}
+static inline bool hpm_lvgl_rtos_in_lvgl_task(void) { return false; }
+static inline void hpm_lvgl_rtos_flush_done_isr(lv_display_t *disp) { (void)disp; }
+static inline bool hpm_lvgl_rtos_flush_ready(void) { return false; }
+static inline void hpm_lvgl_rtos_wait(uint32_t timeout_ms) { (void)timeout_ms; }
+static inline void hpm_lvgl_rtos_delay(uint32_t ms) { (void)ms; }
+
+#endif /* HPM_LVGL_RTOS */
+
+#endif /* HPM_LVGL_RTOS_H */
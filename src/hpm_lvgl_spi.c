@@ -14,16 +14,32 @@
 #include "hpm_soc.h"
 #include "hpm_spi_drv.h"
 #include "hpm_interrupt.h"
+#include "hpm_csr_drv.h"
 #include <stddef.h>
 #include <string.h>
 
+/* Backends compiled into this image: one of the two, or both with HPM_LVGL_BACKEND_AB. With
+ * HPM_LVGL_DUALCORE == 1 the only backend is the ring to core 1, which owns SPI and DMA. */
+#define HPM_LVGL_HAS_REMOTE_BACKEND     (HPM_LVGL_DUALCORE == 1)
+#define HPM_LVGL_HAS_MIPI_BACKEND       (HPM_LVGL_USE_LVGL_ST7789_DRIVER && !HPM_LVGL_HAS_REMOTE_BACKEND)
+#define HPM_LVGL_HAS_LEGACY_BACKEND     \
+    ((!HPM_LVGL_USE_LVGL_ST7789_DRIVER || HPM_LVGL_BACKEND_AB) && !HPM_LVGL_HAS_REMOTE_BACKEND)
+
 /* LVGL built-in ST7789 (generic MIPI) driver lives under:
  * middleware/lvgl/lvgl/src/drivers/display/st7789 */
-#if HPM_LVGL_USE_LVGL_ST7789_DRIVER
+#if HPM_LVGL_HAS_MIPI_BACKEND
 #include "src/drivers/display/st7789/lv_st7789.h"
 #endif
+#include "src/display/lv_display_private.h"
+
+/* LVGL runs on an RTOS: waits block on LVGL OS primitives instead of WFI. */
+#if defined(LV_USE_OS) && (LV_USE_OS != LV_OS_NONE)
+#define HPM_LVGL_HAS_OS                 1
+#else
+#define HPM_LVGL_HAS_OS                 0
+#endif
 
-#if !HPM_LVGL_USE_LVGL_ST7789_DRIVER
+#if HPM_LVGL_HAS_LEGACY_BACKEND
 #include "st7789.h"
 #endif
 
@@ -51,6 +67,22 @@
 #error "USE_DMA_MGR=1 conflicts with legacy DMAv2 ISR path. Set HPM_LVGL_USE_LVGL_ST7789_DRIVER=1 or disable DMA manager."
 #endif
 
+/* A/B mode runs the legacy driver on a DMA manager channel, so it needs the official backend's setup. */
+#if HPM_LVGL_BACKEND_AB && !HPM_LVGL_USE_LVGL_ST7789_DRIVER
+#error "HPM_LVGL_BACKEND_AB requires HPM_LVGL_USE_LVGL_ST7789_DRIVER=1 (and therefore USE_DMA_MGR=1)."
+#endif
+
+/* Dual-core split: this adapter is the core 0 side and drives no SPI itself. */
+#if HPM_LVGL_DUALCORE == 2
+#error "HPM_LVGL_DUALCORE=2 is the core 1 image: build hpm_lvgl_dualcore.c and st7789.c only"
+#endif
+#if HPM_LVGL_HAS_REMOTE_BACKEND && (HPM_LVGL_USE_LVGL_ST7789_DRIVER || HPM_LVGL_BACKEND_AB)
+#error "HPM_LVGL_DUALCORE=1 requires HPM_LVGL_USE_LVGL_ST7789_DRIVER=0 and HPM_LVGL_BACKEND_AB=0 (core 1 runs st7789.c)."
+#endif
+#if HPM_LVGL_HAS_REMOTE_BACKEND && HPM_LVGL_WARM_RESTART
+#error "HPM_LVGL_WARM_RESTART is not supported with HPM_LVGL_DUALCORE=1 (panel reads would have to go through core 1)."
+#endif
+
 /*============================================================================
  * Board-specific configuration (from board.h)
  *============================================================================*/
@@ -105,6 +137,11 @@
 #define HPM_LVGL_SPI_HAS_GPIO_CS    0
 #endif
 
+/* Panel register reads (ST7789/GC9307) and the longest one (RDDST: 4 bytes + the dummy clock) */
+#define LCD_CMD_RDDID           0x04U
+#define LCD_CMD_RDDST           0x09U
+#define HPM_LVGL_PANEL_READ_MAX 8U
+
 /* Default offsets for 172x320 screens */
 #ifndef BOARD_LCD_X_OFFSET
 #define BOARD_LCD_X_OFFSET          34
@@ -118,13 +155,48 @@
  * Private data
  *============================================================================*/
 
-/* Frame buffers - cache aligned */
-static uint8_t HPM_LVGL_FB_ATTR lvgl_fb0[HPM_LVGL_FB_SIZE];
+/* Frame buffers - cache aligned (placement selected by HPM_LVGL_FB_CACHEABLE) */
+static uint8_t HPM_LVGL_FB_ATTR lvgl_fb0_mem[HPM_LVGL_FB_SIZE];
+
+#if HPM_LVGL_USE_DOUBLE_BUFFER
+static uint8_t HPM_LVGL_FB_ATTR lvgl_fb1_mem[HPM_LVGL_FB_SIZE];
+#endif
+
+#if HPM_LVGL_FB_PLACEMENT_AB
+/* The other placement, for hpm_lvgl_spi_set_fb_cacheable() */
+#if HPM_LVGL_FB_CACHEABLE
+#define LVGL_FB_ALT_ATTR HPM_LVGL_FB_NONCACHEABLE_ATTR
+#else
+#define LVGL_FB_ALT_ATTR HPM_LVGL_FB_CACHEABLE_ATTR
+#endif
+static uint8_t LVGL_FB_ALT_ATTR lvgl_fb0_alt[HPM_LVGL_FB_SIZE];
+#if HPM_LVGL_USE_DOUBLE_BUFFER
+static uint8_t LVGL_FB_ALT_ATTR lvgl_fb1_alt[HPM_LVGL_FB_SIZE];
+#endif
+#endif
 
+/* Draw buffers LVGL renders into */
+static uint8_t *lvgl_fb0 = lvgl_fb0_mem;
 #if HPM_LVGL_USE_DOUBLE_BUFFER
-static uint8_t HPM_LVGL_FB_ATTR lvgl_fb1[HPM_LVGL_FB_SIZE];
+static uint8_t *lvgl_fb1 = lvgl_fb1_mem;
 #endif
 
+/* Display backend operations (selected at runtime when HPM_LVGL_BACKEND_AB is enabled) */
+typedef struct {
+    const char *name;
+    hpm_stat_t (*attach)(void);         /* Take over SPI/DMA and bring the panel to a known state */
+    lv_display_flush_cb_t flush;
+    bool (*overlay_push)(const lv_area_t *area, const uint8_t *px_map);
+    hpm_stat_t (*set_spi_freq)(uint32_t freq_hz);
+    void (*set_rotation)(uint16_t rotation);
+    void (*backlight)(bool on);
+    hpm_stat_t (*read)(uint8_t cmd, uint8_t *data, uint32_t len);  /* Raw bytes clocked after cmd */
+    /* Start a DMA window write outside LVGL (boot splash); lvgl_ctx.dma_busy clears on completion */
+    hpm_stat_t (*write_dma)(const lv_area_t *area, const uint8_t *px_map, uint32_t len);
+} lvgl_backend_ops_t;
+
+static const lvgl_backend_ops_t *lvgl_backend;
+
 /* LVGL context */
 static struct {
     lv_display_t *disp;
@@ -141,10 +213,74 @@ static struct {
     volatile uint64_t flush_bytes;
     volatile uint32_t last_flush_tick;
     lv_area_t last_flush_area;
+
+    /* Refresh/transfer timing (CPU cycles) */
+    uint32_t cpu_mhz;
+    uint32_t refresh_count;
+    uint64_t render_cycles;
+    volatile uint64_t xfer_cycles;
+    volatile uint64_t flush_start_cycle;
+    uint64_t refr_start_cycle;
+    uint64_t wait_start_cycle;
+    uint64_t frame_wait_cycles;
+    uint64_t wait_cycles;
+    uint64_t frame_xfer_base;
+    uint32_t frame_flush_base;
+    uint32_t frames_rendered;
+    uint64_t frame_cycles;
+
+    /* Backend cost (CPU cycles) */
+    uint64_t flush_cpu_cycles;
+    volatile uint64_t isr_cycles;
+    volatile uint32_t isr_count;
+    volatile uint32_t isr_max_cycles;
+
+    /* Flush wait (CPU asleep or LVGL task blocked while both draw buffers are on the bus) */
+    uint64_t idle_cycles;
+    uint32_t sleep_count;
+    volatile bool flush_waiting;
+    uint64_t loop_sleep_cycles;
+    uint64_t stats_start_cycle;
+
+    /* Runtime configuration */
+    uint32_t fb_lines;
+    bool fb_double;
+    bool fb_cacheable;
+    uint32_t spi_freq_hz;
+    uint16_t rotation;
 } lvgl_ctx;
 
-/* Timer frequency */
+/* Timer frequency, and its inverse in 0.32 fixed point (see lvgl_mchtmr_to_ms()) */
 static uint32_t mchtmr_freq_khz = 0;
+static uint32_t mchtmr_ms_mult;
+
+#if HPM_LVGL_FLUSH_WAIT_SLEEP && HPM_LVGL_HAS_OS && !HPM_LVGL_RTOS
+static lv_thread_sync_t lvgl_flush_sync;
+#endif
+
+/* Boot splash registered before hpm_lvgl_spi_init() */
+static const hpm_lvgl_splash_t *lvgl_splash;
+
+/* Panel bring-up (advanced from an LVGL timer, see lvgl_boot_poll()) */
+static struct {
+    lv_timer_t *timer;
+    volatile bool ready;
+    bool warm;                      /* Panel kept across an MCU reset (hpm_lvgl_warm.h) */
+    uint64_t deadline;              /* Core cycle before which the panel takes no command */
+    uint64_t init_return_cycle;
+    uint64_t ready_cycle;
+    uint64_t splash_cycle;
+    volatile uint64_t first_pixel_cycle;
+#if HPM_LVGL_HAS_MIPI_BACKEND
+    /* Commands lv_st7789_create() issues, replayed with their delays: { cmd_size, param_size (LE16),
+     * cmd..., param... }, or a delay { 0, ms (LE16) }. */
+    bool recording;
+    uint8_t last_cmd;               /* Command the next recorded delay follows */
+    uint16_t prog_len;
+    uint16_t prog_pos;
+    uint8_t prog[HPM_LVGL_INIT_PROG_SIZE];
+#endif
+} lvgl_boot;
 
 /*============================================================================
  * LCD GPIO helpers (D/C, CS, RST, BL)
@@ -164,6 +300,7 @@ static inline void lcd_cs_assert(void)
 {
 #if HPM_LVGL_SPI_HAS_GPIO_CS
     gpio_write_pin(BOARD_LCD_GPIO, BOARD_LCD_CS_INDEX, BOARD_LCD_CS_PIN, BOARD_LCD_CS_ACTIVE_LEVEL);
+    hpm_lvgl_spi_capture_cs(true);
 #endif
 }
 
@@ -171,6 +308,27 @@ static inline void lcd_cs_deassert(void)
 {
 #if HPM_LVGL_SPI_HAS_GPIO_CS
     gpio_write_pin(BOARD_LCD_GPIO, BOARD_LCD_CS_INDEX, BOARD_LCD_CS_PIN, !BOARD_LCD_CS_ACTIVE_LEVEL);
+    hpm_lvgl_spi_capture_cs(false);
+#endif
+}
+
+/*============================================================================
+ * Draw buffer cache maintenance
+ *============================================================================*/
+
+/* Make pixels about to be sent by DMA visible to it. Draw buffers start on a cache line, so
+ * only the lines holding these bytes are written back; non-cacheable buffers need nothing. */
+HPM_LVGL_HOT_ATTR static inline void lvgl_fb_writeback(const void *px_map, uint32_t len)
+{
+#if HPM_LVGL_FB_CACHEABLE || HPM_LVGL_FB_PLACEMENT_AB
+    if (lvgl_ctx.fb_cacheable && l1c_dc_is_enabled()) {
+        uint32_t start = HPM_L1C_CACHELINE_ALIGN_DOWN((uint32_t)px_map);
+        uint32_t end = HPM_L1C_CACHELINE_ALIGN_UP((uint32_t)px_map + len);
+        l1c_dc_writeback(start, end - start);
+    }
+#else
+    (void)px_map;
+    (void)len;
 #endif
 }
 
@@ -183,19 +341,88 @@ static inline void lcd_backlight_set(bool on)
 #endif
 }
 
+static inline void lvgl_boot_wait_ms(uint32_t ms)
+{
+    lvgl_boot.deadline = hpm_csr_get_core_cycle() + (uint64_t)ms * lvgl_ctx.cpu_mhz * 1000U;
+}
+
+static inline bool lvgl_boot_wait_done(void)
+{
+    return (int64_t)(hpm_csr_get_core_cycle() - lvgl_boot.deadline) >= 0;
+}
+
+/* Reset pulse only; the 120 ms the panel needs before SLPOUT elapse in lvgl_boot_poll(). */
 static void lcd_hw_reset(void)
 {
 #if defined(BOARD_LCD_RESET_INDEX) && defined(BOARD_LCD_RESET_PIN)
-    gpio_write_pin(BOARD_LCD_GPIO, BOARD_LCD_RESET_INDEX, BOARD_LCD_RESET_PIN, 1);
-    board_delay_ms(10);
     gpio_write_pin(BOARD_LCD_GPIO, BOARD_LCD_RESET_INDEX, BOARD_LCD_RESET_PIN, 0);
-    board_delay_ms(10);
+    board_delay_us(20);
     gpio_write_pin(BOARD_LCD_GPIO, BOARD_LCD_RESET_INDEX, BOARD_LCD_RESET_PIN, 1);
-    board_delay_ms(120);
+    lvgl_boot_wait_ms(120);
+#endif
+}
+
+/*============================================================================
+ * Flush bookkeeping (shared by both backends)
+ *============================================================================*/
+
+HPM_LVGL_HOT_ATTR static inline void lvgl_flush_begin(void)
+{
+    lvgl_ctx.flush_start_cycle = hpm_csr_get_core_cycle();
+}
+
+/* Account a finished transfer (task or ISR context). */
+HPM_LVGL_HOT_ATTR static inline void lvgl_flush_done(void)
+{
+    uint64_t now = hpm_csr_get_core_cycle();
+
+    lvgl_ctx.xfer_cycles += now - lvgl_ctx.flush_start_cycle;
+    if (lvgl_boot.first_pixel_cycle == 0U) {
+        lvgl_boot.first_pixel_cycle = now;
+    }
+    hpm_lvgl_warm_flush_complete();
+    hpm_lvgl_trace_record(HPM_LVGL_TRACE_FLUSH_END, (uint16_t)lvgl_ctx.flush_count, 0);
+}
+
+/* Account the transfer and hand the draw buffer back to LVGL (task or ISR context). */
+HPM_LVGL_HOT_ATTR static inline void lvgl_flush_complete(lv_display_t *disp)
+{
+    lvgl_flush_done();
+    lv_display_flush_ready(disp);
+#if HPM_LVGL_FLUSH_WAIT_SLEEP && HPM_LVGL_HAS_OS && !HPM_LVGL_RTOS
+    /* Only completions that arrive while LVGL waits come from the ISR; the blocking fallbacks
+     * complete inside the flush callback, before any wait. */
+    if (lvgl_ctx.flush_waiting) {
+        lv_thread_sync_signal_isr(&lvgl_flush_sync);
+    }
+#endif
+}
+
+/* Same from the DMA completion handler. With HPM_LVGL_RTOS the LVGL task calls
+ * lv_display_flush_ready(), so LVGL state is never touched from the ISR. */
+HPM_LVGL_HOT_ATTR static inline void lvgl_flush_complete_isr(lv_display_t *disp)
+{
+#if HPM_LVGL_RTOS
+    lvgl_flush_done();
+    hpm_lvgl_rtos_flush_done_isr(disp);
+#else
+    lvgl_flush_complete(disp);
 #endif
 }
 
-static inline void lcd_spi_wait_transfer_done(SPI_Type *spi)
+/* Account the time spent in a DMA completion handler (ISR context). */
+HPM_LVGL_HOT_ATTR static inline void lvgl_isr_account(uint64_t start_cycle)
+{
+    uint32_t cycles = (uint32_t)(hpm_csr_get_core_cycle() - start_cycle);
+
+    lvgl_ctx.isr_cycles += cycles;
+    lvgl_ctx.isr_count++;
+    if (cycles > lvgl_ctx.isr_max_cycles) {
+        lvgl_ctx.isr_max_cycles = cycles;
+    }
+}
+
+HPM_LVGL_HOT_ATTR static inline void lcd_spi_wait_transfer_done(SPI_Type *spi)
 {
     while (spi_get_tx_fifo_valid_data_size(spi) != 0U) {
     }
@@ -207,16 +434,41 @@ static inline void lcd_spi_wait_transfer_done(SPI_Type *spi)
  * Tick management
  *============================================================================*/
 
+static void lvgl_mchtmr_init(void)
+{
+    mchtmr_freq_khz = clock_get_frequency(clock_mchtmr0) / 1000U;
+    if (mchtmr_freq_khz == 0U) {
+        mchtmr_freq_khz = 1U;
+    }
+    mchtmr_ms_mult = (uint32_t)(((1ULL << 32) + (mchtmr_freq_khz / 2U)) / mchtmr_freq_khz);
+}
+
+/* count / f_khz as count * (2^32 / f_khz) >> 32, from two 32x32 multiplies instead of a 64-bit
+ * divide (a libgcc call on RV32). Exact modulo 2^32, so the tick stays monotonic across the wrap;
+ * the rounded multiplier is off by < 3 ppm at 24 MHz, well inside the crystal tolerance. */
+HPM_LVGL_HOT_ATTR static inline uint32_t lvgl_mchtmr_to_ms(uint64_t count)
+{
+    uint32_t hi = (uint32_t)(count >> 32);
+    uint32_t lo = (uint32_t)count;
+
+    return (hi * mchtmr_ms_mult) + (uint32_t)(((uint64_t)lo * mchtmr_ms_mult) >> 32);
+}
+
 static uint32_t lvgl_tick_get_cb(void)
 {
+    uint32_t ms;
+
 #if HPM_LVGL_TICK_SOURCE_MCHTMR
     if (mchtmr_freq_khz == 0) {
-        mchtmr_freq_khz = clock_get_frequency(clock_mchtmr0) / 1000;
+        lvgl_mchtmr_init();
     }
-    return (uint32_t)(mchtmr_get_count(HPM_MCHTMR) / mchtmr_freq_khz);
+    ms = lvgl_mchtmr_to_ms(mchtmr_get_count(HPM_MCHTMR));
 #else
-    return lvgl_ctx.tick_ms;
+    ms = lvgl_ctx.tick_ms;
 #endif
+
+    /* Virtual time while a recorded journey is replayed */
+    return hpm_lvgl_replay_tick(ms);
 }
 
 void hpm_lvgl_spi_tick_inc(uint32_t ms)
@@ -241,10 +493,63 @@ uint32_t custom_tick_get(void)
 }
 
 /*============================================================================
- * DMA completion callback
+ * Run loop
  *============================================================================*/
 
-#if HPM_LVGL_USE_LVGL_ST7789_DRIVER
+#if !HPM_LVGL_HAS_OS
+/* Sleep until MCHTMR reaches the deadline or another interrupt is pending. The timer interrupt
+ * is only enabled around WFI with interrupts masked: it wakes the core but its handler never
+ * runs, so the application needs no MCHTMR ISR. */
+static void lvgl_sleep_ms(uint32_t ms)
+{
+    if (mchtmr_freq_khz == 0) {
+        lvgl_mchtmr_init();
+    }
+
+    uint32_t level = disable_global_irq(CSR_MSTATUS_MIE_MASK);
+    mchtmr_set_compare_value(HPM_MCHTMR, mchtmr_get_count(HPM_MCHTMR) + ((uint64_t)ms * mchtmr_freq_khz));
+    enable_mchtmr_irq();
+    __asm volatile("wfi");
+    disable_mchtmr_irq();
+    restore_global_irq(level);
+}
+#endif
+
+#if HPM_LVGL_HAS_REMOTE_BACKEND
+static void lvgl_remote_poll(void);
+#endif
+
+uint32_t hpm_lvgl_spi_run_once(uint32_t max_sleep_ms)
+{
+#if HPM_LVGL_HAS_REMOTE_BACKEND
+    /* Hand back a draw buffer core 1 finished while this core slept. */
+    lvgl_remote_poll();
+#endif
+    uint32_t next = lv_timer_handler();
+    uint32_t ms = (next < max_sleep_ms) ? next : max_sleep_ms;
+
+    /* Virtual time advances per call while a journey is replayed: never wait for it. */
+    if ((ms == 0U) || hpm_lvgl_replay_is_playing()) {
+        return 0U;
+    }
+
+    uint64_t start = hpm_csr_get_core_cycle();
+    uint32_t tick = lvgl_tick_get_cb();
+#if HPM_LVGL_HAS_OS
+    lv_sleep_ms(ms);
+#else
+    lvgl_sleep_ms(ms);
+#endif
+    lvgl_ctx.loop_sleep_cycles += hpm_csr_get_core_cycle() - start;
+
+    return lvgl_tick_get_cb() - tick;
+}
+
+/*============================================================================
+ * Official backend: LVGL lv_st7789 + hpm_spi + dma_mgr
+ *============================================================================*/
+
+#if HPM_LVGL_HAS_MIPI_BACKEND
 #include "hpm_spi.h"
 #include "hpm_dma_mgr.h"
 
@@ -265,31 +570,59 @@ typedef struct {
 
 static hpm_lvgl_spi_dma_done_ctx_t lvgl_dma_done_ctx;
 
-static void hpm_lvgl_spi_dma_tc_cb(DMA_Type *base, uint32_t channel, void *cb_data_ptr)
+/* Generic MIPI flush installed by lv_st7789_create(); called through lvgl_flush_cb(). */
+static lv_display_flush_cb_t lvgl_mipi_flush;
+
+HPM_LVGL_HOT_ATTR static void hpm_lvgl_spi_dma_tc_cb(DMA_Type *base, uint32_t channel, void *cb_data_ptr)
 {
     (void)base;
     (void)channel;
 
+    uint64_t isr_start = hpm_csr_get_core_cycle();
     hpm_lvgl_spi_dma_done_ctx_t *ctx = (hpm_lvgl_spi_dma_done_ctx_t *)cb_data_ptr;
     if ((ctx == NULL) || (ctx->spi == NULL)) {
         return;
     }
 
+    hpm_lvgl_trace_record(HPM_LVGL_TRACE_DMA_TC, (uint16_t)lvgl_ctx.flush_count, 0);
+
     /* DMA TC only means FIFO writes are done; wait for SPI shifter to finish. */
     lcd_spi_wait_transfer_done(ctx->spi);
+    hpm_lvgl_spi_capture_dma_done();
+
+#if HPM_LVGL_L8
+    /* Rest of an L8 strip: CS stays asserted and the panel continues the memory write. */
+    uint32_t chunk_len = 0;
+    uint8_t *chunk = (uint8_t *)hpm_lvgl_l8_stream_next(&chunk_len);
+    if (chunk != NULL) {
+        hpm_lvgl_spi_capture_dma_start(chunk_len, !HPM_LVGL_SPI_HAS_GPIO_CS);
+        if (hpm_spi_transmit_nonblocking(ctx->spi, chunk, chunk_len) == status_success) {
+            hpm_lvgl_l8_stream_prefetch();
+            lvgl_isr_account(isr_start);
+            return;
+        }
+        hpm_lvgl_spi_capture_dma_done();
+        hpm_lvgl_l8_stream_abort();
+    }
+#endif
 
     /* Release chip select after actual bus idle. */
     lcd_cs_deassert();
 
+    hpm_lvgl_trace_record(HPM_LVGL_TRACE_SPI_IDLE, (uint16_t)lvgl_ctx.flush_count, 0);
+
     lvgl_ctx.dma_busy = false;
 
     /* Notify LVGL that flush is complete */
     if (ctx->disp) {
-        lv_display_flush_ready(ctx->disp);
+        lvgl_flush_complete_isr(ctx->disp);
+    } else {
+        hpm_lvgl_rtos_wake_from_isr();  /* lvgl_wait_bus_idle() */
     }
 
     /* FPS counting */
     lvgl_ctx.frame_count++;
+    lvgl_isr_account(isr_start);
 }
 
 static inline void lvgl_update_last_flush_area_from_mipi_state(void)
@@ -305,15 +638,8 @@ static inline void lvgl_update_last_flush_area_from_mipi_state(void)
     lvgl_ctx.last_flush_area.y2 = (int32_t)lcd_addr_state.y2_vram - (int32_t)BOARD_LCD_Y_OFFSET;
 }
 
-static void lvgl_lcd_send_cmd_cb(lv_display_t *disp, const uint8_t *cmd, size_t cmd_size,
-                                const uint8_t *param, size_t param_size)
+static void lvgl_lcd_transmit_cmd(const uint8_t *cmd, size_t cmd_size, const uint8_t *param, size_t param_size)
 {
-    (void)disp;
-
-    if ((cmd == NULL) || (cmd_size == 0U)) {
-        return;
-    }
-
     /* Capture last address window for stats (generic MIPI flush sends CASET then RASET). */
     if ((cmd_size == 1U) && (param != NULL) && (param_size == 4U)) {
         if (cmd[0] == LV_LCD_CMD_SET_COLUMN_ADDRESS) {
@@ -330,22 +656,148 @@ static void lvgl_lcd_send_cmd_cb(lv_display_t *disp, const uint8_t *cmd, size_t
     lcd_cs_assert();
 
     lcd_dc_command();
+    uint64_t cap_start = hpm_lvgl_spi_capture_now();
     if (hpm_spi_transmit_blocking(BOARD_LCD_SPI, (uint8_t *)cmd, cmd_size, 1000) != status_success) {
         lcd_cs_deassert();
         return;
     }
+    /* Drain the shifter first, so the entry covers the whole command phase */
+    lcd_spi_wait_transfer_done(BOARD_LCD_SPI);
+    hpm_lvgl_spi_capture_write(false, cmd, cmd_size, cap_start, !HPM_LVGL_SPI_HAS_GPIO_CS);
 
     if ((param != NULL) && (param_size != 0U)) {
         lcd_dc_data();
+        cap_start = hpm_lvgl_spi_capture_now();
         (void)hpm_spi_transmit_blocking(BOARD_LCD_SPI, (uint8_t *)param, param_size, 1000);
+        lcd_spi_wait_transfer_done(BOARD_LCD_SPI);
+        hpm_lvgl_spi_capture_write(true, param, param_size, cap_start, !HPM_LVGL_SPI_HAS_GPIO_CS);
     }
 
-    lcd_spi_wait_transfer_done(BOARD_LCD_SPI);
     lcd_cs_deassert();
 }
 
-static void lvgl_lcd_send_color_cb(lv_display_t *disp, const uint8_t *cmd, size_t cmd_size, uint8_t *param,
-                                  size_t param_size)
+/*
+ * Boot program: lv_st7789_create() runs while the panel is still in its post-reset window,
+ * so its commands and lv_delay_ms() calls are recorded here and replayed by lvgl_boot_poll().
+ */
+static bool lvgl_boot_play(bool block);
+
+static void lvgl_boot_record_delay_cb(uint32_t ms)
+{
+    uint8_t last_cmd = lvgl_boot.last_cmd;
+
+    lvgl_boot.last_cmd = 0U;
+    if (lvgl_boot.warm) {
+        return;
+    }
+#if defined(BOARD_LCD_RESET_INDEX) && defined(BOARD_LCD_RESET_PIN)
+    if (last_cmd == LV_LCD_CMD_SOFT_RESET) {
+        return;
+    }
+#endif
+    /* SLPOUT only needs 5 ms before the next command (120 ms is the SLPIN constraint). */
+    if ((last_cmd == LV_LCD_CMD_EXIT_SLEEP_MODE) && (ms > 5U)) {
+        ms = 5U;
+    }
+    if (ms > 0xFFFFU) {
+        ms = 0xFFFFU;
+    }
+    if ((lvgl_boot.prog_len + 3U) > sizeof(lvgl_boot.prog)) {
+        /* Program full: catch up in place (lvgl_boot_play() honors the recorded delays). */
+        (void)lvgl_boot_play(true);
+        board_delay_ms(ms);
+        return;
+    }
+    lvgl_boot.prog[lvgl_boot.prog_len++] = 0U;
+    lvgl_boot.prog[lvgl_boot.prog_len++] = (uint8_t)ms;
+    lvgl_boot.prog[lvgl_boot.prog_len++] = (uint8_t)(ms >> 8);
+}
+
+static void lvgl_boot_record_cmd(const uint8_t *cmd, size_t cmd_size, const uint8_t *param, size_t param_size)
+{
+    if (param == NULL) {
+        param_size = 0U;
+    }
+
+    lvgl_boot.last_cmd = cmd[0];
+    /* Warm restart: the panel is configured and showing a picture; only re-apply what the
+     * generic MIPI driver tracks itself (address mode and inversion). */
+    if (lvgl_boot.warm && (cmd[0] != LV_LCD_CMD_SET_ADDRESS_MODE) && (cmd[0] != LV_LCD_CMD_ENTER_INVERT_MODE) &&
+        (cmd[0] != LV_LCD_CMD_EXIT_INVERT_MODE)) {
+        return;
+    }
+#if defined(BOARD_LCD_RESET_INDEX) && defined(BOARD_LCD_RESET_PIN)
+    /* The hardware reset already put the panel in its default state: drop SWRESET and its delay. */
+    if ((cmd_size == 1U) && (cmd[0] == LV_LCD_CMD_SOFT_RESET)) {
+        return;
+    }
+#endif
+
+    if ((cmd_size > 0xFFU) || (param_size > 0xFFFFU) ||
+        ((lvgl_boot.prog_len + 3U + cmd_size + param_size) > sizeof(lvgl_boot.prog))) {
+        (void)lvgl_boot_play(true);
+        lvgl_lcd_transmit_cmd(cmd, cmd_size, param, param_size);
+        return;
+    }
+
+    uint8_t *p = &lvgl_boot.prog[lvgl_boot.prog_len];
+    p[0] = (uint8_t)cmd_size;
+    p[1] = (uint8_t)param_size;
+    p[2] = (uint8_t)(param_size >> 8);
+    memcpy(&p[3], cmd, cmd_size);
+    if (param_size != 0U) {
+        memcpy(&p[3 + cmd_size], param, param_size);
+    }
+    lvgl_boot.prog_len += (uint16_t)(3U + cmd_size + param_size);
+}
+
+/* Send recorded entries up to the next delay (or all of them when blocking); true once played out. */
+static bool lvgl_boot_play(bool block)
+{
+    while (true) {
+        if (!lvgl_boot_wait_done()) {
+            if (!block) {
+                return false;
+            }
+            continue;
+        }
+        if (lvgl_boot.prog_pos >= lvgl_boot.prog_len) {
+            lvgl_boot.prog_pos = 0;
+            lvgl_boot.prog_len = 0;
+            return true;
+        }
+
+        const uint8_t *p = &lvgl_boot.prog[lvgl_boot.prog_pos];
+        uint16_t len = (uint16_t)p[1] | ((uint16_t)p[2] << 8);
+
+        if (p[0] == 0U) {
+            lvgl_boot.prog_pos += 3U;
+            lvgl_boot_wait_ms(len);
+        } else {
+            lvgl_lcd_transmit_cmd(&p[3], p[0], (len != 0U) ? &p[3 + p[0]] : NULL, len);
+            lvgl_boot.prog_pos += (uint16_t)(3U + p[0] + len);
+        }
+    }
+}
+
+static void lvgl_lcd_send_cmd_cb(lv_display_t *disp, const uint8_t *cmd, size_t cmd_size,
+                                const uint8_t *param, size_t param_size)
+{
+    (void)disp;
+
+    if ((cmd == NULL) || (cmd_size == 0U)) {
+        return;
+    }
+
+    if (lvgl_boot.recording) {
+        lvgl_boot_record_cmd(cmd, cmd_size, param, param_size);
+        return;
+    }
+    lvgl_lcd_transmit_cmd(cmd, cmd_size, param, param_size);
+}
+
+HPM_LVGL_HOT_ATTR static void lvgl_lcd_send_color_cb(lv_display_t *disp, const uint8_t *cmd, size_t cmd_size,
+                                                      uint8_t *param, size_t param_size)
 {
     if ((disp == NULL) || (cmd == NULL) || (cmd_size == 0U) || (param == NULL) || (param_size == 0U)) {
         if (disp) {
@@ -355,10 +807,20 @@ static void lvgl_lcd_send_color_cb(lv_display_t *disp, const uint8_t *cmd, size_
     }
 
     /* Flush statistics (derive area from last CASET/RASET). */
+    lvgl_update_last_flush_area_from_mipi_state();
+#if HPM_LVGL_L8
+    /* param holds one L8 byte per pixel of the window; RGB565 goes on the wire */
+    uint32_t l8_px = (uint32_t)lv_area_get_size(&lvgl_ctx.last_flush_area);
+    param_size = (size_t)l8_px * HPM_LVGL_PIXEL_SIZE;
+#endif
     lvgl_ctx.flush_count++;
     lvgl_ctx.flush_bytes += param_size;
     lvgl_ctx.last_flush_tick = lvgl_tick_get_cb();
-    lvgl_update_last_flush_area_from_mipi_state();
+    lvgl_flush_begin();
+    hpm_lvgl_trace_record(HPM_LVGL_TRACE_FLUSH_START, (uint16_t)lvgl_ctx.flush_count, (uint32_t)param_size);
+    hpm_lvgl_replay_flush(&lvgl_ctx.last_flush_area, param);
+    hpm_lvgl_heatmap_flush(&lvgl_ctx.last_flush_area, param);
+    hpm_lvgl_overlay_flush(&lvgl_ctx.last_flush_area, param);
 
     /* Record the display for DMA completion callback. */
     lvgl_dma_done_ctx.disp = disp;
@@ -367,58 +829,139 @@ static void lvgl_lcd_send_color_cb(lv_display_t *disp, const uint8_t *cmd, size_
 
     /* Send the RAMWR command first (polling) */
     lcd_dc_command();
+    uint64_t cap_start = hpm_lvgl_spi_capture_now();
     if (hpm_spi_transmit_blocking(BOARD_LCD_SPI, (uint8_t *)cmd, cmd_size, 1000) != status_success) {
         lcd_cs_deassert();
-        lv_display_flush_ready(disp);
+        lvgl_flush_complete(disp);
         return;
     }
 
     lcd_spi_wait_transfer_done(BOARD_LCD_SPI);
-
+    hpm_lvgl_spi_capture_write(false, cmd, cmd_size, cap_start, !HPM_LVGL_SPI_HAS_GPIO_CS);
+
+#if HPM_LVGL_L8
+    /* The DMA reads RGB565 chunks from the non-cacheable staging ring, chained by the TC callback.
+     * Every slot is staged before the first start, so the callback always finds the next chunk and is
+     * the only one touching the ring once it runs. */
+    uint32_t tx_len = 0;
+    hpm_lvgl_l8_stream_begin(param, l8_px);
+    uint8_t *tx = (uint8_t *)hpm_lvgl_l8_stream_next(&tx_len);
+#else
     /* Ensure data buffer is visible to DMA when using cacheable memory. */
-    if (l1c_dc_is_enabled()) {
-        uint32_t aligned_start = HPM_L1C_CACHELINE_ALIGN_DOWN((uint32_t)param);
-        uint32_t aligned_end = HPM_L1C_CACHELINE_ALIGN_UP((uint32_t)param + (uint32_t)param_size);
-        uint32_t aligned_size = aligned_end - aligned_start;
-        l1c_dc_writeback(aligned_start, aligned_size);
-    }
+    lvgl_fb_writeback(param, (uint32_t)param_size);
+    uint8_t *tx = param;
+    uint32_t tx_len = (uint32_t)param_size;
+#endif
 
     /* Start pixel transfer using DMA (non-blocking). CS remains asserted until DMA callback. */
     lcd_dc_data();
     lvgl_ctx.dma_busy = true;
-    if (hpm_spi_transmit_nonblocking(BOARD_LCD_SPI, param, param_size) != status_success) {
+    hpm_lvgl_spi_capture_dma_start(tx_len, !HPM_LVGL_SPI_HAS_GPIO_CS);
+    if (hpm_spi_transmit_nonblocking(BOARD_LCD_SPI, tx, tx_len) != status_success) {
         /* DMA failed, fall back to blocking transfer (always release CS + flush_ready). */
         lvgl_ctx.dma_busy = false;
-        (void)hpm_spi_transmit_blocking(BOARD_LCD_SPI, param, param_size, 1000);
-        lcd_spi_wait_transfer_done(BOARD_LCD_SPI);
+        while (tx != NULL) {
+            cap_start = hpm_lvgl_spi_capture_now();
+            (void)hpm_spi_transmit_blocking(BOARD_LCD_SPI, tx, tx_len, 1000);
+            lcd_spi_wait_transfer_done(BOARD_LCD_SPI);
+            hpm_lvgl_spi_capture_write(true, tx, tx_len, cap_start, !HPM_LVGL_SPI_HAS_GPIO_CS);
+#if HPM_LVGL_L8
+            hpm_lvgl_l8_stream_prefetch();
+            tx = (uint8_t *)hpm_lvgl_l8_stream_next(&tx_len);
+#else
+            tx = NULL;
+#endif
+        }
         lcd_cs_deassert();
-        lv_display_flush_ready(disp);
+        lvgl_flush_complete(disp);
         lvgl_ctx.frame_count++;
+        return;
     }
 }
 
-static hpm_stat_t lvgl_display_hw_init(void)
+/* Overlay plane push between LVGL refreshes (blocking; only when no flush is on the bus). */
+/* Same window as the generic MIPI flush: LVGL coordinates + configured gap. */
+static void lvgl_mipi_set_window(const lv_area_t *area)
 {
-    spi_initialize_config_t spi_cfg;
+    static const uint8_t caset = LV_LCD_CMD_SET_COLUMN_ADDRESS;
+    static const uint8_t raset = LV_LCD_CMD_SET_PAGE_ADDRESS;
+    uint8_t param[4];
+
+    uint16_t x1 = (uint16_t)(area->x1 + BOARD_LCD_X_OFFSET);
+    uint16_t x2 = (uint16_t)(area->x2 + BOARD_LCD_X_OFFSET);
+    uint16_t y1 = (uint16_t)(area->y1 + BOARD_LCD_Y_OFFSET);
+    uint16_t y2 = (uint16_t)(area->y2 + BOARD_LCD_Y_OFFSET);
+
+    param[0] = (uint8_t)(x1 >> 8);
+    param[1] = (uint8_t)x1;
+    param[2] = (uint8_t)(x2 >> 8);
+    param[3] = (uint8_t)x2;
+    lvgl_lcd_transmit_cmd(&caset, 1, param, sizeof(param));
+    param[0] = (uint8_t)(y1 >> 8);
+    param[1] = (uint8_t)y1;
+    param[2] = (uint8_t)(y2 >> 8);
+    param[3] = (uint8_t)y2;
+    lvgl_lcd_transmit_cmd(&raset, 1, param, sizeof(param));
+}
 
-    /* Initialize LCD control GPIOs (pinmux must be done by board_init_lcd()). */
-    gpio_set_pin_output(BOARD_LCD_GPIO, BOARD_LCD_D_C_INDEX, BOARD_LCD_D_C_PIN);
-#if defined(BOARD_LCD_RESET_INDEX) && defined(BOARD_LCD_RESET_PIN)
-    gpio_set_pin_output(BOARD_LCD_GPIO, BOARD_LCD_RESET_INDEX, BOARD_LCD_RESET_PIN);
-#endif
-#if defined(BOARD_LCD_BL_INDEX) && defined(BOARD_LCD_BL_PIN)
-    gpio_set_pin_output(BOARD_LCD_GPIO, BOARD_LCD_BL_INDEX, BOARD_LCD_BL_PIN);
-    lcd_backlight_set(false);
-#endif
-#if HPM_LVGL_SPI_HAS_GPIO_CS
-    gpio_set_pin_output(BOARD_LCD_GPIO, BOARD_LCD_CS_INDEX, BOARD_LCD_CS_PIN);
+static bool lvgl_mipi_overlay_push(const lv_area_t *area, const uint8_t *px_map)
+{
+    static const uint8_t ramwr = LV_LCD_CMD_WRITE_MEMORY_START;
+
+    if (lvgl_ctx.dma_busy || (lvgl_ctx.disp == NULL)) {
+        return false;
+    }
+
+    lvgl_mipi_set_window(area);
+
+    size_t len = (size_t)lv_area_get_size(area) * HPM_LVGL_PIXEL_SIZE;
+    lcd_cs_assert();
+    lcd_dc_command();
+    uint64_t cap_start = hpm_lvgl_spi_capture_now();
+    (void)hpm_spi_transmit_blocking(BOARD_LCD_SPI, (uint8_t *)&ramwr, 1, 1000);
+    lcd_spi_wait_transfer_done(BOARD_LCD_SPI);
+    hpm_lvgl_spi_capture_write(false, &ramwr, 1, cap_start, !HPM_LVGL_SPI_HAS_GPIO_CS);
+    lcd_dc_data();
+    cap_start = hpm_lvgl_spi_capture_now();
+    (void)hpm_spi_transmit_blocking(BOARD_LCD_SPI, (uint8_t *)px_map, len, 1000);
+    lcd_spi_wait_transfer_done(BOARD_LCD_SPI);
+    hpm_lvgl_spi_capture_write(true, px_map, len, cap_start, !HPM_LVGL_SPI_HAS_GPIO_CS);
     lcd_cs_deassert();
-#endif
 
-    lcd_hw_reset();
+    return true;
+}
 
-    /* Initialize DMA manager + SPI component backend. */
-    dma_mgr_init();
+static hpm_stat_t lvgl_mipi_write_dma(const lv_area_t *area, const uint8_t *px_map, uint32_t len)
+{
+    static const uint8_t ramwr = LV_LCD_CMD_WRITE_MEMORY_START;
+
+    lvgl_mipi_set_window(area);
+
+    lcd_cs_assert();
+    lcd_dc_command();
+    if (hpm_spi_transmit_blocking(BOARD_LCD_SPI, (uint8_t *)&ramwr, 1, 1000) != status_success) {
+        lcd_cs_deassert();
+        return status_fail;
+    }
+    lcd_spi_wait_transfer_done(BOARD_LCD_SPI);
+
+    lvgl_fb_writeback(px_map, len);
+
+    /* Completion (hpm_lvgl_spi_dma_tc_cb) releases CS; no display is attached to it yet. */
+    lcd_dc_data();
+    lvgl_ctx.dma_busy = true;
+    if (hpm_spi_transmit_nonblocking(BOARD_LCD_SPI, (uint8_t *)px_map, len) != status_success) {
+        lvgl_ctx.dma_busy = false;
+        (void)hpm_spi_transmit_blocking(BOARD_LCD_SPI, (uint8_t *)px_map, len, 1000);
+        lcd_spi_wait_transfer_done(BOARD_LCD_SPI);
+        lcd_cs_deassert();
+    }
+    return status_success;
+}
+
+static hpm_stat_t lvgl_mipi_spi_init(void)
+{
+    spi_initialize_config_t spi_cfg;
 
     /* Enable SPI clock (required for hpm_spi_set_sclk_frequency). */
     clock_add_to_group(BOARD_LCD_SPI_CLK_NAME, 0);
@@ -427,41 +970,170 @@ static hpm_stat_t lvgl_display_hw_init(void)
     if (hpm_spi_initialize(BOARD_LCD_SPI, &spi_cfg) != status_success) {
         return status_fail;
     }
-    if (hpm_spi_set_sclk_frequency(BOARD_LCD_SPI, HPM_LVGL_SPI_FREQ) != status_success) {
+    if (hpm_spi_set_sclk_frequency(BOARD_LCD_SPI, lvgl_ctx.spi_freq_hz) != status_success) {
         return status_fail;
     }
 
     /* Register DMA completion callback for TX channel. */
     lvgl_dma_done_ctx.spi = BOARD_LCD_SPI;
-    lvgl_dma_done_ctx.disp = NULL;
     if (hpm_spi_tx_dma_mgr_install_custom_callback(BOARD_LCD_SPI, hpm_lvgl_spi_dma_tc_cb, &lvgl_dma_done_ctx) != status_success) {
         return status_fail;
     }
 
     return status_success;
 }
-#else /* !HPM_LVGL_USE_LVGL_ST7789_DRIVER */
 
-static void lvgl_dma_done_cb(void *user_data)
+static hpm_stat_t lvgl_display_hw_init(void)
 {
-    (void)user_data;
+    /* Initialize LCD control GPIOs (pinmux must be done by board_init_lcd()). */
+    gpio_set_pin_output(BOARD_LCD_GPIO, BOARD_LCD_D_C_INDEX, BOARD_LCD_D_C_PIN);
+#if defined(BOARD_LCD_RESET_INDEX) && defined(BOARD_LCD_RESET_PIN)
+    /* Released right away: a panel kept across an MCU reset must not see a reset pulse. */
+    gpio_set_pin_output_with_initial(BOARD_LCD_GPIO, BOARD_LCD_RESET_INDEX, BOARD_LCD_RESET_PIN, 1);
+#endif
+#if defined(BOARD_LCD_BL_INDEX) && defined(BOARD_LCD_BL_PIN)
+    gpio_set_pin_output(BOARD_LCD_GPIO, BOARD_LCD_BL_INDEX, BOARD_LCD_BL_PIN);
+    lcd_backlight_set(false);
+#endif
+#if HPM_LVGL_SPI_HAS_GPIO_CS
+    gpio_set_pin_output(BOARD_LCD_GPIO, BOARD_LCD_CS_INDEX, BOARD_LCD_CS_PIN);
+    lcd_cs_deassert();
+#endif
+
+    /* Initialize DMA manager + SPI component backend. */
+    dma_mgr_init();
+    lvgl_dma_done_ctx.disp = NULL;
+
+    return lvgl_mipi_spi_init();
+}
+
+static hpm_stat_t lvgl_mipi_read(uint8_t cmd, uint8_t *data, uint32_t len)
+{
+    uint8_t tx[HPM_LVGL_PANEL_READ_MAX + 1U] = {0};
+    uint8_t rx[HPM_LVGL_PANEL_READ_MAX + 1U];
+    hpm_stat_t stat;
+
+    if ((len == 0U) || (len > HPM_LVGL_PANEL_READ_MAX)) {
+        return status_invalid_argument;
+    }
+
+    /* Full duplex so CS stays asserted between the command and the reply */
+    tx[0] = cmd;
+    lcd_cs_assert();
+    lcd_dc_command();
+    stat = hpm_spi_transmit_receive_blocking(BOARD_LCD_SPI, tx, rx, len + 1U, 1000);
+    lcd_cs_deassert();
+    memcpy(data, &rx[1], len);
+
+    return stat;
+}
+
+/* Re-take the bus from the legacy driver (A/B switch). The panel was reset and initialized by
+ * st7789.c, so restore what the generic MIPI driver assumes: inversion and its address mode. */
+static hpm_stat_t lvgl_mipi_attach(void)
+{
+    hpm_stat_t stat = lvgl_mipi_spi_init();
+
+    if ((stat != status_success) || (lvgl_ctx.disp == NULL)) {
+        return stat;
+    }
+
+    lv_st7789_set_invert(lvgl_ctx.disp, HPM_LVGL_LCD_INVERT);
+    lv_lcd_generic_mipi_set_address_mode(lvgl_ctx.disp, (HPM_LVGL_LCD_FLAGS & LV_LCD_FLAG_MIRROR_X) != 0,
+                                         (HPM_LVGL_LCD_FLAGS & LV_LCD_FLAG_MIRROR_Y) != 0, false,
+                                         (HPM_LVGL_LCD_FLAGS & LV_LCD_FLAG_BGR) != 0);
+    lcd_backlight_set(true);
+    return status_success;
+}
+
+static hpm_stat_t lvgl_mipi_set_spi_freq(uint32_t freq_hz)
+{
+    return hpm_spi_set_sclk_frequency(BOARD_LCD_SPI, freq_hz);
+}
+
+static void lvgl_mipi_set_rotation(uint16_t rotation)
+{
+    if (!lvgl_ctx.disp) {
+        return;
+    }
+
+    switch (rotation) {
+    case 0:
+        lv_display_set_rotation(lvgl_ctx.disp, LV_DISPLAY_ROTATION_0);
+        break;
+    case 90:
+        lv_display_set_rotation(lvgl_ctx.disp, LV_DISPLAY_ROTATION_90);
+        break;
+    case 180:
+        lv_display_set_rotation(lvgl_ctx.disp, LV_DISPLAY_ROTATION_180);
+        break;
+    case 270:
+        lv_display_set_rotation(lvgl_ctx.disp, LV_DISPLAY_ROTATION_270);
+        break;
+    default:
+        break;
+    }
+    hpm_lvgl_heatmap_reset();
+}
+
+HPM_LVGL_HOT_ATTR static void lvgl_mipi_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    lvgl_mipi_flush(disp, area, px_map);
+}
+
+static const lvgl_backend_ops_t lvgl_backend_mipi = {
+    .name = "dma_mgr",
+    .attach = lvgl_mipi_attach,
+    .flush = lvgl_mipi_flush_cb,
+    .overlay_push = lvgl_mipi_overlay_push,
+    .set_spi_freq = lvgl_mipi_set_spi_freq,
+    .set_rotation = lvgl_mipi_set_rotation,
+    .backlight = lcd_backlight_set,
+    .read = lvgl_mipi_read,
+    .write_dma = lvgl_mipi_write_dma,
+};
+#endif /* HPM_LVGL_HAS_MIPI_BACKEND */
+
+/*============================================================================
+ * Legacy backend: st7789.c (DMAv2)
+ *============================================================================*/
+
+#if HPM_LVGL_HAS_LEGACY_BACKEND
+
+HPM_LVGL_HOT_ATTR static void lvgl_dma_done_cb(void *user_data)
+{
+    (void)user_data;
+
+#if HPM_LVGL_L8
+    /* Rest of an L8 strip: send the next staged chunk right away, then expand the one after it. */
+    uint32_t chunk_len = 0;
+    const uint8_t *chunk = hpm_lvgl_l8_stream_next(&chunk_len);
+    if (chunk != NULL) {
+        if (st7789_write_pixels_dma(chunk, chunk_len, lvgl_dma_done_cb, NULL) == status_success) {
+            hpm_lvgl_l8_stream_prefetch();
+            return;
+        }
+        hpm_lvgl_l8_stream_abort();
+    }
+#endif
+
+    /* st7789.c invokes this after the SPI shifter has drained. */
+    hpm_lvgl_trace_record(HPM_LVGL_TRACE_SPI_IDLE, (uint16_t)lvgl_ctx.flush_count, 0);
 
     lvgl_ctx.dma_busy = false;
 
     /* Notify LVGL that flush is complete */
     if (lvgl_ctx.disp) {
-        lv_display_flush_ready(lvgl_ctx.disp);
+        lvgl_flush_complete_isr(lvgl_ctx.disp);
+    } else {
+        hpm_lvgl_rtos_wake_from_isr();  /* lvgl_wait_bus_idle() */
     }
 
     /* FPS counting */
     lvgl_ctx.frame_count++;
 }
 
-/*============================================================================
- * LVGL flush callback (legacy st7789.c driver)
- *============================================================================*/
-
-static void lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+HPM_LVGL_HOT_ATTR static void lvgl_legacy_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
 {
     uint16_t x1 = area->x1;
     uint16_t y1 = area->y1;
@@ -475,7 +1147,12 @@ static void lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px
     lvgl_ctx.flush_count++;
     lvgl_ctx.flush_bytes += byte_len;
     lvgl_ctx.last_flush_tick = lvgl_tick_get_cb();
+    lvgl_flush_begin();
     lv_area_copy(&lvgl_ctx.last_flush_area, area);
+    hpm_lvgl_trace_record(HPM_LVGL_TRACE_FLUSH_START, (uint16_t)lvgl_ctx.flush_count, byte_len);
+    hpm_lvgl_replay_flush(area, px_map);
+    hpm_lvgl_heatmap_flush(area, px_map);
+    hpm_lvgl_overlay_flush(area, px_map);
 
     /* Set display window */
     st7789_set_window(x1, y1, x2, y2);
@@ -483,84 +1160,780 @@ static void lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px
     /* Start DMA transfer */
     lvgl_ctx.dma_busy = true;
 
+#if HPM_LVGL_L8
+    /* L8 strip: sent as RGB565 chunks from the staging ring, chained by lvgl_dma_done_cb() */
+    uint32_t chunk_len = 0;
+    hpm_lvgl_l8_stream_begin(px_map, w * h);
+    const uint8_t *chunk = hpm_lvgl_l8_stream_next(&chunk_len);
+
+    /* Every slot is staged already: from the start on, only lvgl_dma_done_cb() touches the ring */
+    if (st7789_write_pixels_dma(chunk, chunk_len, lvgl_dma_done_cb, NULL) == status_success) {
+        return;
+    }
+
+    /* DMA failed, fall back to blocking transfers */
+    lvgl_ctx.dma_busy = false;
+    while (chunk != NULL) {
+        st7789_write_pixels((const uint16_t *)chunk, chunk_len / HPM_LVGL_PIXEL_SIZE);
+        hpm_lvgl_l8_stream_prefetch();
+        chunk = hpm_lvgl_l8_stream_next(&chunk_len);
+    }
+    lvgl_flush_complete(disp);
+#else
     if (st7789_write_pixels_dma(px_map, byte_len, lvgl_dma_done_cb, NULL) != status_success) {
         /* DMA failed, fall back to blocking transfer */
         lvgl_ctx.dma_busy = false;
         st7789_write_pixels((const uint16_t *)px_map, w * h);
-        lv_display_flush_ready(disp);
+        lvgl_flush_complete(disp);
     }
+#endif
 }
 
-static hpm_stat_t lvgl_display_hw_init(void)
+/* Overlay plane push between LVGL refreshes (blocking; only when no flush is on the bus). */
+static bool lvgl_legacy_overlay_push(const lv_area_t *area, const uint8_t *px_map)
+{
+    if (lvgl_ctx.dma_busy || st7789_is_busy()) {
+        return false;
+    }
+
+    st7789_set_window(area->x1, area->y1, area->x2, area->y2);
+    st7789_write_pixels((const uint16_t *)px_map, lv_area_get_size(area));
+    return true;
+}
+
+static void lvgl_legacy_write_dma_done(void *user_data)
+{
+    (void)user_data;
+    lvgl_ctx.dma_busy = false;
+    hpm_lvgl_rtos_wake_from_isr();
+}
+
+static hpm_stat_t lvgl_legacy_write_dma(const lv_area_t *area, const uint8_t *px_map, uint32_t len)
+{
+    st7789_set_window((uint16_t)area->x1, (uint16_t)area->y1, (uint16_t)area->x2, (uint16_t)area->y2);
+    lvgl_ctx.dma_busy = true;
+    if (st7789_write_pixels_dma(px_map, len, lvgl_legacy_write_dma_done, NULL) != status_success) {
+        lvgl_ctx.dma_busy = false;
+        return status_fail;
+    }
+    return status_success;
+}
+
+#if HPM_LVGL_BACKEND_AB
+/* DMA manager owns the DMA IRQ in A/B mode: the legacy driver runs on a channel requested from
+ * it, and completion arrives through the manager's TC callback instead of our own ISR. */
+static dma_resource_t lvgl_legacy_dma;
+static bool lvgl_legacy_dma_ready;
+
+HPM_LVGL_HOT_ATTR static void lvgl_legacy_dma_tc_cb(DMA_Type *base, uint32_t channel, void *cb_data_ptr)
+{
+    (void)base;
+    (void)channel;
+    (void)cb_data_ptr;
+
+    uint64_t isr_start = hpm_csr_get_core_cycle();
+    hpm_lvgl_trace_record(HPM_LVGL_TRACE_DMA_TC, (uint16_t)lvgl_ctx.flush_count, 0);
+    st7789_dma_tc_handler();
+    lvgl_isr_account(isr_start);
+}
+#endif
+
+static hpm_stat_t lvgl_legacy_get_config(st7789_config_t *cfg)
 {
     st7789_config_t lcd_cfg = {0};
 
     /* SPI configuration */
     lcd_cfg.spi_base = BOARD_LCD_SPI;
     lcd_cfg.spi_clk_name = BOARD_LCD_SPI_CLK_NAME;
-    lcd_cfg.spi_freq_hz = HPM_LVGL_SPI_FREQ;
+    lcd_cfg.spi_freq_hz = lvgl_ctx.spi_freq_hz;
 
     /* DMA configuration */
+#if HPM_LVGL_BACKEND_AB
+    if (!lvgl_legacy_dma_ready) {
+        if (dma_mgr_request_resource(&lvgl_legacy_dma) != status_success) {
+            return status_fail;
+        }
+        dma_mgr_install_chn_tc_callback(&lvgl_legacy_dma, lvgl_legacy_dma_tc_cb, NULL);
+        dma_mgr_enable_dma_irq_with_priority(&lvgl_legacy_dma, 5);
+        lvgl_legacy_dma_ready = true;
+    }
+    lcd_cfg.dma_base = lvgl_legacy_dma.base;
+    lcd_cfg.dma_channel = (uint8_t)lvgl_legacy_dma.channel;
+    lcd_cfg.dma_irq_num = (uint32_t)lvgl_legacy_dma.irq_num;
+#else
     lcd_cfg.dma_base = BOARD_LCD_DMA;
-    lcd_cfg.dmamux_base = BOARD_LCD_DMAMUX;
     lcd_cfg.dma_channel = BOARD_LCD_DMA_CH;
+    lcd_cfg.dma_irq_num = BOARD_LCD_DMA_IRQ;
+#endif
+    lcd_cfg.dmamux_base = BOARD_LCD_DMAMUX;
     lcd_cfg.dma_mux_channel = BOARD_LCD_DMA_MUX_CH;
     lcd_cfg.dma_src_request = BOARD_LCD_DMA_SRC;
-    lcd_cfg.dma_irq_num = BOARD_LCD_DMA_IRQ;
 
-    /* GPIO configuration */
-    lcd_cfg.gpio_base = BOARD_LCD_GPIO;
-    lcd_cfg.dc_gpio_index = BOARD_LCD_D_C_INDEX;
-    lcd_cfg.dc_gpio_pin = BOARD_LCD_D_C_PIN;
-    lcd_cfg.rst_gpio_index = BOARD_LCD_RESET_INDEX;
-    lcd_cfg.rst_gpio_pin = BOARD_LCD_RESET_PIN;
-    lcd_cfg.bl_gpio_index = BOARD_LCD_BL_INDEX;
-    lcd_cfg.bl_gpio_pin = BOARD_LCD_BL_PIN;
+    /* GPIO configuration */
+    lcd_cfg.gpio_base = BOARD_LCD_GPIO;
+    lcd_cfg.dc_gpio_index = BOARD_LCD_D_C_INDEX;
+    lcd_cfg.dc_gpio_pin = BOARD_LCD_D_C_PIN;
+    lcd_cfg.rst_gpio_index = BOARD_LCD_RESET_INDEX;
+    lcd_cfg.rst_gpio_pin = BOARD_LCD_RESET_PIN;
+    lcd_cfg.bl_gpio_index = BOARD_LCD_BL_INDEX;
+    lcd_cfg.bl_gpio_pin = BOARD_LCD_BL_PIN;
+
+    /* Display configuration */
+    lcd_cfg.width = HPM_LVGL_LCD_WIDTH;
+    lcd_cfg.height = HPM_LVGL_LCD_HEIGHT;
+    lcd_cfg.x_offset = BOARD_LCD_X_OFFSET;
+    lcd_cfg.y_offset = BOARD_LCD_Y_OFFSET;
+    lcd_cfg.driver_ic = LCD_DRIVER_ST7789;  /* Also works for GC9307 */
+    lcd_cfg.rotation = 0;
+    lcd_cfg.invert_colors = true;           /* Most ST7789 displays need inversion */
+    lcd_cfg.noncacheable_buffers = !lvgl_ctx.fb_cacheable;
+
+    *cfg = lcd_cfg;
+    return status_success;
+}
+
+static hpm_stat_t lvgl_legacy_attach(void)
+{
+    st7789_config_t lcd_cfg;
+
+    if (lvgl_legacy_get_config(&lcd_cfg) != status_success) {
+        return status_fail;
+    }
+    return st7789_init(&lcd_cfg);
+}
+
+static void lvgl_legacy_set_rotation(uint16_t rotation)
+{
+    st7789_set_rotation((uint8_t)rotation);
+
+    /* Update LVGL display size if rotated 90/270 */
+    if (lvgl_ctx.disp) {
+        if (rotation == 90 || rotation == 270) {
+            lv_display_set_resolution(lvgl_ctx.disp, HPM_LVGL_LCD_HEIGHT, HPM_LVGL_LCD_WIDTH);
+        } else {
+            lv_display_set_resolution(lvgl_ctx.disp, HPM_LVGL_LCD_WIDTH, HPM_LVGL_LCD_HEIGHT);
+        }
+        hpm_lvgl_heatmap_reset();
+    }
+}
+
+static const lvgl_backend_ops_t lvgl_backend_legacy = {
+    .name = "legacy",
+    .attach = lvgl_legacy_attach,
+    .flush = lvgl_legacy_flush_cb,
+    .overlay_push = lvgl_legacy_overlay_push,
+    .set_spi_freq = st7789_set_spi_freq,
+    .set_rotation = lvgl_legacy_set_rotation,
+    .backlight = st7789_backlight,
+    .read = st7789_read,
+    .write_dma = lvgl_legacy_write_dma,
+};
+#endif /* HPM_LVGL_HAS_LEGACY_BACKEND */
+
+/*============================================================================
+ * Remote backend: core 1 owns SPI/DMA (HPM_LVGL_DUALCORE == 1)
+ *============================================================================*/
+
+#if HPM_LVGL_HAS_REMOTE_BACKEND
+
+#ifndef BOARD_RUNNING_CORE
+#define BOARD_RUNNING_CORE HPM_CORE0
+#endif
+
+/* Pixel message on core 1, and the LVGL flush it completes (NULL for splash/overlay writes).
+ * Core 1 raises no interrupt on this core: completion is polled by lvgl_remote_poll() wherever
+ * the single-core backends would wait for the DMA interrupt. */
+static uint32_t lvgl_remote_seq;
+static lv_display_t *lvgl_remote_disp;
+
+HPM_LVGL_HOT_ATTR static void lvgl_remote_poll(void)
+{
+    uint32_t xfer_us;
+
+    if (!lvgl_ctx.dma_busy || !hpm_lvgl_dualcore_done(lvgl_remote_seq, &xfer_us)) {
+        return;
+    }
+    hpm_lvgl_trace_record(HPM_LVGL_TRACE_SPI_IDLE, (uint16_t)lvgl_ctx.flush_count, 0);
+    lvgl_ctx.dma_busy = false;
+
+    lv_display_t *disp = lvgl_remote_disp;
+    if (disp != NULL) {
+        lvgl_remote_disp = NULL;
+        /* Account the transfer as core 1 timed it, not from when this core noticed. */
+        lvgl_ctx.flush_start_cycle = hpm_csr_get_core_cycle() - ((uint64_t)xfer_us * lvgl_ctx.cpu_mhz);
+        lvgl_flush_complete(disp);
+        lvgl_ctx.frame_count++;
+    }
+}
+
+HPM_LVGL_HOT_ATTR static hpm_stat_t lvgl_remote_send_pixels(const lv_area_t *area, const uint8_t *px_map,
+                                                            uint32_t len, lv_display_t *disp)
+{
+    hpm_lvgl_dualcore_msg_t msg = {0};
+
+    /* Core 1 reads the buffer by DMA through the system bus: push it out of this core's cache
+     * and hand over the bus address (draw buffers may sit in this core's DLM). */
+    lvgl_fb_writeback(px_map, len);
+    msg.type = HPM_LVGL_DUALCORE_MSG_PIXELS;
+    msg.x1 = (uint16_t)area->x1;
+    msg.y1 = (uint16_t)area->y1;
+    msg.x2 = (uint16_t)area->x2;
+    msg.y2 = (uint16_t)area->y2;
+    msg.addr = core_local_mem_to_sys_address(BOARD_RUNNING_CORE, (uint32_t)px_map);
+    msg.len = len;
+
+    lvgl_remote_disp = disp;
+    lvgl_ctx.dma_busy = true;
+    if (hpm_lvgl_dualcore_send(&msg) != status_success) {
+        /* Core 1 is not taking messages (counted in its stats): give the buffer back undrawn
+         * so LVGL keeps running. */
+        lvgl_remote_disp = NULL;
+        lvgl_ctx.dma_busy = false;
+        if (disp != NULL) {
+            lvgl_flush_complete(disp);
+        }
+        return status_timeout;
+    }
+    lvgl_remote_seq = msg.seq;
+    return status_success;
+}
+
+/* Commands queue behind pending pixels and need no completion: core 1 runs them in order. */
+static hpm_stat_t lvgl_remote_send_cmd(hpm_lvgl_dualcore_msg_type_t type, uint32_t arg)
+{
+    hpm_lvgl_dualcore_msg_t msg = {0};
+
+    msg.type = type;
+    msg.arg = arg;
+    return hpm_lvgl_dualcore_send(&msg);
+}
+
+HPM_LVGL_HOT_ATTR static void lvgl_remote_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    uint32_t byte_len = lv_area_get_size(area) * HPM_LVGL_PIXEL_SIZE;
+
+    /* Flush statistics */
+    lvgl_ctx.flush_count++;
+    lvgl_ctx.flush_bytes += byte_len;
+    lvgl_ctx.last_flush_tick = lvgl_tick_get_cb();
+    lvgl_flush_begin();
+    lv_area_copy(&lvgl_ctx.last_flush_area, area);
+    hpm_lvgl_trace_record(HPM_LVGL_TRACE_FLUSH_START, (uint16_t)lvgl_ctx.flush_count, byte_len);
+    hpm_lvgl_replay_flush(area, px_map);
+    hpm_lvgl_heatmap_flush(area, px_map);
+    hpm_lvgl_overlay_flush(area, px_map);
+
+    (void)lvgl_remote_send_pixels(area, px_map, byte_len, disp);
+}
+
+/* Overlay plane push between LVGL refreshes: blocking like the local backends, as the overlay
+ * reuses its buffer right after. */
+static bool lvgl_remote_overlay_push(const lv_area_t *area, const uint8_t *px_map)
+{
+    if (lvgl_ctx.dma_busy) {
+        return false;
+    }
+
+    if (lvgl_remote_send_pixels(area, px_map, lv_area_get_size(area) * HPM_LVGL_PIXEL_SIZE, NULL) !=
+        status_success) {
+        return false;
+    }
+    while (lvgl_ctx.dma_busy) {
+        lvgl_remote_poll();
+    }
+    return true;
+}
+
+static hpm_stat_t lvgl_remote_write_dma(const lv_area_t *area, const uint8_t *px_map, uint32_t len)
+{
+    return lvgl_remote_send_pixels(area, px_map, len, NULL);
+}
+
+static hpm_stat_t lvgl_remote_set_spi_freq(uint32_t freq_hz)
+{
+    return lvgl_remote_send_cmd(HPM_LVGL_DUALCORE_MSG_SPI_FREQ, freq_hz);
+}
+
+static void lvgl_remote_set_rotation(uint16_t rotation)
+{
+    (void)lvgl_remote_send_cmd(HPM_LVGL_DUALCORE_MSG_ROTATION, rotation);
+
+    if (lvgl_ctx.disp) {
+        if (rotation == 90 || rotation == 270) {
+            lv_display_set_resolution(lvgl_ctx.disp, HPM_LVGL_LCD_HEIGHT, HPM_LVGL_LCD_WIDTH);
+        } else {
+            lv_display_set_resolution(lvgl_ctx.disp, HPM_LVGL_LCD_WIDTH, HPM_LVGL_LCD_HEIGHT);
+        }
+        hpm_lvgl_heatmap_reset();
+    }
+}
+
+static void lvgl_remote_backlight(bool on)
+{
+    (void)lvgl_remote_send_cmd(HPM_LVGL_DUALCORE_MSG_BACKLIGHT, on ? 1U : 0U);
+}
+
+/* Panel reads stay on core 1 (no warm restart in this mode). */
+static hpm_stat_t lvgl_remote_read(uint8_t cmd, uint8_t *data, uint32_t len)
+{
+    (void)cmd;
+    (void)data;
+    (void)len;
+    return status_fail;
+}
+
+static const lvgl_backend_ops_t lvgl_backend_remote = {
+    .name = "dualcore",
+    .attach = hpm_lvgl_dualcore_attach,
+    .flush = lvgl_remote_flush_cb,
+    .overlay_push = lvgl_remote_overlay_push,
+    .set_spi_freq = lvgl_remote_set_spi_freq,
+    .set_rotation = lvgl_remote_set_rotation,
+    .backlight = lvgl_remote_backlight,
+    .read = lvgl_remote_read,
+    .write_dma = lvgl_remote_write_dma,
+};
+#endif /* HPM_LVGL_HAS_REMOTE_BACKEND */
+
+/* Wait until no transfer of ours is on the bus (completions of the remote backend are polled).
+ * With HPM_LVGL_RTOS every completion notifies the LVGL task, which sleeps on it instead of
+ * spinning with lv_lock() held; other tasks give the CPU up a tick at a time. */
+static void lvgl_wait_bus_idle(void)
+{
+#if HPM_LVGL_RTOS && !HPM_LVGL_HAS_REMOTE_BACKEND
+    bool lvgl_task = hpm_lvgl_rtos_in_lvgl_task();
+#endif
+
+    while (lvgl_ctx.dma_busy) {
+#if HPM_LVGL_HAS_REMOTE_BACKEND
+        lvgl_remote_poll();
+#elif HPM_LVGL_RTOS
+        if (!lvgl_task) {
+            hpm_lvgl_rtos_delay(1U);
+        } else if (!hpm_lvgl_rtos_flush_ready()) {
+            hpm_lvgl_rtos_wait(HPM_LVGL_RTOS_WAIT_FOREVER);
+        }
+#endif
+    }
+
+#if HPM_LVGL_RTOS && !HPM_LVGL_HAS_REMOTE_BACKEND
+    /* The wait may have taken the notification of a flush completion: hand it to LVGL now */
+    if (lvgl_task) {
+        (void)hpm_lvgl_rtos_flush_ready();
+    }
+#endif
+}
+
+/*============================================================================
+ * Backend dispatch
+ *============================================================================*/
+
+/* Registered LVGL flush callback for every backend, so flush cost is measured the same way. */
+HPM_LVGL_HOT_ATTR static void lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    uint64_t start = hpm_csr_get_core_cycle();
+
+    /* Only reachable through an explicit lv_refr_now() while the panel boots; the refresh
+     * timer is paused until then and the screen is invalidated once the panel is up. */
+    if (!lvgl_boot.ready) {
+        lv_display_flush_ready(disp);
+        return;
+    }
+
+    /* After a warm restart the panel may already show (part of) this area. */
+    lv_area_t send = *area;
+    if (!hpm_lvgl_warm_flush_begin(&send, px_map)) {
+        if (lvgl_boot.first_pixel_cycle == 0U) {
+            lvgl_boot.first_pixel_cycle = hpm_csr_get_core_cycle();
+        }
+        lv_display_flush_ready(disp);
+        return;
+    }
+
+    lvgl_backend->flush(disp, &send, px_map);
+    lvgl_ctx.flush_cpu_cycles += hpm_csr_get_core_cycle() - start;
+}
+
+static bool lvgl_overlay_push(const lv_area_t *area, const uint8_t *px_map)
+{
+    if (!lvgl_boot.ready) {
+        return false;
+    }
+    hpm_lvgl_warm_invalidate_area(area);
+    return lvgl_backend->overlay_push(area, px_map);
+}
+
+/*============================================================================
+ * Panel bring-up
+ *============================================================================*/
+
+/*
+ * Boot splash: full-width bands sent by DMA. A full-screen RAW image goes straight from flash;
+ * anything else is composed (background + decoded rows) into the draw buffers, the next band
+ * being prepared while the previous one is on the bus when double buffering is enabled.
+ */
+typedef struct {
+    const uint8_t *p;
+    const uint8_t *end;
+    uint8_t count;              /* Pixels left in the current run */
+    bool repeat;
+} lvgl_splash_rle_t;
+
+static void lvgl_splash_fill(uint8_t *out, uint32_t pixels, uint16_t color)
+{
+    for (uint32_t i = 0; i < pixels; i++) {
+        out[0] = (uint8_t)(color >> 8);
+        out[1] = (uint8_t)color;
+        out += 2;
+    }
+}
+
+/* RLE: control byte c, then either (c & 0x80) one pixel repeated (c & 0x7F) + 1 times,
+ * or c + 1 literal pixels; runs may cross rows. A truncated stream ends in background. */
+static void lvgl_splash_rle_decode(lvgl_splash_rle_t *d, uint8_t *out, uint32_t pixels, uint16_t bg)
+{
+    while (pixels > 0U) {
+        if (d->count == 0U) {
+            if (d->p >= d->end) {
+                lvgl_splash_fill(out, pixels, bg);
+                return;
+            }
+            uint8_t c = *d->p++;
+            d->repeat = (c & 0x80U) != 0U;
+            d->count = (uint8_t)((c & 0x7FU) + 1U);
+        }
+        if ((d->end - d->p) < 2) {
+            d->p = d->end;
+            d->count = 0;
+            continue;
+        }
+        out[0] = d->p[0];
+        out[1] = d->p[1];
+        out += 2;
+        pixels--;
+        d->count--;
+        if (!d->repeat || (d->count == 0U)) {
+            d->p += 2;
+        }
+    }
+}
+
+static void lvgl_splash_show(const hpm_lvgl_splash_t *splash)
+{
+    const uint32_t width = HPM_LVGL_LCD_WIDTH;
+    const uint32_t height = HPM_LVGL_LCD_HEIGHT;
+    const uint32_t row_bytes = width * HPM_LVGL_PIXEL_SIZE;
+    const uint32_t band_lines = HPM_LVGL_FB_SIZE / row_bytes;   /* Fewer than FB_LINES with L8 buffers */
+    uint8_t *bufs[2] = { lvgl_fb0, lvgl_fb0 };
+    lvgl_splash_rle_t rle = { splash->data, splash->data + splash->data_size, 0, false };
+    uint32_t sw = splash->width;
+    uint32_t sh = splash->height;
+
+    if ((splash->data == NULL) || (sw > width) || (sh > height) ||
+        ((splash->format == HPM_LVGL_SPLASH_RAW) && (splash->data_size < (sw * sh * 2U)))) {
+        return;
+    }
+#if HPM_LVGL_USE_DOUBLE_BUFFER
+    bufs[1] = lvgl_fb1;
+#endif
+
+    uint32_t x0 = (width - sw) / 2U;
+    uint32_t y0 = (height - sh) / 2U;
+    bool direct = (splash->format == HPM_LVGL_SPLASH_RAW) && (sw == width) && (sh == height);
+
+    for (uint32_t y = 0, i = 0; y < height; y += band_lines, i ^= 1U) {
+        uint32_t lines = LV_MIN(band_lines, height - y);
+        const uint8_t *src = splash->data + (y * row_bytes);
+        lv_area_t band = { 0, (int32_t)y, (int32_t)width - 1, (int32_t)(y + lines) - 1 };
+
+        if (!direct) {
+            uint8_t *buf = bufs[i];
+            if (bufs[0] == bufs[1]) {
+                lvgl_wait_bus_idle();
+            }
+            for (uint32_t r = 0; r < lines; r++) {
+                uint8_t *row = buf + (r * row_bytes);
+                uint32_t iy = y + r - y0;
+
+                if (((y + r) < y0) || (iy >= sh)) {
+                    lvgl_splash_fill(row, width, splash->bg_color);
+                    continue;
+                }
+                lvgl_splash_fill(row, x0, splash->bg_color);
+                if (splash->format == HPM_LVGL_SPLASH_RAW) {
+                    memcpy(row + (x0 * 2U), splash->data + (iy * sw * 2U), sw * 2U);
+                } else {
+                    lvgl_splash_rle_decode(&rle, row + (x0 * 2U), sw, splash->bg_color);
+                }
+                lvgl_splash_fill(row + ((x0 + sw) * 2U), width - x0 - sw, splash->bg_color);
+            }
+            src = buf;
+        }
+
+        lvgl_wait_bus_idle();
+        if (lvgl_backend->write_dma(&band, src, lines * row_bytes) != status_success) {
+            return;
+        }
+    }
+    lvgl_wait_bus_idle();
+    lvgl_boot.splash_cycle = hpm_csr_get_core_cycle();
+}
+
+#if HPM_LVGL_WARM_RESTART
+/* Multi-byte panel reads start with one dummy clock: realign to whole bytes (MSB first). */
+static uint32_t lvgl_panel_read(uint8_t cmd, uint32_t len)
+{
+    uint8_t raw[HPM_LVGL_PANEL_READ_MAX];
+    uint32_t value = 0;
+
+    if (lvgl_backend->read(cmd, raw, len + 1U) != status_success) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < len; i++) {
+        value = (value << 8) | (uint8_t)((raw[i] << 1) | (raw[i + 1U] >> 7));
+    }
+    return value;
+}
+#endif
+
+#if !HPM_LVGL_HAS_REMOTE_BACKEND
+/* Before any reset: is the panel still configured from the previous run? */
+static bool lvgl_warm_probe(void)
+{
+#if HPM_LVGL_WARM_RESTART
+    uint32_t id = lvgl_panel_read(LCD_CMD_RDDID, 3);
+    uint32_t status = lvgl_panel_read(LCD_CMD_RDDST, 4);
+
+    return hpm_lvgl_warm_probe(id, status);
+#else
+    return false;
+#endif
+}
+#endif
+
+/* Advance the panel init; never waits. true once the panel is on. */
+static bool lvgl_boot_poll(void)
+{
+#if HPM_LVGL_HAS_REMOTE_BACKEND
+    return hpm_lvgl_dualcore_panel_ready();
+#elif HPM_LVGL_USE_LVGL_ST7789_DRIVER
+    return lvgl_boot_play(false);
+#else
+    return st7789_init_poll();
+#endif
+}
 
-    /* Display configuration */
-    lcd_cfg.width = HPM_LVGL_LCD_WIDTH;
-    lcd_cfg.height = HPM_LVGL_LCD_HEIGHT;
-    lcd_cfg.x_offset = BOARD_LCD_X_OFFSET;
-    lcd_cfg.y_offset = BOARD_LCD_Y_OFFSET;
-    lcd_cfg.driver_ic = LCD_DRIVER_ST7789;  /* Also works for GC9307 */
-    lcd_cfg.rotation = 0;
-    lcd_cfg.invert_colors = true;           /* Most ST7789 displays need inversion */
+static void lvgl_boot_finish(void)
+{
+    lv_timer_t *refr_timer = lv_display_get_refr_timer(lvgl_ctx.disp);
 
-    return st7789_init(&lcd_cfg);
+#if HPM_LVGL_USE_LVGL_ST7789_DRIVER
+    lvgl_boot.recording = false;
+#endif
+    lvgl_backend->backlight(true);
+    lvgl_boot.ready_cycle = hpm_csr_get_core_cycle();
+    lvgl_boot.ready = true;
+
+    /* Render the UI built during bring-up right away instead of on the next refresh period. */
+    lv_obj_invalidate(lv_screen_active());
+    if (refr_timer != NULL) {
+        lv_timer_resume(refr_timer);
+        lv_timer_ready(refr_timer);
+    }
+}
+
+static void lvgl_boot_timer_cb(lv_timer_t *timer)
+{
+    if (lvgl_boot_poll()) {
+        lv_timer_delete(timer);
+        lvgl_boot.timer = NULL;
+        lvgl_boot_finish();
+    }
 }
-#endif /* HPM_LVGL_USE_LVGL_ST7789_DRIVER */
 
 /*============================================================================
  * DMA IRQ handler
  *============================================================================*/
 
-void hpm_lvgl_spi_dma_irq_handler(void)
+HPM_LVGL_HOT_ATTR void hpm_lvgl_spi_dma_irq_handler(void)
 {
-#if !HPM_LVGL_USE_LVGL_ST7789_DRIVER
+#if !HPM_LVGL_USE_LVGL_ST7789_DRIVER && !HPM_LVGL_HAS_REMOTE_BACKEND
+    uint64_t isr_start = hpm_csr_get_core_cycle();
+    bool busy = st7789_is_busy();
+
+    if (busy) {
+        hpm_lvgl_trace_record(HPM_LVGL_TRACE_DMA_TC, (uint16_t)lvgl_ctx.flush_count, 0);
+    }
     st7789_dma_irq_handler();
+    if (busy) {
+        lvgl_isr_account(isr_start);
+    }
+    /* Same controller IRQ: the DMA draw unit's channel completes here as well. */
+    hpm_lvgl_draw_dma_irq_handler();
 #endif
 }
 
-#if !USE_DMA_MGR && !HPM_LVGL_USE_LVGL_ST7789_DRIVER
+#if !USE_DMA_MGR && !HPM_LVGL_USE_LVGL_ST7789_DRIVER && !HPM_LVGL_HAS_REMOTE_BACKEND
 /* Register DMA IRQ for legacy DMAv2 path.
  * NOTE: Not used when DMA manager is enabled (dma_mgr owns IRQn_HDMA/IRQn_XDMA ISRs). */
 SDK_DECLARE_EXT_ISR_M(BOARD_LCD_DMA_IRQ, hpm_lvgl_spi_dma_isr)
-void hpm_lvgl_spi_dma_isr(void)
+HPM_LVGL_HOT_ATTR void hpm_lvgl_spi_dma_isr(void)
 {
     hpm_lvgl_spi_dma_irq_handler();
 }
 #endif
 
+/*============================================================================
+ * LVGL display events
+ *============================================================================*/
+
+static inline uint32_t lvgl_cycles_to_us(uint64_t cycles)
+{
+    return (uint32_t)(cycles / lvgl_ctx.cpu_mhz);
+}
+
+#if HPM_LVGL_FLUSH_WAIT_SLEEP || HPM_LVGL_HAS_REMOTE_BACKEND
+/* Called by LVGL instead of spinning on `disp->flushing` when it needs a draw buffer that is
+ * still on the bus. Sleeps until the DMA completion handler has called lv_display_flush_ready(). */
+HPM_LVGL_HOT_ATTR static void lvgl_flush_wait_cb(lv_display_t *disp)
+{
+#if HPM_LVGL_HAS_REMOTE_BACKEND
+    /* Nothing interrupts this core when core 1 finishes: poll the ring instead of sleeping. */
+    while (disp->flushing) {
+        lvgl_remote_poll();
+    }
+#elif HPM_LVGL_RTOS
+    /* This is the LVGL task: finish the deferred completion here when it arrives. */
+    uint64_t start = hpm_csr_get_core_cycle();
+
+    while (disp->flushing) {
+        if (!hpm_lvgl_rtos_flush_ready()) {
+            hpm_lvgl_rtos_wait(HPM_LVGL_RTOS_WAIT_FOREVER);
+            lvgl_ctx.sleep_count++;
+        }
+    }
+    lvgl_ctx.idle_cycles += hpm_csr_get_core_cycle() - start;
+#elif HPM_LVGL_HAS_OS
+    uint64_t start = hpm_csr_get_core_cycle();
+
+    lvgl_ctx.flush_waiting = true;
+    while (disp->flushing) {
+        lv_thread_sync_wait(&lvgl_flush_sync);
+        lvgl_ctx.sleep_count++;
+    }
+    lvgl_ctx.flush_waiting = false;
+    lvgl_ctx.idle_cycles += hpm_csr_get_core_cycle() - start;
+#else
+    while (disp->flushing) {
+        /* Check and sleep with interrupts masked: WFI still wakes on the pending DMA
+         * interrupt, which is taken once they are restored, so no completion is missed. */
+        uint32_t level = disable_global_irq(CSR_MSTATUS_MIE_MASK);
+        if (disp->flushing) {
+            uint64_t start = hpm_csr_get_core_cycle();
+            __asm volatile("wfi");
+            lvgl_ctx.idle_cycles += hpm_csr_get_core_cycle() - start;
+            lvgl_ctx.sleep_count++;
+        }
+        restore_global_irq(level);
+    }
+#endif
+}
+#endif
+
+static void lvgl_display_event_cb(lv_event_t *e)
+{
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_INVALIDATE_AREA:
+        hpm_lvgl_jank_invalidate((const lv_area_t *)lv_event_get_param(e));
+        break;
+    case LV_EVENT_REFR_START:
+        hpm_lvgl_trace_record(HPM_LVGL_TRACE_REFR_START, 0, 0);
+        lvgl_ctx.refr_start_cycle = hpm_csr_get_core_cycle();
+        lvgl_ctx.frame_wait_cycles = 0;
+        lvgl_ctx.frame_xfer_base = lvgl_ctx.xfer_cycles;
+        lvgl_ctx.frame_flush_base = lvgl_ctx.flush_count;
+        hpm_lvgl_jank_frame_start();
+        break;
+    case LV_EVENT_FLUSH_WAIT_START:
+        lvgl_ctx.wait_start_cycle = hpm_csr_get_core_cycle();
+        break;
+    case LV_EVENT_FLUSH_WAIT_FINISH: {
+        uint64_t wait = hpm_csr_get_core_cycle() - lvgl_ctx.wait_start_cycle;
+        lvgl_ctx.frame_wait_cycles += wait;
+        lvgl_ctx.wait_cycles += wait;
+        break;
+    }
+    case LV_EVENT_REFR_READY: {
+        hpm_lvgl_trace_record(HPM_LVGL_TRACE_REFR_READY, 0, 0);
+        uint64_t frame = hpm_csr_get_core_cycle() - lvgl_ctx.refr_start_cycle;
+        uint64_t render = (frame > lvgl_ctx.frame_wait_cycles) ? (frame - lvgl_ctx.frame_wait_cycles) : 0U;
+        lvgl_ctx.refresh_count++;
+        lvgl_ctx.render_cycles += render;
+        if (lvgl_ctx.flush_count != lvgl_ctx.frame_flush_base) {
+            lvgl_ctx.frames_rendered++;
+            lvgl_ctx.frame_cycles += frame;
+        }
+        hpm_lvgl_jank_frame_end(lvgl_cycles_to_us(frame), lvgl_cycles_to_us(render),
+                                lvgl_cycles_to_us(lvgl_ctx.xfer_cycles - lvgl_ctx.frame_xfer_base),
+                                lvgl_ctx.flush_count - lvgl_ctx.frame_flush_base);
+        hpm_lvgl_replay_frame_end();
+        hpm_lvgl_overlay_refr_ready();
+        hpm_lvgl_warm_frame_end();
+        break;
+    }
+    default:
+        break;
+    }
+}
+
 /*============================================================================
  * Public API
  *============================================================================*/
 
+/* Setters may be called from any task with LV_USE_OS: serialize them with LVGL (the lock is
+ * recursive, so calls from the LVGL task or from a posted call are fine). LVGL's lock only
+ * exists after lv_init(). */
+static inline bool lvgl_api_lock(void)
+{
+#if HPM_LVGL_HAS_OS
+    if (lvgl_ctx.disp != NULL) {
+        lv_lock();
+        return true;
+    }
+#endif
+    return false;
+}
+
+static inline void lvgl_api_unlock(bool locked)
+{
+#if HPM_LVGL_HAS_OS
+    if (locked) {
+        lv_unlock();
+    }
+#else
+    (void)locked;
+#endif
+}
+
 lv_display_t *hpm_lvgl_spi_init(void)
 {
     lv_display_t *disp;
     
     /* Clear context */
     memset(&lvgl_ctx, 0, sizeof(lvgl_ctx));
+    lvgl_ctx.cpu_mhz = clock_get_frequency(clock_cpu0) / 1000000UL;
+    if (lvgl_ctx.cpu_mhz == 0U) {
+        lvgl_ctx.cpu_mhz = 1U;
+    }
+    lvgl_ctx.spi_freq_hz = HPM_LVGL_SPI_FREQ;
+    lvgl_ctx.fb_lines = HPM_LVGL_FB_LINES;
+    lvgl_ctx.fb_double = (HPM_LVGL_USE_DOUBLE_BUFFER != 0);
+    lvgl_ctx.fb_cacheable = (HPM_LVGL_FB_CACHEABLE != 0);
+    lvgl_ctx.stats_start_cycle = hpm_csr_get_core_cycle();
+    lvgl_mchtmr_init();
+    memset(&lvgl_boot, 0, sizeof(lvgl_boot));
+    hpm_lvgl_trace_init();
+    hpm_lvgl_spi_capture_init();
     
     /* Initialize LVGL */
     lv_init();
@@ -568,12 +1941,36 @@ lv_display_t *hpm_lvgl_spi_init(void)
     /* Set tick callback */
     lv_tick_set_cb(lvgl_tick_get_cb);
     
-    /* Initialize display hardware */
-    if (lvgl_display_hw_init() != status_success) {
+#if HPM_LVGL_HAS_REMOTE_BACKEND
+    /* Core 1 brings the panel up; lvgl_boot_poll() watches for it. */
+    lvgl_backend = &lvgl_backend_remote;
+    if (lvgl_backend->attach() != status_success) {
+        return NULL;
+    }
+
+    disp = lv_display_create(HPM_LVGL_LCD_WIDTH, HPM_LVGL_LCD_HEIGHT);
+    if (disp == NULL) {
+        return NULL;
+    }
+#elif !HPM_LVGL_USE_LVGL_ST7789_DRIVER
+    /* Initialize display hardware; the panel itself comes up in lvgl_boot_poll(). */
+    st7789_config_t lcd_cfg;
+
+    lvgl_backend = &lvgl_backend_legacy;
+    if (lvgl_legacy_get_config(&lcd_cfg) != status_success) {
+        return NULL;
+    }
+    lcd_cfg.defer_backlight = true;     /* lvgl_boot_finish() switches it on, after a splash */
+    if (st7789_attach(&lcd_cfg) != status_success) {
+        return NULL;
+    }
+    lvgl_boot.warm = lvgl_warm_probe();
+    if (lvgl_boot.warm) {
+        st7789_init_warm();
+    } else if (st7789_init_start(&lcd_cfg) != status_success) {
         return NULL;
     }
 
-#if !HPM_LVGL_USE_LVGL_ST7789_DRIVER
     /* Enable DMA interrupt (legacy DMAv2 path). */
     intc_m_enable_irq_with_priority(BOARD_LCD_DMA_IRQ, 5);
 
@@ -583,17 +1980,40 @@ lv_display_t *hpm_lvgl_spi_init(void)
         return NULL;
     }
 #else
-    /* Create LVGL display (LVGL built-in ST7789 wrapper uses generic MIPI driver). */
+    /* Initialize display hardware */
+    lvgl_backend = &lvgl_backend_mipi;
+    if (lvgl_display_hw_init() != status_success) {
+        return NULL;
+    }
+    lvgl_boot.warm = lvgl_warm_probe();
+    if (!lvgl_boot.warm) {
+        lcd_hw_reset();
+    }
+
+    /* Create LVGL display (LVGL built-in ST7789 wrapper uses generic MIPI driver). The panel is
+     * still in its reset window, so record the init sequence for lvgl_boot_poll() to replay. */
+    lvgl_boot.recording = true;
+    lv_delay_set_cb(lvgl_boot_record_delay_cb);
     disp = lv_st7789_create(HPM_LVGL_LCD_WIDTH, HPM_LVGL_LCD_HEIGHT, (lv_lcd_flag_t)HPM_LVGL_LCD_FLAGS,
                             lvgl_lcd_send_cmd_cb, lvgl_lcd_send_color_cb);
+    if (disp != NULL) {
+        lv_st7789_set_gap(disp, BOARD_LCD_X_OFFSET, BOARD_LCD_Y_OFFSET);
+        lv_st7789_set_invert(disp, HPM_LVGL_LCD_INVERT);
+    }
+    lv_delay_set_cb(NULL);
     if (disp == NULL) {
         return NULL;
     }
 
-    lv_st7789_set_gap(disp, BOARD_LCD_X_OFFSET, BOARD_LCD_Y_OFFSET);
-    lv_st7789_set_invert(disp, HPM_LVGL_LCD_INVERT);
+    /* Route the generic MIPI flush through lvgl_flush_cb() like the legacy one. */
+    lvgl_mipi_flush = disp->flush_cb;
 #endif
     
+    /* L8 draw buffers: the color format sets the buffer stride, so switch it first */
+    if (hpm_lvgl_l8_init(disp) != status_success) {
+        return NULL;
+    }
+
     /* Configure buffers */
 #if HPM_LVGL_USE_DOUBLE_BUFFER
     lv_display_set_buffers(disp, lvgl_fb0, lvgl_fb1, HPM_LVGL_FB_SIZE, 
@@ -604,19 +2024,47 @@ lv_display_t *hpm_lvgl_spi_init(void)
 #endif
     
     /* Set flush callback */
-#if !HPM_LVGL_USE_LVGL_ST7789_DRIVER
     lv_display_set_flush_cb(disp, lvgl_flush_cb);
+#if HPM_LVGL_FLUSH_WAIT_SLEEP || HPM_LVGL_HAS_REMOTE_BACKEND
+#if HPM_LVGL_FLUSH_WAIT_SLEEP && HPM_LVGL_HAS_OS && !HPM_LVGL_RTOS
+    lv_thread_sync_init(&lvgl_flush_sync);
+#endif
+    lv_display_set_flush_wait_cb(disp, lvgl_flush_wait_cb);
 #endif
     
     /* Store display reference */
     lvgl_ctx.disp = disp;
     lvgl_ctx.last_fps_tick = lvgl_tick_get_cb();
+    hpm_lvgl_heatmap_init(disp);
+    hpm_lvgl_jank_init(disp);
+    hpm_lvgl_overlay_init(disp, lvgl_overlay_push);
+    hpm_lvgl_replay_init(disp);
+    hpm_lvgl_warm_init(disp);
+    /* Without a free DMA channel every task simply stays on the software renderer. */
+    (void)hpm_lvgl_draw_dma_init(disp);
+
+    lv_display_add_event_cb(disp, lvgl_display_event_cb, LV_EVENT_ALL, NULL);
+
+    /* No rendering until the panel is up; lvgl_boot_finish() resumes the refresh timer. */
+    lv_timer_pause(lv_display_get_refr_timer(disp));
+
+    /* A splash brings the panel up in place: the image is on screen before the UI is built. */
+    bool splash = (lvgl_splash != NULL) && !lvgl_boot.warm;
+    if (splash || !HPM_LVGL_ASYNC_INIT) {
+        while (!lvgl_boot_poll()) {
+        }
+        if (splash) {
+            lvgl_splash_show(lvgl_splash);
+        }
+        lvgl_boot_finish();
+    } else {
+        lvgl_boot.timer = lv_timer_create(lvgl_boot_timer_cb, 1, NULL);
+        if (lvgl_boot.timer == NULL) {
+            return NULL;
+        }
+    }
+    lvgl_boot.init_return_cycle = hpm_csr_get_core_cycle();
 
-#if HPM_LVGL_USE_LVGL_ST7789_DRIVER
-    /* Turn on backlight after successful init */
-    lcd_backlight_set(true);
-#endif
-    
     return disp;
 }
 
@@ -625,50 +2073,49 @@ lv_display_t *hpm_lvgl_spi_get_display(void)
     return lvgl_ctx.disp;
 }
 
-void hpm_lvgl_spi_backlight(bool on)
+void hpm_lvgl_spi_set_splash(const hpm_lvgl_splash_t *splash)
 {
-#if HPM_LVGL_USE_LVGL_ST7789_DRIVER
-    lcd_backlight_set(on);
-#else
-    st7789_backlight(on);
-#endif
+    lvgl_splash = splash;
 }
 
-void hpm_lvgl_spi_set_rotation(uint16_t rotation)
+bool hpm_lvgl_spi_is_ready(void)
 {
-#if HPM_LVGL_USE_LVGL_ST7789_DRIVER
-    if (!lvgl_ctx.disp) {
+    return lvgl_boot.ready;
+}
+
+void hpm_lvgl_spi_get_boot_stats(hpm_lvgl_spi_boot_stats_t *out)
+{
+    if (out == NULL) {
         return;
     }
 
-    switch (rotation) {
-    case 0:
-        lv_display_set_rotation(lvgl_ctx.disp, LV_DISPLAY_ROTATION_0);
-        break;
-    case 90:
-        lv_display_set_rotation(lvgl_ctx.disp, LV_DISPLAY_ROTATION_90);
-        break;
-    case 180:
-        lv_display_set_rotation(lvgl_ctx.disp, LV_DISPLAY_ROTATION_180);
-        break;
-    case 270:
-        lv_display_set_rotation(lvgl_ctx.disp, LV_DISPLAY_ROTATION_270);
-        break;
-    default:
-        break;
+    out->panel_ready = lvgl_boot.ready;
+    out->warm_start = lvgl_boot.warm;
+    out->init_return_us = lvgl_cycles_to_us(lvgl_boot.init_return_cycle);
+    out->splash_us = lvgl_cycles_to_us(lvgl_boot.splash_cycle);
+    out->panel_ready_us = lvgl_cycles_to_us(lvgl_boot.ready_cycle);
+    out->first_pixel_us = lvgl_cycles_to_us(lvgl_boot.first_pixel_cycle);
+}
+
+void hpm_lvgl_spi_backlight(bool on)
+{
+    bool locked = lvgl_api_lock();
+
+    if (lvgl_backend != NULL) {
+        lvgl_backend->backlight(on);
     }
-#else
-    st7789_set_rotation((uint8_t)rotation);
+    lvgl_api_unlock(locked);
+}
 
-    /* Update LVGL display size if rotated 90/270 */
-    if (lvgl_ctx.disp) {
-        if (rotation == 90 || rotation == 270) {
-            lv_display_set_resolution(lvgl_ctx.disp, HPM_LVGL_LCD_HEIGHT, HPM_LVGL_LCD_WIDTH);
-        } else {
-            lv_display_set_resolution(lvgl_ctx.disp, HPM_LVGL_LCD_WIDTH, HPM_LVGL_LCD_HEIGHT);
-        }
+void hpm_lvgl_spi_set_rotation(uint16_t rotation)
+{
+    bool locked = lvgl_api_lock();
+
+    if (lvgl_backend != NULL) {
+        lvgl_backend->set_rotation(rotation);
+        lvgl_ctx.rotation = rotation;
     }
-#endif
+    lvgl_api_unlock(locked);
 }
 
 uint32_t hpm_lvgl_spi_get_fps(void)
@@ -687,10 +2134,27 @@ uint32_t hpm_lvgl_spi_get_fps(void)
 
 void hpm_lvgl_spi_reset_stats(void)
 {
+    bool locked = lvgl_api_lock();
+
     lvgl_ctx.flush_count = 0;
     lvgl_ctx.flush_bytes = 0;
     lvgl_ctx.last_flush_tick = lvgl_tick_get_cb();
     memset(&lvgl_ctx.last_flush_area, 0, sizeof(lvgl_ctx.last_flush_area));
+    lvgl_ctx.refresh_count = 0;
+    lvgl_ctx.frames_rendered = 0;
+    lvgl_ctx.frame_cycles = 0;
+    lvgl_ctx.render_cycles = 0;
+    lvgl_ctx.xfer_cycles = 0;
+    lvgl_ctx.wait_cycles = 0;
+    lvgl_ctx.flush_cpu_cycles = 0;
+    lvgl_ctx.isr_cycles = 0;
+    lvgl_ctx.isr_count = 0;
+    lvgl_ctx.isr_max_cycles = 0;
+    lvgl_ctx.idle_cycles = 0;
+    lvgl_ctx.sleep_count = 0;
+    lvgl_ctx.loop_sleep_cycles = 0;
+    lvgl_ctx.stats_start_cycle = hpm_csr_get_core_cycle();
+    lvgl_api_unlock(locked);
 }
 
 void hpm_lvgl_spi_get_stats(hpm_lvgl_spi_stats_t *out)
@@ -699,8 +2163,254 @@ void hpm_lvgl_spi_get_stats(hpm_lvgl_spi_stats_t *out)
         return;
     }
 
+    bool locked = lvgl_api_lock();
+
     out->flush_count = lvgl_ctx.flush_count;
     out->flush_bytes = lvgl_ctx.flush_bytes;
     out->last_flush_tick = lvgl_ctx.last_flush_tick;
     lv_area_copy(&out->last_flush_area, &lvgl_ctx.last_flush_area);
+    out->refresh_count = lvgl_ctx.refresh_count;
+    out->frames_rendered = lvgl_ctx.frames_rendered;
+    out->frame_us = lvgl_ctx.frame_cycles / lvgl_ctx.cpu_mhz;
+    out->render_us = lvgl_ctx.render_cycles / lvgl_ctx.cpu_mhz;
+    out->xfer_us = lvgl_ctx.xfer_cycles / lvgl_ctx.cpu_mhz;
+    out->wait_us = lvgl_ctx.wait_cycles / lvgl_ctx.cpu_mhz;
+    uint64_t overlapped = (lvgl_ctx.xfer_cycles > lvgl_ctx.wait_cycles) ? (lvgl_ctx.xfer_cycles - lvgl_ctx.wait_cycles) : 0U;
+    out->overlap_pct = (lvgl_ctx.xfer_cycles > 0U) ? (uint8_t)((overlapped * 100U) / lvgl_ctx.xfer_cycles) : 0U;
+    out->idle_us = lvgl_ctx.idle_cycles / lvgl_ctx.cpu_mhz;
+    out->sleep_count = lvgl_ctx.sleep_count;
+    out->loop_sleep_us = lvgl_ctx.loop_sleep_cycles / lvgl_ctx.cpu_mhz;
+    uint64_t elapsed = hpm_csr_get_core_cycle() - lvgl_ctx.stats_start_cycle;
+    uint64_t idle = lvgl_ctx.idle_cycles + lvgl_ctx.loop_sleep_cycles;
+    out->cpu_idle_pct = (elapsed > 0U) ? (uint8_t)((idle * 100U) / elapsed) : 0U;
+    out->flush_cpu_us = lvgl_ctx.flush_cpu_cycles / lvgl_ctx.cpu_mhz;
+    out->isr_count = lvgl_ctx.isr_count;
+    out->isr_us = lvgl_ctx.isr_cycles / lvgl_ctx.cpu_mhz;
+    out->isr_max_us = lvgl_ctx.isr_max_cycles / lvgl_ctx.cpu_mhz;
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    out->heap_total = (uint32_t)mon.total_size;
+    out->heap_used = (uint32_t)(mon.total_size - mon.free_size);
+    out->heap_peak = (uint32_t)mon.max_used;
+    out->heap_largest_free = (uint32_t)mon.free_biggest_size;
+    out->heap_frag_pct = mon.frag_pct;
+    lvgl_api_unlock(locked);
+}
+
+static hpm_stat_t lvgl_set_buffer_config(uint32_t lines, bool double_buffer)
+{
+    if ((lvgl_ctx.disp == NULL) || (lines == 0U) || (lines > HPM_LVGL_FB_LINES)) {
+        return status_invalid_argument;
+    }
+#if !HPM_LVGL_USE_DOUBLE_BUFFER
+    if (double_buffer) {
+        return status_invalid_argument;
+    }
+#endif
+
+    /* LVGL must not be handed new buffers while one is still on the bus. */
+    lvgl_wait_bus_idle();
+
+    uint32_t size = lines * HPM_LVGL_LCD_WIDTH * HPM_LVGL_FB_PIXEL_SIZE;
+#if HPM_LVGL_USE_DOUBLE_BUFFER
+    lv_display_set_buffers(lvgl_ctx.disp, lvgl_fb0, double_buffer ? lvgl_fb1 : NULL, size,
+                           LV_DISPLAY_RENDER_MODE_PARTIAL);
+#else
+    lv_display_set_buffers(lvgl_ctx.disp, lvgl_fb0, NULL, size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+#endif
+    lvgl_ctx.fb_lines = lines;
+    lvgl_ctx.fb_double = double_buffer;
+
+    lv_obj_invalidate(lv_display_get_screen_active(lvgl_ctx.disp));
+    return status_success;
+}
+
+hpm_stat_t hpm_lvgl_spi_set_buffer_config(uint32_t lines, bool double_buffer)
+{
+    bool locked = lvgl_api_lock();
+    hpm_stat_t stat = lvgl_set_buffer_config(lines, double_buffer);
+
+    lvgl_api_unlock(locked);
+    return stat;
+}
+
+void hpm_lvgl_spi_get_buffer_config(uint32_t *lines, bool *double_buffer)
+{
+    if (lines != NULL) {
+        *lines = lvgl_ctx.fb_lines;
+    }
+    if (double_buffer != NULL) {
+        *double_buffer = lvgl_ctx.fb_double;
+    }
+}
+
+static hpm_stat_t lvgl_set_fb_cacheable(bool cacheable)
+{
+#if HPM_LVGL_FB_PLACEMENT_AB
+    if (lvgl_ctx.disp == NULL) {
+        return status_invalid_argument;
+    }
+    if (cacheable == lvgl_ctx.fb_cacheable) {
+        return status_success;
+    }
+
+    lvgl_wait_bus_idle();
+
+    bool home = (cacheable == (HPM_LVGL_FB_CACHEABLE != 0));
+    lvgl_fb0 = home ? lvgl_fb0_mem : lvgl_fb0_alt;
+#if HPM_LVGL_USE_DOUBLE_BUFFER
+    lvgl_fb1 = home ? lvgl_fb1_mem : lvgl_fb1_alt;
+#endif
+    lvgl_ctx.fb_cacheable = cacheable;
+#if HPM_LVGL_HAS_LEGACY_BACKEND
+    st7789_set_noncacheable_buffers(!cacheable);
+#endif
+
+    /* Same geometry on the other buffers (also invalidates the screen) */
+    return lvgl_set_buffer_config(lvgl_ctx.fb_lines, lvgl_ctx.fb_double);
+#else
+    (void)cacheable;
+    return status_invalid_argument;
+#endif
+}
+
+hpm_stat_t hpm_lvgl_spi_set_fb_cacheable(bool cacheable)
+{
+    bool locked = lvgl_api_lock();
+    hpm_stat_t stat = lvgl_set_fb_cacheable(cacheable);
+
+    lvgl_api_unlock(locked);
+    return stat;
+}
+
+bool hpm_lvgl_spi_get_fb_cacheable(void)
+{
+    return lvgl_ctx.fb_cacheable;
+}
+
+static hpm_stat_t lvgl_set_spi_freq(uint32_t freq_hz)
+{
+    hpm_stat_t stat;
+
+    if ((freq_hz == 0U) || (lvgl_backend == NULL)) {
+        return status_invalid_argument;
+    }
+
+    lvgl_wait_bus_idle();
+
+    stat = lvgl_backend->set_spi_freq(freq_hz);
+    if (stat == status_success) {
+        lvgl_ctx.spi_freq_hz = freq_hz;
+    }
+
+    return stat;
+}
+
+hpm_stat_t hpm_lvgl_spi_set_spi_freq(uint32_t freq_hz)
+{
+    bool locked = lvgl_api_lock();
+    hpm_stat_t stat = lvgl_set_spi_freq(freq_hz);
+
+    lvgl_api_unlock(locked);
+    return stat;
+}
+
+uint32_t hpm_lvgl_spi_get_spi_freq(void)
+{
+    return lvgl_ctx.spi_freq_hz;
+}
+
+const char *hpm_lvgl_spi_get_backend_name(void)
+{
+#if HPM_LVGL_HAS_REMOTE_BACKEND
+    const lvgl_backend_ops_t *ops = &lvgl_backend_remote;
+#elif HPM_LVGL_USE_LVGL_ST7789_DRIVER
+    const lvgl_backend_ops_t *ops = &lvgl_backend_mipi;
+#else
+    const lvgl_backend_ops_t *ops = &lvgl_backend_legacy;
+#endif
+
+    /* Before init: the backend the display will start on */
+    return (lvgl_backend != NULL) ? lvgl_backend->name : ops->name;
+}
+
+hpm_lvgl_spi_backend_t hpm_lvgl_spi_get_backend(void)
+{
+#if HPM_LVGL_HAS_REMOTE_BACKEND
+    return HPM_LVGL_SPI_BACKEND_DUALCORE;
+#endif
+#if HPM_LVGL_HAS_LEGACY_BACKEND
+    if (lvgl_backend == &lvgl_backend_legacy) {
+        return HPM_LVGL_SPI_BACKEND_LEGACY;
+    }
+#endif
+#if HPM_LVGL_HAS_MIPI_BACKEND
+    if (lvgl_backend == &lvgl_backend_mipi) {
+        return HPM_LVGL_SPI_BACKEND_DMA_MGR;
+    }
+#endif
+    return HPM_LVGL_USE_LVGL_ST7789_DRIVER ? HPM_LVGL_SPI_BACKEND_DMA_MGR : HPM_LVGL_SPI_BACKEND_LEGACY;
+}
+
+static hpm_stat_t lvgl_set_backend(hpm_lvgl_spi_backend_t backend)
+{
+    const lvgl_backend_ops_t *ops = NULL;
+    hpm_stat_t stat;
+
+#if HPM_LVGL_HAS_REMOTE_BACKEND
+    if (backend == HPM_LVGL_SPI_BACKEND_DUALCORE) {
+        ops = &lvgl_backend_remote;
+    }
+#endif
+#if HPM_LVGL_HAS_LEGACY_BACKEND
+    if (backend == HPM_LVGL_SPI_BACKEND_LEGACY) {
+        ops = &lvgl_backend_legacy;
+    }
+#endif
+#if HPM_LVGL_HAS_MIPI_BACKEND
+    if (backend == HPM_LVGL_SPI_BACKEND_DMA_MGR) {
+        ops = &lvgl_backend_mipi;
+    }
+#endif
+    if ((ops == NULL) || (lvgl_ctx.disp == NULL)) {
+        return status_invalid_argument;
+    }
+    if (ops == lvgl_backend) {
+        return status_success;
+    }
+    if (!lvgl_boot.ready) {
+        return status_fail;
+    }
+
+    /* The outgoing backend must not have a transfer on the bus. */
+    lvgl_wait_bus_idle();
+
+    /* Both drivers start from rotation 0; undo any rotation through the outgoing one. */
+    if (lvgl_ctx.rotation != 0U) {
+        lvgl_backend->set_rotation(0);
+        lvgl_ctx.rotation = 0;
+    }
+
+    stat = ops->attach();
+    if (stat != status_success) {
+        /* Hand the bus back so the display keeps working on the previous backend. */
+        (void)lvgl_backend->attach();
+        return stat;
+    }
+
+    lvgl_backend = ops;
+    hpm_lvgl_heatmap_reset();
+    hpm_lvgl_warm_reset();
+    lv_obj_invalidate(lv_display_get_screen_active(lvgl_ctx.disp));
+    return status_success;
+}
+
+hpm_stat_t hpm_lvgl_spi_set_backend(hpm_lvgl_spi_backend_t backend)
+{
+    bool locked = lvgl_api_lock();
+    hpm_stat_t stat = lvgl_set_backend(backend);
+
+    lvgl_api_unlock(locked);
+    return stat;
 }
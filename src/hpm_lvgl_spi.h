@@ -11,6 +11,19 @@
 
 #include "hpm_common.h"
 #include "lvgl.h"
+#include "hpm_lvgl_trace.h"
+#include "hpm_lvgl_spi_capture.h"
+#include "hpm_lvgl_heatmap.h"
+#include "hpm_lvgl_jank.h"
+#include "hpm_lvgl_overlay.h"
+#include "hpm_lvgl_replay.h"
+#include "hpm_lvgl_warm.h"
+#include "hpm_lvgl_mem.h"
+#include "hpm_lvgl_rtos.h"
+#include "hpm_lvgl_dualcore.h"
+#include "hpm_lvgl_draw_dma.h"
+#include "hpm_lvgl_dsp.h"
+#include "hpm_lvgl_l8.h"
 
 /* If using the HPM SDK `components/spi` driver with DMA manager, the SDK will define `USE_DMA_MGR=1`.
  * Provide a safe default for projects that don't enable DMA manager. */
@@ -67,6 +80,64 @@
 #define HPM_LVGL_USE_LVGL_ST7789_DRIVER USE_DMA_MGR
 #endif
 
+/* Backend A/B mode: compile both backends into one image and switch at runtime with
+ * hpm_lvgl_spi_set_backend(). Requires the official backend (USE_DMA_MGR=1); the legacy
+ * st7789.c driver then runs on a channel requested from DMA manager instead of its own ISR.
+ */
+#ifndef HPM_LVGL_BACKEND_AB
+#define HPM_LVGL_BACKEND_AB 0
+#endif
+
+/* Panel bring-up:
+ * - 1: hpm_lvgl_spi_init() returns right after the reset pulse; the init sequence is sent from an
+ *      LVGL timer while the application builds its UI, and the first frame renders once the panel is on.
+ * - 0: hpm_lvgl_spi_init() returns with the panel on (same sequence, polled in place).
+ */
+#ifndef HPM_LVGL_ASYNC_INIT
+#define HPM_LVGL_ASYNC_INIT 1
+#endif
+
+/* Waiting for a draw buffer that is still on the bus (both buffers in flight):
+ * - 1: sleep until the DMA completion interrupt returns it (WFI on bare metal; with LV_USE_OS the
+ *      LVGL task blocks on an lv_thread_sync_t and other tasks run). The time is reported as idle_us.
+ * - 0: LVGL busy-polls the flushing flag.
+ */
+#ifndef HPM_LVGL_FLUSH_WAIT_SLEEP
+#define HPM_LVGL_FLUSH_WAIT_SLEEP 1
+#endif
+
+/* Longest sleep of hpm_lvgl_spi_run_once() when the caller has nothing shorter to wait for
+ * (LVGL's refresh timer normally wakes it much earlier). */
+#ifndef HPM_LVGL_RUN_MAX_SLEEP_MS
+#define HPM_LVGL_RUN_MAX_SLEEP_MS 100
+#endif
+
+/* Hot-path placement for XIP builds, set from CMake (`-DHPM_LVGL_RAMFUNC=<n>`):
+ * - 0: code runs where the build type puts it (XIP flash for flash_xip)
+ * - 1: DMA completion handlers and the flush path run from ILM (`.fast`, about 3 KB)
+ * - 2: also LVGL's `LV_ATTRIBUTE_FAST_MEM` software render kernels and `lv_display_flush_ready()`
+ *      (see lv_conf_ext.h; tens of KB depending on the enabled color formats)
+ */
+#ifndef HPM_LVGL_RAMFUNC
+#define HPM_LVGL_RAMFUNC 0
+#endif
+
+#ifndef HPM_LVGL_HOT_ATTR
+#if (HPM_LVGL_RAMFUNC >= 1) && defined(ATTR_RAMFUNC)
+#define HPM_LVGL_HOT_ATTR ATTR_RAMFUNC
+#elif (HPM_LVGL_RAMFUNC >= 1)
+#define HPM_LVGL_HOT_ATTR __attribute__((section(".fast")))
+#else
+#define HPM_LVGL_HOT_ATTR
+#endif
+#endif
+
+/* Bytes reserved for the recorded lv_st7789 init sequence (official backend); a longer
+ * sequence still works but is sent blocking once the buffer is full. */
+#ifndef HPM_LVGL_INIT_PROG_SIZE
+#define HPM_LVGL_INIT_PROG_SIZE 256
+#endif
+
 /* LVGL ST7789 (generic MIPI) configuration (only used when `HPM_LVGL_USE_LVGL_ST7789_DRIVER == 1`).
  *
  * `HPM_LVGL_LCD_FLAGS` maps to `lv_lcd_flag_t` (e.g. `LV_LCD_FLAG_BGR`, `LV_LCD_FLAG_MIRROR_X`).
@@ -88,19 +159,65 @@
  * - Larger buffer = fewer flush calls, better for scattered updates
  */
 #define HPM_LVGL_PIXEL_SIZE     (LV_COLOR_DEPTH / 8)
+#ifndef HPM_LVGL_FB_LINES
 #define HPM_LVGL_FB_LINES       80      /* 1/4 screen height */
-#define HPM_LVGL_FB_SIZE        (HPM_LVGL_LCD_WIDTH * HPM_LVGL_FB_LINES * HPM_LVGL_PIXEL_SIZE)
+#endif
 
-/* DMA/LVGL draw buffers should be cache-safe. By default we place buffers into
- * a non-cacheable section and align to 64 bytes (HPM6E D-Cache line size).
- *
- * You can override this macro to match your linker script / toolchain.
+/* Bytes per pixel in the draw buffers: RGB565 as sent, or L8 expanded in the flush path
+ * (HPM_LVGL_L8, which halves the buffers or doubles the lines they hold) */
+#if HPM_LVGL_L8
+#define HPM_LVGL_FB_PIXEL_SIZE  1
+#else
+#define HPM_LVGL_FB_PIXEL_SIZE  HPM_LVGL_PIXEL_SIZE
+#endif
+#define HPM_LVGL_FB_SIZE        (HPM_LVGL_LCD_WIDTH * HPM_LVGL_FB_LINES * HPM_LVGL_FB_PIXEL_SIZE)
+
+/* Draw buffer placement:
+ * - 0: non-cacheable section. DMA needs no cache maintenance, but every blend LVGL does is a
+ *      read-modify-write on uncached memory.
+ * - 1: cacheable SRAM, aligned to the D-cache line. Before each DMA only the lines holding the
+ *      flushed pixels are written back.
  */
-#ifndef HPM_LVGL_FB_ATTR
+#ifndef HPM_LVGL_FB_CACHEABLE
+#define HPM_LVGL_FB_CACHEABLE 0
+#endif
+
+/* Placement A/B mode: compile both placements into one image and switch at runtime with
+ * hpm_lvgl_spi_set_fb_cacheable() (render time comparison, see examples/render_benchmark).
+ * Costs a second set of draw buffers.
+ */
+#ifndef HPM_LVGL_FB_PLACEMENT_AB
+#define HPM_LVGL_FB_PLACEMENT_AB 0
+#endif
+
+/* D-cache line size; draw buffers start on a line boundary */
+#if defined(HPM_L1C_CACHELINE_SIZE)
+#define HPM_LVGL_FB_ALIGN HPM_L1C_CACHELINE_SIZE
+#else
+#define HPM_LVGL_FB_ALIGN 64
+#endif
+
+/* Section attributes of the non-cacheable and cacheable draw buffers. Override to match your
+ * linker script / toolchain (e.g. put the cacheable ones in a fast SRAM section).
+ */
+#ifndef HPM_LVGL_FB_NONCACHEABLE_ATTR
 #if defined(ATTR_PLACE_AT_NONCACHEABLE_WITH_ALIGNMENT)
-#define HPM_LVGL_FB_ATTR ATTR_PLACE_AT_NONCACHEABLE_WITH_ALIGNMENT(64)
+#define HPM_LVGL_FB_NONCACHEABLE_ATTR ATTR_PLACE_AT_NONCACHEABLE_WITH_ALIGNMENT(HPM_LVGL_FB_ALIGN)
 #else
-#define HPM_LVGL_FB_ATTR __attribute__((aligned(64), section(".noncacheable")))
+#define HPM_LVGL_FB_NONCACHEABLE_ATTR __attribute__((aligned(HPM_LVGL_FB_ALIGN), section(".noncacheable")))
+#endif
+#endif
+
+#ifndef HPM_LVGL_FB_CACHEABLE_ATTR
+#define HPM_LVGL_FB_CACHEABLE_ATTR __attribute__((aligned(HPM_LVGL_FB_ALIGN)))
+#endif
+
+/* Attribute of the draw buffers LVGL starts with */
+#ifndef HPM_LVGL_FB_ATTR
+#if HPM_LVGL_FB_CACHEABLE
+#define HPM_LVGL_FB_ATTR HPM_LVGL_FB_CACHEABLE_ATTR
+#else
+#define HPM_LVGL_FB_ATTR HPM_LVGL_FB_NONCACHEABLE_ATTR
 #endif
 #endif
 
@@ -116,11 +233,64 @@
  * - Configures ST7789/GC9307 display via SPI
  * - Sets up DMA for async transfers
  * - Configures double buffering
+ *
+ * With `HPM_LVGL_ASYNC_INIT == 1` the panel is still booting on return: build the UI and
+ * run `lv_timer_handler()` as usual, the first frame is sent once the panel is on.
  * 
  * @return lv_display_t* Display object, or NULL on failure
  */
 lv_display_t *hpm_lvgl_spi_init(void);
 
+/**
+ * @brief true once the panel init sequence has completed and rendering is enabled
+ */
+bool hpm_lvgl_spi_is_ready(void);
+
+/* Boot timeline, in microseconds since core reset (0 = not reached yet). */
+typedef struct {
+    bool panel_ready;            /* Panel init sequence completed */
+    bool warm_start;             /* Panel kept across an MCU reset (HPM_LVGL_WARM_RESTART) */
+    uint32_t init_return_us;     /* hpm_lvgl_spi_init() returned */
+    uint32_t splash_us;          /* Splash on screen and backlight on (0 = no splash) */
+    uint32_t panel_ready_us;     /* Display on, rendering enabled */
+    uint32_t first_pixel_us;     /* First flush transferred to the panel */
+} hpm_lvgl_spi_boot_stats_t;
+
+typedef enum {
+    HPM_LVGL_SPLASH_RAW = 0,     /* RGB565 pixels, wire byte order (MSB first), row-major */
+    HPM_LVGL_SPLASH_RLE,         /* Same pixels run-length coded (tools/hpm_lvgl_img2splash.py) */
+} hpm_lvgl_splash_format_t;
+
+/* Boot splash, usually a const table in XIP flash generated by tools/hpm_lvgl_img2splash.py.
+ * Centered on the unrotated panel; the rest of the screen is filled with bg_color. */
+typedef struct {
+    hpm_lvgl_splash_format_t format;
+    uint16_t width;
+    uint16_t height;
+    uint16_t bg_color;           /* RGB565 */
+    uint32_t data_size;          /* Bytes at data */
+    const uint8_t *data;
+} hpm_lvgl_splash_t;
+
+/**
+ * @brief Show a splash image as soon as the panel is configured (call before hpm_lvgl_spi_init())
+ *
+ * hpm_lvgl_spi_init() then brings the panel up in place, streams the image by DMA (straight
+ * from flash for a full-screen RAW image, otherwise decoded band by band into the draw buffers,
+ * no LVGL heap involved) and switches the backlight on before returning. The splash stays on
+ * screen while the application builds its UI; the first LVGL frame draws over it. Not shown
+ * after a warm restart (the panel keeps its picture).
+ *
+ * @param splash Splash image (must stay valid until hpm_lvgl_spi_init() returns), NULL to disable
+ */
+void hpm_lvgl_spi_set_splash(const hpm_lvgl_splash_t *splash);
+
+/**
+ * @brief Get boot-to-first-pixel timing
+ * @param out Output stats (must not be NULL)
+ */
+void hpm_lvgl_spi_get_boot_stats(hpm_lvgl_spi_boot_stats_t *out);
+
 /**
  * @brief Get the LVGL display object
  * @return lv_display_t* Display object
@@ -140,6 +310,17 @@ void hpm_lvgl_spi_tick_inc(uint32_t ms);
  */
 uint32_t hpm_lvgl_spi_tick_get(void);
 
+/**
+ * @brief Run LVGL timers, then sleep until the next one is due
+ * @param max_sleep_ms Upper bound for the sleep, e.g. the application's input polling period
+ * @return Time slept in ms (0 when a timer is already due or a recorded journey is replayed)
+ * @note Replaces `lv_timer_handler(); board_delay_us(1000);` in a bare-metal super loop. The core
+ *       sleeps in WFI until an MCHTMR compare match at the deadline or any enabled interrupt
+ *       (DMA completion, GPIO, UART) wakes it. Owns the MCHTMR compare register; with LV_USE_OS
+ *       it sleeps with lv_sleep_ms() instead.
+ */
+uint32_t hpm_lvgl_spi_run_once(uint32_t max_sleep_ms);
+
 /**
  * @brief Set display backlight
  * @param on true to turn on
@@ -173,6 +354,26 @@ typedef struct {
     uint64_t flush_bytes;        /* Total bytes requested to flush */
     lv_area_t last_flush_area;   /* Last flushed area (LVGL coordinates) */
     uint32_t last_flush_tick;    /* Tick (ms) when last flush started */
+    uint32_t refresh_count;      /* LVGL refresh cycles completed */
+    uint32_t frames_rendered;    /* Refresh cycles that flushed at least one area */
+    uint64_t frame_us;           /* Duration (REFR_START -> REFR_READY) of those cycles */
+    uint64_t render_us;          /* Time inside refresh cycles, excluding waits for a free draw buffer */
+    uint64_t xfer_us;            /* Time draw buffers were owned by the SPI side (flush -> flush_ready) */
+    uint64_t wait_us;            /* Time LVGL was blocked waiting for a draw buffer to come back from DMA */
+    uint8_t overlap_pct;         /* Share of xfer_us that LVGL spent rendering instead of in wait_us */
+    uint64_t idle_us;            /* Part of wait_us spent asleep in WFI (or blocked, with an RTOS) */
+    uint32_t sleep_count;        /* Sleeps taken in the flush wait */
+    uint64_t loop_sleep_us;      /* Time hpm_lvgl_spi_run_once() slept until the next LVGL timer */
+    uint8_t cpu_idle_pct;        /* idle_us + loop_sleep_us relative to the time since the last reset */
+    uint64_t flush_cpu_us;       /* CPU time inside the flush callback (window, command, cache, DMA setup) */
+    uint32_t isr_count;          /* DMA completion handlers run */
+    uint64_t isr_us;             /* CPU time inside those handlers (includes the wait for the SPI shifter) */
+    uint32_t isr_max_us;         /* Longest single handler (jitter from code fetch shows up here) */
+    uint32_t heap_total;         /* LVGL heap (lv_mem_monitor(), sampled when the stats are read) */
+    uint32_t heap_used;
+    uint32_t heap_peak;          /* High-water mark since boot (not cleared by reset_stats) */
+    uint32_t heap_largest_free;  /* Largest block lv_malloc() can still return */
+    uint8_t heap_frag_pct;       /* 100 - largest free * 100 / free */
 } hpm_lvgl_spi_stats_t;
 
 /**
@@ -186,4 +387,79 @@ void hpm_lvgl_spi_reset_stats(void);
  */
 void hpm_lvgl_spi_get_stats(hpm_lvgl_spi_stats_t *out);
 
+/*============================================================================
+ * Runtime configuration (benchmarking)
+ *============================================================================*/
+
+/**
+ * @brief Change draw buffer height and single/double buffering at runtime
+ *
+ * Waits for a pending flush, re-assigns the LVGL draw buffers and invalidates the screen.
+ * Call from the LVGL thread (between `lv_timer_handler()` calls).
+ *
+ * @param lines Buffer height in panel lines (1..HPM_LVGL_FB_LINES, unrotated panel width)
+ * @param double_buffer Use two buffers (only possible when `HPM_LVGL_USE_DOUBLE_BUFFER == 1`)
+ * @return status_success, or status_invalid_argument
+ */
+hpm_stat_t hpm_lvgl_spi_set_buffer_config(uint32_t lines, bool double_buffer);
+
+/**
+ * @brief Get the current draw buffer configuration
+ */
+void hpm_lvgl_spi_get_buffer_config(uint32_t *lines, bool *double_buffer);
+
+/**
+ * @brief Change the SPI clock at runtime (waits for a pending flush)
+ * @param freq_hz Requested SCLK frequency; the SPI divider may round it down
+ * @return status_success on success
+ */
+hpm_stat_t hpm_lvgl_spi_set_spi_freq(uint32_t freq_hz);
+
+/**
+ * @brief Get the last requested SPI clock
+ */
+uint32_t hpm_lvgl_spi_get_spi_freq(void);
+
+typedef enum {
+    HPM_LVGL_SPI_BACKEND_LEGACY = 0,    /* st7789.c DMAv2 driver */
+    HPM_LVGL_SPI_BACKEND_DMA_MGR,       /* LVGL lv_st7789 + hpm_spi + dma_mgr */
+    HPM_LVGL_SPI_BACKEND_DUALCORE,      /* st7789.c on core 1 (HPM_LVGL_DUALCORE == 1) */
+} hpm_lvgl_spi_backend_t;
+
+/**
+ * @brief Name of the active backend ("dma_mgr", "legacy" or "dualcore")
+ */
+const char *hpm_lvgl_spi_get_backend_name(void);
+
+/**
+ * @brief Get the active backend
+ */
+hpm_lvgl_spi_backend_t hpm_lvgl_spi_get_backend(void);
+
+/**
+ * @brief Switch the display backend at runtime (`HPM_LVGL_BACKEND_AB == 1`)
+ *
+ * Waits for a pending flush, hands SPI/DMA to the other driver, brings the panel to that
+ * driver's state (the legacy driver resets and re-initializes it), resets the rotation to 0
+ * and invalidates the screen. Call from the LVGL thread (between `lv_timer_handler()` calls).
+ *
+ * @return status_success, or status_invalid_argument if the backend is not compiled in
+ */
+hpm_stat_t hpm_lvgl_spi_set_backend(hpm_lvgl_spi_backend_t backend);
+
+/**
+ * @brief Move LVGL to the cacheable or the non-cacheable draw buffers (`HPM_LVGL_FB_PLACEMENT_AB == 1`)
+ *
+ * Waits for a pending flush, keeps the current line count / double buffering and invalidates
+ * the screen. Call from the LVGL thread (between `lv_timer_handler()` calls).
+ *
+ * @return status_success, or status_invalid_argument if placement A/B is not compiled in
+ */
+hpm_stat_t hpm_lvgl_spi_set_fb_cacheable(bool cacheable);
+
+/**
+ * @brief true if LVGL renders into cacheable draw buffers
+ */
+bool hpm_lvgl_spi_get_fb_cacheable(void);
+
 #endif /* HPM_LVGL_SPI_H */
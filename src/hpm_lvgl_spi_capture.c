@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Wire-level SPI transaction capture implementation
+ */
+
+#include "hpm_lvgl_spi_capture.h"
+
+#if HPM_LVGL_SPI_CAPTURE_ENABLE
+
+#include "hpm_common.h"
+#include "hpm_clock_drv.h"
+#include "hpm_csr_drv.h"
+#include "hpm_interrupt.h"
+#include <stdio.h>
+#include <string.h>
+
+/*============================================================================
+ * Private data
+ *============================================================================*/
+
+static struct {
+    hpm_lvgl_spi_cap_entry_t ring[HPM_LVGL_SPI_CAPTURE_DEPTH];
+    volatile uint32_t head;     /* total entries written (wraps) */
+    volatile bool enabled;
+    volatile bool cs_asserted;  /* last GPIO CS level seen */
+} cap_ctx;
+
+static void cap_append(uint8_t kind, uint8_t flags, uint64_t cycle, uint32_t len, uint32_t dur,
+                       const void *data)
+{
+    if (!cap_ctx.enabled) {
+        return;
+    }
+
+    uint32_t level = disable_global_irq(CSR_MSTATUS_MIE_MASK);
+    hpm_lvgl_spi_cap_entry_t *e = &cap_ctx.ring[cap_ctx.head & (HPM_LVGL_SPI_CAPTURE_DEPTH - 1U)];
+    e->cycle = cycle;
+    e->len = len;
+    e->dur = dur;
+    e->kind = kind;
+    e->flags = flags | (cap_ctx.cs_asserted ? HPM_LVGL_SPI_CAP_FLAG_CS : 0U);
+    memset(e->data, 0, sizeof(e->data) + sizeof(e->reserved));
+    if (data != NULL) {
+        memcpy(e->data, data, (len < sizeof(e->data)) ? len : sizeof(e->data));
+    }
+    cap_ctx.head++;
+    restore_global_irq(level);
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+void hpm_lvgl_spi_capture_init(void)
+{
+    uint32_t level = disable_global_irq(CSR_MSTATUS_MIE_MASK);
+    memset(&cap_ctx, 0, sizeof(cap_ctx));
+    cap_ctx.enabled = true;
+    restore_global_irq(level);
+}
+
+void hpm_lvgl_spi_capture_enable(bool enable)
+{
+    cap_ctx.enabled = enable;
+}
+
+uint64_t hpm_lvgl_spi_capture_now(void)
+{
+    return hpm_csr_get_core_cycle();
+}
+
+void hpm_lvgl_spi_capture_write(bool dc, const void *data, uint32_t len, uint64_t start, bool hw_cs)
+{
+    uint64_t now = hpm_csr_get_core_cycle();
+    uint8_t flags = (dc ? HPM_LVGL_SPI_CAP_FLAG_DC : 0U) | (hw_cs ? HPM_LVGL_SPI_CAP_FLAG_HW_CS : 0U);
+
+    cap_append(HPM_LVGL_SPI_CAP_WRITE, flags, start, len, (uint32_t)(now - start), data);
+}
+
+void hpm_lvgl_spi_capture_dma_start(uint32_t len, bool hw_cs)
+{
+    uint8_t flags = HPM_LVGL_SPI_CAP_FLAG_DC | (hw_cs ? HPM_LVGL_SPI_CAP_FLAG_HW_CS : 0U);
+
+    cap_append(HPM_LVGL_SPI_CAP_DMA_START, flags, hpm_csr_get_core_cycle(), len, 0, NULL);
+}
+
+void hpm_lvgl_spi_capture_dma_done(void)
+{
+    cap_append(HPM_LVGL_SPI_CAP_DMA_DONE, HPM_LVGL_SPI_CAP_FLAG_DC, hpm_csr_get_core_cycle(), 0, 0, NULL);
+}
+
+void hpm_lvgl_spi_capture_cs(bool asserted)
+{
+    cap_ctx.cs_asserted = asserted;
+    cap_append(HPM_LVGL_SPI_CAP_CS, 0, hpm_csr_get_core_cycle(), 0, 0, NULL);
+}
+
+void hpm_lvgl_spi_capture_dump(uint32_t spi_hz)
+{
+    bool was_enabled = cap_ctx.enabled;
+    cap_ctx.enabled = false;
+
+    uint32_t head = cap_ctx.head;
+    uint32_t count = (head < HPM_LVGL_SPI_CAPTURE_DEPTH) ? head : HPM_LVGL_SPI_CAPTURE_DEPTH;
+    uint32_t first = head - count;
+
+    /* Line format is parsed by tools/hpm_lvgl_spi_analyze.py; keep it stable. */
+    printf("# hpm_lvgl_spi_capture v1 cpu_hz=%lu spi_hz=%lu entries=%lu dropped=%lu\n",
+           (unsigned long)clock_get_frequency(clock_cpu0),
+           (unsigned long)spi_hz,
+           (unsigned long)count,
+           (unsigned long)(head - count));
+
+    for (uint32_t i = 0; i < count; i++) {
+        const hpm_lvgl_spi_cap_entry_t *e = &cap_ctx.ring[(first + i) & (HPM_LVGL_SPI_CAPTURE_DEPTH - 1U)];
+        printf("S %08lx%08lx %u %x %lu %lu %02x%02x%02x%02x\n",
+               (unsigned long)(e->cycle >> 32),
+               (unsigned long)(e->cycle & 0xFFFFFFFFUL),
+               (unsigned int)e->kind,
+               (unsigned int)e->flags,
+               (unsigned long)e->len,
+               (unsigned long)e->dur,
+               e->data[0], e->data[1], e->data[2], e->data[3]);
+    }
+
+    printf("# hpm_lvgl_spi_capture end\n");
+
+    cap_ctx.enabled = was_enabled;
+}
+
+#endif /* HPM_LVGL_SPI_CAPTURE_ENABLE */
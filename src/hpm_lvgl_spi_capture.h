@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Wire-level SPI transaction capture for ST7789/GC9307
+ *
+ * Every LCD bus transaction (D/C level, CS edges, byte count, first payload bytes,
+ * cycle timestamps) is appended to a RAM ring. `hpm_lvgl_spi_capture_dump()` prints it
+ * over the console UART; `tools/hpm_lvgl_spi_analyze.py` replays the log through an
+ * ST7789 command model (per-flush overhead, redundant windows, gaps, FPS ceiling).
+ */
+
+#ifndef HPM_LVGL_SPI_CAPTURE_H
+#define HPM_LVGL_SPI_CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+/* Disabled by default: every hook below compiles to nothing. */
+#ifndef HPM_LVGL_SPI_CAPTURE_ENABLE
+#define HPM_LVGL_SPI_CAPTURE_ENABLE 0
+#endif
+
+/* Number of transactions kept in RAM (power of two, 24 bytes each). Oldest entries are overwritten. */
+#ifndef HPM_LVGL_SPI_CAPTURE_DEPTH
+#define HPM_LVGL_SPI_CAPTURE_DEPTH  2048
+#endif
+
+#if HPM_LVGL_SPI_CAPTURE_ENABLE && ((HPM_LVGL_SPI_CAPTURE_DEPTH & (HPM_LVGL_SPI_CAPTURE_DEPTH - 1)) != 0)
+#error "HPM_LVGL_SPI_CAPTURE_DEPTH must be a power of two."
+#endif
+
+/* Payload bytes kept per transaction (enough for CASET/RASET parameters). */
+#define HPM_LVGL_SPI_CAPTURE_DATA_BYTES 4
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+/* Kinds are part of the dump format; append only. */
+typedef enum {
+    HPM_LVGL_SPI_CAP_WRITE     = 1, /* blocking write; dur = cycles until bus idle */
+    HPM_LVGL_SPI_CAP_DMA_START = 2, /* pixel DMA started; len = bytes */
+    HPM_LVGL_SPI_CAP_DMA_DONE  = 3, /* pixel DMA finished and shifter drained */
+    HPM_LVGL_SPI_CAP_CS        = 4, /* GPIO CS edge; flags bit1 = new level (asserted) */
+} hpm_lvgl_spi_cap_kind_t;
+
+/* Flags */
+#define HPM_LVGL_SPI_CAP_FLAG_DC        (1U << 0)   /* D/C high (data) */
+#define HPM_LVGL_SPI_CAP_FLAG_CS        (1U << 1)   /* CS asserted during/after this entry */
+#define HPM_LVGL_SPI_CAP_FLAG_HW_CS     (1U << 2)   /* CS driven by the SPI controller per transfer */
+
+typedef struct {
+    uint64_t cycle;     /* CPU cycle counter at transaction start */
+    uint32_t len;       /* bytes on the wire */
+    uint32_t dur;       /* cycles from start to bus idle (blocking writes only) */
+    uint8_t kind;       /* hpm_lvgl_spi_cap_kind_t */
+    uint8_t flags;
+    uint8_t data[HPM_LVGL_SPI_CAPTURE_DATA_BYTES];
+    uint8_t reserved[2];
+} hpm_lvgl_spi_cap_entry_t;
+
+/*============================================================================
+ * API Functions
+ *============================================================================*/
+
+#if HPM_LVGL_SPI_CAPTURE_ENABLE
+
+/**
+ * @brief Clear the ring and start capturing
+ */
+void hpm_lvgl_spi_capture_init(void);
+
+/**
+ * @brief Pause/resume capturing (the ring content is kept)
+ */
+void hpm_lvgl_spi_capture_enable(bool enable);
+
+/**
+ * @brief Timestamp to pass as `start` to `hpm_lvgl_spi_capture_write()`
+ */
+uint64_t hpm_lvgl_spi_capture_now(void);
+
+/**
+ * @brief Record a completed blocking write
+ * @param dc true if D/C was high (data), false for a command byte
+ * @param data Payload (first bytes are kept), may be NULL
+ * @param len Byte count
+ * @param start Value of `hpm_lvgl_spi_capture_now()` before the transfer started
+ * @param hw_cs true if CS is driven by the SPI controller
+ */
+void hpm_lvgl_spi_capture_write(bool dc, const void *data, uint32_t len, uint64_t start, bool hw_cs);
+
+/**
+ * @brief Record the start of a pixel DMA transfer (D/C high)
+ */
+void hpm_lvgl_spi_capture_dma_start(uint32_t len, bool hw_cs);
+
+/**
+ * @brief Record the end of a pixel DMA transfer (safe to call from ISR)
+ */
+void hpm_lvgl_spi_capture_dma_done(void);
+
+/**
+ * @brief Record a GPIO chip-select edge
+ */
+void hpm_lvgl_spi_capture_cs(bool asserted);
+
+/**
+ * @brief Print the ring over the console UART (printf)
+ * @param spi_hz SPI clock, recorded in the header for the offline analyzer
+ */
+void hpm_lvgl_spi_capture_dump(uint32_t spi_hz);
+
+#else
+
+static inline void hpm_lvgl_spi_capture_init(void) {}
+static inline void hpm_lvgl_spi_capture_enable(bool enable) { (void)enable; }
+static inline uint64_t hpm_lvgl_spi_capture_now(void) { return 0; }
+static inline void hpm_lvgl_spi_capture_write(bool dc, const void *data, uint32_t len, uint64_t start, bool hw_cs)
+{
+    (void)dc;
+    (void)data;
+    (void)len;
+    (void)start;
+    (void)hw_cs;
+}
+static inline void hpm_lvgl_spi_capture_dma_start(uint32_t len, bool hw_cs)
+{
+    (void)len;
+    (void)hw_cs;
+}
+static inline void hpm_lvgl_spi_capture_dma_done(void) {}
+static inline void hpm_lvgl_spi_capture_cs(bool asserted) { (void)asserted; }
+static inline void hpm_lvgl_spi_capture_dump(uint32_t spi_hz) { (void)spi_hz; }
+
+#endif /* HPM_LVGL_SPI_CAPTURE_ENABLE */
+
+#endif /* HPM_LVGL_SPI_CAPTURE_H */
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Event trace ring implementation
+ */
+
+#include "hpm_lvgl_trace.h"
+
+#if HPM_LVGL_TRACE_ENABLE
+
+#include "hpm_common.h"
+#include "hpm_clock_drv.h"
+#include "hpm_csr_drv.h"
+#include "hpm_interrupt.h"
+#include <stdio.h>
+#include <string.h>
+
+/*============================================================================
+ * Private data
+ *============================================================================*/
+
+static struct {
+    hpm_lvgl_trace_record_t ring[HPM_LVGL_TRACE_DEPTH];
+    volatile uint32_t head;     /* total records written (wraps) */
+    volatile bool enabled;
+} trace_ctx;
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+void hpm_lvgl_trace_init(void)
+{
+    uint32_t level = disable_global_irq(CSR_MSTATUS_MIE_MASK);
+    memset(&trace_ctx, 0, sizeof(trace_ctx));
+    trace_ctx.enabled = true;
+    restore_global_irq(level);
+}
+
+void hpm_lvgl_trace_enable(bool enable)
+{
+    trace_ctx.enabled = enable;
+}
+
+void hpm_lvgl_trace_record(hpm_lvgl_trace_event_t event, uint16_t arg16, uint32_t arg)
+{
+    if (!trace_ctx.enabled) {
+        return;
+    }
+
+    /* Keep the slot claim and fill atomic so a nested ISR record cannot interleave. */
+    uint32_t level = disable_global_irq(CSR_MSTATUS_MIE_MASK);
+    hpm_lvgl_trace_record_t *rec = &trace_ctx.ring[trace_ctx.head & (HPM_LVGL_TRACE_DEPTH - 1U)];
+    rec->cycle = hpm_csr_get_core_cycle();
+    rec->event = (uint8_t)event;
+    rec->reserved = 0;
+    rec->arg16 = arg16;
+    rec->arg = arg;
+    trace_ctx.head++;
+    restore_global_irq(level);
+}
+
+void hpm_lvgl_trace_dump(void)
+{
+    bool was_enabled = trace_ctx.enabled;
+    trace_ctx.enabled = false;
+
+    uint32_t head = trace_ctx.head;
+    uint32_t count = (head < HPM_LVGL_TRACE_DEPTH) ? head : HPM_LVGL_TRACE_DEPTH;
+    uint32_t first = head - count;
+
+    /* Line format is parsed by tools/hpm_lvgl_trace2json.py; keep it stable. */
+    printf("# hpm_lvgl_trace v1 cpu_hz=%lu records=%lu dropped=%lu\n",
+           (unsigned long)clock_get_frequency(clock_cpu0),
+           (unsigned long)count,
+           (unsigned long)(head - count));
+
+    for (uint32_t i = 0; i < count; i++) {
+        const hpm_lvgl_trace_record_t *rec = &trace_ctx.ring[(first + i) & (HPM_LVGL_TRACE_DEPTH - 1U)];
+        printf("T %08lx%08lx %u %u %lx\n",
+               (unsigned long)(rec->cycle >> 32),
+               (unsigned long)(rec->cycle & 0xFFFFFFFFUL),
+               (unsigned int)rec->event,
+               (unsigned int)rec->arg16,
+               (unsigned long)rec->arg);
+    }
+
+    printf("# hpm_lvgl_trace end\n");
+
+    trace_ctx.enabled = was_enabled;
+}
+
+#endif /* HPM_LVGL_TRACE_ENABLE */
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Event trace ring for the LVGL SPI display adapter
+ *
+ * Records flush/DMA/refresh/input events with CPU cycle timestamps into a RAM ring.
+ * `hpm_lvgl_trace_dump()` prints the ring over the console UART; convert the log to
+ * Chrome/Perfetto trace JSON with `tools/hpm_lvgl_trace2json.py`.
+ */
+
+#ifndef HPM_LVGL_TRACE_H
+#define HPM_LVGL_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+/* Disabled by default: every hook below compiles to nothing. */
+#ifndef HPM_LVGL_TRACE_ENABLE
+#define HPM_LVGL_TRACE_ENABLE   0
+#endif
+
+/* Number of records kept in RAM (power of two, 16 bytes each). Oldest records are overwritten. */
+#ifndef HPM_LVGL_TRACE_DEPTH
+#define HPM_LVGL_TRACE_DEPTH    1024
+#endif
+
+#if HPM_LVGL_TRACE_ENABLE && ((HPM_LVGL_TRACE_DEPTH & (HPM_LVGL_TRACE_DEPTH - 1)) != 0)
+#error "HPM_LVGL_TRACE_DEPTH must be a power of two."
+#endif
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+/* Event IDs are part of the dump format; append only. */
+typedef enum {
+    HPM_LVGL_TRACE_FLUSH_START = 1, /* arg16: flush seq, arg: pixel bytes */
+    HPM_LVGL_TRACE_FLUSH_END   = 2, /* arg16: flush seq (lv_display_flush_ready) */
+    HPM_LVGL_TRACE_DMA_TC      = 3, /* arg16: flush seq */
+    HPM_LVGL_TRACE_SPI_IDLE    = 4, /* arg16: flush seq (shifter drained, CS released) */
+    HPM_LVGL_TRACE_REFR_START  = 5, /* LVGL refresh cycle started */
+    HPM_LVGL_TRACE_REFR_READY  = 6, /* LVGL refresh cycle finished */
+    HPM_LVGL_TRACE_INPUT       = 7, /* arg16: key/input code, arg: 1 pressed / 0 released */
+    HPM_LVGL_TRACE_MARKER      = 8, /* arg16: user marker ID, arg: user value */
+} hpm_lvgl_trace_event_t;
+
+typedef struct {
+    uint64_t cycle;     /* CPU cycle counter (mcycle) */
+    uint8_t event;      /* hpm_lvgl_trace_event_t */
+    uint8_t reserved;
+    uint16_t arg16;
+    uint32_t arg;
+} hpm_lvgl_trace_record_t;
+
+/*============================================================================
+ * API Functions
+ *============================================================================*/
+
+#if HPM_LVGL_TRACE_ENABLE
+
+/**
+ * @brief Clear the ring and start recording
+ * @note Called by `hpm_lvgl_spi_init()`.
+ */
+void hpm_lvgl_trace_init(void);
+
+/**
+ * @brief Pause/resume recording (the ring content is kept)
+ */
+void hpm_lvgl_trace_enable(bool enable);
+
+/**
+ * @brief Append one record (safe to call from ISR)
+ */
+void hpm_lvgl_trace_record(hpm_lvgl_trace_event_t event, uint16_t arg16, uint32_t arg);
+
+/**
+ * @brief Print the ring over the console UART (printf)
+ *
+ * Recording is paused while dumping and resumed afterwards.
+ */
+void hpm_lvgl_trace_dump(void);
+
+#else
+
+static inline void hpm_lvgl_trace_init(void) {}
+static inline void hpm_lvgl_trace_enable(bool enable) { (void)enable; }
+static inline void hpm_lvgl_trace_record(hpm_lvgl_trace_event_t event, uint16_t arg16, uint32_t arg)
+{
+    (void)event;
+    (void)arg16;
+    (void)arg;
+}
+static inline void hpm_lvgl_trace_dump(void) {}
+
+#endif /* HPM_LVGL_TRACE_ENABLE */
+
+/**
+ * @brief Record a user marker (shown as an instant event on the timeline)
+ */
+static inline void hpm_lvgl_trace_marker(uint16_t id, uint32_t value)
+{
+    hpm_lvgl_trace_record(HPM_LVGL_TRACE_MARKER, id, value);
+}
+
+/**
+ * @brief Record an input event (e.g. a key press)
+ */
+static inline void hpm_lvgl_trace_input(uint16_t code, bool pressed)
+{
+    hpm_lvgl_trace_record(HPM_LVGL_TRACE_INPUT, code, pressed ? 1U : 0U);
+}
+
+#endif /* HPM_LVGL_TRACE_H */
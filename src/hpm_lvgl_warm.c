@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Warm restart implementation
+ */
+
+#include "hpm_lvgl_warm.h"
+
+#if HPM_LVGL_WARM_RESTART
+
+#include "hpm_lvgl_spi.h"
+#include <stddef.h>
+#include <string.h>
+
+/* Same tile count in either orientation. */
+#define WARM_TILES_X        ((HPM_LVGL_LCD_WIDTH + HPM_LVGL_WARM_TILE - 1) >> HPM_LVGL_WARM_TILE_SHIFT)
+#define WARM_TILES_Y        ((HPM_LVGL_LCD_HEIGHT + HPM_LVGL_WARM_TILE - 1) >> HPM_LVGL_WARM_TILE_SHIFT)
+#define WARM_MAX_TILES      (WARM_TILES_X * WARM_TILES_Y)
+
+#define WARM_MAGIC          0x57524D31UL    /* "WRM1" */
+
+/* RDDST: sleep out, normal mode, display on; idle and partial mode off; 16-bit interface format */
+#define RDDST_SLPOUT        (1UL << 17)
+#define RDDST_NORON         (1UL << 16)
+#define RDDST_DISON         (1UL << 10)
+#define RDDST_IDMON         (1UL << 19)
+#define RDDST_PTLON         (1UL << 18)
+#define RDDST_IFPF_SHIFT    20
+#define RDDST_IFPF_MASK     (7UL << RDDST_IFPF_SHIFT)
+#define RDDST_IFPF_16BIT    (5UL << RDDST_IFPF_SHIFT)
+
+/*============================================================================
+ * Private data
+ *============================================================================*/
+
+/* Survives MCU resets; tile[] holds the hash of what the panel shows, 0 = unknown. */
+typedef struct {
+    uint32_t magic;
+    uint32_t panel_id;
+    uint16_t width;
+    uint16_t height;
+    uint16_t rotation;          /* lv_display_rotation_t the tiles were hashed in */
+    uint16_t reserved;
+    uint32_t tile[WARM_MAX_TILES];
+    uint32_t check;             /* XOR of every word above */
+} warm_record_t;
+
+static warm_record_t HPM_LVGL_WARM_ATTR warm_rec;
+
+static struct {
+    lv_display_t *disp;
+    bool warm;
+    bool filter;                /* First frame of a warm start: only send changed tiles */
+    bool flush_seen;
+    uint16_t tiles_x;
+    uint16_t tiles_y;
+    int32_t hor_res;
+    int32_t ver_res;
+
+    /* Hashes of the flush in flight, committed when it reaches the panel */
+    volatile bool pending;
+    uint16_t ptx1, ptx2, pty1, pty2;
+    uint32_t pending_hash[WARM_MAX_TILES];
+
+    hpm_lvgl_warm_stats_t stats;
+} warm_ctx;
+
+/*============================================================================
+ * Record
+ *============================================================================*/
+
+static uint32_t warm_record_sum(void)
+{
+    const uint32_t *w = (const uint32_t *)&warm_rec;
+    uint32_t sum = 0;
+
+    for (uint32_t i = 0; i < (offsetof(warm_record_t, check) / sizeof(uint32_t)); i++) {
+        sum ^= w[i];
+    }
+    return sum;
+}
+
+static inline void warm_set_tile(uint32_t idx, uint32_t hash)
+{
+    warm_rec.check ^= warm_rec.tile[idx] ^ hash;
+    warm_rec.tile[idx] = hash;
+}
+
+static void warm_record_clear(uint16_t rotation)
+{
+    memset(warm_rec.tile, 0, sizeof(warm_rec.tile));
+    warm_rec.rotation = rotation;
+    warm_rec.check = warm_record_sum();
+}
+
+/* Tiles are kept in LVGL coordinates: a rotation change makes all of them unknown. */
+static void warm_sync_rotation(void)
+{
+    uint16_t rotation = (uint16_t)lv_display_get_rotation(warm_ctx.disp);
+
+    warm_ctx.hor_res = lv_display_get_horizontal_resolution(warm_ctx.disp);
+    warm_ctx.ver_res = lv_display_get_vertical_resolution(warm_ctx.disp);
+    warm_ctx.tiles_x = (uint16_t)((warm_ctx.hor_res + HPM_LVGL_WARM_TILE - 1) >> HPM_LVGL_WARM_TILE_SHIFT);
+    warm_ctx.tiles_y = (uint16_t)((warm_ctx.ver_res + HPM_LVGL_WARM_TILE - 1) >> HPM_LVGL_WARM_TILE_SHIFT);
+
+    if (rotation != warm_rec.rotation) {
+        warm_record_clear(rotation);
+    }
+}
+
+/*============================================================================
+ * Tiles
+ *============================================================================*/
+
+static void warm_tile_area(uint16_t tx, uint16_t ty, lv_area_t *out)
+{
+    out->x1 = (int32_t)tx << HPM_LVGL_WARM_TILE_SHIFT;
+    out->y1 = (int32_t)ty << HPM_LVGL_WARM_TILE_SHIFT;
+    out->x2 = LV_MIN(out->x1 + HPM_LVGL_WARM_TILE - 1, warm_ctx.hor_res - 1);
+    out->y2 = LV_MIN(out->y1 + HPM_LVGL_WARM_TILE - 1, warm_ctx.ver_res - 1);
+}
+
+/* FNV-1a over the tile's pixels; never 0 (reserved for "unknown") */
+static uint32_t warm_hash(const lv_area_t *area, const uint8_t *px_map, const lv_area_t *tile)
+{
+    int32_t stride = lv_area_get_width(area);
+    int32_t w = lv_area_get_width(tile);
+    uint32_t h = 2166136261UL;
+
+    for (int32_t y = tile->y1; y <= tile->y2; y++) {
+        const uint16_t *row = (const uint16_t *)px_map + ((y - area->y1) * stride) + (tile->x1 - area->x1);
+        for (int32_t i = 0; i < w; i++) {
+            h = (h ^ row[i]) * 16777619UL;
+        }
+    }
+    return (h != 0U) ? h : 1U;
+}
+
+/* Move the rows of sub (inside area) to the start of px_map as a packed sub-image. */
+static void warm_compact(const lv_area_t *area, uint8_t *px_map, const lv_area_t *sub)
+{
+    int32_t stride = lv_area_get_width(area) * 2;
+    int32_t row_bytes = lv_area_get_width(sub) * 2;
+    uint8_t *dst = px_map;
+
+    for (int32_t y = sub->y1; y <= sub->y2; y++) {
+        memmove(dst, px_map + ((y - area->y1) * stride) + ((sub->x1 - area->x1) * 2), (size_t)row_bytes);
+        dst += row_bytes;
+    }
+}
+
+static bool warm_tile_range(const lv_area_t *area, uint16_t *tx1, uint16_t *tx2, uint16_t *ty1, uint16_t *ty2)
+{
+    lv_area_t screen;
+    lv_area_t a;
+
+    lv_area_set(&screen, 0, 0, warm_ctx.hor_res - 1, warm_ctx.ver_res - 1);
+    if (!lv_area_intersect(&a, area, &screen)) {
+        return false;
+    }
+    *tx1 = (uint16_t)(a.x1 >> HPM_LVGL_WARM_TILE_SHIFT);
+    *tx2 = (uint16_t)(a.x2 >> HPM_LVGL_WARM_TILE_SHIFT);
+    *ty1 = (uint16_t)(a.y1 >> HPM_LVGL_WARM_TILE_SHIFT);
+    *ty2 = (uint16_t)(a.y2 >> HPM_LVGL_WARM_TILE_SHIFT);
+    return true;
+}
+
+/*============================================================================
+ * Public API
+ *============================================================================*/
+
+bool hpm_lvgl_warm_probe(uint32_t panel_id, uint32_t panel_status)
+{
+    uint32_t required = RDDST_SLPOUT | RDDST_NORON | RDDST_DISON | RDDST_IFPF_16BIT;
+    uint32_t mask = required | RDDST_IDMON | RDDST_PTLON | RDDST_IFPF_MASK;
+
+    memset(&warm_ctx, 0, sizeof(warm_ctx));
+    warm_ctx.stats.panel_id = panel_id;
+    warm_ctx.stats.panel_status = panel_status;
+
+    /* A bus without MISO reads all zeros or all ones */
+    if ((panel_id == 0U) || (panel_id == 0xFFFFFFU)) {
+        return false;
+    }
+
+    warm_ctx.warm = (warm_rec.magic == WARM_MAGIC) && (warm_rec.check == warm_record_sum()) &&
+                    (warm_rec.panel_id == panel_id) && (warm_rec.width == HPM_LVGL_LCD_WIDTH) &&
+                    (warm_rec.height == HPM_LVGL_LCD_HEIGHT) && ((panel_status & mask) == required);
+    return warm_ctx.warm;
+}
+
+void hpm_lvgl_warm_init(lv_display_t *disp)
+{
+    warm_ctx.disp = disp;
+    warm_ctx.stats.warm_start = warm_ctx.warm;
+
+    if (warm_ctx.warm) {
+        warm_ctx.filter = true;
+        warm_sync_rotation();
+        return;
+    }
+
+    warm_rec.magic = WARM_MAGIC;
+    warm_rec.panel_id = warm_ctx.stats.panel_id;
+    warm_rec.width = HPM_LVGL_LCD_WIDTH;
+    warm_rec.height = HPM_LVGL_LCD_HEIGHT;
+    warm_rec.reserved = 0;
+    warm_record_clear((uint16_t)lv_display_get_rotation(disp));
+    warm_sync_rotation();
+}
+
+bool hpm_lvgl_warm_flush_begin(lv_area_t *area, uint8_t *px_map)
+{
+    uint16_t tx1, tx2, ty1, ty2;
+    lv_area_t send;
+    bool any = false;
+
+    if (warm_ctx.disp == NULL) {
+        return true;
+    }
+
+    warm_sync_rotation();
+    warm_ctx.flush_seen = true;
+    if (!warm_tile_range(area, &tx1, &tx2, &ty1, &ty2)) {
+        return true;
+    }
+
+    for (uint16_t ty = ty1; ty <= ty2; ty++) {
+        for (uint16_t tx = tx1; tx <= tx2; tx++) {
+            uint32_t idx = ((uint32_t)ty * warm_ctx.tiles_x) + tx;
+            lv_area_t tile;
+            lv_area_t part;
+            uint32_t hash = 0;
+
+            warm_tile_area(tx, ty, &tile);
+            if (lv_area_is_in(&tile, area, 0)) {
+                hash = warm_hash(area, px_map, &tile);
+            }
+            warm_ctx.pending_hash[idx] = hash;
+
+            /* Tiles only partly in this flush, and changed ones, have to go out */
+            if (warm_ctx.filter && ((hash == 0U) || (hash != warm_rec.tile[idx]))) {
+                (void)lv_area_intersect(&part, &tile, area);
+                if (!any) {
+                    send = part;
+                    any = true;
+                } else {
+                    send.x1 = LV_MIN(send.x1, part.x1);
+                    send.y1 = LV_MIN(send.y1, part.y1);
+                    send.x2 = LV_MAX(send.x2, part.x2);
+                    send.y2 = LV_MAX(send.y2, part.y2);
+                }
+            }
+        }
+    }
+
+    if (warm_ctx.filter) {
+        if (!any) {
+            warm_ctx.stats.skipped_flushes++;
+            return false;
+        }
+        if ((send.x1 != area->x1) || (send.y1 != area->y1) || (send.x2 != area->x2) || (send.y2 != area->y2)) {
+            warm_compact(area, px_map, &send);
+            *area = send;
+            warm_ctx.stats.trimmed_flushes++;
+        }
+    }
+
+    /* Unknown until the transfer completes (a reset mid-transfer leaves them half written) */
+    for (uint16_t ty = ty1; ty <= ty2; ty++) {
+        for (uint16_t tx = tx1; tx <= tx2; tx++) {
+            warm_set_tile(((uint32_t)ty * warm_ctx.tiles_x) + tx, 0U);
+        }
+    }
+    warm_ctx.ptx1 = tx1;
+    warm_ctx.ptx2 = tx2;
+    warm_ctx.pty1 = ty1;
+    warm_ctx.pty2 = ty2;
+    warm_ctx.pending = true;
+    return true;
+}
+
+void hpm_lvgl_warm_flush_complete(void)
+{
+    if (!warm_ctx.pending) {
+        return;
+    }
+
+    for (uint16_t ty = warm_ctx.pty1; ty <= warm_ctx.pty2; ty++) {
+        for (uint16_t tx = warm_ctx.ptx1; tx <= warm_ctx.ptx2; tx++) {
+            uint32_t idx = ((uint32_t)ty * warm_ctx.tiles_x) + tx;
+            warm_set_tile(idx, warm_ctx.pending_hash[idx]);
+        }
+    }
+    warm_ctx.pending = false;
+}
+
+void hpm_lvgl_warm_invalidate_area(const lv_area_t *area)
+{
+    uint16_t tx1, tx2, ty1, ty2;
+
+    if ((warm_ctx.disp == NULL) || (area == NULL)) {
+        return;
+    }
+
+    warm_sync_rotation();
+    if (!warm_tile_range(area, &tx1, &tx2, &ty1, &ty2)) {
+        return;
+    }
+    for (uint16_t ty = ty1; ty <= ty2; ty++) {
+        for (uint16_t tx = tx1; tx <= tx2; tx++) {
+            warm_set_tile(((uint32_t)ty * warm_ctx.tiles_x) + tx, 0U);
+        }
+    }
+}
+
+void hpm_lvgl_warm_reset(void)
+{
+    if (warm_ctx.disp == NULL) {
+        return;
+    }
+
+    warm_ctx.pending = false;
+    warm_ctx.filter = false;
+    warm_record_clear((uint16_t)lv_display_get_rotation(warm_ctx.disp));
+}
+
+void hpm_lvgl_warm_frame_end(void)
+{
+    if (warm_ctx.filter && warm_ctx.flush_seen) {
+        warm_ctx.filter = false;
+    }
+}
+
+void hpm_lvgl_warm_get_stats(hpm_lvgl_warm_stats_t *out)
+{
+    uint32_t total = (uint32_t)warm_ctx.tiles_x * warm_ctx.tiles_y;
+    uint32_t known = 0;
+
+    if (out == NULL) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < total; i++) {
+        if (warm_rec.tile[i] != 0U) {
+            known++;
+        }
+    }
+    *out = warm_ctx.stats;
+    out->known_tiles = known;
+    out->total_tiles = total;
+}
+
+#endif /* HPM_LVGL_WARM_RESTART */
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Warm restart: keep the panel picture across an MCU reset
+ *
+ * A hash of every 16x16 tile known to be on the panel is kept in RAM that survives a
+ * watchdog or software reset. If the panel still answers as configured (RDDID/RDDST)
+ * after such a reset, it is neither reset nor re-initialized, and the first frame only
+ * flushes the tiles whose content differs from what the panel already shows.
+ *
+ * Needs the panel SDO wired to SPI MISO; without it the reads fail and every boot is cold.
+ */
+
+#ifndef HPM_LVGL_WARM_H
+#define HPM_LVGL_WARM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl.h"
+
+/*============================================================================
+ * Configuration
+ *============================================================================*/
+
+/* Disabled by default: every hook below compiles to nothing and the panel is always reset. */
+#ifndef HPM_LVGL_WARM_RESTART
+#define HPM_LVGL_WARM_RESTART       0
+#endif
+
+/* Tile size is fixed at 16x16 pixels. */
+#define HPM_LVGL_WARM_TILE_SHIFT    4
+#define HPM_LVGL_WARM_TILE          (1 << HPM_LVGL_WARM_TILE_SHIFT)
+
+/* Placement of the tile record: a section the startup code neither zeroes nor loads. */
+#ifndef HPM_LVGL_WARM_ATTR
+#if defined(ATTR_PLACE_AT)
+#define HPM_LVGL_WARM_ATTR ATTR_PLACE_AT(".noinit")
+#else
+#define HPM_LVGL_WARM_ATTR __attribute__((section(".noinit")))
+#endif
+#endif
+
+/*============================================================================
+ * Types
+ *============================================================================*/
+
+typedef struct {
+    bool warm_start;            /* Last boot kept the panel */
+    uint32_t panel_id;          /* RDDID read at boot (24 bit) */
+    uint32_t panel_status;      /* RDDST read at boot */
+    uint32_t known_tiles;       /* Tiles whose panel content is known */
+    uint32_t total_tiles;
+    uint32_t skipped_flushes;   /* Boot-frame flushes not sent at all */
+    uint32_t trimmed_flushes;   /* Boot-frame flushes reduced to their changed tiles */
+} hpm_lvgl_warm_stats_t;
+
+/*============================================================================
+ * API Functions
+ *============================================================================*/
+
+#if HPM_LVGL_WARM_RESTART
+
+/**
+ * @brief Decide at boot whether the panel can be kept (called by `hpm_lvgl_spi_init()`)
+ * @param panel_id RDDID (24 bit)
+ * @param panel_status RDDST (32 bit)
+ * @return true if the record is intact, the panel ID matches and the panel is awake,
+ *         displaying and in 16-bit color mode
+ */
+bool hpm_lvgl_warm_probe(uint32_t panel_id, uint32_t panel_status);
+
+/**
+ * @brief Attach to a display after hpm_lvgl_warm_probe() (called by `hpm_lvgl_spi_init()`)
+ *
+ * On a cold start the record is rebuilt empty; on a warm start the first frame is filtered.
+ */
+void hpm_lvgl_warm_init(lv_display_t *disp);
+
+/**
+ * @brief Flush hook: hash the tiles of an area and, during the first frame of a warm start,
+ *        drop the tiles the panel already shows
+ * @param area Flushed area (LVGL coordinates, inclusive), shrunk in place
+ * @param px_map RGB565 pixels of the area, compacted in place when the area shrinks
+ * @return false if nothing needs to be sent
+ */
+bool hpm_lvgl_warm_flush_begin(lv_area_t *area, uint8_t *px_map);
+
+/**
+ * @brief The flush started last reached the panel (ISR context)
+ */
+void hpm_lvgl_warm_flush_complete(void);
+
+/**
+ * @brief Pixels written to the panel outside LVGL (overlay plane): forget these tiles
+ */
+void hpm_lvgl_warm_invalidate_area(const lv_area_t *area);
+
+/**
+ * @brief Panel content lost (re-initialized): forget every tile
+ */
+void hpm_lvgl_warm_reset(void);
+
+/**
+ * @brief LVGL refresh cycle finished (ends the warm-start filter after its first frame)
+ */
+void hpm_lvgl_warm_frame_end(void);
+
+/**
+ * @brief Get warm restart statistics
+ * @param out Output stats (must not be NULL)
+ */
+void hpm_lvgl_warm_get_stats(hpm_lvgl_warm_stats_t *out);
+
+#else
+
+static inline bool hpm_lvgl_warm_probe(uint32_t panel_id, uint32_t panel_status)
+{
+    (void)panel_id;
+    (void)panel_status;
+    return false;
+}
+static inline void hpm_lvgl_warm_init(lv_display_t *disp) { (void)disp; }
+static inline bool hpm_lvgl_warm_flush_begin(lv_area_t *area, uint8_t *px_map)
+{
+    (void)area;
+    (void)px_map;
+    return true;
+}
+static inline void hpm_lvgl_warm_flush_complete(void) {}
+static inline void hpm_lvgl_warm_invalidate_area(const lv_area_t *area) { (void)area; }
+static inline void hpm_lvgl_warm_reset(void) {}
+static inline void hpm_lvgl_warm_frame_end(void) {}
+static inline void hpm_lvgl_warm_get_stats(hpm_lvgl_warm_stats_t *out) { (void)out; }
+
+#endif /* HPM_LVGL_WARM_RESTART */
+
+#endif /* HPM_LVGL_WARM_H */
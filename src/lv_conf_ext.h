@@ -38,6 +38,58 @@
 #endif
 #define LV_MEM_SIZE (48 * 1024U)
 
+/* HPM_LVGL_MEM_POOLS=1 (set from CMake): lv_malloc() is served by size-class pools and an
+ * arena in DLM (src/hpm_lvgl_mem.c) instead of the TLSF heap above. */
+#if defined(HPM_LVGL_MEM_POOLS) && HPM_LVGL_MEM_POOLS
+#ifdef LV_USE_STDLIB_MALLOC
+#undef LV_USE_STDLIB_MALLOC
+#endif
+#define LV_USE_STDLIB_MALLOC LV_STDLIB_CUSTOM
+#endif
+
+/* HPM_LVGL_RTOS=1 (set from CMake): LVGL runs in a FreeRTOS task (src/hpm_lvgl_rtos.c) and
+ * lv_lock() guards it against the application's other tasks. */
+#if defined(HPM_LVGL_RTOS) && HPM_LVGL_RTOS
+#ifdef LV_USE_OS
+#undef LV_USE_OS
+#endif
+#define LV_USE_OS LV_OS_FREERTOS
+#endif
+
+/* HPM_LVGL_DRAW_UNITS > 1 (set from CMake): that many software draw units, one LVGL thread each,
+ * render the independent draw tasks of a strip in parallel. Needs the OS layer above. */
+#if defined(HPM_LVGL_DRAW_UNITS) && (HPM_LVGL_DRAW_UNITS > 1)
+#if !defined(LV_USE_OS) || (LV_USE_OS == LV_OS_NONE)
+#error "HPM_LVGL_DRAW_UNITS > 1 needs an LVGL OS layer (HPM_LVGL_RTOS=1)"
+#endif
+#ifdef LV_DRAW_SW_DRAW_UNIT_CNT
+#undef LV_DRAW_SW_DRAW_UNIT_CNT
+#endif
+#define LV_DRAW_SW_DRAW_UNIT_CNT HPM_LVGL_DRAW_UNITS
+#endif
+
+/* HPM_LVGL_DSP=1 (set from CMake): LVGL's RGB565 fill, blend and byte-swap loops are replaced by the
+ * packed-SIMD kernels in src/hpm_lvgl_dsp.c through LVGL's custom draw-sw asm hooks. */
+#if defined(HPM_LVGL_DSP) && HPM_LVGL_DSP
+#ifdef LV_USE_DRAW_SW_ASM
+#undef LV_USE_DRAW_SW_ASM
+#endif
+#define LV_USE_DRAW_SW_ASM LV_DRAW_SW_ASM_CUSTOM
+#ifdef LV_DRAW_SW_ASM_CUSTOM_INCLUDE
+#undef LV_DRAW_SW_ASM_CUSTOM_INCLUDE
+#endif
+#define LV_DRAW_SW_ASM_CUSTOM_INCLUDE "hpm_lvgl_dsp.h"
+#endif
+
+/* HPM_LVGL_L8=1 (set from CMake): LVGL renders into 8-bit L8 draw buffers, expanded to RGB565
+ * through a palette LUT in the flush path (src/hpm_lvgl_l8.c). */
+#if defined(HPM_LVGL_L8) && HPM_LVGL_L8
+#ifdef LV_DRAW_SW_SUPPORT_L8
+#undef LV_DRAW_SW_SUPPORT_L8
+#endif
+#define LV_DRAW_SW_SUPPORT_L8 1
+#endif
+
 /* 16ms ~= 60Hz, good default for SPI LCDs. */
 #ifdef LV_DEF_REFR_PERIOD
 #undef LV_DEF_REFR_PERIOD
@@ -50,6 +102,25 @@
 #endif
 #define LV_INV_BUF_SIZE 32
 
+/*====================
+ * Code placement
+ *====================*/
+
+/* HPM_LVGL_RAMFUNC >= 2 (set from CMake, see hpm_lvgl_spi.h): run the software render kernels LVGL
+ * marks as fast (blend/fill, masks, lv_memcpy/lv_memset) and lv_display_flush_ready(), which the DMA
+ * completion ISR calls, from ILM instead of XIP flash. The HPM startup code copies `.fast` to ILM. */
+#if defined(HPM_LVGL_RAMFUNC) && (HPM_LVGL_RAMFUNC >= 2)
+#ifdef LV_ATTRIBUTE_FAST_MEM
+#undef LV_ATTRIBUTE_FAST_MEM
+#endif
+#define LV_ATTRIBUTE_FAST_MEM __attribute__((section(".fast")))
+
+#ifdef LV_ATTRIBUTE_FLUSH_READY
+#undef LV_ATTRIBUTE_FLUSH_READY
+#endif
+#define LV_ATTRIBUTE_FLUSH_READY __attribute__((section(".fast")))
+#endif
+
 /*==================
  * Display drivers
  *==================*/
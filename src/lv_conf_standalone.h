@@ -27,6 +27,39 @@
 /* Size of the memory available for `lv_malloc()` in bytes (>= 2kB) */
 #define LV_MEM_SIZE (48 * 1024U)
 
+/* HPM_LVGL_MEM_POOLS=1: size-class pools + arena in DLM (src/hpm_lvgl_mem.c) replace the TLSF heap */
+#if defined(HPM_LVGL_MEM_POOLS) && HPM_LVGL_MEM_POOLS
+#define LV_USE_STDLIB_MALLOC LV_STDLIB_CUSTOM
+#endif
+
+/* HPM_LVGL_RTOS=1: LVGL runs in a FreeRTOS task (src/hpm_lvgl_rtos.c) and lv_lock() guards it
+ * against the application's other tasks */
+#if defined(HPM_LVGL_RTOS) && HPM_LVGL_RTOS
+#ifdef LV_USE_OS
+#undef LV_USE_OS
+#endif
+#define LV_USE_OS LV_OS_FREERTOS
+#endif
+
+/* HPM_LVGL_DRAW_UNITS > 1: that many software draw units render a strip's independent draw tasks
+ * in parallel, one thread each (needs LV_USE_OS) */
+#if defined(HPM_LVGL_DRAW_UNITS) && (HPM_LVGL_DRAW_UNITS > 1)
+#define LV_DRAW_SW_DRAW_UNIT_CNT HPM_LVGL_DRAW_UNITS
+#endif
+
+/* HPM_LVGL_DSP=1: packed-SIMD RGB565 fill/blend/swap kernels (src/hpm_lvgl_dsp.c) through LVGL's
+ * custom draw-sw asm hooks */
+#if defined(HPM_LVGL_DSP) && HPM_LVGL_DSP
+#define LV_USE_DRAW_SW_ASM LV_DRAW_SW_ASM_CUSTOM
+#define LV_DRAW_SW_ASM_CUSTOM_INCLUDE "hpm_lvgl_dsp.h"
+#endif
+
+/* HPM_LVGL_L8=1: L8 draw buffers, expanded to RGB565 through a palette LUT when flushed
+ * (src/hpm_lvgl_l8.c) */
+#if defined(HPM_LVGL_L8) && HPM_LVGL_L8
+#define LV_DRAW_SW_SUPPORT_L8 1
+#endif
+
 /*=======================
    DISPLAY SETTINGS
  *=======================*/
@@ -55,6 +88,13 @@
  * LVGL will combine overlapping/adjacent dirty rectangles */
 #define LV_REFR_MERGE_AREAS 1
 
+/* HPM_LVGL_RAMFUNC >= 2 (see hpm_lvgl_spi.h): LVGL's fast-marked render kernels and
+ * lv_display_flush_ready() run from ILM instead of XIP flash (`.fast` is copied at startup) */
+#if defined(HPM_LVGL_RAMFUNC) && (HPM_LVGL_RAMFUNC >= 2)
+#define LV_ATTRIBUTE_FAST_MEM __attribute__((section(".fast")))
+#define LV_ATTRIBUTE_FLUSH_READY __attribute__((section(".fast")))
+#endif
+
 /*=================
    FONT USAGE
  =================*/
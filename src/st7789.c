@@ -6,8 +6,10 @@
  */
 
 #include "st7789.h"
+#include "hpm_lvgl_spi_capture.h"
 #include "hpm_clock_drv.h"
 #include "hpm_l1c_drv.h"
+#include "hpm_csr_drv.h"
 #include "board.h"
 #include <string.h>
 
@@ -18,6 +20,14 @@
 /*============================================================================
  * Private data
  *============================================================================*/
+typedef enum {
+    ST7789_INIT_IDLE = 0,
+    ST7789_INIT_RESET,          /* Reset released; panel needs 120 ms before SLPOUT */
+    ST7789_INIT_TABLE,          /* Sending st7789_init_cmds[] */
+    ST7789_INIT_DISPON,         /* Display on; settling before the backlight */
+    ST7789_INIT_DONE,
+} st7789_init_state_t;
+
 static struct {
     st7789_config_t cfg;
     volatile bool dma_busy;
@@ -26,6 +36,12 @@ static struct {
     uint8_t rotation;
     uint16_t width;
     uint16_t height;
+
+    /* Non-blocking init */
+    st7789_init_state_t init_state;
+    uint32_t init_pos;
+    uint32_t cycles_per_ms;
+    uint64_t deadline;
 } st7789_ctx;
 
 /*============================================================================
@@ -41,13 +57,13 @@ static inline void st7789_cs_high(void)
     /* CS is handled by SPI controller in most cases */
 }
 
-static inline void st7789_dc_command(void)
+ST7789_HOT_ATTR static inline void st7789_dc_command(void)
 {
     gpio_write_pin(st7789_ctx.cfg.gpio_base, st7789_ctx.cfg.dc_gpio_index, 
                    st7789_ctx.cfg.dc_gpio_pin, 0);
 }
 
-static inline void st7789_dc_data(void)
+ST7789_HOT_ATTR static inline void st7789_dc_data(void)
 {
     gpio_write_pin(st7789_ctx.cfg.gpio_base, st7789_ctx.cfg.dc_gpio_index, 
                    st7789_ctx.cfg.dc_gpio_pin, 1);
@@ -65,12 +81,17 @@ static inline void st7789_rst_high(void)
                    st7789_ctx.cfg.rst_gpio_pin, 1);
 }
 
-static void st7789_delay_ms(uint32_t ms)
+static void st7789_wait_ms(uint32_t ms)
+{
+    st7789_ctx.deadline = hpm_csr_get_core_cycle() + (uint64_t)ms * st7789_ctx.cycles_per_ms;
+}
+
+static bool st7789_wait_done(void)
 {
-    board_delay_ms(ms);
+    return (int64_t)(hpm_csr_get_core_cycle() - st7789_ctx.deadline) >= 0;
 }
 
-static inline void st7789_spi_wait_transfer_done(SPI_Type *spi)
+ST7789_HOT_ATTR static inline void st7789_spi_wait_transfer_done(SPI_Type *spi)
 {
     /* FIFO empty does NOT always mean the shifter is done.
      * Wait for both FIFO empty and SPI inactive. */
@@ -80,7 +101,7 @@ static inline void st7789_spi_wait_transfer_done(SPI_Type *spi)
     }
 }
 
-static void st7789_spi_write_byte(uint8_t data)
+ST7789_HOT_ATTR static void st7789_spi_write_byte(uint8_t data)
 {
     SPI_Type *spi = st7789_ctx.cfg.spi_base;
 
@@ -97,7 +118,7 @@ static void st7789_spi_write_byte(uint8_t data)
     st7789_spi_wait_transfer_done(spi);
 }
 
-static void st7789_spi_write_data(const uint8_t *data, uint32_t len)
+ST7789_HOT_ATTR static void st7789_spi_write_data(const uint8_t *data, uint32_t len)
 {
     SPI_Type *spi = st7789_ctx.cfg.spi_base;
 
@@ -118,25 +139,34 @@ static void st7789_spi_write_data(const uint8_t *data, uint32_t len)
     st7789_spi_wait_transfer_done(spi);
 }
 
-static void st7789_write_cmd(uint8_t cmd)
+ST7789_HOT_ATTR static void st7789_write_cmd(uint8_t cmd)
 {
+    uint64_t cap_start = hpm_lvgl_spi_capture_now();
+
     st7789_dc_command();
     st7789_spi_write_byte(cmd);
+    hpm_lvgl_spi_capture_write(false, &cmd, 1, cap_start, true);
 }
 
 static void st7789_write_data(uint8_t data)
 {
+    uint64_t cap_start = hpm_lvgl_spi_capture_now();
+
     st7789_dc_data();
     st7789_spi_write_byte(data);
+    hpm_lvgl_spi_capture_write(true, &data, 1, cap_start, true);
 }
 
 static void st7789_write_data_buf(const uint8_t *data, uint32_t len)
 {
+    uint64_t cap_start = hpm_lvgl_spi_capture_now();
+
     st7789_dc_data();
     st7789_spi_write_data(data, len);
+    hpm_lvgl_spi_capture_write(true, data, len, cap_start, true);
 }
 
-static void st7789_write_cmd_data_buf(uint8_t cmd, const uint8_t *data, uint32_t len)
+ST7789_HOT_ATTR static void st7789_write_cmd_data_buf(uint8_t cmd, const uint8_t *data, uint32_t len)
 {
     st7789_write_cmd(cmd);
     if ((data != NULL) && (len != 0U)) {
@@ -147,90 +177,31 @@ static void st7789_write_cmd_data_buf(uint8_t cmd, const uint8_t *data, uint32_t
 /*============================================================================
  * Initialization sequences
  *============================================================================*/
-static void st7789_init_sequence(void)
-{
-    static const uint8_t porctrl[] = { 0x0C, 0x0C, 0x00, 0x33, 0x33 };
-    static const uint8_t pwctrl1[] = { 0xA4, 0xA1 };
-    static const uint8_t gamma_pos[] = {
-        0xD0, 0x04, 0x0D, 0x11, 0x13, 0x2B, 0x3F,
-        0x54, 0x4C, 0x18, 0x0D, 0x0B, 0x1F, 0x23
-    };
-    static const uint8_t gamma_neg[] = {
-        0xD0, 0x04, 0x0C, 0x11, 0x13, 0x2C, 0x3F,
-        0x44, 0x51, 0x2F, 0x1F, 0x1F, 0x20, 0x23
-    };
 
-    /* Software reset */
-    st7789_write_cmd(ST7789_SWRESET);
-    st7789_delay_ms(150);
-    
-    /* Sleep out */
-    st7789_write_cmd(ST7789_SLPOUT);
-    st7789_delay_ms(120);
-    
-    /* Color mode - RGB565 */
-    st7789_write_cmd_data_buf(ST7789_COLMOD, (const uint8_t[]){0x55}, 1); /* 16-bit color */
-    
-    /* Memory data access control */
-    st7789_write_cmd_data_buf(ST7789_MADCTL, (const uint8_t[]){0x00}, 1);
-    
-    /* Porch control */
-    st7789_write_cmd_data_buf(ST7789_PORCTRL, porctrl, sizeof(porctrl));
-    
-    /* Gate control */
-    st7789_write_cmd_data_buf(ST7789_GCTRL, (const uint8_t[]){0x35}, 1);
-    
-    /* VCOM setting */
-    st7789_write_cmd_data_buf(ST7789_VCOMS, (const uint8_t[]){0x19}, 1);
-    
-    /* LCM control */
-    st7789_write_cmd_data_buf(ST7789_LCMCTRL, (const uint8_t[]){0x2C}, 1);
-    
-    /* VDV and VRH command enable */
-    st7789_write_cmd_data_buf(ST7789_VDVVRHEN, (const uint8_t[]){0x01}, 1);
-    
-    /* VRH set */
-    st7789_write_cmd_data_buf(ST7789_VRHS, (const uint8_t[]){0x12}, 1);
-    
-    /* VDV set */
-    st7789_write_cmd_data_buf(ST7789_VDVS, (const uint8_t[]){0x20}, 1);
-    
-    /* Frame rate control */
-    st7789_write_cmd_data_buf(ST7789_FRCTRL2, (const uint8_t[]){0x0F}, 1);  /* 60Hz */
-    
-    /* Power control */
-    st7789_write_cmd_data_buf(ST7789_PWCTRL1, pwctrl1, sizeof(pwctrl1));
-    
-    /* Positive voltage gamma control */
-    st7789_write_cmd_data_buf(ST7789_PVGAMCTRL, gamma_pos, sizeof(gamma_pos));
-    
-    /* Negative voltage gamma control */
-    st7789_write_cmd_data_buf(ST7789_NVGAMCTRL, gamma_neg, sizeof(gamma_neg));
-    
-    /* Inversion on (most ST7789 displays need this) */
-    if (st7789_ctx.cfg.invert_colors) {
-        st7789_write_cmd(ST7789_INVON);
-    } else {
-        st7789_write_cmd(ST7789_INVOFF);
-    }
-    
-    /* Normal display mode on */
-    st7789_write_cmd(ST7789_NORON);
-    st7789_delay_ms(10);
-    
-    /* Display on */
-    st7789_write_cmd(ST7789_DISPON);
-    st7789_delay_ms(10);
-}
-
-static void gc9307_init_sequence(void)
-{
-    /* GC9307 is largely compatible with ST7789 */
-    /* Use ST7789 init sequence with minor adjustments if needed */
-    st7789_init_sequence();
-    
-    /* GC9307 specific settings can be added here */
-}
+/* Pseudo command: the next byte is a delay in ms */
+#define ST7789_CMD_DELAY    0xFFU
+
+/* Sent after the hardware reset (so no SWRESET), in batches between delays: { cmd, len, data... }.
+ * MADCTL, inversion and DISPON follow from the configuration. GC9307 uses the same table. */
+static const uint8_t st7789_init_cmds[] = {
+    ST7789_SLPOUT, 0,
+    ST7789_CMD_DELAY, 5,                                /* Supplies/clocks settle before the next command */
+    ST7789_COLMOD, 1, 0x55,                             /* 16-bit color */
+    ST7789_PORCTRL, 5, 0x0C, 0x0C, 0x00, 0x33, 0x33,
+    ST7789_GCTRL, 1, 0x35,
+    ST7789_VCOMS, 1, 0x19,
+    ST7789_LCMCTRL, 1, 0x2C,
+    ST7789_VDVVRHEN, 1, 0x01,
+    ST7789_VRHS, 1, 0x12,
+    ST7789_VDVS, 1, 0x20,
+    ST7789_FRCTRL2, 1, 0x0F,                            /* 60Hz */
+    ST7789_PWCTRL1, 2, 0xA4, 0xA1,
+    ST7789_PVGAMCTRL, 14, 0xD0, 0x04, 0x0D, 0x11, 0x13, 0x2B, 0x3F,
+                          0x54, 0x4C, 0x18, 0x0D, 0x0B, 0x1F, 0x23,
+    ST7789_NVGAMCTRL, 14, 0xD0, 0x04, 0x0C, 0x11, 0x13, 0x2C, 0x3F,
+                          0x44, 0x51, 0x2F, 0x1F, 0x1F, 0x20, 0x23,
+    ST7789_NORON, 0,
+};
 
 /*============================================================================
  * GPIO initialization
@@ -242,10 +213,10 @@ static void st7789_gpio_init(void)
                         st7789_ctx.cfg.dc_gpio_index,
                         st7789_ctx.cfg.dc_gpio_pin);
     
-    /* RST pin */
-    gpio_set_pin_output(st7789_ctx.cfg.gpio_base, 
-                        st7789_ctx.cfg.rst_gpio_index,
-                        st7789_ctx.cfg.rst_gpio_pin);
+    /* RST pin (driven high right away: a low level would reset a panel kept across an MCU reset) */
+    gpio_set_pin_output_with_initial(st7789_ctx.cfg.gpio_base,
+                                     st7789_ctx.cfg.rst_gpio_index,
+                                     st7789_ctx.cfg.rst_gpio_pin, 1);
     
     /* Backlight pin */
     gpio_set_pin_output(st7789_ctx.cfg.gpio_base, 
@@ -345,7 +316,7 @@ static void st7789_dma_init(void)
  * Public API implementation
  *============================================================================*/
 
-hpm_stat_t st7789_init(const st7789_config_t *config)
+hpm_stat_t st7789_attach(const st7789_config_t *config)
 {
     if (config == NULL) {
         return status_invalid_argument;
@@ -357,18 +328,13 @@ hpm_stat_t st7789_init(const st7789_config_t *config)
     st7789_ctx.width = config->width;
     st7789_ctx.height = config->height;
     st7789_ctx.dma_busy = false;
+    st7789_ctx.cycles_per_ms = clock_get_frequency(clock_cpu0) / 1000U;
+    
+    st7789_ctx.init_state = ST7789_INIT_IDLE;
     
     /* Initialize GPIO */
     st7789_gpio_init();
     
-    /* Hardware reset */
-    st7789_rst_high();
-    st7789_delay_ms(10);
-    st7789_rst_low();
-    st7789_delay_ms(10);
-    st7789_rst_high();
-    st7789_delay_ms(120);
-    
     /* Initialize SPI */
     if (st7789_spi_init() != status_success) {
         return status_fail;
@@ -377,23 +343,135 @@ hpm_stat_t st7789_init(const st7789_config_t *config)
     /* Initialize DMA */
     st7789_dma_init();
     
-    /* Initialize display */
-    if (config->driver_ic == LCD_DRIVER_GC9307) {
-        gc9307_init_sequence();
-    } else {
-        st7789_init_sequence();
+    return status_success;
+}
+
+hpm_stat_t st7789_init_start(const st7789_config_t *config)
+{
+    hpm_stat_t stat = st7789_attach(config);
+
+    if (stat != status_success) {
+        return stat;
     }
-    
-    /* Set initial rotation */
-    st7789_set_rotation(config->rotation);
-    
-    /* Turn on backlight */
-    st7789_backlight(true);
+
+    /* Hardware reset: >= 10 us low pulse, then 120 ms before SLPOUT (spent in st7789_init_poll()) */
+    st7789_rst_low();
+    board_delay_us(20);
+    st7789_rst_high();
+    st7789_wait_ms(120);
+    st7789_ctx.init_state = ST7789_INIT_RESET;
     
     return status_success;
 }
 
-void st7789_set_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+void st7789_init_warm(void)
+{
+    /* Skip the reset and the command table; st7789_init_poll() re-applies inversion,
+     * rotation and DISPON, which leave a running panel's picture untouched. */
+    st7789_ctx.init_pos = sizeof(st7789_init_cmds);
+    st7789_ctx.deadline = hpm_csr_get_core_cycle();
+    st7789_ctx.init_state = ST7789_INIT_TABLE;
+}
+
+hpm_stat_t st7789_read(uint8_t cmd, uint8_t *data, uint32_t len)
+{
+    spi_control_config_t control = {0};
+    uint8_t tx[ST7789_READ_MAX + 1U] = {0};
+    uint8_t rx[ST7789_READ_MAX + 1U];
+    hpm_stat_t stat;
+
+    if ((data == NULL) || (len == 0U) || (len > ST7789_READ_MAX) || st7789_ctx.dma_busy) {
+        return status_invalid_argument;
+    }
+
+    /* One full-duplex transfer so CS stays asserted between the command and the reply */
+    tx[0] = cmd;
+    spi_master_get_default_control_config(&control);
+    control.common_config.trans_mode = spi_trans_write_read_together;
+    control.common_config.data_phase_fmt = spi_single_io_mode;
+
+    st7789_dc_command();
+    stat = spi_transfer(st7789_ctx.cfg.spi_base, &control, NULL, NULL, tx, len + 1U, rx, len + 1U);
+    memcpy(data, &rx[1], len);
+
+    /* Back to the write-only setup the pixel path relies on */
+    if (st7789_spi_init() != status_success) {
+        return status_fail;
+    }
+    return stat;
+}
+
+bool st7789_init_poll(void)
+{
+    switch (st7789_ctx.init_state) {
+    case ST7789_INIT_RESET:
+        if (!st7789_wait_done()) {
+            return false;
+        }
+        st7789_ctx.init_pos = 0;
+        st7789_ctx.init_state = ST7789_INIT_TABLE;
+        break;
+    case ST7789_INIT_TABLE:
+    case ST7789_INIT_DISPON:
+        if (!st7789_wait_done()) {
+            return false;
+        }
+        break;
+    case ST7789_INIT_DONE:
+        return true;
+    default:
+        return false;
+    }
+
+    if (st7789_ctx.init_state == ST7789_INIT_DISPON) {
+        if (!st7789_ctx.cfg.defer_backlight) {
+            st7789_backlight(true);
+        }
+        st7789_ctx.init_state = ST7789_INIT_DONE;
+        return true;
+    }
+
+    /* Send commands up to the next delay */
+    while (st7789_ctx.init_pos < sizeof(st7789_init_cmds)) {
+        const uint8_t *entry = &st7789_init_cmds[st7789_ctx.init_pos];
+
+        if (entry[0] == ST7789_CMD_DELAY) {
+            st7789_ctx.init_pos += 2U;
+            st7789_wait_ms(entry[1]);
+            return false;
+        }
+        st7789_write_cmd_data_buf(entry[0], &entry[2], entry[1]);
+        st7789_ctx.init_pos += 2U + entry[1];
+    }
+
+    /* Inversion on (most ST7789 displays need this) */
+    if (st7789_ctx.cfg.invert_colors) {
+        st7789_write_cmd(ST7789_INVON);
+    } else {
+        st7789_write_cmd(ST7789_INVOFF);
+    }
+
+    st7789_ctx.init_state = ST7789_INIT_DISPON;
+    st7789_set_rotation(st7789_ctx.rotation);
+    st7789_write_cmd(ST7789_DISPON);
+    st7789_wait_ms(10);
+    return false;
+}
+
+hpm_stat_t st7789_init(const st7789_config_t *config)
+{
+    hpm_stat_t stat = st7789_init_start(config);
+
+    if (stat != status_success) {
+        return stat;
+    }
+    while (!st7789_init_poll()) {
+    }
+
+    return status_success;
+}
+
+ST7789_HOT_ATTR void st7789_set_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
 {
     uint16_t x_start = x0 + st7789_ctx.cfg.x_offset;
     uint16_t x_end = x1 + st7789_ctx.cfg.x_offset;
@@ -427,28 +505,34 @@ void st7789_fill_area(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16
     uint32_t pixel_count = (uint32_t)(x1 - x0 + 1) * (y1 - y0 + 1);
     uint8_t color_hi = color >> 8;
     uint8_t color_lo = color & 0xFF;
+    const uint8_t color_be[] = { color_hi, color_lo, color_hi, color_lo };
     
     st7789_set_window(x0, y0, x1, y1);
     
+    uint64_t cap_start = hpm_lvgl_spi_capture_now();
     st7789_dc_data();
     for (uint32_t i = 0; i < pixel_count; i++) {
         st7789_spi_write_byte(color_hi);
         st7789_spi_write_byte(color_lo);
     }
+    hpm_lvgl_spi_capture_write(true, color_be, pixel_count * 2U, cap_start, true);
 }
 
 void st7789_write_pixels(const uint16_t *data, uint32_t pixel_count)
 {
+    uint64_t cap_start = hpm_lvgl_spi_capture_now();
+
     st7789_dc_data();
     
     const uint8_t *ptr = (const uint8_t *)data;
     uint32_t byte_count = pixel_count * 2;
     
     st7789_spi_write_data(ptr, byte_count);
+    hpm_lvgl_spi_capture_write(true, ptr, byte_count, cap_start, true);
 }
 
-hpm_stat_t st7789_write_pixels_dma(const void *data, uint32_t byte_len,
-                                    st7789_dma_done_cb_t callback, void *user_data)
+ST7789_HOT_ATTR hpm_stat_t st7789_write_pixels_dma(const void *data, uint32_t byte_len,
+                                                    st7789_dma_done_cb_t callback, void *user_data)
 {
     if (st7789_ctx.dma_busy) {
         return status_fail;
@@ -463,9 +547,11 @@ hpm_stat_t st7789_write_pixels_dma(const void *data, uint32_t byte_len,
         return status_invalid_argument;
     }
     
-    /* Flush cache for DMA source buffer */
-    if (l1c_dc_is_enabled()) {
-        l1c_dc_writeback((uint32_t)data, byte_len);
+    /* Write back the cache lines holding the DMA source (the range must be line aligned) */
+    if (!st7789_ctx.cfg.noncacheable_buffers && l1c_dc_is_enabled()) {
+        uint32_t start = HPM_L1C_CACHELINE_ALIGN_DOWN((uint32_t)data);
+        uint32_t end = HPM_L1C_CACHELINE_ALIGN_UP((uint32_t)data + byte_len);
+        l1c_dc_writeback(start, end - start);
     }
     
     /* Store callback */
@@ -495,6 +581,7 @@ hpm_stat_t st7789_write_pixels_dma(const void *data, uint32_t byte_len,
     dma_cfg.dst_mode = DMA_HANDSHAKE_MODE_HANDSHAKE;
     
     /* Start DMA transfer */
+    hpm_lvgl_spi_capture_dma_start(byte_len, true);
     if (dma_setup_channel(dma, ch, &dma_cfg, true) != status_success) {
         st7789_ctx.dma_busy = false;
         spi_disable_tx_dma(spi);
@@ -504,6 +591,11 @@ hpm_stat_t st7789_write_pixels_dma(const void *data, uint32_t byte_len,
     return status_success;
 }
 
+void st7789_set_noncacheable_buffers(bool noncacheable)
+{
+    st7789_ctx.cfg.noncacheable_buffers = noncacheable;
+}
+
 bool st7789_is_busy(void)
 {
     return st7789_ctx.dma_busy;
@@ -521,6 +613,11 @@ void st7789_set_rotation(uint16_t rotation)
     uint8_t madctl = 0;
     
     st7789_ctx.rotation = (uint8_t)rotation;
+
+    /* Before the panel is awake, only remember it: st7789_init_poll() applies it. */
+    if (st7789_ctx.init_state < ST7789_INIT_DISPON) {
+        return;
+    }
     
     switch (rotation) {
     case 0:
@@ -552,6 +649,26 @@ void st7789_set_rotation(uint16_t rotation)
     st7789_write_data(madctl);
 }
 
+hpm_stat_t st7789_set_spi_freq(uint32_t freq_hz)
+{
+    spi_timing_config_t timing = {0};
+
+    st7789_wait_idle();
+
+    spi_master_get_default_timing_config(&timing);
+    timing.master_config.clk_src_freq_in_hz = clock_get_frequency(st7789_ctx.cfg.spi_clk_name);
+    timing.master_config.sclk_freq_in_hz = freq_hz;
+    timing.master_config.cs2sclk = spi_cs2sclk_half_sclk_1;
+    timing.master_config.csht = spi_csht_half_sclk_1;
+
+    if (spi_master_timing_init(st7789_ctx.cfg.spi_base, &timing) != status_success) {
+        return status_fail;
+    }
+
+    st7789_ctx.cfg.spi_freq_hz = freq_hz;
+    return status_success;
+}
+
 void st7789_display_on(bool on)
 {
     if (on) {
@@ -588,23 +705,17 @@ uint16_t st7789_get_height(void)
     return st7789_ctx.height;
 }
 
-void st7789_dma_irq_handler(void)
+ST7789_HOT_ATTR static void st7789_dma_finish(bool tc)
 {
     DMA_Type *dma = st7789_ctx.cfg.dma_base;
     SPI_Type *spi = st7789_ctx.cfg.spi_base;
     uint8_t ch = st7789_ctx.cfg.dma_channel;
-    
-    uint32_t stat = dma_check_transfer_status(dma, ch);
-
-    /* Only handle terminal events; ignore ongoing/half-done */
-    if ((stat & (DMA_CHANNEL_STATUS_TC | DMA_CHANNEL_STATUS_ERROR | DMA_CHANNEL_STATUS_ABORT)) == 0U) {
-        return;
-    }
 
     /* DMA TC only means FIFO writes are done; wait for SPI shifter to finish */
-    if ((stat & DMA_CHANNEL_STATUS_TC) != 0U) {
+    if (tc) {
         st7789_spi_wait_transfer_done(spi);
     }
+    hpm_lvgl_spi_capture_dma_done();
 
     /* Stop DMA & mark idle */
     dma_disable_channel(dma, ch);
@@ -616,3 +727,24 @@ void st7789_dma_irq_handler(void)
         st7789_ctx.dma_callback(st7789_ctx.dma_user_data);
     }
 }
+
+ST7789_HOT_ATTR void st7789_dma_irq_handler(void)
+{
+    uint32_t stat = dma_check_transfer_status(st7789_ctx.cfg.dma_base, st7789_ctx.cfg.dma_channel);
+
+    /* Only handle terminal events; ignore ongoing/half-done */
+    if ((stat & (DMA_CHANNEL_STATUS_TC | DMA_CHANNEL_STATUS_ERROR | DMA_CHANNEL_STATUS_ABORT)) == 0U) {
+        return;
+    }
+
+    st7789_dma_finish((stat & DMA_CHANNEL_STATUS_TC) != 0U);
+}
+
+ST7789_HOT_ATTR void st7789_dma_tc_handler(void)
+{
+    if (!st7789_ctx.dma_busy) {
+        return;
+    }
+
+    st7789_dma_finish(true);
+}
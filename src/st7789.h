@@ -38,6 +38,15 @@
 #define ST7789_COLOR_MODE   ST7789_COLOR_RGB565
 #endif
 
+/* Placement of the pixel DMA path and its completion handlers (ILM with HPM_LVGL_RAMFUNC >= 1) */
+#ifndef ST7789_HOT_ATTR
+#if defined(HPM_LVGL_RAMFUNC) && (HPM_LVGL_RAMFUNC >= 1)
+#define ST7789_HOT_ATTR ATTR_RAMFUNC
+#else
+#define ST7789_HOT_ATTR
+#endif
+#endif
+
 /* Display offset (some screens need this) */
 #ifndef ST7789_X_OFFSET
 #define ST7789_X_OFFSET     34      /* Common for 172x320 screens */
@@ -165,6 +174,8 @@ typedef struct {
     lcd_driver_ic_t driver_ic;
     uint8_t rotation;               /* 0, 90, 180, 270 */
     bool invert_colors;
+    bool defer_backlight;           /* Leave the backlight off after init (caller switches it on) */
+    bool noncacheable_buffers;      /* Pixel buffers are never cached: skip the D-cache writeback */
 } st7789_config_t;
 
 /* DMA transfer completion callback */
@@ -181,6 +192,46 @@ typedef void (*st7789_dma_done_cb_t)(void *user_data);
  */
 hpm_stat_t st7789_init(const st7789_config_t *config);
 
+/**
+ * @brief Start a non-blocking init (GPIO, reset pulse, SPI, DMA); the panel is then
+ *        brought up by st7789_init_poll() while the caller does other work
+ * @param config Hardware configuration
+ * @return status_success on success
+ */
+hpm_stat_t st7789_init_start(const st7789_config_t *config);
+
+/**
+ * @brief Take over SPI, DMA and the control GPIOs without touching the panel (RST is held high)
+ * @param config Hardware configuration
+ * @return status_success on success
+ */
+hpm_stat_t st7789_attach(const st7789_config_t *config);
+
+/**
+ * @brief After st7789_attach(): the panel kept its configuration across an MCU reset, so
+ *        st7789_init_poll() only re-applies inversion, rotation and DISPON (no reset, no table)
+ */
+void st7789_init_warm(void);
+
+/**
+ * @brief Advance the init started by st7789_init_start(): sends the next batch of the
+ *        command table once the pending panel delay has elapsed, never waits
+ * @return true once the display is on and the backlight enabled (unless defer_backlight)
+ */
+bool st7789_init_poll(void);
+
+/* Longest st7789_read() */
+#define ST7789_READ_MAX     8U
+
+/**
+ * @brief Read a panel register (needs the panel SDO wired to SPI MISO; no DMA transfer may be running)
+ * @param cmd Read command (e.g. ST7789_RDDID, ST7789_RDDST)
+ * @param data Bytes clocked in after the command, raw: multi-byte reads start with one dummy clock
+ * @param len Number of bytes (1..ST7789_READ_MAX)
+ * @return status_success on success
+ */
+hpm_stat_t st7789_read(uint8_t cmd, uint8_t *data, uint32_t len);
+
 /**
  * @brief Set display window for pixel writes
  * @param x0, y0 Top-left corner
@@ -204,7 +255,7 @@ void st7789_write_pixels(const uint16_t *data, uint32_t pixel_count);
 
 /**
  * @brief Write pixel data via DMA (non-blocking)
- * @param data Pointer to RGB565 pixel data (must be cache-aligned)
+ * @param data Pointer to RGB565 pixel data (cache-line aligned when cacheable)
  * @param len Length in bytes
  * @param callback Function to call when DMA completes
  * @param user_data User data passed to callback
@@ -216,6 +267,12 @@ void st7789_write_pixels(const uint16_t *data, uint32_t pixel_count);
 hpm_stat_t st7789_write_pixels_dma(const void *data, uint32_t byte_len, 
                                     st7789_dma_done_cb_t callback, void *user_data);
 
+/**
+ * @brief Tell the driver whether pixel buffers are cacheable (see `noncacheable_buffers`)
+ * @param noncacheable true to skip the D-cache writeback before each DMA
+ */
+void st7789_set_noncacheable_buffers(bool noncacheable);
+
 /**
  * @brief Check if DMA transfer is in progress
  * @return true if busy
@@ -233,6 +290,13 @@ void st7789_wait_idle(void);
  */
 void st7789_set_rotation(uint16_t rotation);
 
+/**
+ * @brief Change the SPI clock (waits for a pending DMA transfer first)
+ * @param freq_hz Requested SCLK frequency
+ * @return status_success if the SPI timing could be configured
+ */
+hpm_stat_t st7789_set_spi_freq(uint32_t freq_hz);
+
 /**
  * @brief Turn display on/off
  * @param on true to turn on
@@ -266,4 +330,11 @@ uint16_t st7789_get_height(void);
  */
 void st7789_dma_irq_handler(void);
 
+/**
+ * @brief DMA transfer-complete handler for a channel whose IRQ is owned elsewhere
+ * @note Call from the owner's terminal-count callback (e.g. DMA manager, which has
+ *       already read and cleared the channel status).
+ */
+void st7789_dma_tc_handler(void);
+
 #endif /* ST7789_H */
@@ -0,0 +1,57 @@
+# Copyright (c) 2024 HPMicro
+# SPDX-License-Identifier: BSD-3-Clause
+
+# Runs test_spi_capture (TEST_BINARY), saves its dump to CAPTURE_LOG and feeds it to the analyzer.
+# The simulated bus makes the report exact; the expected lines follow from test_spi_capture.c
+# (64x32 panel, 8-line strips, 40 MHz):
+# - 4 DMA strips with the same columns, then one 10x10 window written twice and filled once:
+#   7 flushes, 3 + 2 redundant CASET, 2 redundant RASET;
+# - each flush sends CASET + 4, RASET + 4 and RAMWR before its pixels: 11 bytes in 5 transactions,
+#   2.2 us at 40 MHz;
+# - the bus never idles: pixel phases take the capture span less the command bytes
+#   (939.2 of 954.6 us, 98.4%);
+# - a frame is 4096 bytes, 819.2 us on the wire (1220.7 FPS), plus 4 x 2.2 us of overhead
+#   (828.0 us, 1207.7 FPS).
+
+execute_process(COMMAND ${TEST_BINARY} OUTPUT_VARIABLE out RESULT_VARIABLE result)
+file(WRITE ${CAPTURE_LOG} "${out}")
+if(NOT result EQUAL 0)
+    execute_process(COMMAND ${CMAKE_COMMAND} -E echo "${out}")
+    message(FATAL_ERROR "${TEST_BINARY} failed (${result})")
+endif()
+
+execute_process(COMMAND ${PYTHON} ${ANALYZER} ${CAPTURE_LOG} --width 64 --height 32 --fb-lines 8
+                OUTPUT_VARIABLE report RESULT_VARIABLE result)
+string(STRIP "${report}" report)
+execute_process(COMMAND ${CMAKE_COMMAND} -E echo "${report}")
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "analyzer failed (${result})")
+endif()
+
+set(expected
+    "redundant CASET: 5  redundant RASET: 2"
+    "Flushes: 7  (4 via DMA)"
+    "command bytes/flush:    avg 11.0  transactions/flush: avg 5.0"
+    "command overhead/flush: avg 2.2 us  p95 2.2 us  max 2.2 us"
+    "Bus utilization (pixel phases): 98.4%"
+    "wire only:                 1220.7 FPS (0.82 ms/frame)"
+    "with measured overhead:    1207.7 FPS (0.83 ms/frame)")
+set(missing)
+foreach(line IN LISTS expected)
+    string(FIND "${report}" "${line}" pos)
+    if(pos EQUAL -1)
+        list(APPEND missing "${line}")
+    endif()
+endforeach()
+foreach(line "DMA start failures" "WARNING")
+    string(FIND "${report}" "${line}" pos)
+    if(NOT pos EQUAL -1)
+        list(APPEND missing "no \"${line}\"")
+    endif()
+endforeach()
+
+if(missing)
+    string(REPLACE ";" "\n  " missing "${missing}")
+    message(FATAL_ERROR "analyzer report differs, expected:\n  ${missing}")
+endif()
+message(STATUS "analyzer report matches the transactions sent")
@@ -0,0 +1,22 @@
+/**
+ * @file lv_conf.h
+ * Host configuration for the module tests: the target's standalone configuration with a larger
+ * heap and no panel driver. The RTOS test gets FreeRTOS (POSIX port) as the OS layer from
+ * HPM_LVGL_RTOS, as on the target.
+ */
+
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+#include "lv_conf_standalone.h"
+
+#undef LV_MEM_SIZE
+#define LV_MEM_SIZE (256 * 1024U)
+
+/* No panel on the host */
+#undef LV_USE_ST7789
+#define LV_USE_ST7789 0
+#undef LV_USE_GENERIC_MIPI
+#define LV_USE_GENERIC_MIPI 0
+
+#endif /* LV_CONF_H */
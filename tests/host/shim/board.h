@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Host stand-in for the board header: LCD pins and a sleeping delay.
+ */
+
+#ifndef _HPM_BOARD_H
+#define _HPM_BOARD_H
+
+#include "hpm_soc.h"
+
+#define BOARD_LCD_D_C_INDEX         0U
+#define BOARD_LCD_D_C_PIN           28U
+#define BOARD_LCD_RESET_INDEX       0U
+#define BOARD_LCD_RESET_PIN         30U
+#define BOARD_LCD_BL_INDEX          0U
+#define BOARD_LCD_BL_PIN            25U
+
+void board_delay_ms(uint32_t ms);
+void board_delay_us(uint32_t us);
+
+#endif /* _HPM_BOARD_H */
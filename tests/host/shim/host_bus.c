@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Host LCD bus for st7789.c: SPI, DMA, GPIO and cache stand-ins on a simulated clock
+ *
+ * Replaces the wall-clock hpm_csr_get_core_cycle() of host_sdk.c: time (1 GHz cycles) only moves
+ * while bytes shift out at the configured sclk rate, so a capture of the driver's transactions
+ * has exact, repeatable timestamps.
+ */
+
+#include <string.h>
+#include "hpm_csr_drv.h"
+#include "hpm_clock_drv.h"
+#include "hpm_l1c_drv.h"
+#include "hpm_spi_drv.h"
+#include "hpm_dmav2_drv.h"
+#include "hpm_dmamux_drv.h"
+#include "hpm_gpio_drv.h"
+
+static struct {
+    uint64_t cycle;
+    uint32_t sclk_hz;
+    uint32_t pending;           /* Bytes of the current transfer not yet shifted out */
+    uint32_t dma_status;
+} host_bus;
+
+uint64_t hpm_csr_get_core_cycle(void)
+{
+    return host_bus.cycle;
+}
+
+uint32_t core_local_mem_to_sys_address(uint8_t core_id, uint32_t addr)
+{
+    (void)core_id;
+    return addr;
+}
+
+void clock_add_to_group(clock_name_t clock_name, uint32_t group)
+{
+    (void)clock_name;
+    (void)group;
+}
+
+bool l1c_dc_is_enabled(void)
+{
+    return false;
+}
+
+void l1c_dc_writeback(uint32_t addr, uint32_t size)
+{
+    (void)addr;
+    (void)size;
+}
+
+/*============================================================================
+ * SPI
+ *============================================================================*/
+
+void spi_master_get_default_timing_config(spi_timing_config_t *config)
+{
+    memset(config, 0, sizeof(*config));
+}
+
+hpm_stat_t spi_master_timing_init(SPI_Type *ptr, spi_timing_config_t *config)
+{
+    (void)ptr;
+    if ((config->master_config.sclk_freq_in_hz == 0U) ||
+        (config->master_config.sclk_freq_in_hz > config->master_config.clk_src_freq_in_hz)) {
+        return status_invalid_argument;
+    }
+    host_bus.sclk_hz = config->master_config.sclk_freq_in_hz;
+    return status_success;
+}
+
+void spi_master_get_default_format_config(spi_format_config_t *config)
+{
+    memset(config, 0, sizeof(*config));
+}
+
+void spi_format_init(SPI_Type *ptr, spi_format_config_t *config)
+{
+    (void)ptr;
+    (void)config;
+}
+
+void spi_master_get_default_control_config(spi_control_config_t *config)
+{
+    memset(config, 0, sizeof(*config));
+}
+
+hpm_stat_t spi_control_init(SPI_Type *ptr, spi_control_config_t *config, uint32_t wcount, uint32_t rcount)
+{
+    (void)ptr;
+    (void)config;
+    (void)wcount;
+    (void)rcount;
+    return status_success;
+}
+
+/* Nothing answers: reads return zeros */
+hpm_stat_t spi_transfer(SPI_Type *ptr, spi_control_config_t *config, uint8_t *cmd, uint32_t *addr,
+                        uint8_t *wbuff, uint32_t wcount, uint8_t *rbuff, uint32_t rcount)
+{
+    (void)config;
+    (void)cmd;
+    (void)addr;
+    (void)wbuff;
+    if (rbuff != NULL) {
+        memset(rbuff, 0, rcount);
+    }
+    spi_set_write_data_count(ptr, (wcount > rcount) ? wcount : rcount);
+    (void)spi_is_active(ptr);
+    return status_success;
+}
+
+hpm_stat_t spi_set_write_data_count(SPI_Type *ptr, uint32_t count)
+{
+    (void)ptr;
+    host_bus.pending = count;
+    return status_success;
+}
+
+uint8_t spi_get_tx_fifo_valid_data_size(SPI_Type *ptr)
+{
+    (void)ptr;
+    return 0U;
+}
+
+/* The first wait drains the shifter: the clock moves on by the transfer's wire time */
+bool spi_is_active(SPI_Type *ptr)
+{
+    (void)ptr;
+    if ((host_bus.pending != 0U) && (host_bus.sclk_hz != 0U)) {
+        host_bus.cycle += ((uint64_t)host_bus.pending * 8U * clock_get_frequency(clock_cpu0)) / host_bus.sclk_hz;
+    }
+    host_bus.pending = 0U;
+    return false;
+}
+
+void spi_enable_tx_dma(SPI_Type *ptr)
+{
+    (void)ptr;
+}
+
+void spi_disable_tx_dma(SPI_Type *ptr)
+{
+    (void)ptr;
+}
+
+/*============================================================================
+ * DMA
+ *============================================================================*/
+
+void dma_default_channel_config(DMA_Type *ptr, dma_channel_config_t *ch)
+{
+    (void)ptr;
+    memset(ch, 0, sizeof(*ch));
+}
+
+hpm_stat_t dma_setup_channel(DMA_Type *ptr, uint8_t ch_num, dma_channel_config_t *ch, bool start_transfer)
+{
+    (void)ptr;
+    (void)ch_num;
+    if (ch->size_in_byte == 0U) {
+        return status_invalid_argument;
+    }
+    host_bus.dma_status = start_transfer ? DMA_CHANNEL_STATUS_TC : 0U;
+    return status_success;
+}
+
+uint32_t dma_check_transfer_status(DMA_Type *ptr, uint8_t ch)
+{
+    (void)ptr;
+    (void)ch;
+    return host_bus.dma_status;
+}
+
+void dma_clear_transfer_status(DMA_Type *ptr, uint8_t ch)
+{
+    (void)ptr;
+    (void)ch;
+    host_bus.dma_status = 0U;
+}
+
+void dma_disable_channel(DMA_Type *ptr, uint32_t ch_index)
+{
+    (void)ptr;
+    (void)ch_index;
+    host_bus.dma_status = 0U;
+}
+
+void dma_enable_channel_interrupt(DMA_Type *ptr, uint8_t ch_index, int32_t interrupt_mask)
+{
+    (void)ptr;
+    (void)ch_index;
+    (void)interrupt_mask;
+}
+
+void dmamux_config(DMAMUX_Type *ptr, uint8_t dmamux_ch, uint8_t src, bool enable)
+{
+    (void)ptr;
+    (void)dmamux_ch;
+    (void)src;
+    (void)enable;
+}
+
+/*============================================================================
+ * GPIO
+ *============================================================================*/
+
+void gpio_set_pin_output(GPIO_Type *ptr, uint32_t port, uint8_t pin)
+{
+    (void)ptr;
+    (void)port;
+    (void)pin;
+}
+
+void gpio_set_pin_output_with_initial(GPIO_Type *ptr, uint32_t port, uint8_t pin, uint8_t initial)
+{
+    (void)ptr;
+    (void)port;
+    (void)pin;
+    (void)initial;
+}
+
+void gpio_write_pin(GPIO_Type *ptr, uint32_t port, uint8_t pin, uint8_t high)
+{
+    (void)ptr;
+    (void)port;
+    (void)pin;
+    (void)high;
+}
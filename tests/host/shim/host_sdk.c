@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Host implementations of the SDK stand-ins
+ */
+
+#include <time.h>
+#include "board.h"
+#include "hpm_csr_drv.h"
+#include "hpm_clock_drv.h"
+#include "hpm_interrupt.h"
+
+static SPI_Type host_spi7;
+static DMA_Type host_hdma;
+static DMAMUX_Type host_dmamux;
+static GPIO_Type host_gpio0;
+
+SPI_Type *const HPM_SPI7 = &host_spi7;
+DMA_Type *const HPM_HDMA = &host_hdma;
+DMAMUX_Type *const HPM_DMAMUX = &host_dmamux;
+GPIO_Type *const HPM_GPIO0 = &host_gpio0;
+
+/* Wall clock; host_bus.c replaces it with the simulated bus clock */
+ATTR_WEAK uint64_t hpm_csr_get_core_cycle(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+uint32_t clock_get_frequency(clock_name_t clock_name)
+{
+    (void)clock_name;
+    return 1000000000UL;
+}
+
+uint32_t disable_global_irq(uint32_t mask)
+{
+    return mask;
+}
+
+void restore_global_irq(uint32_t level)
+{
+    (void)level;
+}
+
+void intc_m_enable_irq_with_priority(uint32_t irq, uint32_t priority)
+{
+    (void)irq;
+    (void)priority;
+}
+
+void board_delay_us(uint32_t us)
+{
+    struct timespec ts = { (time_t)(us / 1000000U), (long)(us % 1000000U) * 1000L };
+
+    nanosleep(&ts, NULL);
+}
+
+void board_delay_ms(uint32_t ms)
+{
+    board_delay_us(ms * 1000U);
+}
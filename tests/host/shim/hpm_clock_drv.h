@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Host stand-in: every clock reads 1 GHz, matching hpm_csr_get_core_cycle().
+ */
+
+#ifndef HPM_CLOCK_DRV_H
+#define HPM_CLOCK_DRV_H
+
+#include "hpm_common.h"
+
+typedef enum {
+    clock_cpu0 = 0,
+    clock_cpu1,
+    clock_spi7,
+} clock_name_t;
+
+uint32_t clock_get_frequency(clock_name_t clock_name);
+void clock_add_to_group(clock_name_t clock_name, uint32_t group);
+
+#endif /* HPM_CLOCK_DRV_H */
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Host stand-in for the HPM SDK header: status codes and attributes the adapter uses.
+ */
+
+#ifndef HPM_COMMON_H
+#define HPM_COMMON_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef int32_t hpm_stat_t;
+
+enum {
+    status_success = 0,
+    status_fail = 1,
+    status_invalid_argument = 2,
+    status_timeout = 3,
+};
+
+#define HPM_CORE0                   0U
+#define HPM_CORE1                   1U
+
+/* No sections on the host: everything lands in ordinary (cacheable) RAM */
+#define ATTR_ALIGN(a)               __attribute__((aligned(a)))
+#define ATTR_WEAK                   __attribute__((weak))
+#define ATTR_PLACE_AT_NONCACHEABLE_WITH_ALIGNMENT(a) __attribute__((aligned(a)))
+#define ATTR_PLACE_AT_NONCACHEABLE_BSS_WITH_ALIGNMENT(a) __attribute__((aligned(a)))
+
+#define SDK_DECLARE_EXT_ISR_M(irq, isr) void isr(void);
+
+#endif /* HPM_COMMON_H */
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Host stand-in: the cycle counter runs at 1 GHz (nanoseconds), interrupt masking is a no-op.
+ */
+
+#ifndef HPM_CSR_DRV_H
+#define HPM_CSR_DRV_H
+
+#include "hpm_common.h"
+
+#define CSR_MSTATUS_MIE_MASK        (1UL << 3)
+
+uint64_t hpm_csr_get_core_cycle(void);
+uint32_t disable_global_irq(uint32_t mask);
+void restore_global_irq(uint32_t level);
+
+#endif /* HPM_CSR_DRV_H */
@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Host stand-in: request routing is a no-op (host_bus.c).
+ */
+
+#ifndef HPM_DMAMUX_DRV_H
+#define HPM_DMAMUX_DRV_H
+
+#include "hpm_soc.h"
+
+void dmamux_config(DMAMUX_Type *ptr, uint8_t dmamux_ch, uint8_t src, bool enable);
+
+#endif /* HPM_DMAMUX_DRV_H */
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Host stand-in: the channel calls st7789.c makes (host_bus.c). A started transfer reads
+ * terminal count at once; the SPI stand-in accounts for its time on the wire.
+ */
+
+#ifndef HPM_DMAV2_DRV_H
+#define HPM_DMAV2_DRV_H
+
+#include "hpm_soc.h"
+
+#define DMA_TRANSFER_WIDTH_BYTE             0U
+#define DMA_ADDRESS_CONTROL_INCREMENT       0U
+#define DMA_ADDRESS_CONTROL_FIXED           2U
+#define DMA_HANDSHAKE_MODE_NORMAL           0U
+#define DMA_HANDSHAKE_MODE_HANDSHAKE        1U
+
+#define DMA_INTERRUPT_MASK_TERMINAL_COUNT   (1U << 2)
+
+#define DMA_CHANNEL_STATUS_ONGOING          (1U << 0)
+#define DMA_CHANNEL_STATUS_ERROR            (1U << 1)
+#define DMA_CHANNEL_STATUS_ABORT            (1U << 2)
+#define DMA_CHANNEL_STATUS_TC               (1U << 3)
+
+typedef struct {
+    uint32_t src_addr;
+    uint32_t dst_addr;
+    uint32_t size_in_byte;
+    uint8_t src_width;
+    uint8_t dst_width;
+    uint8_t src_addr_ctrl;
+    uint8_t dst_addr_ctrl;
+    uint8_t src_mode;
+    uint8_t dst_mode;
+} dma_channel_config_t;
+
+void dma_default_channel_config(DMA_Type *ptr, dma_channel_config_t *ch);
+hpm_stat_t dma_setup_channel(DMA_Type *ptr, uint8_t ch_num, dma_channel_config_t *ch, bool start_transfer);
+uint32_t dma_check_transfer_status(DMA_Type *ptr, uint8_t ch);
+void dma_clear_transfer_status(DMA_Type *ptr, uint8_t ch);
+void dma_disable_channel(DMA_Type *ptr, uint32_t ch_index);
+void dma_enable_channel_interrupt(DMA_Type *ptr, uint8_t ch_index, int32_t interrupt_mask);
+
+#endif /* HPM_DMAV2_DRV_H */
@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Host stand-in: the pins st7789.c drives (host_bus.c).
+ */
+
+#ifndef HPM_GPIO_DRV_H
+#define HPM_GPIO_DRV_H
+
+#include "hpm_soc.h"
+
+void gpio_set_pin_output(GPIO_Type *ptr, uint32_t port, uint8_t pin);
+void gpio_set_pin_output_with_initial(GPIO_Type *ptr, uint32_t port, uint8_t pin, uint8_t initial);
+void gpio_write_pin(GPIO_Type *ptr, uint32_t port, uint8_t pin, uint8_t high);
+
+#endif /* HPM_GPIO_DRV_H */
@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Host stand-in: interrupts are simulated by the tests.
+ */
+
+#ifndef HPM_INTERRUPT_H
+#define HPM_INTERRUPT_H
+
+#include "hpm_common.h"
+
+void intc_m_enable_irq_with_priority(uint32_t irq, uint32_t priority);
+
+#endif /* HPM_INTERRUPT_H */
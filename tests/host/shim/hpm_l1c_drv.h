@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Host stand-in: the D-cache reads as disabled (host_bus.c), so nothing is written back.
+ */
+
+#ifndef HPM_L1C_DRV_H
+#define HPM_L1C_DRV_H
+
+#include "hpm_common.h"
+
+#define HPM_L1C_CACHELINE_SIZE              64U
+#define HPM_L1C_CACHELINE_ALIGN_DOWN(n)     ((uint32_t)(n) & ~(HPM_L1C_CACHELINE_SIZE - 1U))
+#define HPM_L1C_CACHELINE_ALIGN_UP(n)       (((uint32_t)(n) + HPM_L1C_CACHELINE_SIZE - 1U) & ~(HPM_L1C_CACHELINE_SIZE - 1U))
+
+bool l1c_dc_is_enabled(void);
+void l1c_dc_writeback(uint32_t addr, uint32_t size);
+
+#endif /* HPM_L1C_DRV_H */
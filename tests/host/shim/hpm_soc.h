@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Host stand-in: peripheral types and instances are placeholders; SPI_Type only has the data
+ * register st7789.c writes.
+ */
+
+#ifndef HPM_SOC_H
+#define HPM_SOC_H
+
+#include "hpm_common.h"
+
+typedef struct { volatile uint32_t DATA; } SPI_Type;
+typedef struct { uint32_t reserved; } DMA_Type;
+typedef struct { uint32_t reserved; } DMAMUX_Type;
+typedef struct { uint32_t reserved; } GPIO_Type;
+
+extern SPI_Type *const HPM_SPI7;
+extern DMA_Type *const HPM_HDMA;
+extern DMAMUX_Type *const HPM_DMAMUX;
+extern GPIO_Type *const HPM_GPIO0;
+
+#define IRQn_HDMA                   1U
+#define HPM_DMA_SRC_SPI7_TX         1U
+#define DMAMUX_MUXCFG_HDMA_MUX0     0U
+
+uint32_t core_local_mem_to_sys_address(uint8_t core_id, uint32_t addr);
+
+#endif /* HPM_SOC_H */
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Host stand-in: the master calls st7789.c makes (host_bus.c). The FIFO never fills; the shifter
+ * stays active until the driver first waits for it, which takes the bytes' time at the sclk rate.
+ */
+
+#ifndef HPM_SPI_DRV_H
+#define HPM_SPI_DRV_H
+
+#include "hpm_soc.h"
+
+#define SPI_SOC_FIFO_DEPTH          8U
+
+typedef enum {
+    spi_master_mode = 0,
+    spi_slave_mode,
+} spi_mode_selection_t;
+
+typedef enum {
+    spi_sclk_low_idle = 0,
+    spi_sclk_high_idle,
+} spi_sclk_idle_state_t;
+
+typedef enum {
+    spi_sclk_sampling_odd_clk_edges = 0,
+    spi_sclk_sampling_even_clk_edges,
+} spi_sclk_sampling_clk_edges_t;
+
+typedef enum {
+    spi_cs2sclk_half_sclk_1 = 0,
+} spi_cs2sclk_duration_t;
+
+typedef enum {
+    spi_csht_half_sclk_1 = 0,
+} spi_csht_duration_t;
+
+typedef enum {
+    spi_trans_write_read_together = 0,
+    spi_trans_write_only,
+} spi_trans_mode_t;
+
+typedef enum {
+    spi_single_io_mode = 0,
+} spi_data_phase_format_t;
+
+typedef enum {
+    spi_dummy_count_1 = 0,
+} spi_dummy_count_t;
+
+typedef struct {
+    struct {
+        uint32_t clk_src_freq_in_hz;
+        uint32_t sclk_freq_in_hz;
+        uint8_t cs2sclk;
+        uint8_t csht;
+    } master_config;
+} spi_timing_config_t;
+
+typedef struct {
+    struct {
+        uint8_t addr_len_in_bytes;
+    } master_config;
+    struct {
+        uint8_t data_len_in_bits;
+        bool data_merge;
+        bool mosi_bidir;
+        bool lsb;
+        uint8_t mode;
+        uint8_t cpol;
+        uint8_t cpha;
+    } common_config;
+} spi_format_config_t;
+
+typedef struct {
+    struct {
+        bool cmd_enable;
+        bool addr_enable;
+        bool token_enable;
+    } master_config;
+    struct {
+        bool tx_dma_enable;
+        bool rx_dma_enable;
+        uint8_t trans_mode;
+        uint8_t data_phase_fmt;
+        uint8_t dummy_cnt;
+    } common_config;
+} spi_control_config_t;
+
+void spi_master_get_default_timing_config(spi_timing_config_t *config);
+hpm_stat_t spi_master_timing_init(SPI_Type *ptr, spi_timing_config_t *config);
+void spi_master_get_default_format_config(spi_format_config_t *config);
+void spi_format_init(SPI_Type *ptr, spi_format_config_t *config);
+void spi_master_get_default_control_config(spi_control_config_t *config);
+hpm_stat_t spi_control_init(SPI_Type *ptr, spi_control_config_t *config, uint32_t wcount, uint32_t rcount);
+hpm_stat_t spi_transfer(SPI_Type *ptr, spi_control_config_t *config, uint8_t *cmd, uint32_t *addr,
+                        uint8_t *wbuff, uint32_t wcount, uint8_t *rbuff, uint32_t rcount);
+hpm_stat_t spi_set_write_data_count(SPI_Type *ptr, uint32_t count);
+uint8_t spi_get_tx_fifo_valid_data_size(SPI_Type *ptr);
+bool spi_is_active(SPI_Type *ptr);
+void spi_enable_tx_dma(SPI_Type *ptr);
+void spi_disable_tx_dma(SPI_Type *ptr);
+
+#endif /* HPM_SPI_DRV_H */
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * DSP kernel bit-exactness test
+ *
+ * Every kernel in src/hpm_lvgl_dsp.c (portable build, which computes what the packed instructions
+ * do) runs against LVGL's own C loop for the same blend, from an LVGL built without the hooks.
+ * Random colors, opacities and pixels; odd widths, destinations starting on a halfword, padded
+ * strides. Destination padding is compared too, so a kernel writing past a row fails as well.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "lvgl.h"
+#if defined(__has_include)
+#if __has_include("lvgl_private.h")
+#include "lvgl_private.h"   /* LVGL >= 9.2: blend descriptors */
+#endif
+#endif
+#include "hpm_lvgl_dsp.h"
+#include "test_util.h"
+
+#if !HPM_LVGL_DSP
+#error "Build this file with HPM_LVGL_DSP=1"
+#endif
+
+/* LVGL's blend entry points for RGB565 destinations (lv_draw_sw_blend_to_rgb565.c) */
+void lv_draw_sw_blend_color_to_rgb565(lv_draw_sw_blend_fill_dsc_t *dsc);
+void lv_draw_sw_blend_image_to_rgb565(lv_draw_sw_blend_image_dsc_t *dsc);
+
+#define TEST_ROUNDS         2000U
+#define TEST_MAX_W          67
+#define TEST_MAX_H          9
+#define TEST_MAX_PAD        5           /* Extra pixels per row */
+#define TEST_BUF_PX         ((TEST_MAX_W + TEST_MAX_PAD + 2) * TEST_MAX_H + 2)
+
+/*============================================================================
+ * Random areas
+ *============================================================================*/
+
+static uint32_t test_rand_range(uint32_t lo, uint32_t hi)
+{
+    return lo + (test_rand() % (hi - lo + 1U));
+}
+
+static void test_fill_random(void *buf, size_t bytes)
+{
+    uint8_t *p = buf;
+
+    for (size_t i = 0; i < bytes; i++) {
+        p[i] = (uint8_t)test_rand();
+    }
+}
+
+/* Destination: both copies start alike; the area starts 0 or 1 pixel into a word-aligned buffer */
+typedef struct {
+    uint16_t ref[TEST_BUF_PX] __attribute__((aligned(4)));
+    uint16_t dsp[TEST_BUF_PX] __attribute__((aligned(4)));
+    uint32_t offset;
+    int32_t w;
+    int32_t h;
+    int32_t stride;
+} test_dst_t;
+
+static void test_dst_init(test_dst_t *d)
+{
+    d->w = (int32_t)test_rand_range(1U, TEST_MAX_W);
+    d->h = (int32_t)test_rand_range(1U, TEST_MAX_H);
+    d->stride = (d->w + (int32_t)test_rand_range(0U, TEST_MAX_PAD)) * (int32_t)sizeof(uint16_t);
+    d->offset = test_rand() & 1U;
+    test_fill_random(d->ref, sizeof(d->ref));
+    memcpy(d->dsp, d->ref, sizeof(d->ref));
+}
+
+static bool test_dst_equal(const test_dst_t *d, const char *kernel, uint32_t round)
+{
+    if (memcmp(d->ref, d->dsp, sizeof(d->ref)) == 0) {
+        return true;
+    }
+    for (uint32_t i = 0; i < TEST_BUF_PX; i++) {
+        if (d->ref[i] != d->dsp[i]) {
+            printf("FAIL: %s round %u (w %d h %d stride %d offset %u): px %u is 0x%04X, LVGL 0x%04X\n", kernel,
+                   (unsigned int)round, (int)d->w, (int)d->h, (int)d->stride, (unsigned int)d->offset,
+                   (unsigned int)i, (unsigned int)d->dsp[i], (unsigned int)d->ref[i]);
+            break;
+        }
+    }
+    test_failures++;
+    return false;
+}
+
+static lv_color_t test_rand_color(void)
+{
+    uint32_t c = test_rand();
+
+    return lv_color_make((uint8_t)c, (uint8_t)(c >> 8), (uint8_t)(c >> 16));
+}
+
+/* Opacities LVGL hands to the "with opa" hooks: above LV_OPA_MIN, below LV_OPA_MAX */
+static uint8_t test_rand_opa(void)
+{
+    return (uint8_t)test_rand_range(LV_OPA_MIN + 1U, LV_OPA_MAX - 1U);
+}
+
+/*============================================================================
+ * Kernels
+ *============================================================================*/
+
+static void test_fill(bool with_opa)
+{
+    static test_dst_t d;
+    const char *name = with_opa ? "fill_opa" : "fill";
+
+    for (uint32_t round = 0; round < TEST_ROUNDS; round++) {
+        lv_draw_sw_blend_fill_dsc_t dsc;
+        lv_area_t area;
+
+        test_dst_init(&d);
+        lv_area_set(&area, 0, 0, d.w - 1, d.h - 1);
+        memset(&dsc, 0, sizeof(dsc));
+        dsc.dest_buf = &d.ref[d.offset];
+        dsc.dest_w = d.w;
+        dsc.dest_h = d.h;
+        dsc.dest_stride = d.stride;
+        dsc.color = test_rand_color();
+        dsc.opa = with_opa ? test_rand_opa() : (lv_opa_t)test_rand_range(LV_OPA_MAX, LV_OPA_COVER);
+        dsc.relative_area = area;
+        lv_draw_sw_blend_color_to_rgb565(&dsc);
+
+        if (with_opa) {
+            hpm_lvgl_dsp_fill_opa(&d.dsp[d.offset], d.w, d.h, d.stride, lv_color_to_u16(dsc.color), dsc.opa);
+        } else {
+            hpm_lvgl_dsp_fill(&d.dsp[d.offset], d.w, d.h, d.stride, lv_color_to_u16(dsc.color));
+        }
+        if (!test_dst_equal(&d, name, round)) {
+            return;
+        }
+    }
+}
+
+static void test_image(lv_color_format_t cf, bool with_opa)
+{
+    static test_dst_t d;
+    static uint32_t src[TEST_BUF_PX + 1];
+    const char *name = (cf == LV_COLOR_FORMAT_RGB565) ? "rgb565_blend_opa"
+                       : (with_opa ? "argb8888_blend opa" : "argb8888_blend");
+    uint32_t src_px_size = (cf == LV_COLOR_FORMAT_RGB565) ? sizeof(uint16_t) : sizeof(uint32_t);
+
+    for (uint32_t round = 0; round < TEST_ROUNDS; round++) {
+        lv_draw_sw_blend_image_dsc_t dsc;
+        lv_area_t area;
+
+        test_dst_init(&d);
+        test_fill_random(src, sizeof(src));
+        /* Mostly opaque and transparent pixels, as in antialiased images, plus everything between */
+        if (cf == LV_COLOR_FORMAT_ARGB8888) {
+            for (uint32_t i = 0; i < TEST_BUF_PX; i++) {
+                uint32_t kind = test_rand() & 3U;
+                if (kind == 0U) {
+                    src[i] |= 0xFF000000UL;
+                } else if (kind == 1U) {
+                    src[i] &= 0x00FFFFFFUL;
+                }
+            }
+        }
+
+        /* Source rows: padded stride, RGB565 sources may start on a halfword */
+        uint32_t src_offset = (cf == LV_COLOR_FORMAT_RGB565) ? (test_rand() & 1U) : 0U;
+        int32_t src_stride = (d.w + (int32_t)test_rand_range(0U, TEST_MAX_PAD)) * (int32_t)src_px_size;
+        const uint8_t *src_buf = (const uint8_t *)src + src_offset * src_px_size;
+
+        lv_area_set(&area, 0, 0, d.w - 1, d.h - 1);
+        memset(&dsc, 0, sizeof(dsc));
+        dsc.dest_buf = &d.ref[d.offset];
+        dsc.dest_w = d.w;
+        dsc.dest_h = d.h;
+        dsc.dest_stride = d.stride;
+        dsc.src_buf = src_buf;
+        dsc.src_stride = src_stride;
+        dsc.src_color_format = cf;
+        dsc.opa = with_opa ? test_rand_opa() : (lv_opa_t)test_rand_range(LV_OPA_MAX, LV_OPA_COVER);
+        dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+        dsc.relative_area = area;
+        dsc.src_area = area;
+        lv_draw_sw_blend_image_to_rgb565(&dsc);
+
+        if (cf == LV_COLOR_FORMAT_RGB565) {
+            hpm_lvgl_dsp_rgb565_blend_opa(&d.dsp[d.offset], d.w, d.h, d.stride, (const uint16_t *)src_buf,
+                                          src_stride, dsc.opa);
+        } else {
+            /* The no-opa hook passes 255 whatever dsc->opa is */
+            hpm_lvgl_dsp_argb8888_blend(&d.dsp[d.offset], d.w, d.h, d.stride, (const uint32_t *)src_buf,
+                                        src_stride, with_opa ? dsc.opa : 255U);
+        }
+        if (!test_dst_equal(&d, name, round)) {
+            return;
+        }
+    }
+}
+
+static void test_swap(void)
+{
+    static uint16_t orig[TEST_BUF_PX] __attribute__((aligned(4)));
+    static uint16_t ref[TEST_BUF_PX] __attribute__((aligned(4)));
+    static uint16_t dsp[TEST_BUF_PX] __attribute__((aligned(4)));
+
+    for (uint32_t round = 0; round < TEST_ROUNDS; round++) {
+        uint32_t offset = test_rand() & 1U;
+        uint32_t px = test_rand_range(1U, TEST_BUF_PX - 1U);
+
+        test_fill_random(orig, sizeof(orig));
+        memcpy(dsp, orig, sizeof(orig));
+        hpm_lvgl_dsp_rgb565_swap(&dsp[offset], px);
+
+        /* LVGL's loop reads words: give it the same pixels word-aligned */
+        memcpy(ref, &orig[offset], px * sizeof(uint16_t));
+        lv_draw_sw_rgb565_swap(ref, px);
+
+        bool ok = (memcmp(ref, &dsp[offset], px * sizeof(uint16_t)) == 0) && ((offset == 0U) || (dsp[0] == orig[0])) &&
+                  (memcmp(&dsp[offset + px], &orig[offset + px], (TEST_BUF_PX - offset - px) * sizeof(uint16_t)) == 0);
+        if (!ok) {
+            TEST_CHECK(false, "rgb565_swap round %u (%u px at offset %u)", (unsigned int)round, (unsigned int)px,
+                       (unsigned int)offset);
+            return;
+        }
+    }
+}
+
+int main(void)
+{
+    test_fill(false);
+    test_fill(true);
+    test_image(LV_COLOR_FORMAT_RGB565, true);
+    test_image(LV_COLOR_FORMAT_ARGB8888, false);
+    test_image(LV_COLOR_FORMAT_ARGB8888, true);
+    test_swap();
+
+    return test_result(NULL);
+}
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Dual-core ring test
+ *
+ * src/hpm_lvgl_dualcore.c is built twice, as the core 0 image (HPM_LVGL_DUALCORE=1) and as the
+ * core 1 image (=2), and both run here on their own threads over one shared block. A third thread
+ * plays core 1's SPI DMA: it checks every draw buffer it is handed and completes it later, as the
+ * DMA interrupt would. Checked:
+ * - attach times out while core 1 is not running;
+ * - draw buffers reach the bus whole and in order, commands in order between them;
+ * - the ring wraps many times and fills up (sends wait for a free slot);
+ * - every message is completed, and rendering overlaps the transfers;
+ * - with core 1 stalled, a send on a full ring gives up after HPM_LVGL_DUALCORE_SEND_TIMEOUT_MS.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include "hpm_lvgl_dualcore.h"
+#include "hpm_csr_drv.h"
+#include "board.h"
+#include "st7789.h"
+#include "test_util.h"
+
+#if HPM_LVGL_DUALCORE != 1
+#error "Build this file as the core 0 side (HPM_LVGL_DUALCORE=1)"
+#endif
+
+/* Core 1 image (built with HPM_LVGL_DUALCORE=2) */
+hpm_stat_t hpm_lvgl_dualcore_transport_init(void);
+bool hpm_lvgl_dualcore_transport_poll(void);
+
+#define TEST_BANDS          2000U
+#define TEST_BAND_WORDS     1024U
+#define TEST_RENDER_US      200U
+#define TEST_XFER_US        300U
+#define TEST_CMD_EVERY      50U     /* Bands between command bursts */
+#define TEST_CMD_BURST      (HPM_LVGL_DUALCORE_RING_LEN + 4U)
+
+/* The SDK's SHARE_RAM region */
+uint8_t __share_mem_start__[4096] __attribute__((aligned(64)));
+
+/* Draw buffers: handed over by a 32-bit address, as on the target (the test links without PIE) */
+static uint32_t test_fb[2][TEST_BAND_WORDS];
+
+static volatile bool test_core1_run;
+
+/*============================================================================
+ * Core 1 side: st7789.c with a simulated DMA
+ *============================================================================*/
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    const uint32_t *data;
+    uint32_t len;
+    st7789_dma_done_cb_t cb;
+    void *user_data;
+
+    /* Checked by the DMA thread */
+    uint32_t xfers;
+    uint32_t last_band;
+    uint32_t torn;
+    uint32_t out_of_order;
+    uint32_t cmds;
+    uint32_t last_freq;
+    uint32_t cmd_out_of_order;
+} test_dma = { .lock = PTHREAD_MUTEX_INITIALIZER, .cond = PTHREAD_COND_INITIALIZER };
+
+hpm_stat_t st7789_init(const st7789_config_t *config)
+{
+    (void)config;
+    return status_success;
+}
+
+void st7789_set_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+{
+    (void)x0;
+    (void)y0;
+    (void)x1;
+    (void)y1;
+}
+
+hpm_stat_t st7789_write_pixels_dma(const void *data, uint32_t len, st7789_dma_done_cb_t callback, void *user_data)
+{
+    pthread_mutex_lock(&test_dma.lock);
+    test_dma.data = (const uint32_t *)data;
+    test_dma.len = len;
+    test_dma.cb = callback;
+    test_dma.user_data = user_data;
+    pthread_cond_signal(&test_dma.cond);
+    pthread_mutex_unlock(&test_dma.lock);
+    return status_success;
+}
+
+void st7789_write_pixels(const uint16_t *data, uint32_t pixel_count)
+{
+    (void)data;
+    (void)pixel_count;
+    test_failures++;
+    printf("FAIL: blocking fallback used\n");
+}
+
+void st7789_backlight(bool on)
+{
+    (void)on;
+    test_dma.cmds++;
+}
+
+void st7789_set_rotation(uint16_t rotation)
+{
+    (void)rotation;
+    test_dma.cmds++;
+}
+
+hpm_stat_t st7789_set_spi_freq(uint32_t freq_hz)
+{
+    /* Commands carry an increasing argument: they must run in queue order */
+    if (freq_hz <= test_dma.last_freq) {
+        test_dma.cmd_out_of_order++;
+    }
+    test_dma.last_freq = freq_hz;
+    test_dma.cmds++;
+    return status_success;
+}
+
+void st7789_dma_irq_handler(void)
+{
+}
+
+/* One transfer at a time, completed from this thread like the DMA interrupt */
+static void *test_dma_thread(void *arg)
+{
+    (void)arg;
+
+    for (;;) {
+        pthread_mutex_lock(&test_dma.lock);
+        while ((test_dma.cb == NULL) && test_core1_run) {
+            pthread_cond_wait(&test_dma.cond, &test_dma.lock);
+        }
+        if (test_dma.cb == NULL) {
+            pthread_mutex_unlock(&test_dma.lock);
+            return NULL;
+        }
+        const uint32_t *w = test_dma.data;
+        uint32_t words = test_dma.len / 4U;
+        st7789_dma_done_cb_t cb = test_dma.cb;
+        void *user_data = test_dma.user_data;
+        pthread_mutex_unlock(&test_dma.lock);
+
+        /* The buffer must not change while it is on the bus */
+        uint32_t band = w[0];
+        board_delay_us(TEST_XFER_US);
+        for (uint32_t i = 0; i < words; i++) {
+            if (w[i] != band) {
+                test_dma.torn++;
+                break;
+            }
+        }
+        if (band != (test_dma.last_band + 1U)) {
+            test_dma.out_of_order++;
+        }
+        test_dma.last_band = band;
+        test_dma.xfers++;
+
+        pthread_mutex_lock(&test_dma.lock);
+        test_dma.cb = NULL;
+        pthread_mutex_unlock(&test_dma.lock);
+        cb(user_data);
+    }
+}
+
+static void *test_core1_thread(void *arg)
+{
+    (void)arg;
+
+    if (hpm_lvgl_dualcore_transport_init() != status_success) {
+        test_failures++;
+        return NULL;
+    }
+    while (test_core1_run) {
+        if (!hpm_lvgl_dualcore_transport_poll()) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/*============================================================================
+ * Core 0 side
+ *============================================================================*/
+
+static void test_wait_done(uint32_t seq)
+{
+    while (!hpm_lvgl_dualcore_done(seq, NULL)) {
+        sched_yield();
+    }
+}
+
+int main(void)
+{
+    pthread_t core1;
+    pthread_t dma;
+    uint32_t seq[2] = { 0, 0 };
+    uint32_t freq = 0;
+    uint32_t cmds_sent = 0;
+    uint32_t last_seq = 0;
+    uint64_t render_us = 0;
+    hpm_lvgl_dualcore_stats_t s;
+
+    if (((uintptr_t)test_fb[1] + sizeof(test_fb[1])) > UINT32_MAX) {
+        printf("FAIL: draw buffers above 4 GB, build without PIE\n");
+        return 1;
+    }
+
+    /* Core 1 not running yet */
+    TEST_CHECK(hpm_lvgl_dualcore_attach() == status_timeout, "attach without core 1 did not time out");
+
+    test_core1_run = true;
+    pthread_create(&dma, NULL, test_dma_thread, NULL);
+    pthread_create(&core1, NULL, test_core1_thread, NULL);
+    TEST_CHECK(hpm_lvgl_dualcore_attach() == status_success, "attach failed");
+    while (!hpm_lvgl_dualcore_panel_ready()) {
+        sched_yield();
+    }
+
+    /* Double-buffered rendering: fill one buffer while the other is on the bus */
+    uint64_t start = hpm_csr_get_core_cycle();
+    for (uint32_t band = 1; band <= TEST_BANDS; band++) {
+        uint32_t i = band & 1U;
+
+        if (seq[i] != 0U) {
+            test_wait_done(seq[i]);
+        }
+        for (uint32_t k = 0; k < TEST_BAND_WORDS; k++) {
+            test_fb[i][k] = band;
+        }
+        uint64_t render_start = hpm_csr_get_core_cycle();
+        board_delay_us(TEST_RENDER_US);
+        render_us += (hpm_csr_get_core_cycle() - render_start) / 1000U;
+
+        hpm_lvgl_dualcore_msg_t msg = { 0 };
+        msg.type = HPM_LVGL_DUALCORE_MSG_PIXELS;
+        msg.addr = (uint32_t)(uintptr_t)test_fb[i];
+        msg.len = sizeof(test_fb[i]);
+        TEST_CHECK(hpm_lvgl_dualcore_send(&msg) == status_success, "send of band %u failed", (unsigned int)band);
+        seq[i] = msg.seq;
+        last_seq = msg.seq;
+
+        /* More commands than the ring holds: the sends have to wait for core 1 */
+        if ((band % TEST_CMD_EVERY) == 0U) {
+            for (uint32_t c = 0; c < TEST_CMD_BURST; c++) {
+                hpm_lvgl_dualcore_msg_t cmd = { 0 };
+                cmd.type = HPM_LVGL_DUALCORE_MSG_SPI_FREQ;
+                cmd.arg = ++freq;
+                TEST_CHECK(hpm_lvgl_dualcore_send(&cmd) == status_success, "command send failed");
+                last_seq = cmd.seq;
+                cmds_sent++;
+            }
+        }
+    }
+    test_wait_done(last_seq);
+    uint64_t elapsed_us = (hpm_csr_get_core_cycle() - start) / 1000U;
+
+    /* One core would render and then send: the sum of both, as measured on each side */
+    hpm_lvgl_dualcore_get_stats(&s);
+    uint64_t serial_us = render_us + s.core1_busy_us;
+    printf("bands=%u xfers=%u torn=%u out_of_order=%u cmds=%u/%u cmd_out_of_order=%u\n", (unsigned int)TEST_BANDS,
+           (unsigned int)test_dma.xfers, (unsigned int)test_dma.torn, (unsigned int)test_dma.out_of_order,
+           (unsigned int)test_dma.cmds, (unsigned int)cmds_sent, (unsigned int)test_dma.cmd_out_of_order);
+    printf("sent=%u done=%u ring_full=%u max_depth=%u/%u elapsed_us=%llu serial_us=%llu\n", (unsigned int)s.sent,
+           (unsigned int)s.done, (unsigned int)s.ring_full, (unsigned int)s.max_depth,
+           (unsigned int)HPM_LVGL_DUALCORE_RING_LEN, (unsigned long long)elapsed_us, (unsigned long long)serial_us);
+
+    TEST_CHECK(test_dma.xfers == TEST_BANDS, "transfers");
+    TEST_CHECK(test_dma.torn == 0U, "draw buffer changed while on the bus");
+    TEST_CHECK(test_dma.out_of_order == 0U, "draw buffers out of order");
+    TEST_CHECK(test_dma.cmds == cmds_sent, "commands lost");
+    TEST_CHECK(test_dma.cmd_out_of_order == 0U, "commands out of order");
+    TEST_CHECK(s.done == s.sent, "not every message completed");
+    TEST_CHECK(s.ring_full > 0U, "the ring never filled up");
+    TEST_CHECK(s.max_depth <= HPM_LVGL_DUALCORE_RING_LEN, "ring overfilled");
+    TEST_CHECK(elapsed_us < serial_us, "rendering did not overlap the transfers");
+
+    /* Core 1 stalls: the ring fills, then a send gives up instead of spinning forever */
+    test_core1_run = false;
+    pthread_join(core1, NULL);
+    pthread_mutex_lock(&test_dma.lock);
+    pthread_cond_signal(&test_dma.cond);
+    pthread_mutex_unlock(&test_dma.lock);
+    pthread_join(dma, NULL);
+
+    for (uint32_t c = 0; c < HPM_LVGL_DUALCORE_RING_LEN; c++) {
+        hpm_lvgl_dualcore_msg_t cmd = { 0 };
+        cmd.type = HPM_LVGL_DUALCORE_MSG_BACKLIGHT;
+        TEST_CHECK(hpm_lvgl_dualcore_send(&cmd) == status_success, "send into a free slot failed");
+    }
+    hpm_lvgl_dualcore_msg_t cmd = { 0 };
+    cmd.type = HPM_LVGL_DUALCORE_MSG_BACKLIGHT;
+    start = hpm_csr_get_core_cycle();
+    TEST_CHECK(hpm_lvgl_dualcore_send(&cmd) == status_timeout, "send on a stalled ring did not time out");
+    elapsed_us = (hpm_csr_get_core_cycle() - start) / 1000U;
+    hpm_lvgl_dualcore_get_stats(&s);
+    TEST_CHECK(s.send_timeouts == 1U, "timeout not counted");
+    TEST_CHECK(elapsed_us >= (HPM_LVGL_DUALCORE_SEND_TIMEOUT_MS * 1000U), "gave up too early");
+
+    return test_result(NULL);
+}
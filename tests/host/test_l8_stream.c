@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * L8 expansion and staging ring test
+ *
+ * src/hpm_lvgl_l8.c with a small chunk size, built once per staging slot count. Checked:
+ * - hpm_lvgl_l8_expand() matches a plain LUT loop for any length and source/destination
+ *   alignment, and writes nothing past the end;
+ * - a strip streamed the way the DMA path does it (stream_begin, stream_next, start, then only
+ *   the completion handler: stream_next, start, stream_prefetch) arrives whole and in order, also
+ *   when the completion runs right after each start, and with a last chunk shorter than the rest;
+ * - no slot changes while its chunk is on the bus;
+ * - the blocking fallback loop sends the same bytes, and an abort ends the strip.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "hpm_lvgl_l8.h"
+
+#define TEST_RAND_SEED      0x9E3779B9UL
+#include "test_util.h"
+
+#if !HPM_LVGL_L8
+#error "Build this file with HPM_LVGL_L8=1"
+#endif
+
+#define TEST_ROUNDS         3000U
+#define TEST_MAX_PX         (HPM_LVGL_L8_CHUNK_PX * (HPM_LVGL_L8_STAGE_SLOTS + 5U) + 7U)
+#define TEST_GUARD          0xA5A5U
+
+/* Native RGB565 loaded into the LUT, and what the wire must carry for each L8 value */
+static uint16_t test_lut[256];
+static uint16_t test_wire[256];
+
+static uint8_t test_src[TEST_MAX_PX + 4] __attribute__((aligned(4)));
+static uint16_t test_out[TEST_MAX_PX + 4] __attribute__((aligned(4)));
+
+/*============================================================================
+ * Expansion
+ *============================================================================*/
+
+static void test_expand(void)
+{
+    for (uint32_t round = 0; round < TEST_ROUNDS; round++) {
+        uint32_t src_off = test_rand() & 3U;
+        uint32_t dst_off = test_rand() & 1U;
+        uint32_t px = test_rand() % (TEST_MAX_PX - 1U);
+
+        for (uint32_t i = 0; i < px; i++) {
+            test_src[src_off + i] = (uint8_t)test_rand();
+        }
+        for (uint32_t i = 0; i < (TEST_MAX_PX + 4U); i++) {
+            test_out[i] = TEST_GUARD;
+        }
+
+        hpm_lvgl_l8_expand(&test_out[dst_off], &test_src[src_off], px);
+
+        bool ok = (dst_off == 0U) || (test_out[0] == TEST_GUARD);
+        for (uint32_t i = 0; ok && (i < px); i++) {
+            ok = (test_out[dst_off + i] == test_wire[test_src[src_off + i]]);
+        }
+        ok = ok && (test_out[dst_off + px] == TEST_GUARD);
+        if (!ok) {
+            TEST_CHECK(false, "expand round %u (%u px, src +%u, dst +%u)", (unsigned int)round, (unsigned int)px,
+                       (unsigned int)src_off, (unsigned int)dst_off);
+            return;
+        }
+    }
+}
+
+/*============================================================================
+ * Streaming
+ *============================================================================*/
+
+/* The chunk on the simulated bus, and a copy taken when its transfer started */
+static struct {
+    const uint8_t *chunk;
+    uint32_t len;
+    uint8_t copy[HPM_LVGL_L8_CHUNK_PX * 2U];
+    uint32_t pos;               /* Bytes of the strip sent */
+    uint32_t chunks;
+    bool torn;
+} test_bus;
+
+static void test_bus_start(const uint8_t *chunk, uint32_t len)
+{
+    test_bus.chunk = chunk;
+    test_bus.len = len;
+    memcpy(test_bus.copy, chunk, len);
+    test_bus.chunks++;
+}
+
+/* Transfer done: the bytes leave as they were at the start */
+static void test_bus_done(void)
+{
+    if (memcmp(test_bus.copy, test_bus.chunk, test_bus.len) != 0) {
+        test_bus.torn = true;
+    }
+    if ((test_bus.pos + test_bus.len) <= sizeof(test_out)) {
+        memcpy((uint8_t *)test_out + test_bus.pos, test_bus.copy, test_bus.len);
+    }
+    test_bus.pos += test_bus.len;
+}
+
+/* As the TC callback / lvgl_dma_done_cb(): next chunk at once, then expand ahead. */
+static bool test_dma_isr(void)
+{
+    uint32_t len = 0;
+
+    test_bus_done();
+    const uint8_t *chunk = hpm_lvgl_l8_stream_next(&len);
+    if (chunk == NULL) {
+        return false;
+    }
+    test_bus_start(chunk, len);
+    hpm_lvgl_l8_stream_prefetch();
+    return true;
+}
+
+static bool test_strip_ok(const uint8_t *src, uint32_t px)
+{
+    if (test_bus.pos != (px * 2U)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < px; i++) {
+        if (test_out[i] != test_wire[src[i]]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_stream(void)
+{
+    for (uint32_t round = 0; round < TEST_ROUNDS; round++) {
+        uint32_t off = test_rand() & 3U;
+        uint32_t px;
+
+        /* Whole chunks, whole chunks plus a short last one, less than a chunk */
+        switch (round % 3U) {
+        case 0:
+            px = HPM_LVGL_L8_CHUNK_PX * (1U + (test_rand() % (HPM_LVGL_L8_STAGE_SLOTS + 4U)));
+            break;
+        case 1:
+            px = (HPM_LVGL_L8_CHUNK_PX * (test_rand() % (HPM_LVGL_L8_STAGE_SLOTS + 4U))) + 1U +
+                 (test_rand() % (HPM_LVGL_L8_CHUNK_PX - 1U));
+            break;
+        default:
+            px = 1U + (test_rand() % HPM_LVGL_L8_CHUNK_PX);
+            break;
+        }
+        for (uint32_t i = 0; i < px; i++) {
+            test_src[off + i] = (uint8_t)test_rand();
+        }
+
+        /* Flush callback: stage, start the first chunk; nothing else in thread context */
+        uint32_t len = 0;
+        memset(&test_bus, 0, sizeof(test_bus));
+        hpm_lvgl_l8_stream_begin(&test_src[off], px);
+        const uint8_t *chunk = hpm_lvgl_l8_stream_next(&len);
+        TEST_CHECK(chunk != NULL, "no first chunk");
+        if (chunk == NULL) {
+            return;
+        }
+        test_bus_start(chunk, len);
+
+        /* Each completion interrupt runs as soon as its transfer started */
+        uint32_t limit = (px / HPM_LVGL_L8_CHUNK_PX) + 2U;
+        while (test_dma_isr() && (limit-- > 0U)) {
+        }
+
+        uint32_t expect_chunks = (px + HPM_LVGL_L8_CHUNK_PX - 1U) / HPM_LVGL_L8_CHUNK_PX;
+        if (!test_strip_ok(&test_src[off], px) || test_bus.torn || (test_bus.chunks != expect_chunks)) {
+            TEST_CHECK(false, "stream round %u (%u px at +%u): %u of %u bytes in %u chunks%s", (unsigned int)round,
+                       (unsigned int)px, (unsigned int)off, (unsigned int)test_bus.pos, (unsigned int)(px * 2U),
+                       (unsigned int)test_bus.chunks, test_bus.torn ? ", slot changed on the bus" : "");
+            return;
+        }
+    }
+}
+
+/* The blocking fallback: next, send, prefetch, all in the flush callback */
+static void test_stream_blocking(void)
+{
+    for (uint32_t round = 0; round < (TEST_ROUNDS / 4U); round++) {
+        uint32_t px = 1U + (test_rand() % (TEST_MAX_PX - 1U));
+        uint32_t len = 0;
+        const uint8_t *chunk;
+
+        for (uint32_t i = 0; i < px; i++) {
+            test_src[i] = (uint8_t)test_rand();
+        }
+        memset(&test_bus, 0, sizeof(test_bus));
+        hpm_lvgl_l8_stream_begin(test_src, px);
+        while ((chunk = hpm_lvgl_l8_stream_next(&len)) != NULL) {
+            test_bus_start(chunk, len);
+            test_bus_done();
+            hpm_lvgl_l8_stream_prefetch();
+        }
+        if (!test_strip_ok(test_src, px)) {
+            TEST_CHECK(false, "blocking round %u (%u px): %u bytes", (unsigned int)round, (unsigned int)px,
+                       (unsigned int)test_bus.pos);
+            return;
+        }
+    }
+}
+
+static void test_abort(void)
+{
+    hpm_lvgl_l8_stats_t s;
+    uint32_t len = 0;
+
+    hpm_lvgl_l8_reset();
+    hpm_lvgl_l8_stream_begin(test_src, TEST_MAX_PX);
+    TEST_CHECK(hpm_lvgl_l8_stream_next(&len) != NULL, "no first chunk");
+    hpm_lvgl_l8_stream_abort();
+    TEST_CHECK(hpm_lvgl_l8_stream_next(&len) == NULL, "chunk after an abort");
+    hpm_lvgl_l8_get_stats(&s);
+    TEST_CHECK((s.strips == 1U) && (s.chunks == 1U) && (s.errors == 1U), "abort stats");
+}
+
+int main(void)
+{
+    lv_init();
+    lv_display_t *disp = lv_display_create(64, 16);
+    TEST_CHECK(hpm_lvgl_l8_init(disp) == status_success, "init");
+
+    for (uint32_t i = 0; i < 256U; i++) {
+        test_lut[i] = (uint16_t)test_rand();
+        test_wire[i] = (uint16_t)((test_lut[i] >> 8) | (test_lut[i] << 8));
+    }
+    hpm_lvgl_l8_set_lut(test_lut);
+
+    test_expand();
+    test_stream();
+    test_stream_blocking();
+    test_abort();
+
+    char label[40];
+    snprintf(label, sizeof(label), "chunk_px=%u slots=%u", (unsigned int)HPM_LVGL_L8_CHUNK_PX,
+             (unsigned int)HPM_LVGL_L8_STAGE_SLOTS);
+    return test_result(label);
+}
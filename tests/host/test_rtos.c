@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * FreeRTOS integration test
+ *
+ * src/hpm_lvgl_rtos.c runs on the FreeRTOS POSIX port with a real LVGL (LV_OS_FREERTOS). The
+ * display bring-up is replaced by a small display whose flush starts a simulated DMA: a task above
+ * the LVGL task plays the completion interrupt. A worker task below it changes the UI. Checked:
+ * - flush completions are deferred: the ISR only hands them over, lv_display_flush_ready() runs in
+ *   the LVGL task, once per flush;
+ * - calls from hpm_lvgl_rtos_post() and hpm_lvgl_rtos_post_from_isr() run in the LVGL task, in the
+ *   order they were queued;
+ * - a setter guarded by lv_lock() never runs while the LVGL task is refreshing, and can be called
+ *   from a posted call (the lock is recursive);
+ * - a post from the LVGL task on a full queue fails at once instead of waiting forever.
+ *
+ * Links with -Wl,--wrap=lv_display_flush_ready to see who completes a flush.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "hpm_lvgl_rtos.h"
+#include "hpm_lvgl_spi.h"
+#include "test_util.h"
+
+#if !HPM_LVGL_RTOS
+#error "Build this file with HPM_LVGL_RTOS=1"
+#endif
+
+#define TEST_HOR_RES        64
+#define TEST_VER_RES        32
+#define TEST_BUF_LINES      8
+#define TEST_XFER_TICKS     1U
+#define TEST_POSTS          400U
+#define TEST_SETS           200U
+#define TEST_MIN_FLUSHES    50U
+#define TEST_TIMEOUT_MS     20000U
+
+#define TEST_PRIO_DMA       (HPM_LVGL_RTOS_PRIORITY + 2)
+#define TEST_PRIO_WORKER    (HPM_LVGL_RTOS_PRIORITY - 1)
+#define TEST_PRIO_CHECK     (HPM_LVGL_RTOS_PRIORITY - 2)
+
+void test_rtos_assert(const char *file, int line)
+{
+    printf("FAIL: configASSERT at %s:%d\n", file, line);
+    exit(1);
+}
+
+static lv_display_t *test_disp;
+static lv_obj_t *test_label;
+static TaskHandle_t test_dma_task_handle;
+
+/* Flush bookkeeping: a flush is started by the flush callback and ended by lv_display_flush_ready() */
+static volatile bool test_flushing;
+static volatile uint32_t test_flushes;
+static volatile uint32_t test_flush_readies;
+
+/* Set between LV_EVENT_REFR_START and LV_EVENT_REFR_READY (inside lv_timer_handler()) */
+static volatile bool test_in_refr;
+
+/* Posted calls */
+static volatile uint32_t test_next_seq = 1U;
+static volatile uint32_t test_isr_posts;
+static volatile bool test_fill_done;
+static volatile uint32_t test_noops;
+static volatile uint32_t test_sets;
+static volatile bool test_worker_done;
+
+/*============================================================================
+ * Display: flush through a simulated DMA
+ *============================================================================*/
+
+void __real_lv_display_flush_ready(lv_display_t *disp);
+
+void __wrap_lv_display_flush_ready(lv_display_t *disp)
+{
+    TEST_CHECK(hpm_lvgl_rtos_in_lvgl_task(), "lv_display_flush_ready() outside the LVGL task");
+    TEST_CHECK(test_flushing, "flush completed twice");
+    test_flushing = false;
+    test_flush_readies++;
+    __real_lv_display_flush_ready(disp);
+}
+
+static void test_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    (void)disp;
+    (void)area;
+    (void)px_map;
+
+    TEST_CHECK(!test_flushing, "flush started while the previous one is on the bus");
+    test_flushing = true;
+    test_flushes++;
+    xTaskNotifyGive(test_dma_task_handle);
+}
+
+/* As lvgl_flush_wait_cb() in hpm_lvgl_spi.c with HPM_LVGL_RTOS */
+static void test_flush_wait_cb(lv_display_t *disp)
+{
+    (void)disp;
+
+    while (test_flushing) {
+        if (!hpm_lvgl_rtos_flush_ready()) {
+            hpm_lvgl_rtos_wait(HPM_LVGL_RTOS_WAIT_FOREVER);
+        }
+    }
+}
+
+/* The DMA completion interrupt: above the LVGL task, so nothing runs between the hand-over and
+ * the check below */
+static void test_dma_task(void *arg)
+{
+    (void)arg;
+
+    for (;;) {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        vTaskDelay(TEST_XFER_TICKS);
+
+        uint32_t readies = test_flush_readies;
+        hpm_lvgl_rtos_flush_done_isr(test_disp);
+        TEST_CHECK(test_flush_readies == readies, "flush completed in the ISR");
+        TEST_CHECK(test_flushing, "flush completed before the ISR");
+    }
+}
+
+static void test_refr_event_cb(lv_event_t *e)
+{
+    test_in_refr = (lv_event_get_code(e) == LV_EVENT_REFR_START);
+}
+
+static uint32_t test_tick_cb(void)
+{
+    return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+/* Stands in for the SPI bring-up: called by the LVGL task */
+lv_display_t *hpm_lvgl_spi_init(void)
+{
+    static uint16_t buf[2][TEST_HOR_RES * TEST_BUF_LINES];
+
+    lv_init();
+    lv_tick_set_cb(test_tick_cb);
+
+    test_disp = lv_display_create(TEST_HOR_RES, TEST_VER_RES);
+    if (test_disp == NULL) {
+        return NULL;
+    }
+    lv_display_set_buffers(test_disp, buf[0], buf[1], sizeof(buf[0]), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(test_disp, test_flush_cb);
+    lv_display_set_flush_wait_cb(test_disp, test_flush_wait_cb);
+    lv_display_add_event_cb(test_disp, test_refr_event_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(test_disp, test_refr_event_cb, LV_EVENT_REFR_READY, NULL);
+
+    return test_disp;
+}
+
+static void test_ui_create(void *user_data)
+{
+    (void)user_data;
+
+    test_label = lv_label_create(lv_screen_active());
+    lv_label_set_text(test_label, "0");
+}
+
+/*============================================================================
+ * UI changes from other tasks
+ *============================================================================*/
+
+/* A setter in the style of the adapter's: safe from any task */
+static void test_set_value(uint32_t value)
+{
+    lv_lock();
+    TEST_CHECK(!test_in_refr, "setter ran during a refresh");
+    lv_label_set_text_fmt(test_label, "%u", (unsigned int)value);
+    test_sets++;
+    lv_unlock();
+}
+
+static void test_seq_cb(void *user_data)
+{
+    uint32_t seq = (uint32_t)(uintptr_t)user_data;
+
+    TEST_CHECK(hpm_lvgl_rtos_in_lvgl_task(), "posted call outside the LVGL task");
+    TEST_CHECK(seq == test_next_seq, "posted call %u ran, expected %u", (unsigned int)seq,
+               (unsigned int)test_next_seq);
+    test_next_seq = seq + 1U;
+
+    /* lv_lock() is already held here */
+    if ((seq % 8U) == 0U) {
+        test_set_value(seq);
+    }
+}
+
+static void test_noop_cb(void *user_data)
+{
+    (void)user_data;
+    test_noops++;
+}
+
+/* From the LVGL task: queue until the queue is full. Must fail instead of blocking. */
+static void test_fill_cb(void *user_data)
+{
+    uint32_t posted = 0;
+    hpm_stat_t stat = status_success;
+
+    (void)user_data;
+    while (posted <= HPM_LVGL_RTOS_QUEUE_LEN) {
+        stat = hpm_lvgl_rtos_post(test_noop_cb, NULL, HPM_LVGL_RTOS_WAIT_FOREVER);
+        if (stat != status_success) {
+            break;
+        }
+        posted++;
+    }
+    TEST_CHECK(stat == status_fail, "post from the LVGL task on a full queue did not fail");
+    TEST_CHECK(posted <= HPM_LVGL_RTOS_QUEUE_LEN, "queue took more than its length");
+    test_fill_done = true;
+}
+
+static void test_worker_task(void *arg)
+{
+    (void)arg;
+
+    /* Wait for the LVGL task to bring the UI up */
+    while (test_label == NULL) {
+        vTaskDelay(1);
+    }
+
+    for (uint32_t seq = 1U; seq <= TEST_POSTS; seq++) {
+        if ((seq % 3U) == 0U) {
+            /* As an interrupt would: the queue may be full, retry later */
+            UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+            hpm_stat_t stat = hpm_lvgl_rtos_post_from_isr(test_seq_cb, (void *)(uintptr_t)seq);
+            taskEXIT_CRITICAL_FROM_ISR(mask);
+            if (stat != status_success) {
+                seq--;
+                vTaskDelay(1);
+                continue;
+            }
+            test_isr_posts++;
+        } else {
+            TEST_CHECK(hpm_lvgl_rtos_post(test_seq_cb, (void *)(uintptr_t)seq, 1000U) == status_success,
+                       "post %u timed out", (unsigned int)seq);
+        }
+        if (seq == (TEST_POSTS / 2U)) {
+            TEST_CHECK(hpm_lvgl_rtos_post(test_fill_cb, NULL, 1000U) == status_success, "fill post timed out");
+        }
+    }
+
+    for (uint32_t i = 0; i < TEST_SETS; i++) {
+        test_set_value(i);
+        vTaskDelay((i % 4U == 0U) ? 1U : 0U);
+    }
+
+    test_worker_done = true;
+    vTaskDelete(NULL);
+}
+
+/*============================================================================
+ * Result
+ *============================================================================*/
+
+static void test_check_task(void *arg)
+{
+    (void)arg;
+    TickType_t start = xTaskGetTickCount();
+
+    while (!test_worker_done || (test_next_seq <= TEST_POSTS) || (test_flushes < TEST_MIN_FLUSHES)) {
+        if ((xTaskGetTickCount() - start) > pdMS_TO_TICKS(TEST_TIMEOUT_MS)) {
+            printf("FAIL: stuck (posts run %u/%u, flushes %u)\n", (unsigned int)(test_next_seq - 1U),
+                   (unsigned int)TEST_POSTS, (unsigned int)test_flushes);
+            exit(1);
+        }
+        /* Keep the screen changing so the flushes go on */
+        if (test_worker_done) {
+            test_set_value(test_flushes);
+        }
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+
+    vTaskSuspendAll();
+    uint32_t flushes = test_flushes;
+    uint32_t readies = test_flush_readies;
+    bool flushing = test_flushing;
+    (void)xTaskResumeAll();
+
+    printf("flushes %u, posts %u (%u from ISR), sets %u, no-ops %u\n", (unsigned int)flushes,
+           (unsigned int)TEST_POSTS, (unsigned int)test_isr_posts, (unsigned int)test_sets,
+           (unsigned int)test_noops);
+    TEST_CHECK(readies == (flushing ? (flushes - 1U) : flushes), "flushes not completed once each");
+    TEST_CHECK(test_fill_done, "the full-queue post never ran");
+    TEST_CHECK(test_isr_posts > 0U, "no post from the ISR");
+
+    exit(test_result(NULL));
+}
+
+int main(void)
+{
+    setvbuf(stdout, NULL, _IONBF, 0);
+
+    TEST_CHECK(hpm_lvgl_rtos_start(test_ui_create, NULL) == status_success, "start");
+    xTaskCreate(test_dma_task, "dma", configMINIMAL_STACK_SIZE, NULL, TEST_PRIO_DMA, &test_dma_task_handle);
+    xTaskCreate(test_worker_task, "worker", configMINIMAL_STACK_SIZE, NULL, TEST_PRIO_WORKER, NULL);
+    xTaskCreate(test_check_task, "check", configMINIMAL_STACK_SIZE, NULL, TEST_PRIO_CHECK, NULL);
+
+    vTaskStartScheduler();
+
+    printf("FAIL: scheduler returned\n");
+    return 1;
+}
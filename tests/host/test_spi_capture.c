@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * SPI capture test
+ *
+ * src/st7789.c on the simulated bus of shim/host_bus.c, with src/hpm_lvgl_spi_capture.c
+ * recording. One frame goes out as four DMA strips with the same columns, then one small area is
+ * written twice by the blocking path and filled once, each time with the same window. The dump
+ * printed at the end is checked by check_spi_capture.cmake through tools/hpm_lvgl_spi_analyze.py:
+ * redundant CASET/RASET, command bytes and overhead per flush, and the FPS ceiling.
+ */
+
+#include <stdio.h>
+#include "board.h"
+#include "hpm_clock_drv.h"
+#include "st7789.h"
+#include "hpm_lvgl_spi_capture.h"
+#include "test_util.h"
+
+#if !HPM_LVGL_SPI_CAPTURE_ENABLE
+#error "Build this file with HPM_LVGL_SPI_CAPTURE_ENABLE=1"
+#endif
+
+/* Keep in sync with check_spi_capture.cmake */
+#define TEST_SPI_HZ         40000000UL
+#define TEST_HOR_RES        64U
+#define TEST_VER_RES        32U
+#define TEST_FB_LINES       8U
+
+/* The area written by the blocking path */
+#define TEST_AREA_X0        10U
+#define TEST_AREA_Y0        20U
+#define TEST_AREA_SIDE      10U
+
+static uint16_t test_strip[TEST_HOR_RES * TEST_FB_LINES];
+static uint32_t test_dma_dones;
+
+static void test_dma_done(void *user_data)
+{
+    (void)user_data;
+    test_dma_dones++;
+}
+
+/* As lvgl_flush_cb() with DMA: window, pixel DMA, then the completion interrupt */
+static void test_frame_dma(void)
+{
+    for (uint32_t y = 0; y < TEST_VER_RES; y += TEST_FB_LINES) {
+        st7789_set_window(0, (uint16_t)y, TEST_HOR_RES - 1U, (uint16_t)(y + TEST_FB_LINES - 1U));
+        TEST_CHECK(st7789_write_pixels_dma(test_strip, sizeof(test_strip), test_dma_done, NULL) == status_success,
+                   "DMA start at line %u", (unsigned int)y);
+        TEST_CHECK(st7789_is_busy(), "DMA not busy after its start");
+        st7789_dma_irq_handler();
+        TEST_CHECK(!st7789_is_busy(), "DMA still busy after its interrupt");
+    }
+    TEST_CHECK(test_dma_dones == (TEST_VER_RES / TEST_FB_LINES), "%u DMA completions",
+               (unsigned int)test_dma_dones);
+}
+
+/* The blocking path, twice on the same window, then a fill of it */
+static void test_area_blocking(void)
+{
+    const uint16_t x1 = TEST_AREA_X0 + TEST_AREA_SIDE - 1U;
+    const uint16_t y1 = TEST_AREA_Y0 + TEST_AREA_SIDE - 1U;
+
+    for (uint32_t i = 0; i < 2U; i++) {
+        st7789_set_window(TEST_AREA_X0, TEST_AREA_Y0, x1, y1);
+        st7789_write_pixels(test_strip, TEST_AREA_SIDE * TEST_AREA_SIDE);
+    }
+    st7789_fill_area(TEST_AREA_X0, TEST_AREA_Y0, x1, y1, 0xF800U);
+}
+
+int main(void)
+{
+    const st7789_config_t config = {
+        .spi_base = HPM_SPI7,
+        .spi_clk_name = clock_spi7,
+        .spi_freq_hz = TEST_SPI_HZ,
+        .dma_base = HPM_HDMA,
+        .dmamux_base = HPM_DMAMUX,
+        .dma_src_request = HPM_DMA_SRC_SPI7_TX,
+        .dma_irq_num = IRQn_HDMA,
+        .gpio_base = HPM_GPIO0,
+        .dc_gpio_index = BOARD_LCD_D_C_INDEX,
+        .dc_gpio_pin = BOARD_LCD_D_C_PIN,
+        .rst_gpio_index = BOARD_LCD_RESET_INDEX,
+        .rst_gpio_pin = BOARD_LCD_RESET_PIN,
+        .bl_gpio_index = BOARD_LCD_BL_INDEX,
+        .bl_gpio_pin = BOARD_LCD_BL_PIN,
+        .width = TEST_HOR_RES,
+        .height = TEST_VER_RES,
+    };
+
+    for (uint32_t i = 0; i < (TEST_HOR_RES * TEST_FB_LINES); i++) {
+        test_strip[i] = (uint16_t)test_rand();
+    }
+
+    /* Attach only: the panel bring-up waits on the clock, which here moves with the bus alone */
+    TEST_CHECK(st7789_attach(&config) == status_success, "attach");
+    hpm_lvgl_spi_capture_init();
+
+    test_frame_dma();
+    test_area_blocking();
+
+    hpm_lvgl_spi_capture_dump(TEST_SPI_HZ);
+    return test_result(NULL);
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2024 HPMicro
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Shared helpers of the host tests: failure counting, a seeded xorshift generator and the
+ * PASS/FAIL result that ctest reads from the exit code.
+ */
+
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/* Written by every task or thread of a test, read once at the end */
+static volatile uint32_t test_failures;
+
+#define TEST_CHECK(cond, ...)                   \
+    do {                                        \
+        if (!(cond)) {                          \
+            printf("FAIL: " __VA_ARGS__);       \
+            printf("\n");                       \
+            test_failures++;                    \
+        }                                       \
+    } while (0)
+
+/* Same sequence on every run; a test defines its own seed before including this file */
+#ifndef TEST_RAND_SEED
+#define TEST_RAND_SEED      0x2545F491UL
+#endif
+
+static uint32_t test_rng = TEST_RAND_SEED;
+
+static inline uint32_t test_rand(void)
+{
+    test_rng ^= test_rng << 13;
+    test_rng ^= test_rng >> 17;
+    test_rng ^= test_rng << 5;
+    return test_rng;
+}
+
+/* Print the result, after an optional label, and return the exit code */
+static inline int test_result(const char *label)
+{
+    if (label != NULL) {
+        printf("%s: ", label);
+    }
+    printf("%s\n", (test_failures == 0U) ? "PASS" : "FAIL");
+    return (test_failures == 0U) ? 0 : 1;
+}
+
+#endif /* TEST_UTIL_H */
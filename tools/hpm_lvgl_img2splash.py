@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 HPMicro
+# SPDX-License-Identifier: BSD-3-Clause
+"""Convert an image into a boot splash table for `hpm_lvgl_spi_set_splash()`.
+
+Usage:
+    python3 tools/hpm_lvgl_img2splash.py logo.png [--name boot_splash] [--format auto|raw|rle]
+                                         [--bg 000000] [--max-size 172x320] [-o boot_splash.c]
+
+Pixels are RGB565 in wire byte order (MSB first). RLE output is a stream of runs:
+a control byte c, then either (c & 0x80) one pixel repeated (c & 0x7F) + 1 times,
+or c + 1 literal pixels. `auto` picks whichever is smaller. Transparent pixels are
+blended onto the background color. Needs Pillow (`pip install pillow`).
+"""
+
+import argparse
+import sys
+
+
+def rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def parse_color(text):
+    text = text.lstrip("#")
+    if len(text) != 6:
+        raise ValueError("color must be RRGGBB")
+    v = int(text, 16)
+    return (v >> 16) & 0xFF, (v >> 8) & 0xFF, v & 0xFF
+
+
+def load_pixels(path, bg, max_size):
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit("error: Pillow is required (pip install pillow)")
+
+    img = Image.open(path).convert("RGBA")
+    if max_size and (img.width > max_size[0] or img.height > max_size[1]):
+        img.thumbnail(max_size)
+    base = Image.new("RGBA", img.size, bg + (255,))
+    base.alpha_composite(img)
+    return base.width, base.height, [rgb565(r, g, b) for r, g, b, _ in base.getdata()]
+
+
+def encode_raw(pixels):
+    out = bytearray()
+    for p in pixels:
+        out += bytes((p >> 8, p & 0xFF))
+    return bytes(out)
+
+
+def encode_rle(pixels):
+    out = bytearray()
+    literal = []
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:128]
+            del literal[:128]
+            out.append(len(chunk) - 1)
+            for p in chunk:
+                out.extend((p >> 8, p & 0xFF))
+
+    i = 0
+    n = len(pixels)
+    while i < n:
+        run = 1
+        while i + run < n and run < 128 and pixels[i + run] == pixels[i]:
+            run += 1
+        if run >= 2:
+            flush_literal()
+            out.append(0x80 | (run - 1))
+            out += bytes((pixels[i] >> 8, pixels[i] & 0xFF))
+        else:
+            literal.extend(pixels[i:i + run])
+        i += run
+    flush_literal()
+    return bytes(out)
+
+
+def to_c(name, fmt, width, height, bg, data):
+    out = ["/* %dx%d %s splash, %d bytes (generated by tools/hpm_lvgl_img2splash.py) */"
+           % (width, height, fmt, len(data)),
+           '#include "hpm_lvgl_spi.h"',
+           "",
+           "static const uint8_t %s_data[] = {" % name]
+    for i in range(0, len(data), 16):
+        out.append("    " + " ".join("0x%02x," % b for b in data[i:i + 16]))
+    out += ["};",
+            "",
+            "const hpm_lvgl_splash_t %s = {" % name,
+            "    .format = HPM_LVGL_SPLASH_%s," % fmt.upper(),
+            "    .width = %d," % width,
+            "    .height = %d," % height,
+            "    .bg_color = 0x%04x," % bg,
+            "    .data_size = sizeof(%s_data)," % name,
+            "    .data = %s_data," % name,
+            "};"]
+    return "\n".join(out) + "\n"
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("image", help="input image (PNG, BMP, ...)")
+    ap.add_argument("--name", default="boot_splash", help="C symbol name (default: boot_splash)")
+    ap.add_argument("--format", choices=("auto", "raw", "rle"), default="auto")
+    ap.add_argument("--bg", default="000000", help="background RRGGBB around the image (default: 000000)")
+    ap.add_argument("--max-size", default="172x320", help="shrink larger images to fit WxH (default: 172x320)")
+    ap.add_argument("-o", "--output", help="output file (default: stdout)")
+    args = ap.parse_args()
+
+    try:
+        bg = parse_color(args.bg)
+        max_size = tuple(int(v) for v in args.max_size.lower().split("x"))
+    except ValueError as e:
+        sys.exit("error: %s" % e)
+
+    width, height, pixels = load_pixels(args.image, bg, max_size)
+    raw = encode_raw(pixels)
+    rle = encode_rle(pixels)
+    fmt = args.format
+    if fmt == "auto":
+        fmt = "rle" if len(rle) < len(raw) else "raw"
+    data = rle if fmt == "rle" else raw
+
+    out = to_c(args.name, fmt, width, height, rgb565(*bg), data)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(out)
+    else:
+        sys.stdout.write(out)
+    print("%s: %dx%d, raw %d bytes, rle %d bytes -> %s" % (args.image, width, height, len(raw), len(rle), fmt),
+          file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
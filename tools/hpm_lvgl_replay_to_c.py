@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 HPMicro
+# SPDX-License-Identifier: BSD-3-Clause
+"""Convert a `hpm_lvgl_replay_dump()` UART log into a C journey table.
+
+Usage:
+    python3 tools/hpm_lvgl_replay_to_c.py uart.log [--name tsn_journey] [-o journey.inc]
+
+The output is a `static const hpm_lvgl_replay_event_t <name>[]` definition that can
+be passed to `hpm_lvgl_replay_play()`. Other console output around the dump is
+ignored; if the log holds several dumps, the last one is converted.
+"""
+
+import argparse
+import sys
+
+
+def parse_log(lines):
+    """Return [(delta_ms, code, arg)] for the last complete dump in the log."""
+    dumps = []
+    current = None
+    for line in lines:
+        line = line.strip()
+        if line.startswith("# hpm_lvgl_replay v1"):
+            current = []
+        elif line.startswith("# hpm_lvgl_replay end"):
+            if current is not None:
+                dumps.append(current)
+            current = None
+        elif current is not None and line.startswith("E "):
+            parts = line.split()
+            if len(parts) != 4:
+                continue
+            current.append((int(parts[1]), int(parts[2]), int(parts[3])))
+    if not dumps:
+        raise ValueError("no complete hpm_lvgl_replay dump found")
+    return dumps[-1]
+
+
+def to_c(name, events):
+    total = sum(e[0] for e in events)
+    out = ["/* %d events, %d ms (generated by tools/hpm_lvgl_replay_to_c.py) */" % (len(events), total),
+           "static const hpm_lvgl_replay_event_t %s[] = {" % name]
+    for delta_ms, code, arg in events:
+        out.append("    { %d, %d, %d }," % (delta_ms, code, arg))
+    out.append("};")
+    return "\n".join(out) + "\n"
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("log", help="UART log containing a hpm_lvgl_replay dump ('-' for stdin)")
+    ap.add_argument("--name", default="tsn_journey", help="C array name (default: tsn_journey)")
+    ap.add_argument("-o", "--output", help="output file (default: stdout)")
+    args = ap.parse_args()
+
+    if args.log == "-":
+        lines = sys.stdin.readlines()
+    else:
+        with open(args.log, "r", errors="replace") as f:
+            lines = f.readlines()
+
+    try:
+        events = parse_log(lines)
+    except ValueError as e:
+        sys.exit("error: %s" % e)
+
+    out = to_c(args.name, events)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(out)
+    else:
+        sys.stdout.write(out)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,312 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 HPMicro
+# SPDX-License-Identifier: BSD-3-Clause
+"""Offline analyzer for `hpm_lvgl_spi_capture_dump()` logs.
+
+Replays the captured LCD bus transactions through a small ST7789 (MIPI DCS)
+command model and reports:
+
+- command overhead per flush (bytes, transactions, time before pixel data)
+- redundant CASET/RASET (window already set to the same value)
+- idle gaps between transactions
+- pixel throughput vs. the SPI wire rate, and the theoretical FPS ceiling
+
+Usage:
+    python3 tools/hpm_lvgl_spi_analyze.py uart.log [--width 172 --height 320 --fb-lines 80]
+"""
+
+import argparse
+import math
+import sys
+
+# Must match hpm_lvgl_spi_cap_kind_t in src/hpm_lvgl_spi_capture.h
+WRITE = 1
+DMA_START = 2
+DMA_DONE = 3
+CS = 4
+
+FLAG_DC = 0x1
+FLAG_CS = 0x2
+FLAG_HW_CS = 0x4
+
+CMD_NAMES = {
+    0x01: "SWRESET", 0x11: "SLPOUT", 0x13: "NORON", 0x20: "INVOFF", 0x21: "INVON",
+    0x28: "DISPOFF", 0x29: "DISPON", 0x2A: "CASET", 0x2B: "RASET", 0x2C: "RAMWR",
+    0x36: "MADCTL", 0x3A: "COLMOD", 0xB2: "PORCTRL", 0xB7: "GCTRL", 0xBB: "VCOMS",
+    0xC0: "LCMCTRL", 0xC2: "VDVVRHEN", 0xC3: "VRHS", 0xC4: "VDVS", 0xC6: "FRCTRL2",
+    0xD0: "PWCTRL1", 0xE0: "PVGAMCTRL", 0xE1: "NVGAMCTRL",
+}
+
+CASET = 0x2A
+RASET = 0x2B
+RAMWR = 0x2C
+
+
+class Entry:
+    __slots__ = ("cycle", "kind", "flags", "length", "dur", "data")
+
+    def __init__(self, cycle, kind, flags, length, dur, data):
+        self.cycle = cycle
+        self.kind = kind
+        self.flags = flags
+        self.length = length
+        self.dur = dur
+        self.data = data
+
+
+def parse_log(lines):
+    """Return (header dict, entries) for the last complete dump in the log."""
+    dumps = []
+    current = None
+    header = {}
+    for line in lines:
+        line = line.strip()
+        if line.startswith("# hpm_lvgl_spi_capture v1"):
+            current = []
+            header = {}
+            for field in line.split()[3:]:
+                key, _, value = field.partition("=")
+                header[key] = int(value)
+        elif line.startswith("# hpm_lvgl_spi_capture end"):
+            if current is not None:
+                dumps.append((header, current))
+            current = None
+        elif current is not None and line.startswith("S "):
+            p = line.split()
+            if len(p) != 7:
+                continue
+            current.append(Entry(int(p[1], 16), int(p[2]), int(p[3], 16), int(p[4]), int(p[5]), bytes.fromhex(p[6])))
+    if not dumps:
+        raise ValueError("no complete hpm_lvgl_spi_capture dump found")
+    return dumps[-1]
+
+
+def percentile(values, pct):
+    if not values:
+        return 0.0
+    v = sorted(values)
+    k = min(len(v) - 1, max(0, int(round((pct / 100.0) * (len(v) - 1)))))
+    return v[k]
+
+
+class Flush:
+    def __init__(self, first_cycle):
+        self.first_cycle = first_cycle   # first command transaction of this flush
+        self.cmd_bytes = 0
+        self.cmd_transactions = 0
+        self.pixel_start = None
+        self.pixel_end = None
+        self.pixel_bytes = 0
+        self.window = None
+        self.dma = False
+        self.closed = False
+
+
+def analyze(header, entries, width, height, fb_lines):
+    cpu_hz = header.get("cpu_hz", 0)
+    spi_hz = header.get("spi_hz", 0)
+    if cpu_hz <= 0 or spi_hz <= 0:
+        raise ValueError("dump header needs cpu_hz and spi_hz")
+
+    def us(cycles):
+        return cycles * 1e6 / cpu_hz
+
+    cmd = None
+    caset = None
+    raset = None
+    redundant_caset = 0
+    redundant_raset = 0
+    cmd_hist = {}
+    cs_edges = 0
+    dma_fallbacks = 0
+    size_mismatch = 0
+
+    flushes = []
+    cur = None
+    pending_dma = None
+
+    gaps = []
+    last_end = None
+
+    def close_flush(f):
+        if f is None or f.closed or f.pixel_bytes == 0:
+            return
+        f.closed = True
+        if caset is not None and raset is not None:
+            x1, x2 = (caset[0] << 8) | caset[1], (caset[2] << 8) | caset[3]
+            y1, y2 = (raset[0] << 8) | raset[1], (raset[2] << 8) | raset[3]
+            f.window = (x1, y1, x2, y2)
+        flushes.append(f)
+
+    for e in entries:
+        if e.kind == CS:
+            cs_edges += 1
+            continue
+
+        # Transaction start/end (cycles) for gap accounting.
+        if e.kind == WRITE:
+            start, end = e.cycle, e.cycle + e.dur
+        elif e.kind == DMA_START:
+            start, end = e.cycle, None
+        else:  # DMA_DONE
+            start, end = None, e.cycle
+
+        if start is not None and last_end is not None:
+            gaps.append(start - last_end)
+        if end is not None:
+            last_end = end
+        elif e.kind == DMA_START:
+            last_end = None
+
+        if e.kind == WRITE and not (e.flags & FLAG_DC):
+            if pending_dma is not None:
+                # DMA start never completed before the next command: treated as failed.
+                dma_fallbacks += 1
+                pending_dma = None
+            cmd = e.data[0]
+            cmd_hist[cmd] = cmd_hist.get(cmd, 0) + 1
+            if cur is None or cur.pixel_end is not None:
+                # Blocking-only flushes (legacy fallback path) are closed by the next command.
+                close_flush(cur)
+                cur = Flush(e.cycle)
+            cur.cmd_bytes += e.length
+            cur.cmd_transactions += 1
+            continue
+
+        if e.kind == WRITE:  # data phase
+            if cmd == CASET and e.length == 4:
+                value = bytes(e.data[:4])
+                if value == caset:
+                    redundant_caset += 1
+                caset = value
+                cur.cmd_bytes += e.length
+                cur.cmd_transactions += 1
+            elif cmd == RASET and e.length == 4:
+                value = bytes(e.data[:4])
+                if value == raset:
+                    redundant_raset += 1
+                raset = value
+                cur.cmd_bytes += e.length
+                cur.cmd_transactions += 1
+            elif cur is None:
+                continue
+            elif cmd == RAMWR:
+                if pending_dma is not None:
+                    dma_fallbacks += 1
+                    pending_dma = None
+                if cur.pixel_start is None:
+                    cur.pixel_start = e.cycle
+                cur.pixel_bytes += e.length
+                cur.pixel_end = e.cycle + e.dur
+            else:
+                cur.cmd_bytes += e.length
+                cur.cmd_transactions += 1
+            continue
+
+        if e.kind == DMA_START and cur is not None:
+            pending_dma = e
+            if cur.pixel_start is None:
+                cur.pixel_start = e.cycle
+            continue
+
+        if e.kind == DMA_DONE and pending_dma is not None and cur is not None:
+            cur.pixel_bytes += pending_dma.length
+            cur.pixel_end = e.cycle
+            cur.dma = True
+            pending_dma = None
+            close_flush(cur)
+            continue
+
+    close_flush(cur)
+    pixel_flushes = flushes
+    for f in pixel_flushes:
+        if f.window is not None:
+            x1, y1, x2, y2 = f.window
+            if (x2 - x1 + 1) * (y2 - y1 + 1) * 2 != f.pixel_bytes:
+                size_mismatch += 1
+
+    # ---- Report -------------------------------------------------------------
+    # Up to the end of the last transaction: a blocking write lasts past its start
+    span_cycles = max(e.cycle + e.dur for e in entries) - entries[0].cycle if len(entries) > 1 else 0
+    print("Capture: %d entries, %.1f ms, CPU %.0f MHz, SPI %.2f MHz" %
+          (len(entries), us(span_cycles) / 1000.0, cpu_hz / 1e6, spi_hz / 1e6))
+    if header.get("dropped"):
+        print("  (%d older entries were overwritten; increase HPM_LVGL_SPI_CAPTURE_DEPTH)" % header["dropped"])
+    print("GPIO CS edges: %d" % cs_edges)
+    print()
+
+    print("Commands:")
+    for c, n in sorted(cmd_hist.items(), key=lambda kv: -kv[1]):
+        print("  0x%02X %-10s %6d" % (c, CMD_NAMES.get(c, "?"), n))
+    print("  redundant CASET: %d  redundant RASET: %d" % (redundant_caset, redundant_raset))
+    if dma_fallbacks:
+        print("  DMA start failures (fallback to blocking): %d" % dma_fallbacks)
+    if size_mismatch:
+        print("  WARNING: %d flushes sent a byte count that does not match the address window" % size_mismatch)
+    print()
+
+    if not pixel_flushes:
+        print("No pixel flushes captured.")
+        return
+
+    overhead_us = [us(f.pixel_start - f.first_cycle) for f in pixel_flushes]
+    pixel_us = [us(f.pixel_end - f.pixel_start) for f in pixel_flushes]
+    cmd_bytes = [f.cmd_bytes for f in pixel_flushes]
+    cmd_trans = [f.cmd_transactions for f in pixel_flushes]
+    total_pixel_bytes = sum(f.pixel_bytes for f in pixel_flushes)
+    wire_us = total_pixel_bytes * 8 * 1e6 / spi_hz
+    avg_overhead = sum(overhead_us) / len(overhead_us)
+
+    print("Flushes: %d  (%d via DMA)" % (len(pixel_flushes), sum(1 for f in pixel_flushes if f.dma)))
+    print("  pixel bytes:            %d (avg %.0f per flush)" % (total_pixel_bytes, total_pixel_bytes / len(pixel_flushes)))
+    print("  command bytes/flush:    avg %.1f  transactions/flush: avg %.1f" %
+          (sum(cmd_bytes) / len(cmd_bytes), sum(cmd_trans) / len(cmd_trans)))
+    print("  command overhead/flush: avg %.1f us  p95 %.1f us  max %.1f us" %
+          (avg_overhead, percentile(overhead_us, 95), max(overhead_us)))
+    print("  pixel transfer:         %.1f us total vs %.1f us on the wire (%.0f%% efficiency)" %
+          (sum(pixel_us), wire_us, 100.0 * wire_us / sum(pixel_us) if sum(pixel_us) > 0 else 0.0))
+    print()
+
+    gaps_us = [us(g) for g in gaps if g >= 0]
+    if gaps_us:
+        print("Gaps between transactions: n=%d avg %.1f us  p50 %.1f us  p95 %.1f us  max %.1f us" %
+              (len(gaps_us), sum(gaps_us) / len(gaps_us), percentile(gaps_us, 50),
+               percentile(gaps_us, 95), max(gaps_us)))
+        busy = sum(pixel_us)
+        if span_cycles > 0:
+            print("Bus utilization (pixel phases): %.1f%%" % (100.0 * busy / us(span_cycles)))
+        print()
+
+    frame_bytes = width * height * 2
+    flushes_per_frame = int(math.ceil(height / float(fb_lines)))
+    frame_wire_us = frame_bytes * 8 * 1e6 / spi_hz
+    frame_us = frame_wire_us + flushes_per_frame * avg_overhead
+    print("Theoretical ceiling (%dx%d RGB565, %d-line buffers -> %d flushes/frame):" %
+          (width, height, fb_lines, flushes_per_frame))
+    print("  wire only:                 %.1f FPS (%.2f ms/frame)" % (1e6 / frame_wire_us, frame_wire_us / 1000.0))
+    print("  with measured overhead:    %.1f FPS (%.2f ms/frame)" % (1e6 / frame_us, frame_us / 1000.0))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("log", help="UART log containing a hpm_lvgl_spi_capture dump ('-' for stdin)")
+    ap.add_argument("--width", type=int, default=172)
+    ap.add_argument("--height", type=int, default=320)
+    ap.add_argument("--fb-lines", type=int, default=80, help="HPM_LVGL_FB_LINES used by the firmware")
+    args = ap.parse_args()
+
+    if args.log == "-":
+        lines = sys.stdin.readlines()
+    else:
+        with open(args.log, "r", errors="replace") as f:
+            lines = f.readlines()
+
+    try:
+        header, entries = parse_log(lines)
+        analyze(header, entries, args.width, args.height, args.fb_lines)
+    except ValueError as e:
+        sys.exit("error: %s" % e)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 HPMicro
+# SPDX-License-Identifier: BSD-3-Clause
+"""Convert a `hpm_lvgl_trace_dump()` UART log into Chrome trace JSON.
+
+Usage:
+    python3 tools/hpm_lvgl_trace2json.py uart.log -o trace.json
+
+Open the result in https://ui.perfetto.dev or chrome://tracing.
+Other console output around the dump is ignored; if the log holds several
+dumps, the last one is converted.
+"""
+
+import argparse
+import json
+import sys
+
+# Must match hpm_lvgl_trace_event_t in src/hpm_lvgl_trace.h
+FLUSH_START = 1
+FLUSH_END = 2
+DMA_TC = 3
+SPI_IDLE = 4
+REFR_START = 5
+REFR_READY = 6
+INPUT = 7
+MARKER = 8
+
+TID_REFRESH = 1
+TID_FLUSH = 2
+TID_SPI = 3
+TID_EVENTS = 4
+
+TRACK_NAMES = {
+    TID_REFRESH: "LVGL refresh",
+    TID_FLUSH: "flush (LVGL buffer busy)",
+    TID_SPI: "SPI bus",
+    TID_EVENTS: "input / markers",
+}
+
+
+def parse_log(lines):
+    """Return (cpu_hz, records) for the last complete dump in the log."""
+    dumps = []
+    current = None
+    cpu_hz = 0
+    for line in lines:
+        line = line.strip()
+        if line.startswith("# hpm_lvgl_trace v1"):
+            current = []
+            cpu_hz = 0
+            for field in line.split()[3:]:
+                key, _, value = field.partition("=")
+                if key == "cpu_hz":
+                    cpu_hz = int(value)
+        elif line.startswith("# hpm_lvgl_trace end"):
+            if current is not None:
+                dumps.append((cpu_hz, current))
+            current = None
+        elif current is not None and line.startswith("T "):
+            parts = line.split()
+            if len(parts) != 5:
+                continue
+            current.append((int(parts[1], 16), int(parts[2]), int(parts[3]), int(parts[4], 16)))
+    if not dumps:
+        raise ValueError("no complete hpm_lvgl_trace dump found")
+    return dumps[-1]
+
+
+def to_chrome(cpu_hz, records):
+    if cpu_hz <= 0:
+        raise ValueError("dump header has no cpu_hz")
+    if not records:
+        return {"traceEvents": []}
+
+    base = records[0][0]
+
+    def us(cycle):
+        return (cycle - base) * 1e6 / cpu_hz
+
+    events = []
+    for tid, name in TRACK_NAMES.items():
+        events.append({"ph": "M", "pid": 1, "tid": tid, "name": "thread_name", "args": {"name": name}})
+
+    def span(tid, name, start, end, args=None):
+        ev = {"ph": "X", "pid": 1, "tid": tid, "name": name, "ts": us(start), "dur": max(us(end) - us(start), 0.0)}
+        if args:
+            ev["args"] = args
+        events.append(ev)
+
+    refr_start = None
+    flushes = {}  # seq -> dict(start, bytes, tc)
+    for cycle, event, arg16, arg in records:
+        if event == REFR_START:
+            refr_start = cycle
+        elif event == REFR_READY:
+            if refr_start is not None:
+                span(TID_REFRESH, "refresh", refr_start, cycle)
+            refr_start = None
+        elif event == FLUSH_START:
+            flushes[arg16] = {"start": cycle, "bytes": arg, "tc": None}
+        elif event == DMA_TC:
+            f = flushes.get(arg16)
+            if f is not None:
+                f["tc"] = cycle
+                span(TID_SPI, "pixel DMA", f["start"], cycle, {"seq": arg16, "bytes": f["bytes"]})
+        elif event == SPI_IDLE:
+            f = flushes.get(arg16)
+            if f is not None and f["tc"] is not None:
+                span(TID_SPI, "drain", f["tc"], cycle, {"seq": arg16})
+        elif event == FLUSH_END:
+            f = flushes.pop(arg16, None)
+            if f is not None:
+                span(TID_FLUSH, "flush #%d" % arg16, f["start"], cycle, {"seq": arg16, "bytes": f["bytes"]})
+        elif event == INPUT:
+            events.append({"ph": "i", "s": "g", "pid": 1, "tid": TID_EVENTS, "ts": us(cycle),
+                           "name": "input %d %s" % (arg16, "down" if arg else "up")})
+        elif event == MARKER:
+            events.append({"ph": "i", "s": "t", "pid": 1, "tid": TID_EVENTS, "ts": us(cycle),
+                           "name": "marker %d" % arg16, "args": {"value": arg}})
+
+    return {"traceEvents": events, "displayTimeUnit": "ms"}
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("log", help="UART log containing a hpm_lvgl_trace dump ('-' for stdin)")
+    ap.add_argument("-o", "--output", help="output JSON file (default: stdout)")
+    args = ap.parse_args()
+
+    if args.log == "-":
+        lines = sys.stdin.readlines()
+    else:
+        with open(args.log, "r", errors="replace") as f:
+            lines = f.readlines()
+
+    try:
+        cpu_hz, records = parse_log(lines)
+        trace = to_chrome(cpu_hz, records)
+    except ValueError as e:
+        sys.exit("error: %s" % e)
+
+    out = json.dumps(trace, indent=1)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(out)
+    else:
+        print(out)
+
+
+if __name__ == "__main__":
+    main()